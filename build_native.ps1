@@ -32,8 +32,25 @@ $cFiles = @(
     "src/output_control.c",
     "src/utils.c",
     "src/fft.c",
+    "src/dsp_arena.c",
+    "src/dsp_kernels.c",
+    "src/fixed_point.c",
+    "src/multichannel.c",
+    "src/worker_pool.c",
     "src/lda.c",
-    "src/data_loader.c"
+    "src/data_loader.c",
+    "src/mapped_file.c",
+    "src/csv_scan.c",
+    "src/session_file.c",
+    "src/acquisition.c",
+    "src/welch.c",
+    "src/bci_model.c",
+    "src/profiler.c",
+    "src/telemetry.c",
+    "src/streaming.c",
+    "src/sliding_dft.c",
+    "src/sample_ring.c",
+    "src/scheduler.c"
 )
 
 $objFiles = @()
@@ -62,7 +79,19 @@ if ($LASTEXITCODE -ne 0) {
     exit 1
 }
 
+# Kernel benchmarks: the same objects without main.c
+Write-Host "Building benchmarks..." -ForegroundColor Green
+& $CC -c tests/benchmark.c -o build/benchmark.o -Iinclude -O2 -Wall
+$benchObjects = @($objFiles | Where-Object { $_ -ne "build/main.o" }) + "build/benchmark.o"
+& $CC -o bin/benchmark.exe $benchObjects -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Error linking benchmarks" -ForegroundColor Red
+    exit 1
+}
+
 Write-Host "Build successful!" -ForegroundColor Green
 Write-Host "Output: bin/bci_system.exe" -ForegroundColor Cyan
 Write-Host ""
 Write-Host "To run: .\bin\bci_system.exe" -ForegroundColor Yellow
+Write-Host "To benchmark: .\bin\benchmark.exe (results in bench_output.txt)" -ForegroundColor Yellow
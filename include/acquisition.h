@@ -0,0 +1,182 @@
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include "types.h"
+#include "config.h"
+#include "scheduler.h"
+#include "data_loader.h"
+#include "session_file.h"
+#include "fixed_point.h"
+#include <stdatomic.h>
+
+#if USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* Double-buffered acquisition from a pluggable sample source.
+ *
+ * The source fills one buffer ACQ_BLOCK_SIZE samples at a time (one "DMA
+ * transfer") while the DSP owns the other; a completed buffer is handed
+ * over with a completion callback and/or the poll/wait API, and returned
+ * with acquisition_release. Sources:
+ *   - simulator: a script of mental states through generate_eeg_sample
+ *   - file replay: a CSV recording (dataset_reader_t) or a session file
+ *   - ADC: an SPI/ADC receive register (with DMA, point it at the buffer)
+ *
+ * Paced acquisitions deliver one block per ACQ_BLOCK_PERIOD_US like a real
+ * converter: if neither buffer is back from the DSP, blocks are dropped and
+ * counted. Unpaced ones (file replay) wait for a free buffer instead.
+ * Hosted USE_PTHREADS builds run the source on its own thread; otherwise
+ * it runs from acquisition_wait at each deadline, as an ISR would.
+ *
+ * Samples are microvolts, or Q15 (FIXED_INPUT_FULL_SCALE uV full scale) in
+ * USE_FIXED_POINT builds, so the integer pipeline takes the buffers as they
+ * are: the ADC source converts counts with one integer multiply and shift.
+ */
+
+/* Time between blocks at the sampling rate */
+#define ACQ_BLOCK_PERIOD_US (1000000u * ACQ_BLOCK_SIZE / SAMPLING_RATE)
+
+/* Largest ping-pong buffer */
+#define ACQ_MAX_BUFFER_SAMPLES WINDOW_SIZE
+
+#if USE_FIXED_POINT
+typedef q15_t acq_sample_t;
+#else
+typedef signal_t acq_sample_t;
+#endif
+
+/* Conversions to and from microvolts (copies unless USE_FIXED_POINT) */
+void acq_samples_to_signal(const acq_sample_t *input, signal_t *output, size_t length);
+void acq_samples_from_signal(const signal_t *input, acq_sample_t *output, size_t length);
+
+/* ========== Sources ========== */
+
+/* Source backend: fill up to count samples
+ * Returns: Samples written to buffer; 0 once the source is exhausted
+ */
+typedef size_t (*acq_fill_fn)(void *context, acq_sample_t *buffer, size_t count);
+
+typedef struct {
+    const char *name;
+    acq_fill_fn fill;
+    void *context;
+} acq_source_t;
+
+/* Simulated headset playing one WINDOW_SIZE window per script entry */
+typedef struct {
+    const command_t *script;
+    size_t script_length;
+    size_t total_samples;
+    size_t produced;
+    signal_t window[WINDOW_SIZE];
+} acq_simulator_t;
+
+/* Replay of a recorded file (channel 0 of a session file, or the single
+ * channel of a CSV recording) */
+typedef struct {
+    bool_t is_session;
+    dataset_reader_t csv;
+    session_reader_t session;
+    size_t position;             /* Next session sample */
+#if USE_FIXED_POINT
+    signal_t scratch[ACQ_BLOCK_SIZE];  /* Recorded microvolts before conversion */
+#endif
+} acq_file_t;
+
+/* Live converter read through a memory-mapped receive register */
+typedef struct {
+    volatile const int32_t *data_register;   /* Each read pops one sample */
+    float microvolts_per_lsb;
+#if USE_FIXED_POINT
+    int32_t q15_per_lsb;         /* Q16 gain: Q15 sample = (count * gain) >> 16 */
+#endif
+} acq_adc_t;
+
+/* Simulator source: num_windows windows cycling through script */
+void acq_simulator_open(acq_simulator_t *sim, acq_source_t *source,
+                        const command_t *script, size_t script_length, size_t num_windows);
+
+/* Replay source over a CSV or session file (detected from its contents)
+ * Returns: FALSE if the file cannot be read or has no single-channel layout
+ */
+bool_t acq_file_open(acq_file_t *file, acq_source_t *source, const char *filepath);
+void acq_file_close(acq_file_t *file);
+
+/* ADC source reading raw counts from data_register (the Q15 gain of
+ * USE_FIXED_POINT builds is computed here, once) */
+void acq_adc_open(acq_adc_t *adc, acq_source_t *source,
+                  volatile const int32_t *data_register, float microvolts_per_lsb);
+
+/* ========== Ping-Pong Acquisition ========== */
+
+/* Called in acquisition context whenever a buffer completes */
+typedef void (*acq_complete_fn)(void *user_data, const acq_sample_t *buffer, size_t count);
+
+typedef struct {
+    acq_source_t source;
+    size_t buffer_length;        /* Samples per buffer */
+    bool_t paced;
+    acq_complete_fn on_complete;
+    void *user_data;
+
+    acq_sample_t buffers[2][ACQ_MAX_BUFFER_SAMPLES];
+    size_t counts[2];            /* Valid samples in each completed buffer */
+    uint64_t completed_ticks[2]; /* PROF_NOW() at completion (0 without profiling) */
+    atomic_uint state[2];        /* ACQ_BUFFER_* */
+
+    /* Acquisition side */
+    size_t fill_index;
+    size_t fill_count;
+    bool_t stalled;              /* Both buffers busy: dropping blocks */
+    sched_timer_t timer;
+    sched_event_t buffer_free;
+
+    /* DSP side */
+    size_t consume_index;
+    sched_event_t buffer_ready;
+
+    atomic_uint finished;        /* Source exhausted (last buffer published) */
+    atomic_uint stop;            /* DSP asked the source to stop */
+    atomic_uint dropped;         /* Samples lost to overruns */
+    atomic_uint overruns;        /* Times the DSP held both buffers */
+#if USE_PTHREADS
+    pthread_t thread;
+#endif
+} acquisition_t;
+
+/* Start acquiring buffer_length-sample buffers from source
+ * on_complete: Optional callback per completed buffer (may be NULL)
+ * Returns: FALSE for a bad buffer length
+ */
+bool_t acquisition_start(acquisition_t *acq, const acq_source_t *source,
+                         size_t buffer_length, bool_t paced,
+                         acq_complete_fn on_complete, void *user_data);
+
+/* Take the next completed buffer without blocking (the DSP holds at most
+ * one buffer: release it before taking the next)
+ * Returns: The buffer (count set), or NULL if none is ready yet
+ */
+const acq_sample_t* acquisition_poll(acquisition_t *acq, size_t *count);
+
+/* Sleep until the next buffer completes
+ * Returns: The buffer (count set; the last one may be short), or NULL at the
+ *          end of the stream
+ */
+const acq_sample_t* acquisition_wait(acquisition_t *acq, size_t *count);
+
+/* Hand the buffer returned by poll/wait back to the source */
+void acquisition_release(acquisition_t *acq);
+
+/* Stop the source and wait for it (safe before the stream has ended) */
+void acquisition_stop(acquisition_t *acq);
+
+/* When the buffer held by the DSP completed, in profiler ticks (0 unless
+ * ENABLE_PROFILING), for sample-to-command latency */
+uint64_t acquisition_completed_ticks(const acquisition_t *acq);
+
+/* Diagnostics */
+uint32_t acquisition_dropped(const acquisition_t *acq);
+uint32_t acquisition_overruns(const acquisition_t *acq);
+
+#endif /* ACQUISITION_H */
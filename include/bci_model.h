@@ -0,0 +1,129 @@
+#ifndef BCI_MODEL_H
+#define BCI_MODEL_H
+
+#include "types.h"
+#include "config.h"
+#include "lda.h"
+#include "classifier.h"
+#include "mapped_file.h"
+
+/* Serialized classifier model (.bcim)
+ *
+ * One fixed-size, little-endian record of 32-bit fields with no pointers
+ * and no padding, so the bytes on disk are the struct in memory. A blob
+ * linked into flash (or mapped from a file) is validated once by
+ * bci_model_view and then used where it lies: no parsing, no heap copy.
+ *
+ *   header      magic, version, size, CRC-32 of everything after the CRC,
+ *               section flags, sample rate / window size it was trained at
+ *   features    band table, per-feature normalization (mean, 1/std)
+ *   binary LDA  projection and threshold (lda_model_t)
+ *   multi LDA   per-class weights and biases (lda_multiclass_t)
+ *   rules       classify_command / predict_impairments thresholds
+ */
+
+#define BCI_MODEL_MAGIC     0x4D494342u   /* "BCIM" */
+#define BCI_MODEL_VERSION   1u
+#define BCI_MODEL_MAX_BANDS 8
+#define BCI_MODEL_SIZE      612           /* sizeof(bci_model_t), checked at compile time */
+
+/* Sections present in a blob */
+#define BCI_MODEL_HAS_BINARY     0x1u
+#define BCI_MODEL_HAS_MULTICLASS 0x2u
+
+typedef struct {
+    /* Header */
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                /* Bytes in the record */
+    uint32_t crc32;               /* CRC-32 of the bytes after this field */
+    uint32_t flags;               /* BCI_MODEL_HAS_* */
+    float sample_rate;            /* Feature domain the model was trained in */
+    uint32_t window_size;
+    uint32_t num_features;
+    uint32_t num_classes;
+    uint32_t num_bands;
+
+    /* Feature pipeline */
+    frequency_band_t bands[BCI_MODEL_MAX_BANDS];
+    float feature_mean[LDA_MAX_FEATURES];      /* Normalized x = (x - mean) * inv_std */
+    float feature_inv_std[LDA_MAX_FEATURES];
+
+    /* Binary LDA on normalized features */
+    float projection[LDA_MAX_FEATURES];
+    float threshold;
+
+    /* Multi-class LDA on normalized features */
+    float weights[LDA_MAX_CLASSES][LDA_MAX_FEATURES];
+    float bias[LDA_MAX_CLASSES];
+
+    /* Rule-based classifier */
+    classifier_thresholds_t thresholds;
+} bci_model_t;
+
+/* Model file mapped for in-place use */
+typedef struct {
+    mapped_file_t file;
+    const bci_model_t *model;     /* Points into the mapping */
+} bci_model_file_t;
+
+/* ========== Building ========== */
+
+/* Empty model: default bands and thresholds, identity normalization,
+ * no LDA sections */
+void bci_model_init(bci_model_t *model, size_t num_features);
+
+/* Normalization from training rows (row-major, num_features per row) */
+void bci_model_fit_normalization(bci_model_t *model, const signal_t *rows, size_t num_rows);
+
+/* Store a binary LDA trained on normalized features
+ * Returns: FALSE if untrained or its feature count differs from the model's
+ */
+bool_t bci_model_set_binary(bci_model_t *model, const lda_model_t *lda);
+
+/* Store a multi-class LDA trained on normalized features */
+bool_t bci_model_set_multiclass(bci_model_t *model, const lda_multiclass_t *lda);
+
+/* Fill in size and CRC (call after the last change, before saving or linking) */
+void bci_model_seal(bci_model_t *model);
+
+/* Seal and write the record
+ * Returns: TRUE on success
+ */
+bool_t bci_model_save(bci_model_t *model, const char *filepath);
+
+/* ========== Loading ========== */
+
+/* Validate a blob in place (flash, a mapping or a buffer; 4-byte aligned):
+ * magic, version, size, CRC, section sizes and the build's sample rate,
+ * window size and frequency bands
+ * Returns: The blob as a model, or NULL if it is not usable here
+ */
+const bci_model_t* bci_model_view(const void *data, size_t size);
+
+/* Map and validate a model file
+ * Returns: TRUE on success (file->model valid until bci_model_close)
+ */
+bool_t bci_model_open(bci_model_file_t *file, const char *filepath);
+void bci_model_close(bci_model_file_t *file);
+
+/* ========== Inference ========== */
+
+/* Use the model's classify_command thresholds (the model, e.g. a mapping,
+ * must outlive the state) */
+void bci_model_apply_thresholds(const bci_model_t *model, classifier_state_t *state);
+
+/* Apply the stored normalization (num_features values) */
+void bci_model_normalize(const bci_model_t *model, const signal_t *features, signal_t *normalized);
+
+/* Binary decision on raw features: 1 when the projection reaches the
+ * threshold, 0 otherwise (-1 without a binary section) */
+int bci_model_predict_binary(const bci_model_t *model, const signal_t *features);
+
+/* Multi-class decision on raw features
+ * scores: Optional, num_classes entries
+ * Returns: Best class (-1 without a multi-class section)
+ */
+int bci_model_classify(const bci_model_t *model, const signal_t *features, float *scores);
+
+#endif /* BCI_MODEL_H */
@@ -3,29 +3,116 @@
 
 #include "types.h"
 #include "config.h"
+#include "fixed_point.h"
+
+/* Decision thresholds (defaults from config.h; a model blob can carry its
+ * own). Fixed-width fields only, so a table can be used in place from flash */
+typedef struct {
+    float focus;                 /* Beta power ratio for FOCUS */
+    float relax;                 /* Alpha power ratio for RELAX */
+    float blink;                 /* Peak amplitude multiplier above baseline */
+    int32_t debounce_count;      /* Consecutive detections needed */
+    float visual_alpha_normal;
+    float visual_alpha_borderline;
+    float motor_beta_normal;
+    float motor_beta_borderline;
+    float attention_ratio_normal;
+    float attention_ratio_border;
+} classifier_thresholds_t;
+
+/* Thresholds built from the config.h #defines */
+extern const classifier_thresholds_t classifier_default_thresholds;
 
 /* Classifier state for debouncing */
 typedef struct {
     command_t last_command;
     int debounce_counter;
     signal_t baseline_amplitude;
+    q15_t baseline_amplitude_q15;  /* Baseline for classify_command_q15 (FIXED_SIGMA units) */
+    const classifier_thresholds_t *thresholds;  /* Not copied: may point into flash */
+    q15_t focus_q15;               /* Thresholds pre-converted for classify_command_q15 */
+    q15_t relax_q15;
+    q31_t blink_q8;
 } classifier_state_t;
 
-/* Initialize classifier */
+/* Initialize classifier (with classifier_default_thresholds) */
 void classifier_init(classifier_state_t *state);
 
+/* Switch to another threshold table (must outlive the state) */
+void classifier_set_thresholds(classifier_state_t *state,
+                               const classifier_thresholds_t *thresholds);
+
 /* Classify mental command based on extracted features */
 command_t classify_command(const features_t *features, classifier_state_t *state);
 
+/* Fixed-point classify_command: same rules on Q15 features, integer only */
+command_t classify_command_q15(const features_q15_t *features, classifier_state_t *state);
+
 /* Get string representation of command */
 const char* command_to_string(command_t cmd);
 
 /* Update classifier baseline */
 void update_baseline(classifier_state_t *state, signal_t amplitude);
 
-/* Predict health impairments based on EEG features */
+/* Predict health impairments based on EEG features (default thresholds) */
 void predict_impairments(const features_t *features, predictions_t *predictions);
 
+/* predict_impairments with an explicit threshold table */
+void predict_impairments_with(const classifier_thresholds_t *thresholds,
+                              const features_t *features, predictions_t *predictions);
+
+/* ========== Batch Impairment Scoring ========== */
+
+/* Metrics graded by predict_impairments */
+typedef enum {
+    IMPAIRMENT_VISUAL = 0,       /* Alpha power */
+    IMPAIRMENT_MOTOR,            /* Beta power */
+    IMPAIRMENT_ATTENTION,        /* Theta/beta ratio */
+    NUM_IMPAIRMENT_METRICS
+} impairment_metric_t;
+
+/* Windows per internal block (the theta/beta ratios of one block stay in L1) */
+#define IMPAIRMENT_BLOCK_SIZE 64
+
+/* Band powers of a batch of windows, one array per band */
+typedef struct {
+    size_t count;
+    const signal_t *theta_power;
+    const signal_t *alpha_power;
+    const signal_t *beta_power;
+} band_power_batch_t;
+
+/* Per-window predictions, count entries each (the same grades as
+ * predictions_t, one array per metric) */
+typedef struct {
+    prediction_t *visual;
+    prediction_t *motor;
+    prediction_t *attention;
+} prediction_batch_t;
+
+/* Running totals over one or more batches (e.g. one session) */
+typedef struct {
+    size_t num_windows;
+    size_t counts[NUM_IMPAIRMENT_METRICS][PRED_IMPAIRED + 1];
+} impairment_stats_t;
+
+/* Start empty totals */
+void impairment_stats_init(impairment_stats_t *stats);
+
+/* Share of the windows given a grade for a metric (0 before any window) */
+float impairment_fraction(const impairment_stats_t *stats, impairment_metric_t metric,
+                          prediction_t grade);
+
+/* predict_impairments_with for every window of a batch, branch-free so the
+ * grading loops vectorize; identical grades to the scalar function
+ * predictions: Optional output arrays (NULL to only count)
+ * stats: Optional totals the batch is added to
+ */
+void predict_impairments_batch(const classifier_thresholds_t *thresholds,
+                               const band_power_batch_t *batch,
+                               const prediction_batch_t *predictions,
+                               impairment_stats_t *stats);
+
 /* Get string representation of prediction */
 const char* prediction_to_string(prediction_t pred);
 
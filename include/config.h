@@ -20,12 +20,61 @@
 /* Enable FFT-based band power calculation (more accurate) */
 #define USE_FFT_BANDPOWER    1      /* Set to 0 for faster approximate method */
 
+/* Streaming band powers from a recursive sliding DFT (O(bins) per sample)
+ * instead of one FFT per hop; pays off for hops of a few samples */
+#define USE_SLIDING_DFT      0      /* Set to 1 to enable in streaming mode */
+
+/* Streaming band powers from the time-domain IIR filter bank (no FFT at all) */
+#define USE_IIR_BANDPOWER    0      /* Takes precedence over USE_SLIDING_DFT */
+
+/* Streaming band powers from a Welch average of overlapping Hann-windowed
+ * segments (welch.h): steadier band ratios than one periodogram per window */
+#define USE_WELCH_PSD        0      /* Used when neither option above is set */
+#define WELCH_SEGMENT_SIZE   128    /* samples per segment (power of 2) */
+#define WELCH_OVERLAP        50     /* percent overlap between segments */
+
+/* ========== Streaming Configuration ========== */
+/* Features are emitted every STREAM_HOP_SIZE samples over the last WINDOW_SIZE */
+#define STREAM_HOP_SIZE      32     /* samples (125 ms at 256 Hz, 87.5% overlap) */
+
+/* ========== Acquisition ========== */
+/* Lock-free ring between the ADC interrupt / reader thread and the DSP loop */
+#define SAMPLE_RING_CAPACITY 1024   /* samples, power of 2 (4 s at 256 Hz) */
+#define ACQ_BLOCK_SIZE       32     /* samples delivered per acquisition event */
+#define CACHE_LINE_SIZE      64     /* bytes; separates producer/consumer state */
+
+/* Bare-metal timebase (CLINT on QEMU virt / SiFive cores) */
+#define CLINT_BASE           0x02000000u
+#define MTIME_FREQ_HZ        10000000u  /* mtime ticks per second */
+
+/* ========== Fixed-Point Build ========== */
+/* Run the Q15 pipeline (fixed_point.h) for FPU-less cores; `make FIXED_POINT=1` */
+#ifndef USE_FIXED_POINT
+#define USE_FIXED_POINT      0
+#endif
+#define FIXED_INPUT_FULL_SCALE 512.0f /* microvolts mapped to Q15 full scale */
+
+/* ========== Parallel Processing ========== */
+/* Worker-pool execution with POSIX threads (worker_pool.h); hosted builds only,
+ * e.g. gcc -DUSE_PTHREADS=1 -pthread. Bare-metal builds run jobs serially */
+#ifndef USE_PTHREADS
+#define USE_PTHREADS         0
+#endif
+#define MAX_WORKERS          8      /* Threads per pool */
+
 /* ========== Signal Amplitudes ========== */
 #define ALPHA_AMPLITUDE     50.0f   /* microvolts */
 #define BETA_AMPLITUDE      30.0f   /* microvolts */
 #define BLINK_AMPLITUDE     200.0f  /* microvolts */
 #define NOISE_LEVEL         5.0f    /* microvolts */
 
+/* ========== Simulator ========== */
+/* Seed of the default simulator stream: runs replay exactly unless
+ * eeg_simulator_seed picks another one */
+#ifndef EEG_SIMULATOR_SEED
+#define EEG_SIMULATOR_SEED  0x5EED2024u
+#endif
+
 /* ========== Classification Thresholds ========== */
 #define FOCUS_THRESHOLD     0.6f    /* Beta power ratio */
 #define RELAX_THRESHOLD     0.6f    /* Alpha power ratio */
@@ -49,11 +98,27 @@
 /* ========== Filter Parameters ========== */
 #define MA_FILTER_SIZE      5       /* Moving average window */
 #define BASELINE_SAMPLES    50      /* Samples for baseline calculation */
+#define NOTCH_FREQ          50.0f   /* Hz - mains interference (60.0f for 60 Hz grids) */
+#define NOTCH_Q             30.0f   /* Notch quality factor (bandwidth = f0 / Q) */
+#define BANDPASS_ORDER      6       /* Butterworth order of each band edge (even) */
 
 /* ========== Output Control ========== */
 #define CURSOR_MAX_X        10
 #define CURSOR_MAX_Y        10
 #define BUZZER_DURATION_MS  200
+#define OUTPUT_QUEUE_CAPACITY 16    /* Pending commands (power of 2) */
+/* Least time between output-state boxes (0: every window); printing them
+ * costs more than a window of DSP at high window rates */
+#ifndef OUTPUT_DISPLAY_PERIOD_MS
+#define OUTPUT_DISPLAY_PERIOD_MS 0
+#endif
+
+/* ========== Profiling ========== */
+/* Per-stage cycle histograms and sample-to-command latency (profiler.h);
+ * with 0 the PROF_* hooks compile to nothing. `make PROFILE=1` */
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING     0
+#endif
 
 /* ========== Debug Options ========== */
 #define DEBUG_SIGNALS       0       /* Print signal values */
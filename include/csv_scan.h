@@ -0,0 +1,33 @@
+#ifndef CSV_SCAN_H
+#define CSV_SCAN_H
+
+#include "types.h"
+
+/* Allocation-free scanning primitives for CSV text held in memory (e.g. a
+ * mapped_file_t). Every function takes an explicit end pointer, so the
+ * input need not be NUL-terminated, and none depends on the C locale.
+ */
+
+/* Parse a decimal float ([+-]digits[.digits][(e|E)[+-]digits]) at p
+ * Returns: Pointer past the number, or p itself if there is none
+ *          (*value is then 0)
+ */
+const char* csv_scan_float(const char *p, const char *end, float *value);
+
+/* Skip the rest of the current field
+ * Returns: Pointer to the terminating ',' or '\n' (or end)
+ */
+const char* csv_skip_field(const char *p, const char *end);
+
+/* Pointer to the start of the next line (past '\n', or end) */
+const char* csv_next_line(const char *p, const char *end);
+
+/* Number of '\n' bytes in data, counted a word (8 bytes) at a time */
+size_t csv_count_newlines(const char *data, size_t size);
+
+/* Number of data rows after the header line (a last row without a
+ * trailing newline counts; a file with only a header has 0 rows)
+ */
+size_t csv_count_rows(const char *data, size_t size);
+
+#endif /* CSV_SCAN_H */
@@ -3,11 +3,16 @@
 
 #include "types.h"
 #include "config.h"
+#include "multichannel.h"
+#include "mapped_file.h"
 #include <stdio.h>
 
 /* Maximum path length */
 #define MAX_PATH_LENGTH 512
 
+/* Longest CSV line (32 channels of signed microvolt values) */
+#define MAX_CSV_LINE_LENGTH 2048
+
 /* Data configuration structure */
 typedef struct {
     char data_directory[MAX_PATH_LENGTH];
@@ -24,23 +29,132 @@ typedef struct {
     bool_t has_labels;
 } dataset_info_t;
 
+/* Most fields looked at in one CSV row; later fields are never mapped */
+#define MAX_CSV_FIELDS 64
+
 /* Sample with metadata from CSV */
 typedef struct {
     float time;
     signal_t amplitude;
+    float theta_power;
     float alpha_power;
     float beta_power;
+    float gamma_power;
     command_t command;
 } eeg_sample_t;
 
+/* Dataset columns the loader knows how to route into eeg_sample_t */
+typedef enum {
+    COLUMN_TIME = 0,      /* "time" */
+    COLUMN_AMPLITUDE,     /* "amplitude" */
+    COLUMN_THETA,         /* "theta_power" */
+    COLUMN_ALPHA,         /* "alpha_power" */
+    COLUMN_BETA,          /* "beta_power" */
+    COLUMN_GAMMA,         /* "gamma_power" */
+    COLUMN_COMMAND,       /* "command" */
+    NUM_DATASET_COLUMNS
+} dataset_column_t;
+
+/* Projection masks: which columns a load should parse */
+#define COLUMN_BIT(column) (1u << (column))
+#define COLUMNS_ALL ((1u << NUM_DATASET_COLUMNS) - 1u)
+
+/* Where each known column sits in a CSV row, parsed once from the header */
+typedef struct {
+    int field[NUM_DATASET_COLUMNS];    /* Field index per column, -1 if absent */
+    int num_fields;                    /* Fields in the header */
+} column_map_t;
+
+/* Readahead requested ahead of a chunked reader's cursor (the last chunk's
+ * size is used instead when it is larger) */
+#define DATASET_PREFETCH_BYTES 65536
+
+/* Iterator over the rows of a CSV recording. Rows are parsed straight out
+ * of the mapping into caller buffers, readahead for the next chunk is
+ * issued as each chunk is returned, and pages behind the cursor are
+ * released, so memory stays constant whatever the file length.
+ */
+typedef struct {
+    mapped_file_t file;
+    const char *cursor;                        /* Next unread row */
+    size_t released;                           /* Bytes already dropped behind the cursor */
+    size_t rows_read;                          /* Rows returned so far */
+    signed char field_column[MAX_CSV_FIELDS];  /* Field -> dataset_column_t, -1 if unused */
+    int last_field;                            /* Last projected field */
+    unsigned int required;                     /* Numeric columns a row must carry */
+    int channel_columns[MAX_CHANNELS];         /* Fields of the "chN"/"amplitude" columns */
+    int command_column;
+    size_t num_channels;                       /* Channel columns (0 if none) */
+} dataset_reader_t;
+
 /* Initialize data loader with configuration */
 void data_loader_init(const data_config_t *config);
 
-/* Load dataset from CSV file */
+/* Load dataset from CSV file (all known columns)
+ * The file is memory-mapped and parsed in place (no per-line stdio or
+ * sscanf). With auto_detect_format the header decides which field feeds
+ * which member; otherwise the legacy fixed layout is assumed (see
+ * column_map_legacy). Columns missing from the file are left at 0.
+ */
 bool_t load_dataset_csv(const char *filepath, eeg_sample_t *samples, 
                         size_t max_samples, size_t *num_loaded);
 
-/* Get dataset information without loading full data */
+/* Load only the columns in the columns mask (COLUMN_BIT values)
+ * Fields outside the projection are skipped without being parsed, and
+ * each row stops being scanned after the last projected field. Rows
+ * whose projected numeric fields are not all numbers are skipped.
+ */
+bool_t load_dataset_columns(const char *filepath, eeg_sample_t *samples,
+                            size_t max_samples, unsigned int columns,
+                            size_t *num_loaded);
+
+/* Open a CSV recording for chunked reading
+ * columns: Projection used by dataset_reader_next_chunk (COLUMN_BIT values)
+ */
+bool_t dataset_reader_open(dataset_reader_t *reader, const char *filepath,
+                           unsigned int columns);
+
+/* Read up to max_samples rows as eeg_sample_t (projected columns only)
+ * Returns: Rows read; 0 at the end of the file
+ */
+size_t dataset_reader_next_chunk(dataset_reader_t *reader, eeg_sample_t *chunk,
+                                 size_t max_samples);
+
+/* Read up to frame->length rows of the channel columns into frame, with the
+ * command of each row in labels (frame->length entries, or NULL)
+ * frame: Must have reader->num_channels channels
+ * Returns: Rows read; 0 at the end of the file
+ */
+size_t dataset_reader_next_frame(dataset_reader_t *reader, eeg_frame_t *frame,
+                                 command_t *labels);
+
+/* Unmap the recording */
+void dataset_reader_close(dataset_reader_t *reader);
+
+/* Build a column map from a header line (length bytes, need not be
+ * NUL-terminated); unknown names are ignored
+ * Returns: TRUE if the header names an amplitude column
+ */
+bool_t parse_column_map(const char *header, size_t length, column_map_t *map);
+
+/* Fixed layout used when format detection is off:
+ * time,amplitude,alpha_power,beta_power,command
+ */
+void column_map_legacy(column_map_t *map);
+
+/* Load a multi-channel CSV (time,ch1,...,chN[,command]) into a frame
+ * frame: Initialized with the file's channel count (see get_dataset_info);
+ *        at most frame->length samples are loaded
+ * labels: Per-sample commands (frame->length entries), or NULL
+ * Single-channel files with an "amplitude" column load as one channel
+ */
+bool_t load_multichannel_csv(const char *filepath, eeg_frame_t *frame,
+                             command_t *labels, size_t *num_loaded);
+
+/* Get dataset information without loading full data
+ * num_channels counts "chN" columns (1 for single-channel files);
+ * num_samples comes from one word-at-a-time newline count of the mapping
+ */
 bool_t get_dataset_info(const char *filepath, dataset_info_t *info);
 
 /* Set data directory path */
@@ -0,0 +1,47 @@
+#ifndef DSP_ARENA_H
+#define DSP_ARENA_H
+
+#include "types.h"
+
+/* Bump allocator over a caller-provided buffer
+ * Allocations are never freed individually; reset (or release to a mark)
+ * returns the memory, so the steady state makes no heap calls
+ */
+typedef struct {
+    uint8_t *base;             /* Start of the backing buffer */
+    size_t capacity;           /* Size of the backing buffer in bytes */
+    size_t used;               /* Bytes handed out so far (incl. padding) */
+} dsp_arena_t;
+
+/* Alignment of every arena allocation (enough for float and complex_t) */
+#define DSP_ARENA_ALIGN 8
+
+/* Bytes an allocation of size bytes can take, worst-case padding included */
+#define DSP_ARENA_SIZE(bytes) ((bytes) + DSP_ARENA_ALIGN)
+
+/* Initialize arena over buffer (capacity bytes) */
+void dsp_arena_init(dsp_arena_t *arena, void *buffer, size_t capacity);
+
+/* Allocate size bytes, aligned to DSP_ARENA_ALIGN
+ * Returns: Pointer into the arena, or NULL if it is exhausted
+ */
+void* dsp_arena_alloc(dsp_arena_t *arena, size_t size);
+
+/* Allocate size bytes aligned to align (a power of 2, e.g. a cache line)
+ * Returns: Pointer into the arena, or NULL if it is exhausted
+ */
+void* dsp_arena_alloc_aligned(dsp_arena_t *arena, size_t size, size_t align);
+
+/* Current fill level, to be passed back to dsp_arena_release */
+size_t dsp_arena_mark(const dsp_arena_t *arena);
+
+/* Free everything allocated after mark */
+void dsp_arena_release(dsp_arena_t *arena, size_t mark);
+
+/* Free every allocation */
+void dsp_arena_reset(dsp_arena_t *arena);
+
+/* Bytes still available (before alignment padding) */
+size_t dsp_arena_remaining(const dsp_arena_t *arena);
+
+#endif /* DSP_ARENA_H */
@@ -0,0 +1,50 @@
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include "types.h"
+#include "fft.h"
+
+/* Inner loops shared by the FFT, spectrum, preprocessing and feature code
+ * Built with the RISC-V Vector extension (__riscv_vector, e.g.
+ * `make RISCV_VECTOR=1`) they run the RVV 1.0 kernels in dsp_kernels_rvv.S;
+ * otherwise the portable C loops in dsp_kernels.c
+ */
+
+#if defined(__riscv_vector)
+#define DSP_KERNELS_RVV 1
+#else
+#define DSP_KERNELS_RVV 0
+#endif
+
+/* Name of the compiled-in backend ("rvv" or "scalar") */
+const char* dsp_kernels_backend(void);
+
+/* Sum of x[0..n-1] */
+signal_t dsp_sum(const signal_t *x, size_t n);
+
+/* Largest |x[i]| (0 for n == 0) */
+signal_t dsp_max_abs(const signal_t *x, size_t n);
+
+/* Sums of squared and cubed deviations from mean
+ * sum_sq: Receives sum((x - mean)^2)
+ * sum_cube: Receives sum((x - mean)^3)
+ */
+void dsp_central_moments(const signal_t *x, size_t n, signal_t mean,
+                         signal_t *sum_sq, signal_t *sum_cube);
+
+/* out[i] = scale * |bins[i]|^2 */
+void dsp_magnitude_squared(const complex_t *bins, float *out, size_t n, float scale);
+
+/* One radix-2 stage over n points in groups of 2*half:
+ * t = w[j*stride] * data[k+j+half]; data[k+j] += t; data[k+j+half] = data[k+j] - t
+ */
+void dsp_fft_stage(complex_t *data, size_t n, size_t half,
+                   const complex_t *twiddles, size_t stride);
+
+/* Moving average with a warm-up window at the start (window in [1, length])
+ * Safe for in-place use (input == output)
+ */
+void dsp_moving_average(const signal_t *input, signal_t *output, size_t length,
+                        size_t window);
+
+#endif /* DSP_KERNELS_H */
@@ -4,9 +4,83 @@
 #include "types.h"
 #include "config.h"
 
-/* Initialize the EEG signal simulator */
+/* Synthetic EEG for demos, tests and load generation
+ *
+ * Every stream owns a PCG32 generator, so a (seed, stream id) pair
+ * replays the same samples on every run and platform, and thousands of
+ * streams seeded with one seed and distinct ids never share a sequence.
+ * Background noise is Gaussian; alpha and beta rhythms come from
+ * recursive oscillators (one complex rotation per sample, no sinf).
+ */
+
+/* ========== Random Numbers ========== */
+
+/* PCG32 (XSH-RR) generator with a selectable stream */
+typedef struct {
+    uint64_t state;
+    uint64_t increment;          /* Odd; selects the stream */
+    float spare;                 /* Second deviate of the last Gaussian pair */
+    bool_t has_spare;
+} eeg_rng_t;
+
+/* Seed a generator; different stream ids give independent sequences */
+void eeg_rng_seed(eeg_rng_t *rng, uint64_t seed, uint64_t stream_id);
+
+/* Next 32 uniformly distributed bits */
+uint32_t eeg_rng_next(eeg_rng_t *rng);
+
+/* Uniform in [0, 1) with 24 bits of resolution */
+float eeg_rng_uniform(eeg_rng_t *rng);
+
+/* Standard normal deviate (Marsaglia polar method) */
+float eeg_rng_gaussian(eeg_rng_t *rng);
+
+/* Fill buffer with N(0, sigma^2) deviates */
+void eeg_rng_gaussian_fill(eeg_rng_t *rng, signal_t *buffer, size_t length, float sigma);
+
+/* ========== Oscillators ========== */
+
+/* amplitude * sin(2 pi f n / fs) by rotating a unit phasor */
+typedef struct {
+    float re;                    /* cos of the current phase */
+    float im;                    /* sin of the current phase */
+    float step_re;
+    float step_im;
+    float amplitude;
+} eeg_oscillator_t;
+
+/* Start an oscillator at phase zero */
+void eeg_oscillator_init(eeg_oscillator_t *osc, float frequency, float sample_rate,
+                         float amplitude);
+
+/* Add the next length samples of the oscillator to buffer (the phase
+ * carries over between calls) */
+void eeg_oscillator_add(eeg_oscillator_t *osc, signal_t *buffer, size_t length);
+
+/* ========== Streams ========== */
+
+/* One synthetic headset */
+typedef struct {
+    eeg_rng_t rng;
+} eeg_stream_t;
+
+/* Seed a stream; the same seed and stream id reproduce the same windows */
+void eeg_stream_init(eeg_stream_t *stream, uint64_t seed, uint64_t stream_id);
+
+/* Generate one window for a mental state, starting at t = 0 like
+ * generate_eeg_sample but drawing noise from this stream */
+void eeg_stream_generate(eeg_stream_t *stream, signal_t *buffer, size_t length,
+                         command_t state);
+
+/* ========== Default Stream ========== */
+
+/* Initialize the EEG signal simulator (seeds the default stream with
+ * EEG_SIMULATOR_SEED the first time) */
 void eeg_simulator_init(void);
 
+/* Restart the default stream from a seed */
+void eeg_simulator_seed(uint64_t seed);
+
 /* Generate alpha wave (8-13 Hz) - associated with relaxation */
 signal_t generate_alpha_wave(float time_sec, float frequency);
 
@@ -16,14 +90,15 @@ signal_t generate_beta_wave(float time_sec, float frequency);
 /* Generate blink artifact - sharp spike in signal */
 signal_t generate_blink_artifact(float time_sec, float blink_time);
 
-/* Add Gaussian noise to signal */
+/* Add Gaussian noise to signal (same RMS as a uniform draw in
+ * [-noise_level, noise_level]) */
 signal_t add_noise(signal_t signal, float noise_level);
 
 /* Generate a complete EEG signal sample for a given mental state */
 void generate_eeg_sample(signal_t *buffer, size_t length, command_t state);
 
 /* Generate mixed signal with multiple components */
-signal_t generate_mixed_signal(float time_sec, float alpha_ratio, float beta_ratio, 
+signal_t generate_mixed_signal(float time_sec, float alpha_ratio, float beta_ratio,
                                 bool_t include_blink, float blink_time);
 
 #endif /* EEG_SIMULATOR_H */
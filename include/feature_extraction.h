@@ -3,6 +3,10 @@
 
 #include "types.h"
 #include "config.h"
+#include "fft.h"
+
+/* Standard EEG band table (theta, alpha, beta, gamma), indexed by band_index_t */
+extern const frequency_band_t eeg_bands[NUM_BANDS];
 
 /* Initialize feature extraction module */
 void feature_extraction_init(void);
@@ -11,6 +15,18 @@ void feature_extraction_init(void);
 signal_t calculate_band_power(const signal_t *signal, size_t length, 
                               float low_freq, float high_freq);
 
+/* Calculate power in every band of a band table with a single spectrum */
+void calculate_band_powers(const signal_t *signal, size_t length,
+                           const frequency_band_t *bands, size_t num_bands,
+                           signal_t *band_powers);
+
+/* calculate_band_powers with caller-provided FFT scratch memory
+ * ws: Workspace sized for length, or NULL for the default (static) workspace
+ */
+void calculate_band_powers_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                              const frequency_band_t *bands, size_t num_bands,
+                              signal_t *band_powers);
+
 /* Calculate signal variance */
 signal_t calculate_variance(const signal_t *signal, size_t length);
 
@@ -26,6 +42,23 @@ signal_t calculate_skewness(const signal_t *signal, size_t length);
 /* Extract all features from preprocessed signal */
 void extract_features(const signal_t *signal, size_t length, features_t *features);
 
+/* Extract only the normalized band power ratios
+ * (pair with preprocess_and_measure, which fills the time-domain features)
+ */
+void extract_band_features(const signal_t *signal, size_t length, features_t *features);
+
+/* Workspace variants of extract_features / extract_band_features (ws may be NULL) */
+void extract_features_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                         features_t *features);
+void extract_band_features_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                              features_t *features);
+
+/* Extract peak amplitude, variance and skewness */
+void extract_time_features(const signal_t *signal, size_t length, features_t *features);
+
+/* Convert absolute band powers in features to relative ratios (sum to 1) */
+void normalize_band_powers(features_t *features);
+
 /* Assembly-optimized power calculation (implemented in feature_extraction_asm.S) */
 extern signal_t calculate_power_asm(const signal_t *signal, size_t length);
 
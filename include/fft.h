@@ -3,6 +3,7 @@
 
 #include "types.h"
 #include "config.h"
+#include "dsp_arena.h"
 #include <math.h>
 
 /* Complex number type for FFT */
@@ -18,14 +19,49 @@ typedef struct {
     bool_t use_window;         /* Apply Hanning window */
 } fft_config_t;
 
+/* Precomputed FFT plan: twiddle table and bit-reversal permutation */
+typedef struct {
+    size_t n;                  /* FFT size (power of 2) */
+    size_t log2n;              /* Number of radix-2 stages */
+    complex_t *twiddles;       /* exp(-2*pi*i*k/n) for k = 0..n/2-1 */
+    uint16_t *bitrev;          /* Bit-reversed index for k = 0..n-1 */
+    bool_t owns_tables;        /* Tables were allocated by fft_plan_create */
+} fft_plan_t;
+
+/* Largest FFT size a plan can describe (bitrev entries are 16-bit) */
+#define FFT_MAX_SIZE 65536
+
 /* Power spectrum result */
 typedef struct {
     float *power;              /* Power at each frequency bin */
-    float *frequencies;        /* Frequency values for each bin */
     size_t num_bins;           /* Number of frequency bins */
-    float frequency_resolution;/* Frequency resolution (Hz per bin) */
+    float frequency_resolution;/* Frequency resolution (Hz per bin); bin i is at i * resolution */
 } power_spectrum_t;
 
+/* Scratch memory for band-power extraction at one FFT size
+ * Filled once by fft_workspace_init; band-power calls on it make no heap calls
+ */
+typedef struct {
+    size_t fft_size;           /* FFT size the buffers are sized for */
+    fft_plan_t plan;           /* Default plan, or tables carved from the arena */
+    signal_t *windowed;        /* Zero-padded, windowed signal (fft_size) */
+    signal_t *window;          /* Hann table for window_length samples (fft_size) */
+    size_t window_length;      /* Length the table holds (0 until first use) */
+    complex_t *bins;           /* Real FFT output (fft_size/2+1) */
+    power_spectrum_t spectrum; /* power points into the arena */
+} fft_workspace_t;
+
+/* Arena bytes fft_workspace_init needs for an FFT of size n
+ * (upper bound: a WINDOW_SIZE workspace shares the static plan tables)
+ */
+#define FFT_WORKSPACE_BYTES(n) \
+    (DSP_ARENA_SIZE((n) * sizeof(signal_t)) + \
+     DSP_ARENA_SIZE((n) * sizeof(signal_t)) + \
+     DSP_ARENA_SIZE(((n) / 2 + 1) * sizeof(complex_t)) + \
+     DSP_ARENA_SIZE(((n) / 2 + 1) * sizeof(float)) + \
+     DSP_ARENA_SIZE((n) / 2 * sizeof(complex_t)) + \
+     DSP_ARENA_SIZE((n) * sizeof(uint16_t)))
+
 /* ========== Complex Number Operations ========== */
 
 /* Create complex number */
@@ -48,9 +84,21 @@ float complex_magnitude_squared(complex_t c);
 
 /* ========== FFT Functions ========== */
 
-/* Initialize FFT module */
+/* Initialize FFT module (builds the WINDOW_SIZE plan in static storage) */
 void fft_init(void);
 
+/* Create an FFT plan for size n (must be power of 2)
+ * All cosf/sinf calls happen here, never in fft_compute_plan
+ * Returns: TRUE on success
+ */
+bool_t fft_plan_create(fft_plan_t *plan, size_t n);
+
+/* Free tables allocated by fft_plan_create */
+void fft_plan_destroy(fft_plan_t *plan);
+
+/* Get a plan for size n: the WINDOW_SIZE plan, or a cached plan for other sizes */
+const fft_plan_t* fft_get_plan(size_t n);
+
 /* Check if number is power of 2 */
 bool_t is_power_of_2(size_t n);
 
@@ -60,9 +108,37 @@ size_t next_power_of_2(size_t n);
 /* Bit reversal for FFT */
 size_t bit_reverse(size_t n, size_t bits);
 
-/* Apply Hanning window to signal */
+/* Fill table with the length-point symmetric Hann window
+ * Returns: Window power sum(w[i]^2), the PSD normalization
+ */
+float hann_window_fill(signal_t *table, size_t length);
+
+/* Hann table for length samples: static for WINDOW_SIZE, cached for the
+ * most recent other length (not reentrant); NULL if allocation fails
+ */
+const signal_t* hann_window_table(size_t length);
+
+/* Apply Hanning window to signal (multiplies by the cached table) */
 void apply_hanning_window(signal_t *signal, size_t length);
 
+/* Cooley-Tukey FFT using a precomputed plan
+ * plan: Plan from fft_plan_create (size plan->n)
+ * input: Real signal array (plan->n samples)
+ * output: Complex FFT result (plan->n bins)
+ */
+void fft_compute_plan(const fft_plan_t *plan, const signal_t *input, complex_t *output);
+
+/* Real-input FFT: packs the signal into an n/2-point complex transform
+ * and splits the result into the n/2+1 non-negative frequency bins
+ * plan: Plan of size n (n >= 2)
+ * input: Real signal array (n samples)
+ * output: n/2+1 complex bins (DC to Nyquist), also used as scratch
+ */
+void fft_compute_real(const fft_plan_t *plan, const signal_t *input, complex_t *output);
+
+/* Inverse FFT using a precomputed plan */
+void fft_inverse_plan(const fft_plan_t *plan, const complex_t *input, complex_t *output);
+
 /* Cooley-Tukey FFT algorithm (radix-2, decimation-in-time)
  * input: Real signal array
  * output: Complex FFT result
@@ -103,6 +179,49 @@ float calculate_band_power_psd(const power_spectrum_t *spectrum,
 float calculate_band_power_fft(const signal_t *signal, size_t length,
                                float sampling_rate, float low_freq, float high_freq);
 
+/* Calculate power in several frequency bands from a single FFT
+ * WINDOW_SIZE-length signals use the default workspace; other sizes use the heap
+ * signal: Input signal
+ * length: Signal length
+ * sampling_rate: Sampling rate in Hz
+ * bands: Table of frequency bands
+ * num_bands: Number of bands in the table
+ * band_powers: Output array (num_bands entries), same order as bands
+ * Returns: TRUE on success
+ */
+bool_t calculate_band_powers_fft(const signal_t *signal, size_t length,
+                                 float sampling_rate, const frequency_band_t *bands,
+                                 size_t num_bands, float *band_powers);
+
+/* Initialize a workspace for signals of max_length samples
+ * arena: Backing memory (FFT_WORKSPACE_BYTES(next_power_of_2(max_length)) bytes)
+ * Returns: TRUE on success
+ */
+bool_t fft_workspace_init(fft_workspace_t *ws, dsp_arena_t *arena, size_t max_length);
+
+/* fft_workspace_init that always builds its own plan tables in the arena,
+ * even for WINDOW_SIZE, so the workspace shares no memory with other threads
+ */
+bool_t fft_workspace_init_private(fft_workspace_t *ws, dsp_arena_t *arena, size_t max_length);
+
+/* Workspace for WINDOW_SIZE signals in static storage
+ * Shared by every caller that passes no workspace; not reentrant
+ */
+fft_workspace_t* fft_default_workspace(void);
+
+/* calculate_power_spectrum into ws->spectrum (n must equal ws->fft_size) */
+void calculate_power_spectrum_ws(fft_workspace_t *ws, const complex_t *fft_result,
+                                 size_t n, float sampling_rate);
+
+/* calculate_band_powers_fft using workspace buffers, no heap calls
+ * next_power_of_2(length) must equal ws->fft_size
+ * Returns: TRUE on success
+ */
+bool_t calculate_band_powers_fft_ws(fft_workspace_t *ws, const signal_t *signal,
+                                    size_t length, float sampling_rate,
+                                    const frequency_band_t *bands, size_t num_bands,
+                                    float *band_powers);
+
 /* Free power spectrum memory */
 void free_power_spectrum(power_spectrum_t *spectrum);
 
@@ -114,6 +233,13 @@ float get_frequency_resolution(size_t fft_size, float sampling_rate);
 /* Get frequency bin index for given frequency */
 size_t get_frequency_bin(float frequency, float sampling_rate, size_t fft_size);
 
+/* Get the bins whose frequency lies in [low_freq, high_freq]
+ * first_bin: Receives the lowest bin in the band
+ * Returns: Number of bins in the band (0 if none, capped at Nyquist)
+ */
+size_t get_frequency_bin_range(float low_freq, float high_freq, float sampling_rate,
+                               size_t fft_size, size_t *first_bin);
+
 /* Cleanup FFT module */
 void fft_cleanup(void);
 
@@ -0,0 +1,103 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include "types.h"
+#include "config.h"
+
+/* Fixed-point pipeline for FPU-less cores (rv32imc), selected with
+ * USE_FIXED_POINT: Q15 samples, Q31 (and 64-bit) accumulators, a radix-2
+ * FFT with block floating-point scaling and integer band-power ratios.
+ * Acquisition delivers Q15 samples (the ADC source scales counts with an
+ * integer multiply and shift), so preprocessing, features and classification
+ * run without float arithmetic; fixed_point_init() builds the twiddle,
+ * window and band tables once. Only the float views (features_from_q15,
+ * fixed_to_signal for telemetry and display) and the simulator and file
+ * sources, whose data is float microvolts, convert per sample.
+ */
+
+/* Q15 sample: value / 32768 in [-1, 1) */
+typedef int16_t q15_t;
+
+/* Q31 accumulator / wide value */
+typedef int32_t q31_t;
+
+/* Complex Q15 value for the fixed-point FFT */
+typedef struct {
+    q15_t real;
+    q15_t imag;
+} complex_q15_t;
+
+#define Q15_ONE                 32767
+#define Q15_HALF                16384
+
+/* Compile-time conversion of a float constant to Q15 (folded by the compiler) */
+#define Q15_FROM_FLOAT(x)       ((q15_t)((x) >= 1.0f ? Q15_ONE : (x) * 32768.0f))
+
+/* Preprocessed signals have one standard deviation == FIXED_SIGMA (Q15 / 8),
+ * so samples up to +-8 sigma are representable */
+#define FIXED_SIGMA_SHIFT       12
+#define FIXED_SIGMA             (1 << FIXED_SIGMA_SHIFT)
+
+/* Largest fixed-point FFT size (twiddle table size) */
+#define FIXED_FFT_MAX_SIZE      WINDOW_SIZE
+
+/* Documented agreement with the float pipeline on simulated EEG windows:
+ * band ratios within FIXED_RATIO_TOLERANCE (absolute), peak amplitude within
+ * FIXED_PEAK_TOLERANCE (sigma units); classify_command_q15 makes the same
+ * decisions as classify_command except on windows within those margins of a
+ * threshold */
+#define FIXED_RATIO_TOLERANCE   0.005f
+#define FIXED_PEAK_TOLERANCE    0.02f
+
+/* Fixed-point features (counterpart of features_t) */
+typedef struct {
+    q15_t theta_power;       /* Relative band powers, Q15 (sum to ~1.0) */
+    q15_t alpha_power;
+    q15_t beta_power;
+    q15_t gamma_power;
+    q15_t peak_amplitude;    /* Peak |x| in FIXED_SIGMA units */
+    q31_t variance;          /* Variance in FIXED_SIGMA^2 units */
+    q15_t skewness;          /* Skewness in FIXED_SIGMA units */
+} features_q15_t;
+
+/* ========== Setup and Conversion ========== */
+
+/* Build twiddle, Hann window and band tables (call once before use) */
+void fixed_point_init(void);
+
+/* Convert float samples to Q15 with saturation
+ * full_scale: Input value mapped to Q15 full scale (e.g. FIXED_INPUT_FULL_SCALE uV)
+ */
+void fixed_from_signal(const signal_t *input, q15_t *output, size_t length, float full_scale);
+
+/* Q15 samples back to floats (inverse of fixed_from_signal; display only) */
+void fixed_to_signal(const q15_t *input, signal_t *output, size_t length, float full_scale);
+
+/* Float view of fixed-point features (display and comparison only) */
+void features_from_q15(const features_q15_t *fixed, features_t *features);
+
+/* ========== Pipeline ========== */
+
+/* Fixed-point preprocess_signal: baseline removal, moving average and
+ * normalization to FIXED_SIGMA per standard deviation, in place
+ */
+void preprocess_signal_q15(q15_t *signal, size_t length);
+
+/* Fixed-point fft_compute with block floating-point scaling
+ * input: Real Q15 signal (n samples)
+ * output: n complex bins; true DFT = output * 2^block_exponent
+ * n: Power of 2, 2 <= n <= FIXED_FFT_MAX_SIZE
+ * Returns: TRUE on success
+ */
+bool_t fft_compute_q15(const q15_t *input, complex_q15_t *output, size_t n,
+                       int *block_exponent);
+
+/* Fixed-point extract_features on a preprocessed window
+ * length must be WINDOW_SIZE (the Hann and band tables are built for it)
+ */
+void extract_features_q15(const q15_t *signal, size_t length, features_q15_t *features);
+
+/* Integer square root: floor(sqrt(value)) */
+uint32_t fixed_isqrt(uint64_t value);
+
+#endif /* FIXED_POINT_H */
@@ -12,7 +12,7 @@ typedef struct {
     bool_t is_trained;       /* Training status */
 } lda_model_t;
 
-/* Training sample */
+/* Binary training sample (see lda_scatter_t for contiguous feature matrices) */
 typedef struct {
     signal_t *features;      /* Feature vector */
     int label;               /* Class label (0 or 1) */
@@ -23,7 +23,11 @@ typedef struct {
 /* Initialize LDA model */
 void lda_init(lda_model_t *model, size_t num_features);
 
-/* Train LDA using Fisher's Linear Discriminant */
+/* Train LDA using Fisher's Linear Discriminant: w = S_w^-1 (mean1 - mean0)
+ * with the within-class covariance shrunk by LDA_DEFAULT_SHRINKAGE
+ * Samples with labels other than 0 and 1 are ignored; both classes and at
+ * most LDA_MAX_FEATURES features are required
+ */
 bool_t lda_train(lda_model_t *model, lda_sample_t *samples, size_t num_samples);
 
 /* Predict class for a feature vector */
@@ -40,4 +44,142 @@ void lda_free(lda_model_t *model);
 /* Calculate accuracy on test set */
 float lda_accuracy(const lda_model_t *model, lda_sample_t *samples, size_t num_samples);
 
+/* ========== Multi-Class LDA ========== */
+
+#define LDA_MAX_FEATURES      16
+#define LDA_MAX_CLASSES       4      /* One per command_t */
+#define LDA_NUM_BCI_FEATURES  7      /* Length of lda_feature_vector output */
+
+/* Blend between the within-class correlation matrix (0) and its diagonal (1);
+ * keeps the solve well conditioned with few windows per class */
+#define LDA_DEFAULT_SHRINKAGE 0.1f
+
+/* Class means and pooled within-class scatter, accumulated in one pass
+ * with Welford updates; labels are class indices 0..num_classes-1
+ */
+typedef struct {
+    size_t num_features;
+    size_t num_classes;
+    size_t count[LDA_MAX_CLASSES];
+    float mean[LDA_MAX_CLASSES][LDA_MAX_FEATURES];
+    float scatter[LDA_MAX_FEATURES][LDA_MAX_FEATURES];  /* Upper triangle used */
+} lda_scatter_t;
+
+/* Shared-covariance LDA: class c scores weights[c] . x + bias[c]
+ * (the log posterior up to a constant), prediction is the best score
+ */
+typedef struct {
+    size_t num_features;
+    size_t num_classes;
+    float weights[LDA_MAX_CLASSES][LDA_MAX_FEATURES];   /* Sigma^-1 mean_c */
+    float bias[LDA_MAX_CLASSES];                        /* Includes log prior */
+    bool_t is_trained;
+} lda_multiclass_t;
+
+/* Start an empty accumulator
+ * Returns: FALSE if the sizes exceed LDA_MAX_FEATURES / LDA_MAX_CLASSES
+ */
+bool_t lda_scatter_init(lda_scatter_t *scatter, size_t num_features, size_t num_classes);
+
+/* Add one feature vector (num_features values) of class label
+ * Returns: FALSE for a label out of range
+ */
+bool_t lda_scatter_add(lda_scatter_t *scatter, const signal_t *features, int label);
+
+/* Add num_rows rows of a row-major matrix (num_features values per row)
+ * in a single sequential pass
+ * Returns: Rows added (rows with bad labels are skipped)
+ */
+size_t lda_scatter_add_rows(lda_scatter_t *scatter, const signal_t *rows,
+                            const int *labels, size_t num_rows);
+
+/* Fit discriminants from an accumulator
+ * shrinkage: 0..1 (LDA_DEFAULT_SHRINKAGE is a good start)
+ * Returns: FALSE if no class has samples or the covariance is singular
+ */
+bool_t lda_multiclass_fit(lda_multiclass_t *model, const lda_scatter_t *scatter,
+                          float shrinkage);
+
+/* Accumulate and fit in one call over a contiguous feature matrix */
+bool_t lda_train_multiclass(lda_multiclass_t *model, const signal_t *rows,
+                            const int *labels, size_t num_rows,
+                            size_t num_features, size_t num_classes, float shrinkage);
+
+/* Classify one feature vector
+ * scores: Optional output, num_classes entries
+ * Returns: Best-scoring class (-1 if the model is untrained)
+ */
+int lda_multiclass_predict(const lda_multiclass_t *model, const signal_t *features,
+                           float *scores);
+
+/* Classify num_rows rows of a row-major matrix in one pass
+ * predictions: num_rows entries
+ * scores: Optional output, num_rows x num_classes row-major
+ */
+void lda_predict_batch(const lda_multiclass_t *model, const signal_t *rows, size_t num_rows,
+                       int *predictions, float *scores);
+
+/* ========== Online Adaptation ========== */
+
+/* Updates between exact refactorizations of the inverse (bounds the float
+ * drift of repeated Sherman-Morrison updates); the first ones also run
+ * after 1, 2, 4, ... updates while a cold-started scaling settles */
+#define LDA_ONLINE_REFRESH 256
+
+/* Running class means and pooled covariance with exponential forgetting
+ * (Welford updates, weights decaying by the forgetting factor per window),
+ * plus the inverse scatter kept current by Sherman-Morrison rank-one
+ * updates. Each labeled window costs O(features^2) per class and no
+ * memory beyond this struct.
+ *
+ * The scatter and its inverse are kept in scaled units (feature * scale,
+ * rescaled to a unit diagonal at every refresh) so float rank-one updates
+ * stay accurate when features differ in magnitude by orders of ten.
+ */
+typedef struct {
+    size_t num_features;
+    size_t num_classes;
+    float forgetting;                                   /* 1 = remember everything */
+    float class_weight[LDA_MAX_CLASSES];                /* Decayed sample counts */
+    float mean[LDA_MAX_CLASSES][LDA_MAX_FEATURES];
+    float dof;                                          /* Decayed degrees of freedom */
+    float scale[LDA_MAX_FEATURES];                      /* Feature scaling */
+    float scatter[LDA_MAX_FEATURES][LDA_MAX_FEATURES];  /* Pooled, symmetric, scaled */
+    float inverse[LDA_MAX_FEATURES][LDA_MAX_FEATURES];  /* scatter^-1, scaled */
+    size_t num_updates;
+    size_t since_refresh;
+    lda_multiclass_t model;                             /* Refit after every update */
+} lda_online_t;
+
+/* Cold start with no data
+ * forgetting: (0, 1]; e.g. 0.99 halves a window's weight after ~70 windows
+ * ridge: Prior scatter per feature (feature units squared), keeps the
+ *        inverse defined before the data spans every direction
+ * Returns: FALSE for bad sizes or parameters
+ */
+bool_t lda_online_init(lda_online_t *online, size_t num_features, size_t num_classes,
+                       float forgetting, float ridge);
+
+/* Start from a calibration accumulator (shrunk like lda_multiclass_fit)
+ * Returns: FALSE for bad parameters or a singular covariance
+ */
+bool_t lda_online_init_from(lda_online_t *online, const lda_scatter_t *scatter,
+                            float shrinkage, float forgetting);
+
+/* Fold one labeled window into the statistics and refit online->model
+ * Returns: FALSE for a label out of range
+ */
+bool_t lda_online_update(lda_online_t *online, const signal_t *features, int label);
+
+/* Binary projection (class 1 vs class 0) of the current statistics, in the
+ * lda_train layout: normalized direction and midpoint threshold
+ * model: Initialized by lda_init with online->num_features features
+ */
+bool_t lda_online_export(const lda_online_t *online, lda_model_t *model);
+
+/* Pack features into the LDA input layout: theta, alpha, beta, gamma,
+ * peak amplitude, variance, skewness
+ */
+void lda_feature_vector(const features_t *features, signal_t *vector);
+
 #endif /* LDA_H */
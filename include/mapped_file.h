@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "types.h"
+
+/* Read-only view of a whole file: mmap on POSIX, a file mapping on
+ * Windows, and a heap copy on targets without either. Pages are mapped
+ * for sequential access, so large recordings stream through the page
+ * cache instead of being copied through stdio buffers.
+ */
+typedef struct {
+    const char *data;        /* File contents (NULL for an empty file) */
+    size_t size;             /* Bytes at data */
+    void *handle;            /* Platform state (mapping handle or heap copy) */
+} mapped_file_t;
+
+/* Map filepath for reading
+ * Returns: TRUE on success
+ */
+bool_t mapped_file_open(mapped_file_t *file, const char *filepath);
+
+/* Start reading [offset, offset + length) in the background (readahead),
+ * so the pages are resident by the time a parser reaches them */
+void mapped_file_prefetch(const mapped_file_t *file, size_t offset, size_t length);
+
+/* Drop the pages wholly inside [offset, offset + length) from the working
+ * set; they are re-read from the file if touched again. No-op for heap copies */
+void mapped_file_release(const mapped_file_t *file, size_t offset, size_t length);
+
+/* Unmap (or free) the view; safe on a zeroed or failed mapping */
+void mapped_file_close(mapped_file_t *file);
+
+#endif /* MAPPED_FILE_H */
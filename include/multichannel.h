@@ -0,0 +1,86 @@
+#ifndef MULTICHANNEL_H
+#define MULTICHANNEL_H
+
+#include "types.h"
+#include "config.h"
+#include "dsp_arena.h"
+#include "fft.h"
+
+/* Multi-channel EEG frames stored structure-of-arrays: one contiguous row
+ * of samples per electrode. Rows start on MULTICHANNEL_ALIGN boundaries so
+ * each channel streams through the cache (and vector loads) on its own.
+ */
+
+/* Largest supported electrode count (8-32 channel headsets) */
+#define MAX_CHANNELS            32
+
+/* Row alignment in bytes (one cache line) */
+#define MULTICHANNEL_ALIGN      CACHE_LINE_SIZE
+
+/* Floats per row: length rounded up to a whole number of cache lines */
+#define MULTICHANNEL_STRIDE(length) \
+    (((length) + MULTICHANNEL_ALIGN / sizeof(signal_t) - 1) & \
+     ~(MULTICHANNEL_ALIGN / sizeof(signal_t) - 1))
+
+/* Arena bytes needed by eeg_frame_init_arena (including alignment slack) */
+#define EEG_FRAME_BYTES(channels, length) \
+    ((channels) * MULTICHANNEL_STRIDE(length) * sizeof(signal_t) + MULTICHANNEL_ALIGN)
+
+/* One window of samples for every channel */
+typedef struct {
+    size_t num_channels;
+    size_t length;        /* Samples per channel */
+    size_t stride;        /* Floats between consecutive channel rows */
+    signal_t *data;       /* Channel c starts at data + c * stride */
+    void *allocation;     /* Heap block owned by the frame (NULL if arena-backed) */
+} eeg_frame_t;
+
+/* ========== Frame Management ========== */
+
+/* Allocate a zeroed frame on the heap (release with eeg_frame_destroy)
+ * Returns: TRUE on success
+ */
+bool_t eeg_frame_init(eeg_frame_t *frame, size_t num_channels, size_t length);
+
+/* Carve a zeroed frame from an arena (no heap, nothing to destroy)
+ * Returns: TRUE on success
+ */
+bool_t eeg_frame_init_arena(eeg_frame_t *frame, dsp_arena_t *arena,
+                            size_t num_channels, size_t length);
+
+/* Free a heap-backed frame; safe on arena-backed and zeroed frames */
+void eeg_frame_destroy(eeg_frame_t *frame);
+
+/* Row of samples for one channel (NULL if channel is out of range) */
+signal_t* eeg_frame_channel(const eeg_frame_t *frame, size_t channel);
+
+/* Scatter interleaved samples (sample-major, as read from an ADC or CSV)
+ * into the frame's channel rows
+ * num_samples: Samples per channel to copy (clamped to frame->length)
+ */
+void eeg_frame_deinterleave(eeg_frame_t *frame, const signal_t *interleaved,
+                            size_t num_samples);
+
+/* ========== Batched Processing ========== */
+
+/* preprocess_signal on every channel, in place */
+void preprocess_frame(eeg_frame_t *frame);
+
+/* extract_features on every (preprocessed) channel
+ * features: num_channels entries
+ * ws: FFT workspace shared by all channels (NULL for the default one)
+ */
+void extract_frame_features(fft_workspace_t *ws, const eeg_frame_t *frame,
+                            features_t *features);
+
+/* Preprocess and extract features channel by channel, so each row is
+ * fetched once and stays in cache for both stages
+ * features: num_channels entries
+ */
+void process_frame(fft_workspace_t *ws, eeg_frame_t *frame, features_t *features);
+
+/* Average the features of all channels (e.g. for the single-channel classifier) */
+void average_frame_features(const features_t *features, size_t num_channels,
+                            features_t *average);
+
+#endif /* MULTICHANNEL_H */
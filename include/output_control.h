@@ -3,6 +3,13 @@
 
 #include "types.h"
 #include "config.h"
+#include "scheduler.h"
+#include "sample_ring.h"
+#include <stdatomic.h>
+
+#if USE_PTHREADS
+#include <pthread.h>
+#endif
 
 /* Initialize output control system */
 void output_control_init(output_state_t *state);
@@ -13,6 +20,15 @@ void execute_command(command_t cmd, output_state_t *state);
 /* Display current output state */
 void display_output_state(const output_state_t *state);
 
+/* Pretty-printing policy for display_output_throttled: off entirely, or
+ * at most once per period_ms (default: on, OUTPUT_DISPLAY_PERIOD_MS) */
+void output_display_configure(bool_t enabled, unsigned int period_ms);
+
+/* display_output_state when the policy allows it
+ * Returns: TRUE if the state was printed
+ */
+bool_t display_output_throttled(const output_state_t *state);
+
 /* Control virtual LED */
 void set_led(output_state_t *state, bool_t on);
 
@@ -31,4 +47,81 @@ void display_led(bool_t state);
 /* Display buzzer activation */
 void display_buzzer(void);
 
+/* ========== Command Queue ========== */
+
+/* Event-driven outputs: the classifier posts commands to a bounded
+ * single-producer / single-consumer queue and returns at once; the
+ * consumer drains it and drives the LED, the buzzer (switched off
+ * BUZZER_DURATION_MS after its last trigger) and the keyboard-grid cursor.
+ *
+ * Commands pending at the same drain are coalesced: only the last
+ * FOCUS/RELAX sets the LED, and a burst of BLINKs steps the cursor once
+ * per blink but sounds one buzz. A full queue drops (and counts) the new
+ * command rather than block the signal path. The queue indices are a
+ * ring_index_t (sample_ring.h), so they follow the sample ring's ordering.
+ *
+ * The consumer runs on its own thread with USE_PTHREADS
+ * (output_controller_start); otherwise call output_service from the idle
+ * part of the loop or a timer tick, which also bounds the buzzer timing.
+ */
+
+/* Called by the consumer after a drain that changed the outputs */
+typedef void (*output_changed_fn)(void *user_data, const output_state_t *state);
+
+typedef struct {
+    ring_index_t queue;          /* commands[] indices and drop count */
+
+    /* Consumer */
+    _Alignas(CACHE_LINE_SIZE) uint32_t applied;   /* Commands taken from the queue */
+    uint32_t coalesced;          /* Of those, merged into another one */
+    uint64_t buzzer_off_us;      /* Buzzer deadline (0: silent) */
+    output_state_t state;
+    output_changed_fn on_change;
+    void *user_data;
+
+    /* Shared */
+    _Alignas(CACHE_LINE_SIZE) sched_event_t posted;
+    command_t commands[OUTPUT_QUEUE_CAPACITY];
+#if USE_PTHREADS
+    pthread_mutex_t state_lock;  /* state against output_controller_state */
+    pthread_t thread;
+    atomic_uint stop;
+    bool_t threaded;
+#endif
+} output_controller_t;
+
+/* Empty queue, outputs in their output_control_init state
+ * on_change: Optional, e.g. to display the new state (may be NULL)
+ */
+void output_controller_init(output_controller_t *controller,
+                            output_changed_fn on_change, void *user_data);
+
+/* Release the controller (stops its thread first if it runs) */
+void output_controller_destroy(output_controller_t *controller);
+
+/* Producer: queue a command without blocking (CMD_NONE is ignored)
+ * Returns: FALSE if the queue was full and the command was dropped
+ */
+bool_t output_post(output_controller_t *controller, command_t command);
+
+/* Consumer: apply pending commands and expire the buzzer as of now_us
+ * Returns: TRUE if the outputs changed
+ */
+bool_t output_service(output_controller_t *controller, uint64_t now_us);
+
+/* Run the consumer on its own thread, woken by posts and by the buzzer
+ * deadline (hosted USE_PTHREADS builds; elsewhere it returns FALSE and
+ * the caller keeps calling output_service)
+ */
+bool_t output_controller_start(output_controller_t *controller);
+
+/* Stop the consumer thread after a final drain */
+void output_controller_stop(output_controller_t *controller);
+
+/* Copy of the current outputs (consistent even while the thread runs) */
+void output_controller_state(output_controller_t *controller, output_state_t *state);
+
+/* Diagnostics */
+uint32_t output_dropped(const output_controller_t *controller);
+
 #endif /* OUTPUT_CONTROL_H */
@@ -4,10 +4,33 @@
 #include "types.h"
 #include "config.h"
 
-/* Initialize preprocessing module */
+/* Second-order IIR section (transposed direct form II) */
+typedef struct {
+    float b0, b1, b2;          /* Feed-forward coefficients */
+    float a1, a2;              /* Feedback coefficients (a0 normalized to 1) */
+    float z1, z2;              /* Filter state, persists across calls */
+} biquad_t;
+
+/* Sections per band-pass: a BANDPASS_ORDER Butterworth high-pass at the
+ * low edge, then a BANDPASS_ORDER Butterworth low-pass at the high edge */
+#define BANDPASS_SECTIONS BANDPASS_ORDER
+
+/* Band-pass filter bank: mains notch followed by one band-pass per band */
+typedef struct {
+    biquad_t notch;                                   /* 50/60 Hz notch */
+    biquad_t bands[NUM_BANDS][BANDPASS_SECTIONS];     /* Band-pass cascades */
+    frequency_band_t band_edges[NUM_BANDS];           /* Band definitions */
+    size_t num_bands;                                 /* Bands in use */
+    float band_power[NUM_BANDS];                      /* Running mean square per band */
+    float power_smoothing;                            /* EMA coefficient for band_power */
+} filter_bank_t;
+
+/* Initialize preprocessing module (precomputes the default filter bank) */
 void preprocessing_init(void);
 
-/* Apply moving average filter to reduce noise */
+/* Apply moving average filter to reduce noise
+ * O(1) per sample via a running sum; input and output may be the same buffer
+ */
 void moving_average_filter(const signal_t *input, signal_t *output, size_t length, size_t window);
 
 /* Normalize signal to zero mean */
@@ -19,14 +42,66 @@ signal_t calculate_baseline(const signal_t *signal, size_t length);
 /* Remove baseline from signal */
 void remove_baseline(signal_t *signal, size_t length, signal_t baseline);
 
-/* Simple band-pass filter (alpha or beta band) */
+/* Butterworth band-pass filter (BANDPASS_ORDER high-pass + low-pass)
+ * Starts from zero state on every call; input and output may be the same buffer
+ */
 void bandpass_filter(const signal_t *input, signal_t *output, size_t length, 
                      float low_freq, float high_freq);
 
+/* ========== IIR Filters ========== */
+
+/* Design 2nd-order low-pass section (cutoff fc, quality q) */
+void biquad_design_lowpass(biquad_t *filter, float sampling_rate, float fc, float q);
+
+/* Design 2nd-order high-pass section (cutoff fc, quality q) */
+void biquad_design_highpass(biquad_t *filter, float sampling_rate, float fc, float q);
+
+/* Design notch section (center f0, quality q) */
+void biquad_design_notch(biquad_t *filter, float sampling_rate, float f0, float q);
+
+/* Clear filter state, keeping coefficients */
+void biquad_reset(biquad_t *filter);
+
+/* Filter one sample */
+signal_t biquad_process_sample(biquad_t *filter, signal_t sample);
+
+/* Filter a block; input and output may be the same buffer */
+void biquad_process(biquad_t *filter, const signal_t *input, signal_t *output, size_t length);
+
+/* Initialize filter bank for a band table (at most NUM_BANDS bands)
+ * Coefficients are computed here; processing makes no transcendental calls
+ */
+void filter_bank_init(filter_bank_t *bank, const frequency_band_t *bands, size_t num_bands,
+                      float sampling_rate);
+
+/* Clear all filter state and running band powers */
+void filter_bank_reset(filter_bank_t *bank);
+
+/* Run one sample through the notch and every band-pass
+ * band_out: Per-band filtered sample (may be NULL)
+ * Returns: Notch-filtered sample
+ */
+signal_t filter_bank_process_sample(filter_bank_t *bank, signal_t sample, signal_t *band_out);
+
+/* Running time-domain power of each band (no FFT needed) */
+void filter_bank_band_powers(const filter_bank_t *bank, float *band_powers);
+
+/* Default filter bank for the config.h bands, built by preprocessing_init */
+const filter_bank_t* preprocessing_default_bank(void);
+
 /* Complete preprocessing pipeline */
 void preprocess_signal(signal_t *signal, size_t length);
 
-/* Assembly-optimized moving average (implemented in preprocessing_asm.S) */
+/* Fused preprocessing kernel: baseline removal, moving average and
+ * normalization in two passes over the signal, in place
+ * features: Receives peak_amplitude, variance and skewness of the
+ *           preprocessed signal (may be NULL); band powers are untouched
+ */
+void preprocess_and_measure(signal_t *signal, size_t length, features_t *features);
+
+/* Assembly-optimized moving average (implemented in preprocessing_asm.S)
+ * Same running-sum algorithm and output as moving_average_filter
+ */
 extern void moving_average_asm(const signal_t *input, signal_t *output, 
                                size_t length, size_t window);
 
@@ -0,0 +1,113 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "types.h"
+#include "config.h"
+#include <stdio.h>
+
+/* Pipeline profiler: per-stage duration histograms, sample-to-command
+ * latency and acquisition overruns.
+ *
+ * Ticks are core cycles on bare-metal RISC-V (rdcycle, with rdinstret
+ * alongside for IPC) and nanoseconds of the monotonic clock on hosted
+ * builds, where the counters are not readable from user mode. Histograms
+ * have power-of-2 bins, so recording is a count-leading-zeros and a few
+ * adds: cheap enough to leave in the real-time loop.
+ *
+ * The PROF_* hooks compile to nothing unless ENABLE_PROFILING is set; the
+ * profiler itself is one static instance fed from the DSP loop (records
+ * from other threads are not synchronized).
+ */
+
+/* Pipeline stages (FFT is nested inside FEATURES) */
+typedef enum {
+    PROF_ACQUIRE = 0,            /* Waiting for / taking the next buffer */
+    PROF_PREPROCESS,
+    PROF_FFT,                    /* Window, real FFT and power spectrum */
+    PROF_FEATURES,               /* Band and time-domain features */
+    PROF_CLASSIFY,
+    PROF_OUTPUT,                 /* Actuators and display */
+    PROF_NUM_STAGES
+} prof_stage_t;
+
+/* Bin k counts durations in [2^(k-1), 2^k) ticks (bin 0: zero ticks) */
+#define PROF_HIST_BINS 33
+
+/* Counter snapshot */
+typedef struct {
+    uint64_t ticks;
+    uint64_t instret;            /* Retired instructions (0 on hosted builds) */
+} prof_mark_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint64_t total_ticks;
+    uint64_t total_instret;
+    uint32_t bins[PROF_HIST_BINS];
+} prof_histogram_t;
+
+typedef struct {
+    prof_histogram_t stages[PROF_NUM_STAGES];
+    prof_histogram_t latency;    /* Buffer completion to command decision */
+    uint32_t dropped;            /* Samples lost to acquisition overruns */
+    uint32_t overruns;
+} profiler_t;
+
+/* Name of a stage in reports */
+const char* prof_stage_name(prof_stage_t stage);
+
+/* Tick unit in reports: "cycles" or "ns" */
+const char* prof_tick_unit(void);
+
+/* Read the counters */
+prof_mark_t prof_read(void);
+
+/* Clear every histogram and counter */
+void profiler_reset(void);
+
+/* The profiler's totals (for tests and custom reports) */
+const profiler_t* profiler_get(void);
+
+/* Add one duration to a histogram */
+void prof_histogram_add(prof_histogram_t *hist, uint64_t ticks, uint64_t instret);
+
+/* Record a stage that started at start and ends now */
+void prof_record_stage(prof_stage_t stage, const prof_mark_t *start);
+
+/* Record the latency from a buffer completed at sample_ticks (prof_read().ticks
+ * when it was published) to now */
+void prof_record_latency(uint64_t sample_ticks);
+
+/* Add acquisition losses since the last call */
+void prof_record_overruns(uint32_t dropped, uint32_t overruns);
+
+/* Write the compact report, one line per record:
+ *   @prof,<version>,<unit>
+ *   @hist,<name>,<count>,<min>,<mean>,<max>,<mean instret>,<first bin>,<bins...>
+ *   @overrun,<dropped>,<overruns>
+ *   @end
+ * Bins are '|'-separated counts from the first to the last non-empty bin.
+ */
+void profiler_dump(FILE *out);
+
+/* ========== Hooks ========== */
+
+#if ENABLE_PROFILING
+#define PROF_START(mark)          prof_mark_t mark = prof_read()
+#define PROF_STOP(stage, mark)    prof_record_stage((stage), &(mark))
+#define PROF_NOW()                (prof_read().ticks)
+#define PROF_LATENCY(ticks)       prof_record_latency(ticks)
+#define PROF_OVERRUNS(d, o)       prof_record_overruns((d), (o))
+#define PROF_DUMP(out)            profiler_dump(out)
+#else
+#define PROF_START(mark)          ((void)0)
+#define PROF_STOP(stage, mark)    ((void)0)
+#define PROF_NOW()                ((uint64_t)0)
+#define PROF_LATENCY(ticks)       ((void)(ticks))
+#define PROF_OVERRUNS(d, o)       ((void)(d), (void)(o))
+#define PROF_DUMP(out)            ((void)0)
+#endif
+
+#endif /* PROFILER_H */
@@ -0,0 +1,113 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include "types.h"
+#include "config.h"
+#include <stdatomic.h>
+
+/* ========== Ring Indices ========== */
+
+/* Free-running single-producer / single-consumer index pair, shared by
+ * every lock-free queue in the tree (this sample ring, the output command
+ * queue). Indices run freely and are masked on access by the owner of the
+ * slots, so capacities must be powers of 2 and all of them are usable.
+ *
+ * Only the producer writes head and the drop counters, only the consumer
+ * writes tail; each side publishes with a release store and reads the other
+ * with an acquire load, so no read-modify-write atomics are needed (plain
+ * lw/sw plus fences on cores without the A extension). head and tail live
+ * on separate cache lines to avoid false sharing.
+ */
+
+typedef struct {
+    /* Producer line */
+    _Alignas(CACHE_LINE_SIZE) atomic_uint head;   /* Next slot to write */
+    atomic_uint dropped;         /* Items rejected because the ring was full */
+    atomic_uint overruns;        /* Writes that dropped at least one item */
+
+    /* Consumer line */
+    _Alignas(CACHE_LINE_SIZE) atomic_uint tail;   /* Next slot to read */
+} ring_index_t;
+
+void ring_index_init(ring_index_t *index);
+
+/* Producer: free slots; *head receives the next slot to write */
+size_t ring_index_space(const ring_index_t *index, uint32_t capacity, uint32_t *head);
+
+/* Producer: publish count slots written from head (release) */
+void ring_index_publish(ring_index_t *index, uint32_t head, size_t count);
+
+/* Producer: count items that did not fit as one overrun */
+void ring_index_drop(ring_index_t *index, size_t count);
+
+/* Consumer: filled slots; *tail receives the oldest one */
+size_t ring_index_available(const ring_index_t *index, uint32_t *tail);
+
+/* Consumer: hand count slots from tail back to the producer (release) */
+void ring_index_consume(ring_index_t *index, uint32_t tail, size_t count);
+
+/* Add to a counter only one context writes (no read-modify-write atomic) */
+void ring_counter_add(atomic_uint *counter, size_t amount);
+
+/* ========== Sample Ring ========== */
+
+/* Lock-free sample ring between acquisition (ADC interrupt, or a reader
+ * thread on hosted builds) and the DSP loop. The producer never blocks:
+ * samples that do not fit are dropped and counted.
+ */
+
+typedef struct {
+    ring_index_t index;
+
+    /* Read-only after init */
+    _Alignas(CACHE_LINE_SIZE) signal_t *buffer;
+    uint32_t mask;               /* capacity - 1 */
+} sample_ring_t;
+
+/* Initialize over caller storage
+ * capacity: Power of 2, > 1 (e.g. SAMPLE_RING_CAPACITY)
+ * Returns: TRUE on success
+ */
+bool_t sample_ring_init(sample_ring_t *ring, signal_t *storage, size_t capacity);
+
+/* ========== Producer Side ========== */
+
+/* Append one sample; drops it (and counts an overrun) if the ring is full
+ * Returns: TRUE if stored
+ */
+bool_t sample_ring_push(sample_ring_t *ring, signal_t sample);
+
+/* Append up to count samples; the ones that do not fit are dropped
+ * Returns: Number of samples stored
+ */
+size_t sample_ring_write(sample_ring_t *ring, const signal_t *samples, size_t count);
+
+/* Free slots as seen by the producer */
+size_t sample_ring_space(const sample_ring_t *ring);
+
+/* ========== Consumer Side ========== */
+
+/* Samples ready to read as seen by the consumer */
+size_t sample_ring_available(const sample_ring_t *ring);
+
+/* Copy and consume up to max_count of the oldest samples
+ * Returns: Number of samples read
+ */
+size_t sample_ring_read(sample_ring_t *ring, signal_t *output, size_t max_count);
+
+/* Zero-copy read: point data at the oldest samples
+ * Returns: Contiguous samples available at *data (call again after
+ *          sample_ring_consume to get the part past the wrap)
+ */
+size_t sample_ring_peek(const sample_ring_t *ring, const signal_t **data);
+
+/* Release count samples obtained from sample_ring_peek */
+void sample_ring_consume(sample_ring_t *ring, size_t count);
+
+/* ========== Diagnostics ========== */
+
+/* Drop counters (readable from either side) */
+uint32_t sample_ring_dropped(const sample_ring_t *ring);
+uint32_t sample_ring_overruns(const sample_ring_t *ring);
+
+#endif /* SAMPLE_RING_H */
@@ -0,0 +1,66 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "types.h"
+#include "config.h"
+#include <stdatomic.h>
+
+#if USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* Event-driven scheduling primitives that sleep instead of spinning:
+ * - Hosted builds: monotonic clock and nanosleep (Sleep on Windows)
+ * - Bare metal: CLINT mtime, and wfi with only the machine timer enabled in
+ *   mie; the core wakes once mtimecmp is reached even with interrupts
+ *   globally off, so no trap handler is required
+ */
+
+/* Periodic deadline timer: wakes at start + k * period, without drift */
+typedef struct {
+    uint64_t period_us;
+    uint64_t next_us;            /* Next deadline */
+    uint32_t missed;             /* Deadlines that had already passed */
+} sched_timer_t;
+
+/* Wakeup flag from a producer (ISR or thread) to a sleeping consumer */
+typedef struct {
+    atomic_uint pending;
+#if USE_PTHREADS
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+} sched_event_t;
+
+/* ========== Clock ========== */
+
+/* Monotonic time in microseconds */
+uint64_t sched_now_us(void);
+
+/* Sleep until the absolute time deadline_us (returns at once if past) */
+void sched_sleep_until(uint64_t deadline_us);
+
+/* ========== Periodic Timer ========== */
+
+/* Start a timer whose first deadline is one period from now */
+void sched_timer_start(sched_timer_t *timer, uint32_t period_us);
+
+/* Sleep until the next deadline and advance it by one period
+ * Returns: FALSE if the deadline had already passed (counted in missed)
+ */
+bool_t sched_timer_wait(sched_timer_t *timer);
+
+/* ========== Events ========== */
+
+void sched_event_init(sched_event_t *event);
+void sched_event_destroy(sched_event_t *event);
+
+/* Mark the event pending and wake the waiter (safe from an ISR on bare metal) */
+void sched_event_signal(sched_event_t *event);
+
+/* Sleep until the event is pending or deadline_us passes, then clear it
+ * Returns: TRUE if the event was signalled
+ */
+bool_t sched_event_wait_until(sched_event_t *event, uint64_t deadline_us);
+
+#endif /* SCHEDULER_H */
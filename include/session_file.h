@@ -0,0 +1,98 @@
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#include "types.h"
+#include "config.h"
+#include "multichannel.h"
+#include "mapped_file.h"
+
+/* Binary session recordings (.bcis)
+ *
+ * On-disk layout, all integers and floats little-endian:
+ *   header  SESSION_HEADER_SIZE bytes: magic, version, sample rate, channel
+ *           count, block geometry, band table, label dictionary
+ *   blocks  num_blocks fixed-size blocks from data_offset; each holds
+ *           block_samples float32 values per channel (channel-major), then
+ *           block_samples label bytes, padded to SESSION_DATA_ALIGN
+ *   index   num_blocks entries {first_sample, offset, start_time, reserved}
+ *
+ * Blocks are aligned, so a mapped file hands out channel spans directly
+ * as signal_t pointers; seeking to a time is one division plus an index
+ * lookup.
+ */
+
+#define SESSION_MAGIC        "BCIS"
+#define SESSION_VERSION      1
+#define SESSION_HEADER_SIZE  256
+#define SESSION_BLOCK_SAMPLES WINDOW_SIZE  /* One pipeline window per block */
+#define SESSION_MAX_BANDS    8
+#define SESSION_MAX_LABELS   8
+#define SESSION_LABEL_LENGTH 16
+#define SESSION_INDEX_ENTRY_SIZE 16
+#define SESSION_DATA_ALIGN   CACHE_LINE_SIZE
+
+/* Decoded session header */
+typedef struct {
+    float sample_rate;
+    size_t num_channels;
+    size_t num_bands;
+    size_t num_labels;
+    size_t block_samples;      /* Samples per channel in each block */
+    size_t num_samples;        /* Valid samples (the last block may be partial) */
+    size_t num_blocks;
+    size_t block_bytes;        /* Stride between blocks */
+    size_t data_offset;        /* First block */
+    size_t index_offset;       /* Block index */
+    frequency_band_t bands[SESSION_MAX_BANDS];
+    char labels[SESSION_MAX_LABELS][SESSION_LABEL_LENGTH];
+} session_header_t;
+
+/* Reader over a mapped session file */
+typedef struct {
+    mapped_file_t file;
+    session_header_t header;
+    command_t label_map[SESSION_MAX_LABELS];   /* Label byte -> command */
+} session_reader_t;
+
+/* Write num_samples samples of frame (and labels, or NULL for CMD_NONE) as a
+ * session file, with the standard band table and command dictionary
+ * start_time: Time stamp of the first sample in seconds
+ */
+bool_t session_write(const char *filepath, const eeg_frame_t *frame,
+                     const command_t *labels, size_t num_samples,
+                     float sample_rate, float start_time);
+
+/* Convert a CSV recording (single- or multi-channel layout) to a session file */
+bool_t convert_csv_to_session(const char *csv_path, const char *session_path);
+
+/* Map and validate a session file (rejects bad magic, versions and sizes)
+ * Returns: TRUE on success
+ */
+bool_t session_open(session_reader_t *reader, const char *filepath);
+
+/* Unmap a session file */
+void session_close(session_reader_t *reader);
+
+/* Index of the sample recorded at the given time (clamped to the recording) */
+size_t session_seek_time(const session_reader_t *reader, float seconds);
+
+/* Zero-copy view of one channel starting at first_sample
+ * Returns: Samples available at *data before the end of their block
+ *          (0 past the end of the recording or for a bad channel)
+ */
+size_t session_channel_span(const session_reader_t *reader, size_t channel,
+                            size_t first_sample, const signal_t **data);
+
+/* Command label of one sample (CMD_NONE outside the recording) */
+command_t session_label(const session_reader_t *reader, size_t sample);
+
+/* Copy samples starting at first_sample into frame (one memcpy per block
+ * and channel, no parsing)
+ * frame: Must have the session's channel count
+ * labels: frame->length entries, or NULL
+ * Returns: Samples copied (at most frame->length)
+ */
+size_t load_session_frame(const session_reader_t *reader, size_t first_sample,
+                          eeg_frame_t *frame, command_t *labels);
+
+#endif /* SESSION_FILE_H */
@@ -0,0 +1,42 @@
+#ifndef SLIDING_DFT_H
+#define SLIDING_DFT_H
+
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+
+/* Sliding DFT over the last WINDOW_SIZE samples, tracking only the bins
+ * covered by a band table (plus one guard bin each side for Hann windowing)
+ */
+typedef struct {
+    size_t first_bin;                   /* Lowest tracked bin */
+    size_t num_bins;                    /* Number of tracked bins */
+    complex_t bins[WINDOW_SIZE / 2 + 1];/* Rectangular-window DFT of tracked bins */
+    complex_t phasors[WINDOW_SIZE];     /* exp(+2*pi*i*k/WINDOW_SIZE) */
+    size_t num_bands;                   /* Number of bands */
+    size_t band_low_bin[NUM_BANDS];     /* First bin of each band */
+    size_t band_high_bin[NUM_BANDS];    /* Last bin of each band */
+} sdft_state_t;
+
+/* Initialize sliding DFT for a band table (at most NUM_BANDS bands)
+ * All cosf/sinf calls happen here
+ */
+void sdft_init(sdft_state_t *sdft, const frequency_band_t *bands, size_t num_bands);
+
+/* Slide the window by one sample in O(tracked bins)
+ * sample: Newest sample entering the window
+ * leaving: Oldest sample leaving the window (0 while the window fills)
+ */
+void sdft_update(sdft_state_t *sdft, signal_t sample, signal_t leaving);
+
+/* Recompute tracked bins exactly from a linearized window (oldest first)
+ * Called once per window turnover to cancel accumulated rounding error
+ */
+void sdft_resync(sdft_state_t *sdft, const signal_t *window);
+
+/* Band powers of the current window with a Hann window applied in the
+ * frequency domain; same scaling as calculate_band_power_psd
+ */
+void sdft_band_powers(const sdft_state_t *sdft, float *band_powers);
+
+#endif /* SLIDING_DFT_H */
@@ -0,0 +1,79 @@
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include "types.h"
+#include "config.h"
+#if USE_IIR_BANDPOWER
+#include "preprocessing.h"
+#elif USE_SLIDING_DFT
+#include "sliding_dft.h"
+#elif USE_WELCH_PSD
+#include "welch.h"
+#endif
+
+/* Sliding extreme tracker (monotonic deque over the last WINDOW_SIZE samples) */
+typedef struct {
+    uint32_t index[WINDOW_SIZE];   /* Absolute sample index of each entry */
+    signal_t value[WINDOW_SIZE];   /* Sample value of each entry */
+    size_t head;                   /* Position of the front entry */
+    size_t length;                 /* Number of entries */
+} sliding_extreme_t;
+
+/* Streaming pipeline state: ring buffer plus running window statistics */
+typedef struct {
+    signal_t ring[WINDOW_SIZE];    /* Last WINDOW_SIZE raw samples */
+    signal_t window[WINDOW_SIZE];  /* Linearized window handed to the FFT */
+    size_t head;                   /* Ring position of the next write */
+    size_t count;                  /* Valid samples in ring (<= WINDOW_SIZE) */
+    size_t hop_size;               /* Samples between feature emissions */
+    size_t since_emit;             /* Samples pushed since last emission */
+    uint32_t sample_index;         /* Total samples pushed */
+
+    /* Running statistics over the ring contents */
+    float sum;                     /* Sum of samples */
+    float sum_sq;                  /* Sum of squared samples */
+    float sum_cu;                  /* Sum of cubed samples */
+    size_t since_resync;           /* Samples since sums were recomputed */
+    sliding_extreme_t max_tracker; /* Running maximum */
+    sliding_extreme_t min_tracker; /* Running minimum */
+#if USE_IIR_BANDPOWER
+    filter_bank_t filter_bank;     /* Per-sample time-domain band filters */
+#elif USE_SLIDING_DFT
+    sdft_state_t sdft;             /* Per-sample band bins */
+#elif USE_WELCH_PSD
+    welch_state_t welch;           /* Averaged segment periodograms */
+#endif
+} stream_state_t;
+
+/* Initialize streaming pipeline
+ * hop_size: Samples between feature emissions (1..WINDOW_SIZE,
+ *           0 selects STREAM_HOP_SIZE)
+ */
+void streaming_init(stream_state_t *state, size_t hop_size);
+
+/* Push one sample into the ring buffer
+ * Returns: TRUE when a new feature vector was written to features
+ */
+bool_t streaming_push_sample(stream_state_t *state, signal_t sample, features_t *features);
+
+/* Push a block of samples
+ * features: Output array for emitted feature vectors (may be NULL)
+ * max_features: Capacity of features; extra emissions overwrite the last slot
+ * Returns: Number of feature vectors emitted
+ */
+size_t streaming_push_samples(stream_state_t *state, const signal_t *samples, size_t count,
+                              features_t *features, size_t max_features);
+
+/* Running mean of the current window */
+signal_t streaming_mean(const stream_state_t *state);
+
+/* Running variance of the current window */
+signal_t streaming_variance(const stream_state_t *state);
+
+/* Running peak absolute amplitude of the current window */
+signal_t streaming_peak(const stream_state_t *state);
+
+/* Compute features for the current window without waiting for a hop */
+void streaming_compute_features(stream_state_t *state, features_t *features);
+
+#endif /* STREAMING_H */
@@ -0,0 +1,154 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "types.h"
+#include "config.h"
+#include <stdio.h>
+
+/* Binary telemetry for the visualizers and gateways (.bct streams)
+ *
+ * Every classified window becomes one fixed-size little-endian frame: a
+ * sequence-numbered header, the command, output and prediction states,
+ * the band powers and up to TELEMETRY_FRAME_SAMPLES samples (decimated
+ * when the window is longer). Frames have no padding and end in a CRC-32,
+ * so a reader maps a capture as an array of records, and a receiver on a
+ * noisy UART (or a console that also carries log text) resyncs on the
+ * magic and drops damaged frames; sequence gaps show lost ones.
+ *
+ * Sinks: a FILE (stdout or a capture file), a UART transmit register, or
+ * a UDP socket on hosted builds (one frame per datagram).
+ * scripts/telemetry.py is the numpy reader.
+ */
+
+#define TELEMETRY_MAGIC          0x54494342u   /* "BCIT" */
+#define TELEMETRY_VERSION        1u
+#define TELEMETRY_FRAME_SAMPLES  32
+#define TELEMETRY_FRAME_SIZE     176           /* sizeof(telemetry_frame_t), checked at compile time */
+
+/* telemetry_frame_t.outputs */
+#define TELEMETRY_LED            0x1u
+#define TELEMETRY_BUZZER         0x2u
+
+/* UDP needs BSD sockets: hosted POSIX builds only */
+#if !defined(_WIN32) && !(defined(__riscv) && !defined(__linux__))
+#define TELEMETRY_HAS_UDP 1
+#else
+#define TELEMETRY_HAS_UDP 0
+#endif
+
+/* ========== Frames ========== */
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                /* Bytes in the frame */
+    uint32_t sequence;            /* Frames sent before this one */
+    uint32_t first_sample;        /* Stream index of samples[0] */
+    uint16_t num_samples;         /* Valid entries in samples[] */
+    uint16_t sample_stride;       /* samples[i] is stream sample first_sample + i * stride */
+    uint16_t sample_rate;         /* Hz */
+    uint8_t command;              /* command_t */
+    uint8_t outputs;              /* TELEMETRY_LED | TELEMETRY_BUZZER */
+    uint8_t predictions[3];       /* Visual, motor, attention (prediction_t) */
+    uint8_t selected_char;        /* Keyboard grid character */
+    float band_power[NUM_BANDS];  /* Relative theta, alpha, beta, gamma power */
+    float samples[TELEMETRY_FRAME_SAMPLES];
+    uint32_t crc32;               /* CRC-32 of every byte before this field */
+} telemetry_frame_t;
+
+/* One classified window */
+typedef struct {
+    const signal_t *samples;
+    size_t num_samples;
+    uint32_t first_sample;                 /* Stream index of samples[0] */
+    const features_t *features;            /* NULL: no band powers */
+    command_t command;
+    const output_state_t *outputs;         /* NULL: all off */
+    const predictions_t *predictions;      /* NULL: all PRED_NORMAL */
+} telemetry_record_t;
+
+/* Fill frame from record (keeping every stride-th sample when the window
+ * has more than TELEMETRY_FRAME_SAMPLES) and seal it with its CRC */
+void telemetry_encode(telemetry_frame_t *frame, uint32_t sequence,
+                      const telemetry_record_t *record);
+
+/* Returns: TRUE if frame has the expected magic, version, size and CRC */
+bool_t telemetry_frame_check(const telemetry_frame_t *frame);
+
+/* ========== Sinks ========== */
+
+/* Sink backend: write length bytes
+ * Returns: Bytes accepted (less than length on an error)
+ */
+typedef size_t (*telemetry_write_fn)(void *context, const void *data, size_t length);
+
+typedef struct {
+    const char *name;
+    telemetry_write_fn write;
+    void *context;
+} telemetry_sink_t;
+
+/* Stream of frames to a FILE (switched to binary mode on Windows) */
+void telemetry_file_open(FILE *fp, telemetry_sink_t *sink);
+
+/* UART transmitter: bytes go to tx_register, each after waiting for
+ * (*status_register & ready_mask) unless status_register is NULL */
+typedef struct {
+    volatile uint8_t *tx_register;
+    volatile const uint8_t *status_register;
+    uint8_t ready_mask;
+} telemetry_uart_t;
+
+void telemetry_uart_open(telemetry_uart_t *uart, telemetry_sink_t *sink,
+                         volatile uint8_t *tx_register,
+                         volatile const uint8_t *status_register, uint8_t ready_mask);
+
+#if TELEMETRY_HAS_UDP
+/* Non-blocking UDP sender: a busy socket drops the frame */
+typedef struct {
+    int socket_fd;
+} telemetry_udp_t;
+
+/* Returns: FALSE if host does not resolve or no socket can be opened */
+bool_t telemetry_udp_open(telemetry_udp_t *udp, telemetry_sink_t *sink,
+                          const char *host, uint16_t port);
+void telemetry_udp_close(telemetry_udp_t *udp);
+#endif
+
+/* ========== Telemetry Stream ========== */
+
+typedef struct {
+    telemetry_sink_t sink;
+    uint32_t sequence;            /* Next frame's sequence number */
+    uint32_t failed;              /* Frames the sink did not fully accept */
+} telemetry_t;
+
+void telemetry_init(telemetry_t *telemetry, const telemetry_sink_t *sink);
+
+/* Encode and send one window
+ * Returns: FALSE if the sink dropped the frame (its sequence number is
+ *          still used, so the receiver sees the gap)
+ */
+bool_t telemetry_send(telemetry_t *telemetry, const telemetry_record_t *record);
+
+/* ========== Destinations ========== */
+
+/* Sink chosen by a command-line style spec:
+ *   "-"               stdout
+ *   "udp:HOST:PORT"   UDP datagrams (hosted builds)
+ *   anything else     a capture file, truncated
+ */
+typedef struct {
+    FILE *file;                   /* Opened file (not stdout) */
+#if TELEMETRY_HAS_UDP
+    telemetry_udp_t udp;
+    bool_t is_udp;
+#endif
+} telemetry_endpoint_t;
+
+/* Returns: FALSE (after logging why) if the destination cannot be opened */
+bool_t telemetry_endpoint_open(telemetry_endpoint_t *endpoint, telemetry_sink_t *sink,
+                               const char *spec);
+void telemetry_endpoint_close(telemetry_endpoint_t *endpoint);
+
+#endif /* TELEMETRY_H */
@@ -28,6 +28,21 @@ typedef enum {
     PRED_IMPAIRED        /* Impairment detected */
 } prediction_t;
 
+/* Index of each EEG frequency band in band tables */
+typedef enum {
+    BAND_THETA = 0,      /* 4-8 Hz */
+    BAND_ALPHA,          /* 8-13 Hz */
+    BAND_BETA,           /* 13-30 Hz */
+    BAND_GAMMA,          /* 30-50 Hz */
+    NUM_BANDS
+} band_index_t;
+
+/* Frequency band definition (Hz) */
+typedef struct {
+    float low_freq;
+    float high_freq;
+} frequency_band_t;
+
 /* Mental state representation with extended frequency bands */
 typedef struct {
     signal_t theta_power;    /* Power in theta band (4-8 Hz) */
@@ -36,6 +51,7 @@ typedef struct {
     signal_t gamma_power;    /* Power in gamma band (30-50 Hz) */
     signal_t peak_amplitude; /* Maximum amplitude for blink detection */
     signal_t variance;       /* Signal variance */
+    signal_t skewness;       /* Asymmetry of amplitude distribution */
 } features_t;
 
 /* Health predictions based on EEG patterns */
@@ -16,12 +16,20 @@ void print_signal(const signal_t *signal, size_t length, const char *label);
 /* Print features for debugging */
 void print_features(const features_t *features);
 
-/* Delay function (milliseconds) */
+/* Sleep for ms milliseconds (prefer sched_timer_t for periodic work) */
 void delay_ms(unsigned int ms);
 
 /* Get current time in seconds (for simulation) */
 float get_time_sec(void);
 
+/* Reflected CRC-32 (polynomial 0xEDB88320, zlib.crc32 compatible); pass 0
+ * to start and the previous result to continue */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t length);
+
+/* TRUE on little-endian hosts, whose memory layout matches the on-disk
+ * records (session files, model blobs) that are used in place */
+bool_t host_is_little_endian(void);
+
 /* Console color codes for output */
 #define COLOR_RESET   "\033[0m"
 #define COLOR_RED     "\033[31m"
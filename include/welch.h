@@ -0,0 +1,88 @@
+#ifndef WELCH_H
+#define WELCH_H
+
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+#include "dsp_arena.h"
+
+/* Welch PSD estimate: the average of Hann-windowed periodograms of
+ * overlapping WELCH_SEGMENT_SIZE segments. Each segment is transformed once
+ * when it completes; its spectrum stays in the average for the next
+ * WELCH_NUM_SEGMENTS - 1 segment hops, so band reads between hops cost no
+ * FFT and no transcendental calls.
+ */
+
+#if (WELCH_SEGMENT_SIZE & (WELCH_SEGMENT_SIZE - 1)) != 0 || WELCH_SEGMENT_SIZE > WINDOW_SIZE
+#error "WELCH_SEGMENT_SIZE must be a power of 2 no larger than WINDOW_SIZE"
+#endif
+#if WELCH_OVERLAP < 0 || WELCH_OVERLAP >= 100
+#error "WELCH_OVERLAP must be a percentage in [0, 100)"
+#endif
+
+/* Samples between segment starts */
+#define WELCH_SEGMENT_HOP (WELCH_SEGMENT_SIZE - WELCH_SEGMENT_SIZE * WELCH_OVERLAP / 100)
+
+/* Segments averaged: as many as fit in one WINDOW_SIZE window */
+#define WELCH_NUM_SEGMENTS ((WINDOW_SIZE - WELCH_SEGMENT_SIZE) / WELCH_SEGMENT_HOP + 1)
+
+#define WELCH_NUM_BINS (WELCH_SEGMENT_SIZE / 2 + 1)
+
+typedef struct {
+    signal_t history[WELCH_SEGMENT_SIZE];   /* Ring of the last segment's samples */
+    size_t head;                            /* Ring position of the next write */
+    size_t count;                           /* Valid samples in history */
+    size_t since_segment;                   /* Samples since the last segment */
+
+    /* Segment periodograms (power density), oldest overwritten first */
+    float spectra[WELCH_NUM_SEGMENTS][WELCH_NUM_BINS];
+    size_t next_spectrum;
+    size_t num_spectra;                     /* Periodograms in the average */
+    float average[WELCH_NUM_BINS];
+    power_spectrum_t spectrum;              /* View of average */
+
+    float sampling_rate;
+    float scale;                            /* 2 / (fs * sum(w^2)) */
+    fft_workspace_t ws;                     /* Plan, window table and scratch */
+    dsp_arena_t arena;
+    uint8_t memory[FFT_WORKSPACE_BYTES(WELCH_SEGMENT_SIZE)];
+} welch_state_t;
+
+/* Initialize the estimator (builds the plan and window tables; all
+ * cosf/sinf calls happen here)
+ */
+void welch_init(welch_state_t *welch, float sampling_rate);
+
+/* Forget all samples and segments, keeping the tables */
+void welch_reset(welch_state_t *welch);
+
+/* Push one sample
+ * Returns: TRUE when it completed a segment and the average was updated
+ */
+bool_t welch_push_sample(welch_state_t *welch, signal_t sample);
+
+/* Push a block of samples
+ * Returns: Number of segments completed
+ */
+size_t welch_push_samples(welch_state_t *welch, const signal_t *samples, size_t count);
+
+/* Averaged power spectral density (power per Hz; num_bins is 0 until the
+ * first segment completes)
+ */
+const power_spectrum_t* welch_spectrum(const welch_state_t *welch);
+
+/* Band powers from the averaged spectrum, integrated like
+ * calculate_band_power_psd; a sine of amplitude A reads as A^2/2
+ * band_powers: num_bands entries (zero until the first segment completes)
+ */
+void welch_band_powers(const welch_state_t *welch, const frequency_band_t *bands,
+                       size_t num_bands, float *band_powers);
+
+/* Welch band powers of one buffered signal (resets the estimator first)
+ * Returns: Number of segments averaged (0 if length < WELCH_SEGMENT_SIZE)
+ */
+size_t calculate_band_powers_welch(welch_state_t *welch, const signal_t *signal,
+                                   size_t length, const frequency_band_t *bands,
+                                   size_t num_bands, float *band_powers);
+
+#endif /* WELCH_H */
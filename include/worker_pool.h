@@ -0,0 +1,106 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "types.h"
+#include "config.h"
+#include "dsp_arena.h"
+#include "fft.h"
+#include "multichannel.h"
+#include "data_loader.h"
+#include "classifier.h"
+
+#if USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* Worker pool for embarrassingly parallel work: the channels of a frame, or
+ * whole recorded sessions. Each worker owns its arena, FFT workspace and
+ * plan tables, so jobs share no mutable state. Jobs write results to their
+ * own slot (indexed by job number), which makes the merged output identical
+ * for any worker count or schedule.
+ * Without USE_PTHREADS every job runs on the calling thread.
+ */
+
+struct worker_pool;
+
+/* Private state of one worker */
+typedef struct {
+    size_t id;
+    struct worker_pool *pool;
+    dsp_arena_t arena;
+    void *arena_memory;
+    fft_workspace_t workspace;   /* Own plan tables (fft_workspace_init_private) */
+    eeg_frame_t window;          /* MAX_CHANNELS x window_length scratch frame */
+    command_t *labels;           /* window_length labels for the scratch frame */
+#if USE_PTHREADS
+    pthread_t thread;
+#endif
+} worker_context_t;
+
+/* Job callback: process job number `job` using the worker's private state */
+typedef void (*worker_job_fn)(worker_context_t *worker, size_t job, void *user_data);
+
+typedef struct worker_pool {
+    size_t num_workers;
+    size_t window_length;
+    worker_context_t workers[MAX_WORKERS];
+#if USE_PTHREADS
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    worker_job_fn job_fn;
+    void *job_data;
+    size_t num_jobs;
+    size_t next_job;
+    size_t active;               /* Workers still busy with this batch */
+    uint32_t generation;         /* Incremented for every batch */
+    bool_t shutdown;
+#endif
+} worker_pool_t;
+
+/* Offline scoring result for one recorded session */
+typedef struct {
+    bool_t loaded;
+    size_t num_samples;
+    size_t num_channels;
+    size_t num_windows;
+    size_t command_counts[CMD_BLINK + 1];  /* Windows classified as each command */
+    size_t label_matches;        /* Windows whose command matches the CSV label */
+    features_t mean_features;    /* Channel- and window-averaged features */
+    impairment_stats_t impairments;  /* Impairment grades of the averaged windows */
+} session_result_t;
+
+/* ========== Pool Management ========== */
+
+/* Start a pool
+ * num_workers: Thread count (0 = MAX_WORKERS); forced to 1 without USE_PTHREADS
+ * window_length: Samples per analysis window (sizes the per-worker scratch)
+ * Returns: TRUE on success
+ */
+bool_t worker_pool_init(worker_pool_t *pool, size_t num_workers, size_t window_length);
+
+/* Run jobs 0..num_jobs-1 across the workers and wait for all of them */
+void worker_pool_run(worker_pool_t *pool, size_t num_jobs, worker_job_fn job_fn,
+                     void *user_data);
+
+/* Stop the threads and free every worker's memory */
+void worker_pool_destroy(worker_pool_t *pool);
+
+/* ========== Parallel Pipelines ========== */
+
+/* process_frame with channels spread across the workers
+ * features: frame->num_channels entries, in channel order
+ */
+void worker_pool_process_frame(worker_pool_t *pool, eeg_frame_t *frame, features_t *features);
+
+/* Score recorded sessions (e.g. the CSVs in data/raw/) in parallel: each
+ * session is split into non-overlapping windows that are preprocessed,
+ * featurized, channel-averaged and classified with a fresh classifier;
+ * the averaged band powers are graded in IMPAIRMENT_BLOCK_SIZE batches
+ * results: num_sessions entries, in the order of paths
+ * Returns: Number of sessions that loaded
+ */
+size_t worker_pool_process_sessions(worker_pool_t *pool, const char *const *paths,
+                                    size_t num_sessions, session_result_t *results);
+
+#endif /* WORKER_POOL_H */
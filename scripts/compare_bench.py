@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+BCI Benchmark Comparison
+Compares two benchmark result files (bench_output.txt CSV, or a captured
+console/UART log with @bench lines) and flags kernels that got slower.
+
+Usage:
+    python compare_bench.py baseline.txt current.txt [--threshold 10]
+Exits with status 1 when any point regressed by more than the threshold (%).
+"""
+
+import argparse
+import sys
+
+
+def load_results(path):
+    """Map (kernel, size) -> ticks per sample."""
+    results = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if fields[0] == "@bench":
+                fields = fields[1:]
+            elif fields[0] in ("kernel", "@benchinfo") or len(fields) < 5:
+                continue
+            try:
+                results[(fields[0], int(fields[1]))] = float(fields[4])
+            except ValueError:
+                continue
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[2])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown in percent that counts as a regression")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+    regressions = 0
+
+    print(f"{'kernel':<26} {'size':>5} {'baseline':>10} {'current':>10} {'change':>8}")
+    for key in sorted(baseline.keys() & current.keys()):
+        old, new = baseline[key], current[key]
+        change = 100.0 * (new - old) / old if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{key[0]:<26} {key[1]:>5} {old:>10.3f} {new:>10.3f} {change:>+7.1f}%{flag}")
+
+    missing = sorted(baseline.keys() - current.keys())
+    for kernel, size in missing:
+        print(f"{kernel:<26} {size:>5} missing from {args.current}")
+
+    print(f"\n{regressions} regression(s) above {args.threshold:.0f}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
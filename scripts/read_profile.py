@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+BCI Profiler Report Reader
+Pulls the @prof report (profiler_dump) out of a console or UART capture and
+prints a per-stage table.
+
+Usage:
+    python read_profile.py uart_capture.txt
+    ./bin/bci_system | python read_profile.py
+"""
+
+import sys
+
+
+def parse_profile(lines):
+    """Return (unit, stages, overruns) for the last report in lines.
+
+    stages maps a name to a dict with count, min, mean, max, instret and
+    bins ({bin index: count}; bin k holds durations in [2^(k-1), 2^k)).
+    """
+    unit, stages, overruns, current = None, {}, None, None
+    for line in lines:
+        fields = line.strip().split(",")
+        if fields[0] == "@prof":
+            unit, current = fields[2], {}
+        elif fields[0] == "@hist" and current is not None:
+            first = int(fields[7])
+            counts = [int(c) for c in fields[8].split("|")]
+            current[fields[1]] = {
+                "count": int(fields[2]),
+                "min": int(fields[3]),
+                "mean": int(fields[4]),
+                "max": int(fields[5]),
+                "instret": int(fields[6]),
+                "bins": {first + k: c for k, c in enumerate(counts) if c},
+            }
+        elif fields[0] == "@overrun" and current is not None:
+            overruns = (int(fields[1]), int(fields[2]))
+        elif fields[0] == "@end" and current is not None:
+            stages, current = current, None
+    return unit, stages, overruns
+
+
+def main():
+    stream = open(sys.argv[1], errors="replace") if len(sys.argv) > 1 else sys.stdin
+    unit, stages, overruns = parse_profile(stream)
+    if not stages:
+        print("No profiler report found (build with PROFILE=1 / -DENABLE_PROFILING=1)")
+        return 1
+
+    print(f"{'stage':<11} {'count':>7} {'min':>12} {'mean':>12} {'max':>12} {'IPC':>5}  ({unit})")
+    for name, s in stages.items():
+        ipc = f"{s['instret'] / s['mean']:.2f}" if unit == "cycles" and s["mean"] else "-"
+        print(f"{name:<11} {s['count']:>7} {s['min']:>12} {s['mean']:>12} {s['max']:>12} {ipc:>5}")
+    if overruns:
+        print(f"acquisition: {overruns[0]} samples dropped in {overruns[1]} overruns")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""
+BCI Telemetry Reader
+Reads the binary frames sent by telemetry.c (bci_system --telemetry, the
+integration demo's data/realtime_stream.bct) as numpy record arrays.
+
+A clean capture is mapped in place: every field is a strided view of the
+file, with no per-frame parsing. Captures with other bytes mixed in (a
+console that also carries log text, a UART that lost bytes) are resynced
+on the frame magic, and frames with a bad CRC are dropped.
+
+Usage:
+    python telemetry.py capture.bct            # summary of a capture
+    python telemetry.py --udp 9000             # live from bci_system --telemetry udp:127.0.0.1:9000
+    ./bin/bci_system --telemetry - | python telemetry.py -
+"""
+
+import socket
+import sys
+import zlib
+
+import numpy as np
+
+MAGIC = 0x54494342          # "BCIT"
+VERSION = 1
+FRAME_SAMPLES = 32
+
+COMMANDS = ("NONE", "FOCUS", "RELAX", "BLINK")
+PREDICTIONS = ("NORMAL", "BORDERLINE", "IMPAIRED")
+LED = 0x1
+BUZZER = 0x2
+
+# telemetry_frame_t, little-endian and unpadded
+FRAME_DTYPE = np.dtype([
+    ("magic", "<u4"),
+    ("version", "<u2"),
+    ("size", "<u2"),
+    ("sequence", "<u4"),
+    ("first_sample", "<u4"),
+    ("num_samples", "<u2"),
+    ("sample_stride", "<u2"),
+    ("sample_rate", "<u2"),
+    ("command", "u1"),
+    ("outputs", "u1"),
+    ("predictions", "u1", (3,)),
+    ("selected_char", "u1"),
+    ("band_power", "<f4", (4,)),
+    ("samples", "<f4", (FRAME_SAMPLES,)),
+    ("crc32", "<u4"),
+])
+FRAME_SIZE = FRAME_DTYPE.itemsize
+CRC_OFFSET = FRAME_DTYPE.fields["crc32"][1]
+assert FRAME_SIZE == 176
+
+_MAGIC_BYTES = MAGIC.to_bytes(4, "little")
+
+
+def _header_ok(frames):
+    """Per-frame check of the fixed header fields."""
+    return ((frames["magic"] == MAGIC) & (frames["version"] == VERSION) &
+            (frames["size"] == FRAME_SIZE) & (frames["num_samples"] <= FRAME_SAMPLES))
+
+
+def _crc_ok(raw, frames):
+    """Per-frame CRC check of the frames laid out back to back in raw."""
+    return np.fromiter((zlib.crc32(raw[i * FRAME_SIZE:i * FRAME_SIZE + CRC_OFFSET])
+                        for i in range(len(frames))), dtype=np.uint32,
+                       count=len(frames)) == frames["crc32"]
+
+
+def _frame_ok(raw):
+    """Check one frame's header and CRC (raw: FRAME_SIZE bytes)."""
+    frame = np.frombuffer(raw, FRAME_DTYPE, count=1)
+    return bool(_header_ok(frame)[0] and _crc_ok(raw, frame)[0])
+
+
+def parse_frames(buffer):
+    """Frames in a bytes-like buffer, as a FRAME_DTYPE record array.
+
+    Returns (frames, consumed): consumed counts the bytes up to the end of
+    the last frame (or of the junk skipped), so a streaming caller keeps
+    buffer[consumed:] for the next read. The result is a view of buffer
+    when it is nothing but frames.
+    """
+    view = memoryview(buffer).cast("B")
+    whole = len(view) - len(view) % FRAME_SIZE
+    if whole:
+        frames = np.frombuffer(view[:whole], FRAME_DTYPE)
+        if np.all(_header_ok(frames)) and np.all(_crc_ok(view, frames)):
+            return frames, whole
+
+    # Resync: check every candidate magic, keep the frames that validate
+    data = bytes(view)
+    good, position, consumed = [], 0, 0
+    while True:
+        position = data.find(_MAGIC_BYTES, position)
+        if position < 0:
+            # Only a partial magic at the very end can still become a frame
+            consumed = max(consumed, len(data) - 3)
+            break
+        if position + FRAME_SIZE > len(data):
+            consumed = max(consumed, position)
+            break
+        raw = data[position:position + FRAME_SIZE]
+        if _frame_ok(raw):
+            good.append(raw)
+            position += FRAME_SIZE
+            consumed = position
+        else:
+            position += 1
+    frames = np.frombuffer(b"".join(good), FRAME_DTYPE) if good else np.empty(0, FRAME_DTYPE)
+    return frames, consumed
+
+
+def read_file(path):
+    """All valid frames of a capture file (memory-mapped when clean)."""
+    mapped = np.memmap(path, dtype=np.uint8, mode="r") if _file_size(path) else b""
+    frames, _ = parse_frames(mapped)
+    return frames
+
+
+def _file_size(path):
+    with open(path, "rb") as f:
+        f.seek(0, 2)
+        return f.tell()
+
+
+def stream_frames(fileobj, chunk=64 * FRAME_SIZE):
+    """Yield record arrays as frames arrive on a pipe or serial port."""
+    pending = b""
+    while True:
+        data = fileobj.read1(chunk) if hasattr(fileobj, "read1") else fileobj.read(chunk)
+        if not data:
+            break
+        pending += data
+        frames, consumed = parse_frames(pending)
+        pending = pending[consumed:]
+        if len(frames):
+            yield frames
+
+
+def udp_frames(port, host="0.0.0.0"):
+    """Yield one record array per datagram received on port."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((host, port))
+    try:
+        while True:
+            datagram, _ = sock.recvfrom(65536)
+            frames, _ = parse_frames(datagram)
+            if len(frames):
+                yield frames
+    finally:
+        sock.close()
+
+
+def lost_frames(frames):
+    """Frames missing between the first and last sequence number."""
+    if len(frames) < 2:
+        return 0
+    gaps = np.diff(frames["sequence"].astype(np.int64)) - 1
+    return int(gaps[gaps > 0].sum())
+
+
+def samples(frames):
+    """(time, amplitude) of every transmitted sample, flattened."""
+    index = (frames["first_sample"][:, None].astype(np.int64) +
+             np.arange(FRAME_SAMPLES) * frames["sample_stride"][:, None])
+    valid = np.arange(FRAME_SAMPLES) < frames["num_samples"][:, None]
+    rate = np.repeat(frames["sample_rate"][:, None], FRAME_SAMPLES, axis=1)
+    return index[valid] / rate[valid], frames["samples"][valid]
+
+
+def to_messages(frames):
+    """Per-sample dicts in the format the visualizers' data_queue expects."""
+    for frame in frames:
+        rate = float(frame["sample_rate"])
+        theta, alpha, beta, gamma = (float(p) for p in frame["band_power"])
+        predictions = [PREDICTIONS[min(p, 2)] for p in frame["predictions"]]
+        for i in range(frame["num_samples"]):
+            yield {
+                "time": (frame["first_sample"] + i * frame["sample_stride"]) / rate,
+                "amplitude": float(frame["samples"][i]),
+                "command": COMMANDS[min(frame["command"], 3)],
+                "theta_power": theta,
+                "alpha_power": alpha,
+                "beta_power": beta,
+                "gamma_power": gamma,
+                "led_state": bool(frame["outputs"] & LED),
+                "visual_impairment": predictions[0],
+                "motor_impairment": predictions[1],
+                "attention_deficit": predictions[2],
+            }
+
+
+def summarize(frames):
+    """Print a capture summary."""
+    if len(frames) == 0:
+        print("No telemetry frames")
+        return
+    print(f"Frames:   {len(frames)} (sequence {frames['sequence'][0]}..{frames['sequence'][-1]}, "
+          f"{lost_frames(frames)} lost)")
+    t, _ = samples(frames)
+    print(f"Samples:  {int(frames['num_samples'].sum())} over {t[-1] - t[0]:.2f} s")
+    counts = np.bincount(frames["command"], minlength=len(COMMANDS))
+    print("Commands: " + ", ".join(f"{name} {counts[i]}" for i, name in enumerate(COMMANDS)))
+    led_on = np.count_nonzero(frames["outputs"] & LED)
+    print(f"LED on:   {100.0 * led_on / len(frames):.0f}% of windows")
+    powers = frames["band_power"].mean(axis=0)
+    print("Bands:    theta {:.3f}, alpha {:.3f}, beta {:.3f}, gamma {:.3f}".format(*powers))
+
+
+def main():
+    if len(sys.argv) > 2 and sys.argv[1] == "--udp":
+        last = None
+        for frames in udp_frames(int(sys.argv[2])):
+            for frame in frames:
+                sequence = int(frame["sequence"])
+                if last is not None and sequence > last + 1:
+                    print(f"  ({sequence - last - 1} frames lost)")
+                last = sequence
+                print(f"#{sequence:6d} {COMMANDS[min(frame['command'], 3)]:5s} "
+                      f"LED {'ON ' if frame['outputs'] & LED else 'OFF'} "
+                      f"alpha {frame['band_power'][1]:.3f} beta {frame['band_power'][2]:.3f}")
+    elif len(sys.argv) > 1 and sys.argv[1] != "-":
+        summarize(read_file(sys.argv[1]))
+    else:
+        chunks = list(stream_frames(sys.stdin.buffer))
+        summarize(np.concatenate(chunks) if chunks else np.empty(0, FRAME_DTYPE))
+
+
+if __name__ == "__main__":
+    main()
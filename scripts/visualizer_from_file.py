@@ -9,6 +9,7 @@ Answers your group member's question:
 Usage:
     python visualizer_from_file.py sample_eeg_data.csv
     python visualizer_from_file.py your_data.xlsx
+    python visualizer_from_file.py data/realtime_stream.bct   # binary telemetry
 """
 
 import sys
@@ -67,7 +68,11 @@ print(f"Loading EEG data from: {filepath}")
 print(f"Dataset Type: {dataset_type}")
 
 try:
-    if filepath.endswith('.xlsx') or filepath.endswith('.xls'):
+    if filepath.endswith('.bct'):
+        # Binary telemetry capture: one row per transmitted sample
+        from telemetry import read_file, to_messages
+        df = pd.DataFrame(list(to_messages(read_file(filepath))))
+    elif filepath.endswith('.xlsx') or filepath.endswith('.xls'):
         df = pd.read_excel(filepath)
     else:  # CSV
         df = pd.read_csv(filepath)
@@ -0,0 +1,385 @@
+#include "acquisition.h"
+#include "eeg_simulator.h"
+#include "profiler.h"
+#include "sample_ring.h"
+#include "utils.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Buffer ownership */
+#define ACQ_BUFFER_FREE  0u      /* Owned by the source (being filled or idle) */
+#define ACQ_BUFFER_READY 1u      /* Completed, waiting for the DSP */
+#define ACQ_BUFFER_BUSY  2u      /* Held by the DSP */
+
+static size_t min_size(size_t a, size_t b) {
+    return (a < b) ? a : b;
+}
+
+/* ========== Sample Format ========== */
+
+void acq_samples_to_signal(const acq_sample_t *input, signal_t *output, size_t length) {
+#if USE_FIXED_POINT
+    fixed_to_signal(input, output, length, FIXED_INPUT_FULL_SCALE);
+#else
+    memcpy(output, input, length * sizeof(signal_t));
+#endif
+}
+
+void acq_samples_from_signal(const signal_t *input, acq_sample_t *output, size_t length) {
+#if USE_FIXED_POINT
+    fixed_from_signal(input, output, length, FIXED_INPUT_FULL_SCALE);
+#else
+    memcpy(output, input, length * sizeof(signal_t));
+#endif
+}
+
+/* ========== Simulator Source ========== */
+
+static size_t simulator_fill(void *context, acq_sample_t *buffer, size_t count) {
+    acq_simulator_t *sim = (acq_simulator_t*)context;
+    size_t written = 0;
+
+    while (written < count && sim->produced < sim->total_samples) {
+        size_t offset = sim->produced % WINDOW_SIZE;
+        if (offset == 0) {
+            size_t window_index = sim->produced / WINDOW_SIZE;
+            generate_eeg_sample(sim->window, WINDOW_SIZE,
+                                sim->script[window_index % sim->script_length]);
+        }
+
+        size_t n = min_size(min_size(count - written, WINDOW_SIZE - offset),
+                            sim->total_samples - sim->produced);
+        acq_samples_from_signal(&sim->window[offset], &buffer[written], n);
+        written += n;
+        sim->produced += n;
+    }
+
+    return written;
+}
+
+void acq_simulator_open(acq_simulator_t *sim, acq_source_t *source,
+                        const command_t *script, size_t script_length, size_t num_windows) {
+    sim->script = script;
+    sim->script_length = script_length;
+    sim->total_samples = (script_length > 0) ? num_windows * WINDOW_SIZE : 0;
+    sim->produced = 0;
+
+    source->name = "simulator";
+    source->fill = simulator_fill;
+    source->context = sim;
+}
+
+/* ========== File Replay Source ========== */
+
+/* Recorded microvolts straight from the reader */
+static size_t file_read(acq_file_t *file, signal_t *buffer, size_t count) {
+    if (!file->is_session) {
+        /* One-channel frame view over the caller's buffer */
+        eeg_frame_t view = { 1, count, count, buffer, NULL };
+        return dataset_reader_next_frame(&file->csv, &view, NULL);
+    }
+
+    size_t written = 0;
+    while (written < count) {
+        const signal_t *span;
+        size_t n = session_channel_span(&file->session, 0, file->position, &span);
+        if (n == 0) {
+            break;
+        }
+        n = min_size(n, count - written);
+        memcpy(&buffer[written], span, n * sizeof(signal_t));
+        written += n;
+        file->position += n;
+    }
+    return written;
+}
+
+static size_t file_fill(void *context, acq_sample_t *buffer, size_t count) {
+    acq_file_t *file = (acq_file_t*)context;
+#if USE_FIXED_POINT
+    /* Recordings are in microvolts: convert a block at a time */
+    size_t written = 0;
+    while (written < count) {
+        size_t n = file_read(file, file->scratch, min_size(count - written, ACQ_BLOCK_SIZE));
+        if (n == 0) {
+            break;
+        }
+        acq_samples_from_signal(file->scratch, &buffer[written], n);
+        written += n;
+    }
+    return written;
+#else
+    return file_read(file, buffer, count);
+#endif
+}
+
+/* Session files start with SESSION_MAGIC; anything else is treated as CSV */
+static bool_t has_session_magic(const char *filepath) {
+    char magic[4];
+    FILE *fp = fopen(filepath, "rb");
+    bool_t match = FALSE;
+
+    if (fp != NULL) {
+        match = (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+                 memcmp(magic, SESSION_MAGIC, sizeof(magic)) == 0) ? TRUE : FALSE;
+        fclose(fp);
+    }
+    return match;
+}
+
+bool_t acq_file_open(acq_file_t *file, acq_source_t *source, const char *filepath) {
+    memset(file, 0, sizeof(*file));
+
+    file->is_session = has_session_magic(filepath);
+    if (file->is_session) {
+        if (!session_open(&file->session, filepath)) {
+            return FALSE;
+        }
+    } else {
+        if (!dataset_reader_open(&file->csv, filepath, COLUMN_BIT(COLUMN_AMPLITUDE))) {
+            return FALSE;
+        }
+        if (file->csv.num_channels != 1) {
+            log_error("%s: replay needs a single-channel recording, found %zu channels",
+                      filepath, file->csv.num_channels);
+            dataset_reader_close(&file->csv);
+            return FALSE;
+        }
+    }
+
+    source->name = file->is_session ? "session replay" : "CSV replay";
+    source->fill = file_fill;
+    source->context = file;
+    return TRUE;
+}
+
+void acq_file_close(acq_file_t *file) {
+    if (file->is_session) {
+        session_close(&file->session);
+    } else {
+        dataset_reader_close(&file->csv);
+    }
+}
+
+/* ========== ADC Source ========== */
+
+static size_t adc_fill(void *context, acq_sample_t *buffer, size_t count) {
+    acq_adc_t *adc = (acq_adc_t*)context;
+
+    for (size_t i = 0; i < count; i++) {
+#if USE_FIXED_POINT
+        /* Integer only: counts to Q15 with rounding, saturated */
+        int64_t scaled = ((int64_t)*adc->data_register * adc->q15_per_lsb + (1 << 15)) >> 16;
+        buffer[i] = (q15_t)((scaled > Q15_ONE) ? Q15_ONE : (scaled < -32768) ? -32768 : scaled);
+#else
+        buffer[i] = (signal_t)(*adc->data_register) * adc->microvolts_per_lsb;
+#endif
+    }
+    return count;
+}
+
+void acq_adc_open(acq_adc_t *adc, acq_source_t *source,
+                  volatile const int32_t *data_register, float microvolts_per_lsb) {
+    adc->data_register = data_register;
+    adc->microvolts_per_lsb = microvolts_per_lsb;
+#if USE_FIXED_POINT
+    adc->q15_per_lsb = (int32_t)lrintf(microvolts_per_lsb * (32768.0f / FIXED_INPUT_FULL_SCALE) * 65536.0f);
+#endif
+
+    source->name = "ADC";
+    source->fill = adc_fill;
+    source->context = adc;
+}
+
+/* ========== Acquisition Side ========== */
+
+/* Hand the filled buffer to the DSP and switch to the other one */
+static void acq_publish(acquisition_t *acq) {
+    size_t index = acq->fill_index;
+
+    acq->counts[index] = acq->fill_count;
+    acq->completed_ticks[index] = PROF_NOW();
+    atomic_store_explicit(&acq->state[index], ACQ_BUFFER_READY, memory_order_release);
+    if (acq->on_complete != NULL) {
+        acq->on_complete(acq->user_data, acq->buffers[index], acq->fill_count);
+    }
+    sched_event_signal(&acq->buffer_ready);
+
+    acq->fill_index = index ^ 1;
+    acq->fill_count = 0;
+}
+
+/* Deliver one block into the buffer being filled; a block that arrives
+ * while the DSP still holds that buffer is dropped
+ * Returns: FALSE once the source is exhausted
+ */
+static bool_t acq_produce(acquisition_t *acq) {
+    acq_sample_t discard[ACQ_BLOCK_SIZE];
+    bool_t available = atomic_load_explicit(&acq->state[acq->fill_index],
+                                            memory_order_acquire) == ACQ_BUFFER_FREE;
+    acq_sample_t *target = discard;
+    size_t wanted = ACQ_BLOCK_SIZE;
+
+    if (available) {
+        acq->stalled = FALSE;
+        target = &acq->buffers[acq->fill_index][acq->fill_count];
+        wanted = min_size(ACQ_BLOCK_SIZE, acq->buffer_length - acq->fill_count);
+    } else if (!acq->stalled) {
+        acq->stalled = TRUE;
+        ring_counter_add(&acq->overruns, 1);
+    }
+
+    size_t produced = acq->source.fill(acq->source.context, target, wanted);
+
+    if (!available) {
+        ring_counter_add(&acq->dropped, produced);
+    } else {
+        acq->fill_count += produced;
+        if (acq->fill_count == acq->buffer_length || (produced == 0 && acq->fill_count > 0)) {
+            acq_publish(acq);
+        }
+    }
+
+    if (produced == 0) {
+        atomic_store_explicit(&acq->finished, 1, memory_order_release);
+        sched_event_signal(&acq->buffer_ready);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+#if USE_PTHREADS
+static void* acq_thread(void *arg) {
+    acquisition_t *acq = (acquisition_t*)arg;
+
+    while (!atomic_load_explicit(&acq->stop, memory_order_acquire)) {
+        if (acq->paced) {
+            sched_timer_wait(&acq->timer);
+        } else if (atomic_load_explicit(&acq->state[acq->fill_index],
+                                        memory_order_acquire) != ACQ_BUFFER_FREE) {
+            /* Replay never drops: wait for the DSP to return a buffer */
+            sched_event_wait_until(&acq->buffer_free, sched_now_us() + 4 * ACQ_BLOCK_PERIOD_US);
+            continue;
+        }
+        if (!acq_produce(acq)) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+bool_t acquisition_start(acquisition_t *acq, const acq_source_t *source,
+                         size_t buffer_length, bool_t paced,
+                         acq_complete_fn on_complete, void *user_data) {
+    if (source == NULL || source->fill == NULL ||
+        buffer_length == 0 || buffer_length > ACQ_MAX_BUFFER_SAMPLES) {
+        log_error("Acquisition buffers must hold 1-%d samples", ACQ_MAX_BUFFER_SAMPLES);
+        return FALSE;
+    }
+
+    acq->source = *source;
+    acq->buffer_length = buffer_length;
+    acq->paced = paced;
+    acq->on_complete = on_complete;
+    acq->user_data = user_data;
+    acq->fill_index = 0;
+    acq->fill_count = 0;
+    acq->consume_index = 0;
+    acq->stalled = FALSE;
+    for (size_t i = 0; i < 2; i++) {
+        acq->counts[i] = 0;
+        acq->completed_ticks[i] = 0;
+        atomic_init(&acq->state[i], ACQ_BUFFER_FREE);
+    }
+    atomic_init(&acq->finished, 0);
+    atomic_init(&acq->stop, 0);
+    atomic_init(&acq->dropped, 0);
+    atomic_init(&acq->overruns, 0);
+    sched_event_init(&acq->buffer_free);
+    sched_event_init(&acq->buffer_ready);
+    sched_timer_start(&acq->timer, ACQ_BLOCK_PERIOD_US);
+
+#if USE_PTHREADS
+    if (pthread_create(&acq->thread, NULL, acq_thread, acq) != 0) {
+        log_error("Failed to start acquisition thread");
+        sched_event_destroy(&acq->buffer_ready);
+        sched_event_destroy(&acq->buffer_free);
+        return FALSE;
+    }
+#endif
+
+    return TRUE;
+}
+
+void acquisition_stop(acquisition_t *acq) {
+    atomic_store_explicit(&acq->stop, 1, memory_order_release);
+    sched_event_signal(&acq->buffer_free);
+#if USE_PTHREADS
+    pthread_join(acq->thread, NULL);
+#endif
+    sched_event_destroy(&acq->buffer_ready);
+    sched_event_destroy(&acq->buffer_free);
+}
+
+/* ========== DSP Side ========== */
+
+const acq_sample_t* acquisition_poll(acquisition_t *acq, size_t *count) {
+    size_t index = acq->consume_index;
+
+    if (atomic_load_explicit(&acq->state[index], memory_order_acquire) != ACQ_BUFFER_READY) {
+        return NULL;
+    }
+
+    atomic_store_explicit(&acq->state[index], ACQ_BUFFER_BUSY, memory_order_relaxed);
+    *count = acq->counts[index];
+    return acq->buffers[index];
+}
+
+const acq_sample_t* acquisition_wait(acquisition_t *acq, size_t *count) {
+    for (;;) {
+        const acq_sample_t *buffer = acquisition_poll(acq, count);
+        if (buffer != NULL) {
+            return buffer;
+        }
+        if (atomic_load_explicit(&acq->finished, memory_order_acquire)) {
+            /* The last buffer is published before finished is set */
+            return acquisition_poll(acq, count);
+        }
+#if USE_PTHREADS
+        sched_event_wait_until(&acq->buffer_ready, sched_now_us() + 4 * ACQ_BLOCK_PERIOD_US);
+#else
+        if (acq->paced) {
+            sched_timer_wait(&acq->timer);
+        }
+        acq_produce(acq);
+#endif
+    }
+}
+
+void acquisition_release(acquisition_t *acq) {
+    size_t index = acq->consume_index;
+
+    if (atomic_load_explicit(&acq->state[index], memory_order_relaxed) != ACQ_BUFFER_BUSY) {
+        return;
+    }
+
+    /* Release: reads of the buffer complete before the source refills it */
+    atomic_store_explicit(&acq->state[index], ACQ_BUFFER_FREE, memory_order_release);
+    acq->consume_index = index ^ 1;
+    sched_event_signal(&acq->buffer_free);
+}
+
+uint64_t acquisition_completed_ticks(const acquisition_t *acq) {
+    return acq->completed_ticks[acq->consume_index];
+}
+
+uint32_t acquisition_dropped(const acquisition_t *acq) {
+    return atomic_load_explicit(&acq->dropped, memory_order_relaxed);
+}
+
+uint32_t acquisition_overruns(const acquisition_t *acq) {
+    return atomic_load_explicit(&acq->overruns, memory_order_relaxed);
+}
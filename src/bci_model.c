@@ -0,0 +1,244 @@
+#include "bci_model.h"
+#include "feature_extraction.h"
+#include "utils.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/* The record is read in place: its layout must not depend on the compiler
+ * (a negative array size here means padding crept in or a field changed) */
+typedef char bci_model_size_check[(sizeof(bci_model_t) == BCI_MODEL_SIZE) ? 1 : -1];
+
+/* Bytes covered by the CRC: everything after the crc32 field */
+#define BCI_MODEL_CRC_OFFSET (offsetof(bci_model_t, crc32) + sizeof(uint32_t))
+
+/* Constant-variance features are left unscaled */
+#define BCI_MODEL_MIN_STD 1e-12f
+
+/* ========== CRC-32 ========== */
+
+static uint32_t model_crc(const bci_model_t *model) {
+    return crc32_update(0, (const unsigned char*)model + BCI_MODEL_CRC_OFFSET,
+                        sizeof(bci_model_t) - BCI_MODEL_CRC_OFFSET);
+}
+
+/* ========== Building ========== */
+
+void bci_model_init(bci_model_t *model, size_t num_features) {
+    memset(model, 0, sizeof(*model));
+
+    if (num_features > LDA_MAX_FEATURES) {
+        log_error("Models support at most %d features, got %zu", LDA_MAX_FEATURES, num_features);
+        num_features = LDA_MAX_FEATURES;
+    }
+
+    model->magic = BCI_MODEL_MAGIC;
+    model->version = BCI_MODEL_VERSION;
+    model->size = sizeof(bci_model_t);
+    model->sample_rate = SAMPLING_RATE;
+    model->window_size = WINDOW_SIZE;
+    model->num_features = (uint32_t)num_features;
+    model->num_bands = NUM_BANDS;
+    memcpy(model->bands, eeg_bands, sizeof(eeg_bands));
+    for (size_t i = 0; i < LDA_MAX_FEATURES; i++) {
+        model->feature_inv_std[i] = 1.0f;
+    }
+    model->thresholds = classifier_default_thresholds;
+}
+
+void bci_model_fit_normalization(bci_model_t *model, const signal_t *rows, size_t num_rows) {
+    size_t n = model->num_features;
+    double mean[LDA_MAX_FEATURES] = { 0 };
+    double m2[LDA_MAX_FEATURES] = { 0 };
+
+    if (num_rows < 2) {
+        return;
+    }
+
+    /* Welford: one pass, no cancellation on large feature offsets */
+    for (size_t r = 0; r < num_rows; r++) {
+        const signal_t *x = &rows[r * n];
+        for (size_t i = 0; i < n; i++) {
+            double delta = x[i] - mean[i];
+            mean[i] += delta / (double)(r + 1);
+            m2[i] += delta * (x[i] - mean[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        float std_dev = (float)sqrt(m2[i] / (double)(num_rows - 1));
+        model->feature_mean[i] = (float)mean[i];
+        model->feature_inv_std[i] = (std_dev > BCI_MODEL_MIN_STD) ? 1.0f / std_dev : 1.0f;
+    }
+}
+
+bool_t bci_model_set_binary(bci_model_t *model, const lda_model_t *lda) {
+    if (lda == NULL || !lda->is_trained || lda->num_features != model->num_features) {
+        log_error("Binary LDA does not match the model's %u features", (unsigned)model->num_features);
+        return FALSE;
+    }
+
+    memset(model->projection, 0, sizeof(model->projection));
+    memcpy(model->projection, lda->projection, lda->num_features * sizeof(float));
+    model->threshold = lda->threshold;
+    model->flags |= BCI_MODEL_HAS_BINARY;
+    return TRUE;
+}
+
+bool_t bci_model_set_multiclass(bci_model_t *model, const lda_multiclass_t *lda) {
+    if (lda == NULL || !lda->is_trained || lda->num_features != model->num_features) {
+        log_error("Multi-class LDA does not match the model's %u features",
+                  (unsigned)model->num_features);
+        return FALSE;
+    }
+
+    memcpy(model->weights, lda->weights, sizeof(model->weights));
+    memcpy(model->bias, lda->bias, sizeof(model->bias));
+    model->num_classes = (uint32_t)lda->num_classes;
+    model->flags |= BCI_MODEL_HAS_MULTICLASS;
+    return TRUE;
+}
+
+void bci_model_seal(bci_model_t *model) {
+    model->size = sizeof(bci_model_t);
+    model->crc32 = model_crc(model);
+}
+
+bool_t bci_model_save(bci_model_t *model, const char *filepath) {
+    bci_model_seal(model);
+
+    FILE *fp = fopen(filepath, "wb");
+    if (fp == NULL) {
+        log_error("Could not create model file %s", filepath);
+        return FALSE;
+    }
+
+    bool_t ok = (fwrite(model, sizeof(*model), 1, fp) == 1) ? TRUE : FALSE;
+    if (fclose(fp) != 0) {
+        ok = FALSE;
+    }
+    if (!ok) {
+        log_error("Failed to write model file %s", filepath);
+    }
+    return ok;
+}
+
+/* ========== Loading ========== */
+
+const bci_model_t* bci_model_view(const void *data, size_t size) {
+    const bci_model_t *model = (const bci_model_t*)data;
+
+    if (data == NULL || size < sizeof(bci_model_t)) {
+        log_error("Model blob too short (%zu bytes)", size);
+        return NULL;
+    }
+    if (((uintptr_t)data % sizeof(uint32_t)) != 0) {
+        log_error("Model blob must be 4-byte aligned");
+        return NULL;
+    }
+    if (!host_is_little_endian()) {
+        log_error("Model blobs are little-endian");
+        return NULL;
+    }
+    if (model->magic != BCI_MODEL_MAGIC || model->version != BCI_MODEL_VERSION ||
+        model->size != sizeof(bci_model_t)) {
+        log_error("Not a version %u model blob", BCI_MODEL_VERSION);
+        return NULL;
+    }
+    if (model->crc32 != model_crc(model)) {
+        log_error("Model blob CRC mismatch");
+        return NULL;
+    }
+    if (model->num_features == 0 || model->num_features > LDA_MAX_FEATURES ||
+        model->num_classes > LDA_MAX_CLASSES || model->num_bands > BCI_MODEL_MAX_BANDS ||
+        ((model->flags & BCI_MODEL_HAS_MULTICLASS) && model->num_classes < 2)) {
+        log_error("Model blob has bad section sizes");
+        return NULL;
+    }
+    /* Features computed at another rate or window length mean something else */
+    if (model->sample_rate != SAMPLING_RATE || model->window_size != WINDOW_SIZE) {
+        log_error("Model trained at %.0f Hz / %u samples, build uses %d Hz / %d",
+                  model->sample_rate, (unsigned)model->window_size, SAMPLING_RATE, WINDOW_SIZE);
+        return NULL;
+    }
+    /* So are band powers over other bands: the FFT bin tables and filter
+     * bank are built for eeg_bands */
+    if (model->num_bands != NUM_BANDS ||
+        memcmp(model->bands, eeg_bands, sizeof(eeg_bands)) != 0) {
+        log_error("Model trained on other frequency bands than this build's");
+        return NULL;
+    }
+
+    return model;
+}
+
+bool_t bci_model_open(bci_model_file_t *file, const char *filepath) {
+    file->model = NULL;
+    if (!mapped_file_open(&file->file, filepath)) {
+        return FALSE;
+    }
+
+    file->model = bci_model_view(file->file.data, file->file.size);
+    if (file->model == NULL) {
+        log_error("%s: unusable model file", filepath);
+        mapped_file_close(&file->file);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void bci_model_close(bci_model_file_t *file) {
+    mapped_file_close(&file->file);
+    file->model = NULL;
+}
+
+/* ========== Inference ========== */
+
+void bci_model_apply_thresholds(const bci_model_t *model, classifier_state_t *state) {
+    classifier_set_thresholds(state, &model->thresholds);
+}
+
+void bci_model_normalize(const bci_model_t *model, const signal_t *features, signal_t *normalized) {
+    for (size_t i = 0; i < model->num_features; i++) {
+        normalized[i] = (features[i] - model->feature_mean[i]) * model->feature_inv_std[i];
+    }
+}
+
+int bci_model_predict_binary(const bci_model_t *model, const signal_t *features) {
+    if (!(model->flags & BCI_MODEL_HAS_BINARY)) {
+        return -1;
+    }
+
+    float projection = 0.0f;
+    for (size_t i = 0; i < model->num_features; i++) {
+        float x = (features[i] - model->feature_mean[i]) * model->feature_inv_std[i];
+        projection += model->projection[i] * x;
+    }
+    return (projection >= model->threshold) ? 1 : 0;
+}
+
+int bci_model_classify(const bci_model_t *model, const signal_t *features, float *scores) {
+    float x[LDA_MAX_FEATURES];
+    float local[LDA_MAX_CLASSES];
+    float *out = (scores != NULL) ? scores : local;
+    int best = 0;
+
+    if (!(model->flags & BCI_MODEL_HAS_MULTICLASS)) {
+        return -1;
+    }
+
+    bci_model_normalize(model, features, x);
+    for (size_t c = 0; c < model->num_classes; c++) {
+        float score = model->bias[c];
+        for (size_t i = 0; i < model->num_features; i++) {
+            score += model->weights[c][i] * x[i];
+        }
+        out[c] = score;
+        if (score > out[best]) {
+            best = (int)c;
+        }
+    }
+    return best;
+}
@@ -1,11 +1,37 @@
 #include "classifier.h"
 #include "utils.h"
 #include <stdio.h>
+#include <string.h>
+
+const classifier_thresholds_t classifier_default_thresholds = {
+    FOCUS_THRESHOLD,
+    RELAX_THRESHOLD,
+    BLINK_THRESHOLD,
+    DEBOUNCE_COUNT,
+    VISUAL_ALPHA_NORMAL,
+    VISUAL_ALPHA_BORDERLINE,
+    MOTOR_BETA_NORMAL,
+    MOTOR_BETA_BORDERLINE,
+    ATTENTION_RATIO_NORMAL,
+    ATTENTION_RATIO_BORDER
+};
 
 void classifier_init(classifier_state_t *state) {
     state->last_command = CMD_NONE;
     state->debounce_counter = 0;
     state->baseline_amplitude = 1.0f;
+    state->baseline_amplitude_q15 = FIXED_SIGMA;  /* 1.0 sigma */
+    classifier_set_thresholds(state, &classifier_default_thresholds);
+}
+
+void classifier_set_thresholds(classifier_state_t *state,
+                               const classifier_thresholds_t *thresholds) {
+    state->thresholds = thresholds;
+    
+    /* Converted once here so classify_command_q15 stays integer-only */
+    state->focus_q15 = Q15_FROM_FLOAT(thresholds->focus);
+    state->relax_q15 = Q15_FROM_FLOAT(thresholds->relax);
+    state->blink_q8 = (q31_t)(thresholds->blink * 256.0f);
 }
 
 void update_baseline(classifier_state_t *state, signal_t amplitude) {
@@ -14,32 +40,39 @@ void update_baseline(classifier_state_t *state, signal_t amplitude) {
     state->baseline_amplitude = alpha * amplitude + (1.0f - alpha) * state->baseline_amplitude;
 }
 
+/* Debouncing logic: require consistent detection
+ * Returns: TRUE once detected has been seen debounce_count times in a row
+ */
+static bool_t debounce_command(classifier_state_t *state, command_t detected) {
+    if (detected == state->last_command) {
+        state->debounce_counter++;
+    } else {
+        state->debounce_counter = 1;
+        state->last_command = detected;
+    }
+    
+    return (state->debounce_counter >= state->thresholds->debounce_count) ? TRUE : FALSE;
+}
+
 command_t classify_command(const features_t *features, classifier_state_t *state) {
+    const classifier_thresholds_t *thresholds = state->thresholds;
     command_t detected_command = CMD_NONE;
     
     /* Priority 1: Check for blink artifact (highest priority) */
-    if (features->peak_amplitude > BLINK_THRESHOLD * state->baseline_amplitude) {
+    if (features->peak_amplitude > thresholds->blink * state->baseline_amplitude) {
         detected_command = CMD_BLINK;
     }
     /* Priority 2: Check for focus (high beta activity) */
-    else if (features->beta_power > FOCUS_THRESHOLD) {
+    else if (features->beta_power > thresholds->focus) {
         detected_command = CMD_FOCUS;
     }
     /* Priority 3: Check for relax (high alpha activity) */
-    else if (features->alpha_power > RELAX_THRESHOLD) {
+    else if (features->alpha_power > thresholds->relax) {
         detected_command = CMD_RELAX;
     }
     
-    /* Debouncing logic: require consistent detection */
-    if (detected_command == state->last_command) {
-        state->debounce_counter++;
-    } else {
-        state->debounce_counter = 1;
-        state->last_command = detected_command;
-    }
-    
-    /* Only return command if it's been stable for DEBOUNCE_COUNT samples */
-    if (state->debounce_counter >= DEBOUNCE_COUNT) {
+    /* Only return command if it's been stable for debounce_count samples */
+    if (debounce_command(state, detected_command)) {
         /* Update baseline with current amplitude (if not a blink) */
         if (detected_command != CMD_BLINK) {
             update_baseline(state, features->peak_amplitude);
@@ -50,6 +83,34 @@ command_t classify_command(const features_t *features, classifier_state_t *state
     return CMD_NONE;
 }
 
+command_t classify_command_q15(const features_q15_t *features, classifier_state_t *state) {
+    command_t detected_command = CMD_NONE;
+    
+    /* Same priorities as classify_command; the blink threshold is a Q8
+     * multiplier converted by classifier_set_thresholds (no float here) */
+    if ((q31_t)features->peak_amplitude * 256 >
+        state->blink_q8 * state->baseline_amplitude_q15) {
+        detected_command = CMD_BLINK;
+    }
+    else if (features->beta_power > state->focus_q15) {
+        detected_command = CMD_FOCUS;
+    }
+    else if (features->alpha_power > state->relax_q15) {
+        detected_command = CMD_RELAX;
+    }
+    
+    if (debounce_command(state, detected_command)) {
+        if (detected_command != CMD_BLINK) {
+            /* Same exponential moving average as update_baseline (alpha = 0.1) */
+            q31_t delta = features->peak_amplitude - state->baseline_amplitude_q15;
+            state->baseline_amplitude_q15 += (q15_t)((delta * Q15_FROM_FLOAT(0.1f)) >> 15);
+        }
+        return detected_command;
+    }
+    
+    return CMD_NONE;
+}
+
 const char* command_to_string(command_t cmd) {
     switch (cmd) {
         case CMD_FOCUS: return "FOCUS";
@@ -61,13 +122,18 @@ const char* command_to_string(command_t cmd) {
 }
 
 void predict_impairments(const features_t *features, predictions_t *predictions) {
+    predict_impairments_with(&classifier_default_thresholds, features, predictions);
+}
+
+void predict_impairments_with(const classifier_thresholds_t *thresholds,
+                              const features_t *features, predictions_t *predictions) {
     /* Visual Impairment Detection
      * Based on alpha power in occipital lobe
      * Low alpha during relaxed states indicates visual processing issues
      */
-    if (features->alpha_power >= VISUAL_ALPHA_NORMAL) {
+    if (features->alpha_power >= thresholds->visual_alpha_normal) {
         predictions->visual_impairment = PRED_NORMAL;
-    } else if (features->alpha_power >= VISUAL_ALPHA_BORDERLINE) {
+    } else if (features->alpha_power >= thresholds->visual_alpha_borderline) {
         predictions->visual_impairment = PRED_BORDERLINE;
     } else {
         predictions->visual_impairment = PRED_IMPAIRED;
@@ -77,9 +143,9 @@ void predict_impairments(const features_t *features, predictions_t *predictions)
      * Based on beta/mu rhythm in motor cortex
      * Abnormal beta power indicates motor control issues
      */
-    if (features->beta_power >= MOTOR_BETA_NORMAL) {
+    if (features->beta_power >= thresholds->motor_beta_normal) {
         predictions->motor_impairment = PRED_NORMAL;
-    } else if (features->beta_power >= MOTOR_BETA_BORDERLINE) {
+    } else if (features->beta_power >= thresholds->motor_beta_borderline) {
         predictions->motor_impairment = PRED_BORDERLINE;
     } else {
         predictions->motor_impairment = PRED_IMPAIRED;
@@ -96,9 +162,9 @@ void predict_impairments(const features_t *features, predictions_t *predictions)
         theta_beta_ratio = 10.0f;  /* Very high ratio if beta is negligible */
     }
     
-    if (theta_beta_ratio <= ATTENTION_RATIO_NORMAL) {
+    if (theta_beta_ratio <= thresholds->attention_ratio_normal) {
         predictions->attention_deficit = PRED_NORMAL;
-    } else if (theta_beta_ratio <= ATTENTION_RATIO_BORDER) {
+    } else if (theta_beta_ratio <= thresholds->attention_ratio_border) {
         predictions->attention_deficit = PRED_BORDERLINE;
     } else {
         predictions->attention_deficit = PRED_IMPAIRED;
@@ -113,3 +179,115 @@ const char* prediction_to_string(prediction_t pred) {
         default:              return "UNKNOWN";
     }
 }
+
+/* ========== Batch Impairment Scoring ========== */
+
+/* Grading rule for one metric, oriented so that larger is healthier:
+ * NORMAL while sign * value >= sign * normal, BORDERLINE while it is
+ * >= sign * borderline, IMPAIRED otherwise (sign = -1 for ratios where
+ * lower is healthier; negation is exact, so grades match the scalar code) */
+typedef struct {
+    float sign;
+    float normal;
+    float borderline;
+} grade_rule_t;
+
+static void build_grade_rules(const classifier_thresholds_t *thresholds,
+                              grade_rule_t rules[NUM_IMPAIRMENT_METRICS]) {
+    rules[IMPAIRMENT_VISUAL] = (grade_rule_t){ 1.0f, thresholds->visual_alpha_normal,
+                                               thresholds->visual_alpha_borderline };
+    rules[IMPAIRMENT_MOTOR] = (grade_rule_t){ 1.0f, thresholds->motor_beta_normal,
+                                              thresholds->motor_beta_borderline };
+    rules[IMPAIRMENT_ATTENTION] = (grade_rule_t){ -1.0f, -thresholds->attention_ratio_normal,
+                                                  -thresholds->attention_ratio_border };
+}
+
+/* Grade count values into grades (may be a scratch block) and count the
+ * BORDERLINE and IMPAIRED ones. Comparisons only: !(x >= t) also sends NaN
+ * to IMPAIRED, as the if/else chain does */
+static void grade_block(const grade_rule_t *rule, const signal_t *values, size_t count,
+                        prediction_t *grades, size_t *borderline, size_t *impaired) {
+    uint32_t num_borderline = 0;
+    uint32_t num_impaired = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        float x = rule->sign * values[i];
+        uint32_t below_normal = !(x >= rule->normal);
+        uint32_t below_borderline = !(x >= rule->borderline);
+        uint32_t grade = below_normal * (1u + below_borderline);
+        grades[i] = (prediction_t)grade;
+        num_borderline += (grade == PRED_BORDERLINE);
+        num_impaired += (grade == PRED_IMPAIRED);
+    }
+    
+    *borderline += num_borderline;
+    *impaired += num_impaired;
+}
+
+void impairment_stats_init(impairment_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+float impairment_fraction(const impairment_stats_t *stats, impairment_metric_t metric,
+                          prediction_t grade) {
+    if (stats->num_windows == 0 || metric >= NUM_IMPAIRMENT_METRICS || grade > PRED_IMPAIRED) {
+        return 0.0f;
+    }
+    return (float)stats->counts[metric][grade] / (float)stats->num_windows;
+}
+
+void predict_impairments_batch(const classifier_thresholds_t *thresholds,
+                               const band_power_batch_t *batch,
+                               const prediction_batch_t *predictions,
+                               impairment_stats_t *stats) {
+    grade_rule_t rules[NUM_IMPAIRMENT_METRICS];
+    signal_t ratio[IMPAIRMENT_BLOCK_SIZE];
+    prediction_t scratch[NUM_IMPAIRMENT_METRICS][IMPAIRMENT_BLOCK_SIZE];
+    size_t borderline[NUM_IMPAIRMENT_METRICS] = { 0 };
+    size_t impaired[NUM_IMPAIRMENT_METRICS] = { 0 };
+    
+    build_grade_rules(thresholds, rules);
+    
+    for (size_t start = 0; start < batch->count; start += IMPAIRMENT_BLOCK_SIZE) {
+        size_t n = batch->count - start;
+        if (n > IMPAIRMENT_BLOCK_SIZE) {
+            n = IMPAIRMENT_BLOCK_SIZE;
+        }
+        
+        /* Theta/beta ratio, 10 when beta is negligible. Two select loops:
+         * with the select and the division in one loop GCC keeps a branch */
+        const signal_t *theta = &batch->theta_power[start];
+        const signal_t *beta = &batch->beta_power[start];
+        for (size_t i = 0; i < n; i++) {
+            signal_t divisor = (beta[i] > 0.01f) ? beta[i] : 1.0f;
+            ratio[i] = theta[i] / divisor;
+        }
+        for (size_t i = 0; i < n; i++) {
+            ratio[i] = (beta[i] > 0.01f) ? ratio[i] : 10.0f;
+        }
+        
+        const signal_t *values[NUM_IMPAIRMENT_METRICS] = {
+            &batch->alpha_power[start], beta, ratio
+        };
+        prediction_t *outputs[NUM_IMPAIRMENT_METRICS] = { NULL, NULL, NULL };
+        if (predictions != NULL) {
+            outputs[IMPAIRMENT_VISUAL] = &predictions->visual[start];
+            outputs[IMPAIRMENT_MOTOR] = &predictions->motor[start];
+            outputs[IMPAIRMENT_ATTENTION] = &predictions->attention[start];
+        }
+        
+        for (size_t m = 0; m < NUM_IMPAIRMENT_METRICS; m++) {
+            prediction_t *grades = (outputs[m] != NULL) ? outputs[m] : scratch[m];
+            grade_block(&rules[m], values[m], n, grades, &borderline[m], &impaired[m]);
+        }
+    }
+    
+    if (stats != NULL) {
+        for (size_t m = 0; m < NUM_IMPAIRMENT_METRICS; m++) {
+            stats->counts[m][PRED_NORMAL] += batch->count - borderline[m] - impaired[m];
+            stats->counts[m][PRED_BORDERLINE] += borderline[m];
+            stats->counts[m][PRED_IMPAIRED] += impaired[m];
+        }
+        stats->num_windows += batch->count;
+    }
+}
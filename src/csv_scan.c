@@ -0,0 +1,149 @@
+#include "csv_scan.h"
+#include <string.h>
+#include <stdint.h>
+
+/* Exact powers of ten in double precision */
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define MAX_EXACT_POWER 22
+
+/* Mantissa digits kept; later digits cannot change a float result */
+#define MAX_MANTISSA_DIGITS 19
+
+static int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+const char* csv_scan_float(const char *p, const char *end, float *value) {
+    const char *start = p;
+    bool_t negative = FALSE;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool_t any_digit = FALSE;
+
+    *value = 0.0f;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-') ? TRUE : FALSE;
+        p++;
+    }
+
+    /* Integer part: digits past the mantissa limit only shift the scale */
+    for (; p < end && is_digit(*p); p++) {
+        any_digit = TRUE;
+        if (digits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digits += (mantissa != 0) ? 1 : 0;
+        } else {
+            exponent++;
+        }
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        for (; p < end && is_digit(*p); p++) {
+            any_digit = TRUE;
+            if (digits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                digits += (mantissa != 0) ? 1 : 0;
+                exponent--;
+            }
+        }
+    }
+
+    if (!any_digit) {
+        return start;
+    }
+
+    /* Exponent, only if digits follow (so "1e" parses as 1 followed by "e") */
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool_t negative_exponent = FALSE;
+        if (q < end && (*q == '-' || *q == '+')) {
+            negative_exponent = (*q == '-') ? TRUE : FALSE;
+            q++;
+        }
+        if (q < end && is_digit(*q)) {
+            int e = 0;
+            for (; q < end && is_digit(*q); q++) {
+                if (e < 10000) {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            exponent += negative_exponent ? -e : e;
+            p = q;
+        }
+    }
+
+    /* One rounding in double, one to float: correctly rounded for the short
+     * fixed-point values recordings contain */
+    double result = (double)mantissa;
+    while (exponent > MAX_EXACT_POWER) {
+        result *= powers_of_ten[MAX_EXACT_POWER];
+        exponent -= MAX_EXACT_POWER;
+    }
+    while (exponent < -MAX_EXACT_POWER) {
+        result /= powers_of_ten[MAX_EXACT_POWER];
+        exponent += MAX_EXACT_POWER;
+    }
+    result = (exponent >= 0) ? result * powers_of_ten[exponent]
+                             : result / powers_of_ten[-exponent];
+
+    *value = (float)(negative ? -result : result);
+    return p;
+}
+
+const char* csv_skip_field(const char *p, const char *end) {
+    while (p < end && *p != ',' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+const char* csv_next_line(const char *p, const char *end) {
+    const char *newline = (p < end) ? (const char*)memchr(p, '\n', (size_t)(end - p)) : NULL;
+    return (newline != NULL) ? newline + 1 : end;
+}
+
+size_t csv_count_newlines(const char *data, size_t size) {
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+    const uint64_t newlines = ones * '\n';
+    size_t count = 0;
+    size_t i = 0;
+
+    /* Head bytes up to an 8-byte boundary */
+    for (; i < size && ((uintptr_t)(data + i) & 7) != 0; i++) {
+        count += (data[i] == '\n');
+    }
+
+    /* SWAR: a byte of x is zero exactly where the input byte is '\n'; the
+     * high bit of each zero byte survives ~(((x & 0x7F..) + 0x7F..) | x | 0x7F..),
+     * and the multiply sums those bits into the top byte */
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        uint64_t x = word ^ newlines;
+        uint64_t zero_bytes = ~(((x & low7) + low7) | x | low7);
+        count += (size_t)(((zero_bytes >> 7) * ones) >> 56);
+    }
+
+    for (; i < size; i++) {
+        count += (data[i] == '\n');
+    }
+
+    return count;
+}
+
+size_t csv_count_rows(const char *data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    size_t lines = csv_count_newlines(data, size) + ((data[size - 1] != '\n') ? 1 : 0);
+    return (lines > 0) ? lines - 1 : 0;
+}
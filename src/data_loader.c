@@ -1,7 +1,10 @@
 #include "data_loader.h"
 #include "utils.h"
+#include "mapped_file.h"
+#include "csv_scan.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 /* Global data configuration */
 static data_config_t g_data_config;
@@ -63,13 +66,84 @@ command_t parse_command_string(const char *cmd_str) {
     }
 }
 
+/* Locate the amplitude columns ("chN", or "amplitude") and the command column
+ * in a header line
+ * Returns: Number of channel columns found (at most MAX_CHANNELS)
+ */
+static size_t parse_header_columns(char *header, int *channel_columns, int *command_column) {
+    size_t num_channels = 0;
+    int column = 0;
+    
+    *command_column = -1;
+    /* Split in place without strtok, which is not reentrant */
+    for (char *name = header; *name != '\0'; column++) {
+        char *end = name + strcspn(name, ",\r\n");
+        char separator = *end;
+        *end = '\0';
+        while (*name == ' ') {
+            name++;
+        }
+        
+        bool_t is_channel = (name[0] == 'c' && name[1] == 'h' &&
+                             name[2] >= '0' && name[2] <= '9') ||
+                            strcmp(name, "amplitude") == 0;
+        
+        if (is_channel && num_channels < MAX_CHANNELS) {
+            channel_columns[num_channels++] = column;
+        } else if (strcmp(name, "command") == 0) {
+            *command_column = column;
+        }
+        
+        if (separator != ',') {
+            break;
+        }
+        name = end + 1;
+    }
+    
+    return num_channels;
+}
+
+/* Parse a command label at p (up to the next separator or whitespace) */
+static command_t scan_command(const char *p, const char *end) {
+    char cmd_str[32];
+    size_t length = 0;
+    
+    while (p < end && *p == ' ') {
+        p++;
+    }
+    while (p < end && length < sizeof(cmd_str) - 1 &&
+           *p != ',' && *p != '\n' && *p != '\r' && *p != ' ') {
+        cmd_str[length++] = *p++;
+    }
+    cmd_str[length] = '\0';
+    
+    return (length > 0) ? parse_command_string(cmd_str) : CMD_NONE;
+}
+
+/* Copy the header line of a mapped CSV into a writable, terminated buffer
+ * Returns: Pointer to the first data row
+ */
+static const char* copy_header_line(const mapped_file_t *file, char *header, size_t capacity) {
+    const char *end = file->data + file->size;
+    const char *next = csv_next_line(file->data, end);
+    size_t length = (size_t)(next - file->data);
+    
+    if (length >= capacity) {
+        length = capacity - 1;
+    }
+    memcpy(header, file->data, length);
+    header[length] = '\0';
+    
+    return next;
+}
+
 bool_t get_dataset_info(const char *filepath, dataset_info_t *info) {
     if (filepath == NULL || info == NULL) {
         return FALSE;
     }
     
-    FILE *fp = fopen(filepath, "r");
-    if (fp == NULL) {
+    mapped_file_t file;
+    if (!mapped_file_open(&file, filepath)) {
         return FALSE;
     }
     
@@ -80,77 +154,359 @@ bool_t get_dataset_info(const char *filepath, dataset_info_t *info) {
     info->sampling_rate = SAMPLING_RATE;
     info->has_labels = FALSE;
     
-    char line[512];
-    
-    /* Read header line */
-    if (fgets(line, sizeof(line), fp) != NULL) {
+    if (file.size > 0) {
+        char header[MAX_CSV_LINE_LENGTH];
+        int channel_columns[MAX_CHANNELS];
+        int command_column;
+        
+        copy_header_line(&file, header, sizeof(header));
+        size_t channels = parse_header_columns(header, channel_columns, &command_column);
+        
+        if (channels > 0) {
+            info->num_channels = channels;
+        }
         /* Check if has command column */
-        if (strstr(line, "command") != NULL) {
+        if (command_column >= 0) {
             info->has_labels = TRUE;
         }
+        
+        /* Count samples a word at a time instead of reading every line */
+        info->num_samples = csv_count_rows(file.data, file.size);
     }
     
-    /* Count samples */
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        info->num_samples++;
+    mapped_file_close(&file);
+    return TRUE;
+}
+
+/* Header names of the known columns, indexed by dataset_column_t */
+static const char *const column_names[NUM_DATASET_COLUMNS] = {
+    "time", "amplitude", "theta_power", "alpha_power",
+    "beta_power", "gamma_power", "command"
+};
+
+/* Where each numeric column lands in eeg_sample_t (command is handled apart) */
+static const size_t column_offsets[NUM_DATASET_COLUMNS] = {
+    offsetof(eeg_sample_t, time),
+    offsetof(eeg_sample_t, amplitude),
+    offsetof(eeg_sample_t, theta_power),
+    offsetof(eeg_sample_t, alpha_power),
+    offsetof(eeg_sample_t, beta_power),
+    offsetof(eeg_sample_t, gamma_power),
+    0
+};
+
+bool_t parse_column_map(const char *header, size_t length, column_map_t *map) {
+    const char *end = header + length;
+    const char *name = header;
+    
+    for (int c = 0; c < NUM_DATASET_COLUMNS; c++) {
+        map->field[c] = -1;
     }
+    map->num_fields = 0;
     
-    fclose(fp);
-    return TRUE;
+    while (name < end && *name != '\n') {
+        const char *field_end = csv_skip_field(name, end);
+        const char *name_end = field_end;
+        
+        while (name < name_end && *name == ' ') {
+            name++;
+        }
+        while (name_end > name && (name_end[-1] == ' ' || name_end[-1] == '\r')) {
+            name_end--;
+        }
+        size_t name_length = (size_t)(name_end - name);
+        
+        for (int c = 0; c < NUM_DATASET_COLUMNS && map->num_fields < MAX_CSV_FIELDS; c++) {
+            if (map->field[c] < 0 && strlen(column_names[c]) == name_length &&
+                memcmp(column_names[c], name, name_length) == 0) {
+                map->field[c] = map->num_fields;
+                break;
+            }
+        }
+        
+        map->num_fields++;
+        if (field_end >= end || *field_end != ',') {
+            break;
+        }
+        name = field_end + 1;
+    }
+    
+    return map->field[COLUMN_AMPLITUDE] >= 0;
+}
+
+void column_map_legacy(column_map_t *map) {
+    map->field[COLUMN_TIME] = 0;
+    map->field[COLUMN_AMPLITUDE] = 1;
+    map->field[COLUMN_THETA] = -1;
+    map->field[COLUMN_ALPHA] = 2;
+    map->field[COLUMN_BETA] = 3;
+    map->field[COLUMN_GAMMA] = -1;
+    map->field[COLUMN_COMMAND] = 4;
+    map->num_fields = 5;
 }
 
 bool_t load_dataset_csv(const char *filepath, eeg_sample_t *samples, 
                         size_t max_samples, size_t *num_loaded) {
+    return load_dataset_columns(filepath, samples, max_samples, COLUMNS_ALL, num_loaded);
+}
+
+bool_t load_dataset_columns(const char *filepath, eeg_sample_t *samples,
+                            size_t max_samples, unsigned int columns,
+                            size_t *num_loaded) {
     if (filepath == NULL || samples == NULL || num_loaded == NULL) {
         return FALSE;
     }
+    *num_loaded = 0;
     
-    FILE *fp = fopen(filepath, "r");
-    if (fp == NULL) {
-        log_error("Failed to open dataset file: %s", filepath);
+    dataset_reader_t reader;
+    if (!dataset_reader_open(&reader, filepath, columns)) {
         return FALSE;
     }
     
-    char line[512];
-    size_t sample_count = 0;
+    size_t sample_count = dataset_reader_next_chunk(&reader, samples, max_samples);
+    if (reader.cursor < reader.file.data + reader.file.size) {
+        log_info("%s: stopped at %zu samples; use dataset_reader_t for longer recordings",
+                 filepath, sample_count);
+    }
+    dataset_reader_close(&reader);
+    *num_loaded = sample_count;
+    
+    log_info("Loaded %zu samples from %s", sample_count, filepath);
     
-    /* Skip header line */
-    if (fgets(line, sizeof(line), fp) == NULL) {
-        fclose(fp);
+    return sample_count > 0;
+}
+
+bool_t load_multichannel_csv(const char *filepath, eeg_frame_t *frame,
+                             command_t *labels, size_t *num_loaded) {
+    if (filepath == NULL || frame == NULL || frame->data == NULL || num_loaded == NULL) {
         return FALSE;
     }
+    *num_loaded = 0;
     
-    /* Read data lines */
-    while (fgets(line, sizeof(line), fp) != NULL && sample_count < max_samples) {
-        eeg_sample_t *sample = &samples[sample_count];
-        char cmd_str[32];
-        
-        /* Parse CSV line: time,amplitude,alpha_power,beta_power,command */
-        int fields = sscanf(line, "%f,%f,%f,%f,%31s",
-                           &sample->time,
-                           &sample->amplitude,
-                           &sample->alpha_power,
-                           &sample->beta_power,
-                           cmd_str);
+    dataset_reader_t reader;
+    if (!dataset_reader_open(&reader, filepath, COLUMNS_ALL)) {
+        return FALSE;
+    }
+    
+    if (reader.num_channels != frame->num_channels) {
+        log_error("%s has %zu channels, frame expects %zu",
+                  filepath, reader.num_channels, frame->num_channels);
+        dataset_reader_close(&reader);
+        return FALSE;
+    }
+    
+    size_t sample_count = dataset_reader_next_frame(&reader, frame, labels);
+    dataset_reader_close(&reader);
+    *num_loaded = sample_count;
+    
+    log_info("Loaded %zu samples x %zu channels from %s",
+             sample_count, frame->num_channels, filepath);
+    
+    return sample_count > 0;
+}
+
+/* ========== Chunked Reader ========== */
+
+bool_t dataset_reader_open(dataset_reader_t *reader, const char *filepath,
+                           unsigned int columns) {
+    if (reader == NULL || filepath == NULL) {
+        return FALSE;
+    }
+    memset(reader, 0, sizeof(*reader));
+    
+    if (!mapped_file_open(&reader->file, filepath)) {
+        log_error("Failed to open dataset file: %s", filepath);
+        return FALSE;
+    }
+    
+    if (reader->file.size == 0) {
+        mapped_file_close(&reader->file);
+        return FALSE;
+    }
+    
+    char header[MAX_CSV_LINE_LENGTH];
+    const char *first_row = copy_header_line(&reader->file, header, sizeof(header));
+    
+    /* Parse the header once; rows are then routed by field index alone */
+    column_map_t map;
+    /* Read-only use of the configuration (defaults if never initialized), so
+     * worker threads can open readers concurrently */
+    bool_t auto_detect = g_initialized ? g_data_config.auto_detect_format : TRUE;
+    if (!auto_detect) {
+        column_map_legacy(&map);
+    } else if (!parse_column_map(reader->file.data,
+                                 (size_t)(first_row - reader->file.data), &map)) {
+        log_info("%s: no amplitude column in header, assuming fixed layout", filepath);
+        column_map_legacy(&map);
+    }
+    
+    memset(reader->field_column, -1, sizeof(reader->field_column));
+    reader->last_field = -1;
+    for (int c = 0; c < NUM_DATASET_COLUMNS; c++) {
+        int field = map.field[c];
+        if ((columns & COLUMN_BIT(c)) == 0 || field < 0) {
+            continue;
+        }
+        reader->field_column[field] = (signed char)c;
+        if (field > reader->last_field) {
+            reader->last_field = field;
+        }
+        if (c != COLUMN_COMMAND) {
+            reader->required |= COLUMN_BIT(c);
+        }
+    }
+    
+    reader->num_channels = parse_header_columns(header, reader->channel_columns,
+                                                &reader->command_column);
+    reader->cursor = first_row;
+    mapped_file_prefetch(&reader->file, (size_t)(first_row - reader->file.data),
+                         DATASET_PREFETCH_BYTES);
+    
+    return TRUE;
+}
+
+/* Called as a chunk is handed back: read ahead by about one chunk, so the
+ * next one is resident while the caller runs DSP on this one, and drop the
+ * pages already parsed */
+static void reader_advance(dataset_reader_t *reader, const char *chunk_start) {
+    size_t position = (size_t)(reader->cursor - reader->file.data);
+    size_t chunk_bytes = (size_t)(reader->cursor - chunk_start);
+    
+    mapped_file_prefetch(&reader->file, position,
+                         (chunk_bytes > DATASET_PREFETCH_BYTES) ? chunk_bytes : DATASET_PREFETCH_BYTES);
+    mapped_file_release(&reader->file, reader->released, position - reader->released);
+    reader->released = position;
+}
+
+/* Parse the projected fields of one row
+ * Returns: TRUE if every required numeric column parsed
+ */
+static bool_t parse_sample_row(const dataset_reader_t *reader, const char *line,
+                               const char *end, eeg_sample_t *sample) {
+    unsigned int parsed = 0;
+    const char *cursor = line;
+    
+    memset(sample, 0, sizeof(*sample));
+    sample->command = CMD_NONE;
+    
+    /* Walk fields up to the last projected one; the rest of the row is never touched */
+    for (int field = 0; field <= reader->last_field; field++) {
+        int column = reader->field_column[field];
         
-        if (fields >= 4) {
-            /* Parse command if present */
-            if (fields == 5) {
-                sample->command = parse_command_string(cmd_str);
-            } else {
-                sample->command = CMD_NONE;
+        if (column == COLUMN_COMMAND) {
+            sample->command = scan_command(cursor, end);
+        } else if (column >= 0) {
+            float value;
+            while (cursor < end && *cursor == ' ') {
+                cursor++;
             }
-            
+            if (csv_scan_float(cursor, end, &value) != cursor) {
+                *(float*)((char*)sample + column_offsets[column]) = value;
+                parsed |= COLUMN_BIT(column);
+            }
+        }
+        
+        cursor = csv_skip_field(cursor, end);
+        if (cursor >= end || *cursor != ',') {
+            break;
+        }
+        cursor++;
+    }
+    
+    return (parsed & reader->required) == reader->required;
+}
+
+size_t dataset_reader_next_chunk(dataset_reader_t *reader, eeg_sample_t *chunk,
+                                 size_t max_samples) {
+    if (reader == NULL || chunk == NULL || reader->file.data == NULL) {
+        return 0;
+    }
+    
+    const char *end = reader->file.data + reader->file.size;
+    const char *chunk_start = reader->cursor;
+    const char *line = reader->cursor;
+    size_t sample_count = 0;
+    
+    for (; line < end && sample_count < max_samples; line = csv_next_line(line, end)) {
+        /* Skip blank, short or malformed rows */
+        if (*line != '\n' && *line != '\r' &&
+            parse_sample_row(reader, line, end, &chunk[sample_count])) {
             sample_count++;
         }
     }
     
-    fclose(fp);
-    *num_loaded = sample_count;
+    reader->cursor = line;
+    reader->rows_read += sample_count;
+    reader_advance(reader, chunk_start);
     
-    log_info("Loaded %zu samples from %s", sample_count, filepath);
+    return sample_count;
+}
+
+size_t dataset_reader_next_frame(dataset_reader_t *reader, eeg_frame_t *frame,
+                                 command_t *labels) {
+    if (reader == NULL || frame == NULL || frame->data == NULL || reader->file.data == NULL ||
+        reader->num_channels == 0 || frame->num_channels != reader->num_channels) {
+        return 0;
+    }
     
-    return sample_count > 0;
+    const char *end = reader->file.data + reader->file.size;
+    const char *chunk_start = reader->cursor;
+    const char *line = reader->cursor;
+    const size_t channels = reader->num_channels;
+    size_t sample_count = 0;
+    
+    for (; sample_count < frame->length && line < end; line = csv_next_line(line, end)) {
+        size_t channel = 0;
+        command_t command = CMD_NONE;
+        int column = 0;
+        const char *cursor = line;
+        
+        /* Walk the fields once, routing channel values into their rows */
+        while (cursor < end && *cursor != '\n' && *cursor != '\r') {
+            if (channel < channels && column == reader->channel_columns[channel]) {
+                float value;
+                while (cursor < end && *cursor == ' ') {
+                    cursor++;
+                }
+                csv_scan_float(cursor, end, &value);
+                eeg_frame_channel(frame, channel)[sample_count] = value;
+                channel++;
+            } else if (column == reader->command_column) {
+                command = scan_command(cursor, end);
+            }
+            
+            cursor = csv_skip_field(cursor, end);
+            column++;
+            if (cursor >= end || *cursor != ',') {
+                break;
+            }
+            cursor++;
+        }
+        
+        /* Skip short or malformed rows */
+        if (channel < channels) {
+            continue;
+        }
+        
+        if (labels != NULL) {
+            labels[sample_count] = command;
+        }
+        sample_count++;
+    }
+    
+    reader->cursor = line;
+    reader->rows_read += sample_count;
+    reader_advance(reader, chunk_start);
+    
+    return sample_count;
+}
+
+void dataset_reader_close(dataset_reader_t *reader) {
+    if (reader == NULL) {
+        return;
+    }
+    mapped_file_close(&reader->file);
+    memset(reader, 0, sizeof(*reader));
 }
 
 void data_loader_cleanup(void) {
@@ -3,11 +3,18 @@
 #include "data_loader.h"
 #include "fft.h"
 #include "lda.h"
+#include "bci_model.h"
 #include "feature_extraction.h"
+#include "worker_pool.h"
+#include "scheduler.h"
+#include "telemetry.h"
 #include "utils.h"
 
 #define NUM_TRAIN_SAMPLES 50
 #define NUM_TEST_SAMPLES 10
+#define NUM_DEMO_FEATURES 4
+#define MODEL_PATH "data/bci_model.bin"
+#define TELEMETRY_PATH "data/realtime_stream.bct"
 
 /*
  * INTEGRATION DEMO
@@ -17,6 +24,11 @@
  * 2. Preprocessing: (Simulated here as clean data)
  * 3. Feature Extraction: Uses FFT to get Alpha/Beta power
  * 4. Classification: Uses LDA to predict FOCUS vs RELAX
+ *
+ * The trained model is saved to MODEL_PATH; later runs map it and start
+ * classifying immediately instead of retraining (delete it to retrain).
+ * The real-time loop streams binary telemetry to TELEMETRY_PATH for the
+ * visualizers (scripts/telemetry.py).
  */
 
 /* Helper: Generate Sine Wave */
@@ -42,63 +54,95 @@ int main(void) {
     data_loader_init(&config);
     fft_init();
     
-    lda_model_t lda_model;
-    lda_init(&lda_model, 4); /* 4 features: Alpha, Beta, Variance, Skewness */
-    
     printf("    ✓ Modules initialized\n\n");
     
-    /* 2. Generate Training Data */
-    printf("[2] Generating Training Data (Simulating loaded CSVs)...\n");
+    /* 2. Load the Stored Model, or Train One */
+    bci_model_file_t model_file = { 0 };
+    bci_model_t trained_model;
+    const bci_model_t *model = NULL;
     
-    lda_sample_t *samples = malloc(sizeof(lda_sample_t) * NUM_TRAIN_SAMPLES * 2);
-    for (int i = 0; i < NUM_TRAIN_SAMPLES; i++) {
-        signal_t signal_buffer[256];
-        
-        /* CLASS 0: RELAX (High Alpha - 10.5Hz) */
-        generate_sine_wave(signal_buffer, 256, 10.5f, 256.0f);
-        /* Apply same amplitude scaling as test data */
-        for(int k=0; k<256; k++) signal_buffer[k] *= 200.0f;
-        /* CRITICAL: Add same noise as test data for distribution match! */
-        for(int k=0; k<256; k++) signal_buffer[k] += ((rand()%100)/10.0f);
+    if (bci_model_open(&model_file, MODEL_PATH)) {
+        model = model_file.model;
+        printf("[2] Loaded model from %s (%zu bytes, no retraining)\n", MODEL_PATH, model_file.file.size);
+        printf("    ✓ Threshold: %.4f\n\n", model->threshold);
+    } else {
+        printf("[2] Generating Training Data (Simulating loaded CSVs)...\n");
         
-        features_t feat_relax;
-        extract_features(signal_buffer, 256, &feat_relax);
+        /* Rows of 4 features: Alpha, Beta, Variance, Skewness */
+        signal_t *rows = malloc(sizeof(signal_t) * NUM_TRAIN_SAMPLES * 2 * NUM_DEMO_FEATURES);
+        for (int i = 0; i < NUM_TRAIN_SAMPLES; i++) {
+            signal_t signal_buffer[256];
+            
+            /* CLASS 0: RELAX (High Alpha - 10.5Hz) */
+            generate_sine_wave(signal_buffer, 256, 10.5f, 256.0f);
+            /* Apply same amplitude scaling as test data */
+            for(int k=0; k<256; k++) signal_buffer[k] *= 200.0f;
+            /* CRITICAL: Add same noise as test data for distribution match! */
+            for(int k=0; k<256; k++) signal_buffer[k] += ((rand()%100)/10.0f);
+            
+            features_t feat_relax;
+            extract_features(signal_buffer, 256, &feat_relax);
+            
+            signal_t *relax_row = &rows[i * NUM_DEMO_FEATURES];
+            relax_row[0] = feat_relax.alpha_power;
+            relax_row[1] = feat_relax.beta_power;
+            relax_row[2] = feat_relax.variance;
+            relax_row[3] = feat_relax.skewness;
+            
+            /* CLASS 1: FOCUS (High Beta - 21.5Hz) */
+            generate_sine_wave(signal_buffer, 256, 21.5f, 256.0f);
+            /* Apply same amplitude scaling as test data */
+            for(int k=0; k<256; k++) signal_buffer[k] *= 200.0f;
+            /* CRITICAL: Add same noise as test data for distribution match! */
+            for(int k=0; k<256; k++) signal_buffer[k] += ((rand()%100)/10.0f);
+            
+            features_t feat_focus;
+            extract_features(signal_buffer, 256, &feat_focus);
+            
+            signal_t *focus_row = &rows[(NUM_TRAIN_SAMPLES + i) * NUM_DEMO_FEATURES];
+            focus_row[0] = feat_focus.alpha_power;
+            focus_row[1] = feat_focus.beta_power;
+            focus_row[2] = feat_focus.variance;
+            focus_row[3] = feat_focus.skewness;
+        }
+        printf("    ✓ Generated %d training samples\n\n", NUM_TRAIN_SAMPLES * 2);
         
-        samples[i].features = malloc(sizeof(signal_t) * 4);
-        samples[i].features[0] = feat_relax.alpha_power;
-        samples[i].features[1] = feat_relax.beta_power;
-        samples[i].features[2] = feat_relax.variance;
-        samples[i].features[3] = 0.0f;
-        samples[i].label = 0; // RELAX
+        /* 3. Train LDA Model on normalized features */
+        printf("[3] Training LDA Classifier...\n");
+        bci_model_init(&trained_model, NUM_DEMO_FEATURES);
+        bci_model_fit_normalization(&trained_model, rows, NUM_TRAIN_SAMPLES * 2);
         
-        /* CLASS 1: FOCUS (High Beta - 21.5Hz) */
-        generate_sine_wave(signal_buffer, 256, 21.5f, 256.0f);
-        /* Apply same amplitude scaling as test data */
-        for(int k=0; k<256; k++) signal_buffer[k] *= 200.0f;
-        /* CRITICAL: Add same noise as test data for distribution match! */
-        for(int k=0; k<256; k++) signal_buffer[k] += ((rand()%100)/10.0f);
+        lda_sample_t samples[NUM_TRAIN_SAMPLES * 2];
+        for (int i = 0; i < NUM_TRAIN_SAMPLES * 2; i++) {
+            signal_t *row = &rows[i * NUM_DEMO_FEATURES];
+            bci_model_normalize(&trained_model, row, row);
+            samples[i].features = row;
+            samples[i].label = (i < NUM_TRAIN_SAMPLES) ? 0 : 1; /* RELAX, FOCUS */
+        }
         
-        features_t feat_focus;
-        extract_features(signal_buffer, 256, &feat_focus);
+        lda_model_t lda_model;
+        lda_init(&lda_model, NUM_DEMO_FEATURES);
+        lda_train(&lda_model, samples, NUM_TRAIN_SAMPLES * 2);
+        bci_model_set_binary(&trained_model, &lda_model);
+        lda_free(&lda_model);
+        free(rows);
         
-        samples[NUM_TRAIN_SAMPLES + i].features = malloc(sizeof(signal_t) * 4);
-        samples[NUM_TRAIN_SAMPLES + i].features[0] = feat_focus.alpha_power;
-        samples[NUM_TRAIN_SAMPLES + i].features[1] = feat_focus.beta_power;
-        samples[NUM_TRAIN_SAMPLES + i].features[2] = feat_focus.variance;
-        samples[NUM_TRAIN_SAMPLES + i].features[3] = 0.0f;
-        samples[NUM_TRAIN_SAMPLES + i].label = 1; // FOCUS
+        model = &trained_model;
+        printf("    ✓ Model trained. Threshold: %.4f\n", model->threshold);
+        if (bci_model_save(&trained_model, MODEL_PATH)) {
+            printf("    ✓ Saved to %s for the next run\n", MODEL_PATH);
+        }
+        printf("\n");
     }
-    printf("    ✓ Generated %d training samples\n\n", NUM_TRAIN_SAMPLES * 2);
-    
-    /* 3. Train LDA Model */
-    printf("[3] Training LDA Classifier...\n");
-    lda_train(&lda_model, samples, NUM_TRAIN_SAMPLES * 2);
-    printf("    ✓ Model trained. Threshold: %.4f\n\n", lda_model.threshold);
     
-    /* Open CSV for logging */
-    FILE *log_file = fopen("data/realtime_stream.csv", "w");
-    if (log_file) {
-        fprintf(log_file, "time,amplitude,alpha_power,beta_power,command,led_state\n");
+    /* Telemetry capture for the visualizers */
+    telemetry_endpoint_t telemetry_endpoint;
+    telemetry_sink_t telemetry_sink;
+    telemetry_t telemetry;
+    bool_t telemetry_open = telemetry_endpoint_open(&telemetry_endpoint, &telemetry_sink,
+                                                    TELEMETRY_PATH);
+    if (telemetry_open) {
+        telemetry_init(&telemetry, &telemetry_sink);
     }
 
     /* 4. Process New "Real-time" Signals */
@@ -108,6 +152,10 @@ int main(void) {
     signal_t dummy_signal[256]; /* Buffer for raw EEG */
     float current_time = 0.0f;
     
+    /* One window every 50 ms, on a fixed deadline grid */
+    sched_timer_t window_timer;
+    sched_timer_start(&window_timer, 50000);
+    
     /* Run for 500 iterations (~25 seconds of data at 50ms delay) */
     for (int iter = 0; iter < 500; iter++) {
         /* Determine simulated state based on time */
@@ -129,27 +177,26 @@ int main(void) {
         extract_features(dummy_signal, 256, &features);
         
         /* Prepare for LDA */
-        signal_t input_features[4];
+        signal_t input_features[NUM_DEMO_FEATURES];
         input_features[0] = features.alpha_power;
         input_features[1] = features.beta_power;
         input_features[2] = features.variance;
-        input_features[3] = 0.0f;
+        input_features[3] = features.skewness;
         
         /* C. Classification (LDA) */
-        int prediction = lda_predict(&lda_model, input_features);
+        int prediction = bci_model_predict_binary(model, input_features);
         
-        /* Log data to CSV for Visualizer */
-        if (log_file) {
-             for (int s=0; s<256; s+=8) { 
-                fprintf(log_file, "%.4f,%.4f,%.4f,%.4f,%s,%d\n", 
-                        current_time + (float)s/256.0f, 
-                        dummy_signal[s],
-                        features.alpha_power, 
-                        features.beta_power,
-                        (prediction == 1) ? "FOCUS" : "RELAX",
-                        (prediction == 1) ? 1 : 0);
-             }
-             fflush(log_file); 
+        /* Stream the window to the visualizer (every 8th sample) */
+        if (telemetry_open) {
+            command_t command = (prediction == 1) ? CMD_FOCUS : CMD_RELAX;
+            output_state_t outputs = { (prediction == 1) ? TRUE : FALSE, FALSE, 0, 0, 'A' };
+            predictions_t predictions;
+            predict_impairments_with(&model->thresholds, &features, &predictions);
+            
+            telemetry_record_t record = { dummy_signal, 256,
+                                          (uint32_t)(current_time * SAMPLING_RATE),
+                                          &features, command, &outputs, &predictions };
+            telemetry_send(&telemetry, &record);
         }
         current_time += 1.0f; 
         iter++;
@@ -160,15 +207,52 @@ int main(void) {
                    iter, target_freq, (prediction == 1) ? "FOCUS" : "RELAX");
         }
         
-        delay_ms(50); 
+        sched_timer_wait(&window_timer);
     }
     
-    if (log_file) fclose(log_file);
+    if (telemetry_open) {
+        printf("    Telemetry: %u frames in %s\n", telemetry.sequence, TELEMETRY_PATH);
+        telemetry_endpoint_close(&telemetry_endpoint);
+    }
+    
+    /* 5. Offline Scoring of Recorded Sessions (one job per file) */
+    printf("\n[5] Scoring Recorded Sessions in Parallel...\n");
+    
+    const char *const sessions[] = {
+        "data/raw/sample_eeg_data.csv",
+        "data/raw/visual_impairment_data.csv",
+        "data/raw/motor_impairment_data.csv",
+        "data/raw/attention_deficit_data.csv",
+    };
+    size_t num_sessions = sizeof(sessions) / sizeof(sessions[0]);
+    session_result_t results[sizeof(sessions) / sizeof(sessions[0])];
+    worker_pool_t pool;
+    
+    if (worker_pool_init(&pool, 0, WINDOW_SIZE)) {
+        printf("    Workers: %zu\n", pool.num_workers);
+        worker_pool_process_sessions(&pool, sessions, num_sessions, results);
+        worker_pool_destroy(&pool);
+        
+        /* Results come back in session order regardless of scheduling */
+        for (size_t s = 0; s < num_sessions; s++) {
+            if (!results[s].loaded) {
+                printf("    %s: not loaded\n", sessions[s]);
+                continue;
+            }
+            printf("    %s: %zu windows, alpha %.2f, beta %.2f, FOCUS %zu / RELAX %zu\n",
+                   sessions[s], results[s].num_windows,
+                   results[s].mean_features.alpha_power, results[s].mean_features.beta_power,
+                   results[s].command_counts[CMD_FOCUS], results[s].command_counts[CMD_RELAX]);
+            printf("        impaired: visual %.0f%%, motor %.0f%%, attention %.0f%%\n",
+                   100.0f * impairment_fraction(&results[s].impairments, IMPAIRMENT_VISUAL, PRED_IMPAIRED),
+                   100.0f * impairment_fraction(&results[s].impairments, IMPAIRMENT_MOTOR, PRED_IMPAIRED),
+                   100.0f * impairment_fraction(&results[s].impairments, IMPAIRMENT_ATTENTION, PRED_IMPAIRED));
+        }
+    }
+    printf("\n");
     
     /* Cleanup */
-    for(int i=0; i<NUM_TRAIN_SAMPLES*2; i++) free(samples[i].features);
-    free(samples);
-    lda_free(&lda_model);
+    bci_model_close(&model_file);
     fft_cleanup();
     
     printf("=== Demo Complete ===\n");
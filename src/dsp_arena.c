@@ -0,0 +1,52 @@
+#include "dsp_arena.h"
+#include "utils.h"
+
+void dsp_arena_init(dsp_arena_t *arena, void *buffer, size_t capacity) {
+    arena->base = (uint8_t*)buffer;
+    arena->capacity = (buffer != NULL) ? capacity : 0;
+    arena->used = 0;
+}
+
+void* dsp_arena_alloc(dsp_arena_t *arena, size_t size) {
+    return dsp_arena_alloc_aligned(arena, size, DSP_ARENA_ALIGN);
+}
+
+void* dsp_arena_alloc_aligned(dsp_arena_t *arena, size_t size, size_t align) {
+    if (arena == NULL || arena->base == NULL || align == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+    
+    /* Align the absolute address, not just the offset */
+    uintptr_t current = (uintptr_t)(arena->base + arena->used);
+    size_t padding = (align - (current % align)) % align;
+    
+    if (padding > arena->capacity - arena->used ||
+        size > arena->capacity - arena->used - padding) {
+        log_error("DSP arena exhausted: need %zu bytes, %zu left",
+                  size + padding, arena->capacity - arena->used);
+        return NULL;
+    }
+    
+    void *ptr = arena->base + arena->used + padding;
+    arena->used += padding + size;
+    
+    return ptr;
+}
+
+size_t dsp_arena_mark(const dsp_arena_t *arena) {
+    return arena->used;
+}
+
+void dsp_arena_release(dsp_arena_t *arena, size_t mark) {
+    if (mark < arena->used) {
+        arena->used = mark;
+    }
+}
+
+void dsp_arena_reset(dsp_arena_t *arena) {
+    arena->used = 0;
+}
+
+size_t dsp_arena_remaining(const dsp_arena_t *arena) {
+    return arena->capacity - arena->used;
+}
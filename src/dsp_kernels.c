@@ -0,0 +1,145 @@
+#include "dsp_kernels.h"
+#include <math.h>
+
+#if DSP_KERNELS_RVV
+
+/* ========== RVV Kernels (dsp_kernels_rvv.S) ========== */
+
+extern float dsp_sum_rvv(const float *x, size_t n);
+extern float dsp_max_abs_rvv(const float *x, size_t n);
+extern void dsp_central_moments_rvv(const float *x, size_t n, float mean,
+                                    float *sum_sq, float *sum_cube);
+extern void dsp_magnitude_squared_rvv(const complex_t *bins, float *out, size_t n,
+                                      float scale);
+extern void dsp_fft_stage_rvv(complex_t *data, size_t n, size_t half,
+                              const complex_t *twiddles, size_t stride);
+extern void dsp_moving_average_rvv(const float *input, float *output, size_t length,
+                                   size_t window);
+
+const char* dsp_kernels_backend(void) {
+    return "rvv";
+}
+
+signal_t dsp_sum(const signal_t *x, size_t n) {
+    return dsp_sum_rvv(x, n);
+}
+
+signal_t dsp_max_abs(const signal_t *x, size_t n) {
+    return dsp_max_abs_rvv(x, n);
+}
+
+void dsp_central_moments(const signal_t *x, size_t n, signal_t mean,
+                         signal_t *sum_sq, signal_t *sum_cube) {
+    dsp_central_moments_rvv(x, n, mean, sum_sq, sum_cube);
+}
+
+void dsp_magnitude_squared(const complex_t *bins, float *out, size_t n, float scale) {
+    dsp_magnitude_squared_rvv(bins, out, n, scale);
+}
+
+void dsp_fft_stage(complex_t *data, size_t n, size_t half,
+                   const complex_t *twiddles, size_t stride) {
+    dsp_fft_stage_rvv(data, n, half, twiddles, stride);
+}
+
+void dsp_moving_average(const signal_t *input, signal_t *output, size_t length,
+                        size_t window) {
+    dsp_moving_average_rvv(input, output, length, window);
+}
+
+#else
+
+/* ========== Portable Kernels ========== */
+
+const char* dsp_kernels_backend(void) {
+    return "scalar";
+}
+
+signal_t dsp_sum(const signal_t *x, size_t n) {
+    signal_t sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+signal_t dsp_max_abs(const signal_t *x, size_t n) {
+    signal_t max_value = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        signal_t abs_val = fabsf(x[i]);
+        if (abs_val > max_value) {
+            max_value = abs_val;
+        }
+    }
+    return max_value;
+}
+
+void dsp_central_moments(const signal_t *x, size_t n, signal_t mean,
+                         signal_t *sum_sq, signal_t *sum_cube) {
+    signal_t s2 = 0.0f;
+    signal_t s3 = 0.0f;
+    
+    for (size_t i = 0; i < n; i++) {
+        signal_t diff = x[i] - mean;
+        signal_t diff_sq = diff * diff;
+        s2 += diff_sq;
+        s3 += diff_sq * diff;
+    }
+    
+    *sum_sq = s2;
+    *sum_cube = s3;
+}
+
+void dsp_magnitude_squared(const complex_t *bins, float *out, size_t n, float scale) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = scale * (bins[i].real * bins[i].real + bins[i].imag * bins[i].imag);
+    }
+}
+
+void dsp_fft_stage(complex_t *data, size_t n, size_t half,
+                   const complex_t *twiddles, size_t stride) {
+    for (size_t k = 0; k < n; k += 2 * half) {
+        complex_t *top = &data[k];
+        complex_t *bottom = &data[k + half];
+        
+        for (size_t j = 0; j < half; j++) {
+            /* Butterfly operation with twiddle exp(-2*pi*i*j/(2*half)) */
+            complex_t w = twiddles[j * stride];
+            complex_t u = top[j];
+            float t_real = w.real * bottom[j].real - w.imag * bottom[j].imag;
+            float t_imag = w.real * bottom[j].imag + w.imag * bottom[j].real;
+            
+            top[j].real = u.real + t_real;
+            top[j].imag = u.imag + t_imag;
+            bottom[j].real = u.real - t_real;
+            bottom[j].imag = u.imag - t_imag;
+        }
+    }
+}
+
+void dsp_moving_average(const signal_t *input, signal_t *output, size_t length,
+                        size_t window) {
+    /* Running sum over the last window, walked from the end of the signal.
+     * output[i] only depends on input[i-window+1..i], so going backwards
+     * never reads a sample that has already been overwritten: input and
+     * output may be the same buffer. */
+    signal_t sum = 0.0f;
+    for (size_t i = length - window; i < length; i++) {
+        sum += input[i];
+    }
+    
+    for (size_t i = length; i-- > 0; ) {
+        signal_t current = input[i];
+        size_t count = (i + 1 < window) ? i + 1 : window;  /* Shorter warm-up windows */
+        
+        output[i] = sum / count;
+        
+        /* Slide window back by one sample */
+        sum -= current;
+        if (i >= window) {
+            sum += input[i - window];
+        }
+    }
+}
+
+#endif /* DSP_KERNELS_RVV */
@@ -1,18 +1,201 @@
 #include "eeg_simulator.h"
-#include "utils.h"
 #include <math.h>
-#include <stdlib.h>
-#include <time.h>
 
+/* Gaussian sigma with the RMS of a uniform draw in [-level, level] */
+#define UNIFORM_RMS_SCALE 0.57735027f
+
+/* Blink pulse: sigma 50 ms, clipped to 200 ms after the blink */
+#define BLINK_SIGMA_SEC    0.05f
+#define BLINK_LENGTH_SEC   0.2f
+#define BLINK_TIME_SEC     0.5f
+
+/* Mid-band rhythms used for every state */
+#define ALPHA_FREQUENCY    10.5f
+#define BETA_FREQUENCY     21.5f
+
+/* ========== Random Numbers ========== */
+
+#define PCG32_MULTIPLIER 6364136223846793005ULL
+
+void eeg_rng_seed(eeg_rng_t *rng, uint64_t seed, uint64_t stream_id) {
+    rng->state = 0;
+    rng->increment = (stream_id << 1) | 1u;
+    rng->has_spare = FALSE;
+    rng->spare = 0.0f;
+    eeg_rng_next(rng);
+    rng->state += seed;
+    eeg_rng_next(rng);
+}
+
+uint32_t eeg_rng_next(eeg_rng_t *rng) {
+    uint64_t old = rng->state;
+    rng->state = old * PCG32_MULTIPLIER + rng->increment;
+
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+float eeg_rng_uniform(eeg_rng_t *rng) {
+    return (float)(eeg_rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+/* Two independent deviates per accepted point (about 79% acceptance) */
+static void gaussian_pair(eeg_rng_t *rng, float *first, float *second) {
+    float u, v, s;
+
+    do {
+        u = 2.0f * eeg_rng_uniform(rng) - 1.0f;
+        v = 2.0f * eeg_rng_uniform(rng) - 1.0f;
+        s = u * u + v * v;
+    } while (s >= 1.0f || s == 0.0f);
+
+    float scale = sqrtf(-2.0f * logf(s) / s);
+    *first = u * scale;
+    *second = v * scale;
+}
+
+float eeg_rng_gaussian(eeg_rng_t *rng) {
+    if (rng->has_spare) {
+        rng->has_spare = FALSE;
+        return rng->spare;
+    }
+
+    float value;
+    gaussian_pair(rng, &value, &rng->spare);
+    rng->has_spare = TRUE;
+    return value;
+}
+
+void eeg_rng_gaussian_fill(eeg_rng_t *rng, signal_t *buffer, size_t length, float sigma) {
+    size_t i = 0;
+
+    if (i < length && rng->has_spare) {
+        buffer[i++] = sigma * eeg_rng_gaussian(rng);
+    }
+    for (; i + 1 < length; i += 2) {
+        float a, b;
+        gaussian_pair(rng, &a, &b);
+        buffer[i] = sigma * a;
+        buffer[i + 1] = sigma * b;
+    }
+    if (i < length) {
+        buffer[i] = sigma * eeg_rng_gaussian(rng);
+    }
+}
+
+/* ========== Oscillators ========== */
+
+void eeg_oscillator_init(eeg_oscillator_t *osc, float frequency, float sample_rate,
+                         float amplitude) {
+    float omega = 2.0f * (float)M_PI * frequency / sample_rate;
+
+    osc->re = 1.0f;
+    osc->im = 0.0f;
+    osc->step_re = cosf(omega);
+    osc->step_im = sinf(omega);
+    osc->amplitude = amplitude;
+}
+
+void eeg_oscillator_add(eeg_oscillator_t *osc, signal_t *buffer, size_t length) {
+    float re = osc->re;
+    float im = osc->im;
+    float c = osc->step_re;
+    float s = osc->step_im;
+    float amplitude = osc->amplitude;
+
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] += amplitude * im;
+        float next_re = re * c - im * s;
+        im = re * s + im * c;
+        re = next_re;
+    }
+
+    /* Rounding drifts |z| by ~1 ulp per step: pull it back once per block */
+    float correction = 1.5f - 0.5f * (re * re + im * im);
+    osc->re = re * correction;
+    osc->im = im * correction;
+}
+
+/* ========== Streams ========== */
+
+void eeg_stream_init(eeg_stream_t *stream, uint64_t seed, uint64_t stream_id) {
+    eeg_rng_seed(&stream->rng, seed, stream_id);
+}
+
+void eeg_stream_generate(eeg_stream_t *stream, signal_t *buffer, size_t length,
+                         command_t state) {
+    float alpha_ratio;
+    float beta_ratio;
+    bool_t include_blink = FALSE;
+
+    /* Configure signal based on desired mental state */
+    switch (state) {
+        case CMD_FOCUS:
+            /* High beta, low alpha */
+            beta_ratio = 1.0f;
+            alpha_ratio = 0.3f;
+            break;
+
+        case CMD_RELAX:
+            /* High alpha, low beta */
+            alpha_ratio = 1.0f;
+            beta_ratio = 0.3f;
+            break;
+
+        case CMD_BLINK:
+            /* Normal background with blink artifact */
+            alpha_ratio = 0.5f;
+            beta_ratio = 0.5f;
+            include_blink = TRUE;
+            break;
+
+        case CMD_NONE:
+        default:
+            /* Balanced background activity */
+            alpha_ratio = 0.5f;
+            beta_ratio = 0.5f;
+            break;
+    }
+
+    /* Noise first, then the rhythms on top: straight-line loops over the buffer */
+    eeg_rng_gaussian_fill(&stream->rng, buffer, length, NOISE_LEVEL * UNIFORM_RMS_SCALE);
+
+    eeg_oscillator_t alpha, beta;
+    eeg_oscillator_init(&alpha, ALPHA_FREQUENCY, SAMPLING_RATE, alpha_ratio * ALPHA_AMPLITUDE);
+    eeg_oscillator_init(&beta, BETA_FREQUENCY, SAMPLING_RATE, beta_ratio * BETA_AMPLITUDE);
+    eeg_oscillator_add(&alpha, buffer, length);
+    eeg_oscillator_add(&beta, buffer, length);
+
+    if (include_blink) {
+        /* The pulse only spans ~50 samples: evaluate it there alone */
+        size_t first = (size_t)ceilf(BLINK_TIME_SEC * SAMPLING_RATE);
+        size_t last = (size_t)((BLINK_TIME_SEC + BLINK_LENGTH_SEC) * SAMPLING_RATE);
+        float dt = 1.0f / SAMPLING_RATE;
+        for (size_t i = first; i <= last && i < length; i++) {
+            float time_diff = i * dt - BLINK_TIME_SEC;
+            float exponent = -(time_diff * time_diff) / (2.0f * BLINK_SIGMA_SEC * BLINK_SIGMA_SEC);
+            buffer[i] += BLINK_AMPLITUDE * expf(exponent);
+        }
+    }
+}
+
+/* ========== Default Stream ========== */
+
+static eeg_stream_t default_stream;
 static int simulator_initialized = 0;
 
 void eeg_simulator_init(void) {
     if (!simulator_initialized) {
-        seed_random((unsigned int)time(NULL));
-        simulator_initialized = 1;
+        eeg_simulator_seed(EEG_SIMULATOR_SEED);
     }
 }
 
+void eeg_simulator_seed(uint64_t seed) {
+    eeg_stream_init(&default_stream, seed, 0);
+    simulator_initialized = 1;
+}
+
 signal_t generate_alpha_wave(float time_sec, float frequency) {
     /* Alpha waves: 8-13 Hz, associated with relaxed, wakeful state */
     return ALPHA_AMPLITUDE * sinf(2.0f * M_PI * frequency * time_sec);
@@ -38,9 +221,8 @@ signal_t generate_blink_artifact(float time_sec, float blink_time) {
 }
 
 signal_t add_noise(signal_t signal, float noise_level) {
-    /* Add Gaussian-like noise */
-    float noise = random_float(-noise_level, noise_level);
-    return signal + noise;
+    eeg_simulator_init();
+    return signal + noise_level * UNIFORM_RMS_SCALE * eeg_rng_gaussian(&default_stream.rng);
 }
 
 signal_t generate_mixed_signal(float time_sec, float alpha_ratio, float beta_ratio,
@@ -49,12 +231,12 @@ signal_t generate_mixed_signal(float time_sec, float alpha_ratio, float beta_rat
     
     /* Mix alpha waves (use middle of alpha band: 10.5 Hz) */
     if (alpha_ratio > 0.0f) {
-        signal += alpha_ratio * generate_alpha_wave(time_sec, 10.5f);
+        signal += alpha_ratio * generate_alpha_wave(time_sec, ALPHA_FREQUENCY);
     }
     
     /* Mix beta waves (use middle of beta band: 21.5 Hz) */
     if (beta_ratio > 0.0f) {
-        signal += beta_ratio * generate_beta_wave(time_sec, 21.5f);
+        signal += beta_ratio * generate_beta_wave(time_sec, BETA_FREQUENCY);
     }
     
     /* Add blink artifact if needed */
@@ -69,45 +251,6 @@ signal_t generate_mixed_signal(float time_sec, float alpha_ratio, float beta_rat
 }
 
 void generate_eeg_sample(signal_t *buffer, size_t length, command_t state) {
-    float dt = 1.0f / SAMPLING_RATE;
-    float alpha_ratio = 0.0f;
-    float beta_ratio = 0.0f;
-    bool_t include_blink = FALSE;
-    float blink_time = 0.5f;
-    
-    /* Configure signal based on desired mental state */
-    switch (state) {
-        case CMD_FOCUS:
-            /* High beta, low alpha */
-            beta_ratio = 1.0f;
-            alpha_ratio = 0.3f;
-            break;
-            
-        case CMD_RELAX:
-            /* High alpha, low beta */
-            alpha_ratio = 1.0f;
-            beta_ratio = 0.3f;
-            break;
-            
-        case CMD_BLINK:
-            /* Normal background with blink artifact */
-            alpha_ratio = 0.5f;
-            beta_ratio = 0.5f;
-            include_blink = TRUE;
-            break;
-            
-        case CMD_NONE:
-        default:
-            /* Balanced background activity */
-            alpha_ratio = 0.5f;
-            beta_ratio = 0.5f;
-            break;
-    }
-    
-    /* Generate signal samples */
-    for (size_t i = 0; i < length; i++) {
-        float time_sec = i * dt;
-        buffer[i] = generate_mixed_signal(time_sec, alpha_ratio, beta_ratio,
-                                          include_blink, blink_time);
-    }
+    eeg_simulator_init();
+    eeg_stream_generate(&default_stream, buffer, length, state);
 }
@@ -1,30 +1,31 @@
 #include "feature_extraction.h"
 #include "fft.h"
+#include "dsp_kernels.h"
 #include "utils.h"
 #include <math.h>
 
+const frequency_band_t eeg_bands[NUM_BANDS] = {
+    { THETA_LOW_FREQ, THETA_HIGH_FREQ },
+    { ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ },
+    { BETA_LOW_FREQ,  BETA_HIGH_FREQ  },
+    { GAMMA_LOW_FREQ, GAMMA_HIGH_FREQ }
+};
+
 void feature_extraction_init(void) {
     /* Nothing to initialize for now */
 }
 
 signal_t calculate_mean(const signal_t *signal, size_t length) {
-    signal_t sum = 0.0f;
-    for (size_t i = 0; i < length; i++) {
-        sum += signal[i];
-    }
-    return sum / length;
+    return dsp_sum(signal, length) / length;
 }
 
 signal_t calculate_variance(const signal_t *signal, size_t length) {
     signal_t mean = calculate_mean(signal, length);
-    signal_t variance = 0.0f;
+    signal_t sum_sq, sum_cube;
     
-    for (size_t i = 0; i < length; i++) {
-        signal_t diff = signal[i] - mean;
-        variance += diff * diff;
-    }
+    dsp_central_moments(signal, length, mean, &sum_sq, &sum_cube);
     
-    return variance / length;
+    return sum_sq / length;
 }
 
 signal_t calculate_skewness(const signal_t *signal, size_t length) {
@@ -32,7 +33,10 @@ signal_t calculate_skewness(const signal_t *signal, size_t length) {
     /* skewness = E[(X - μ)³] / σ³ */
     
     signal_t mean = calculate_mean(signal, length);
-    signal_t variance = calculate_variance(signal, length);
+    signal_t sum_sq, sum_cube;
+    dsp_central_moments(signal, length, mean, &sum_sq, &sum_cube);
+    
+    signal_t variance = sum_sq / length;
     signal_t std_dev = sqrtf(variance);
     
     /* Avoid division by zero */
@@ -40,20 +44,13 @@ signal_t calculate_skewness(const signal_t *signal, size_t length) {
         return 0.0f;
     }
     
-    signal_t skewness = 0.0f;
-    for (size_t i = 0; i < length; i++) {
-        signal_t diff = signal[i] - mean;
-        signal_t normalized = diff / std_dev;
-        skewness += normalized * normalized * normalized;
-    }
-    
-    return skewness / length;
+    return (sum_cube / length) / (variance * std_dev);
 }
 
 signal_t calculate_band_power(const signal_t *signal, size_t length,
                               float low_freq, float high_freq) {
     /* Use FFT-based Power Spectral Density for accurate band power */
-    #ifdef USE_FFT_BANDPOWER
+    #if USE_FFT_BANDPOWER
         /* Use FFT for accurate frequency analysis */
         return calculate_band_power_fft(signal, length, SAMPLING_RATE, 
                                        low_freq, high_freq);
@@ -101,43 +98,83 @@ signal_t calculate_band_power(const signal_t *signal, size_t length,
     #endif
 }
 
-signal_t detect_peak_amplitude(const signal_t *signal, size_t length) {
-    signal_t max_amplitude = 0.0f;
-    
-    for (size_t i = 0; i < length; i++) {
-        signal_t abs_val = fabsf(signal[i]);
-        if (abs_val > max_amplitude) {
-            max_amplitude = abs_val;
+void calculate_band_powers(const signal_t *signal, size_t length,
+                           const frequency_band_t *bands, size_t num_bands,
+                           signal_t *band_powers) {
+    calculate_band_powers_ws(NULL, signal, length, bands, num_bands, band_powers);
+}
+
+void calculate_band_powers_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                              const frequency_band_t *bands, size_t num_bands,
+                              signal_t *band_powers) {
+    #if USE_FFT_BANDPOWER
+        /* One FFT for all bands */
+        if (ws != NULL) {
+            calculate_band_powers_fft_ws(ws, signal, length, SAMPLING_RATE,
+                                         bands, num_bands, band_powers);
+        } else {
+            calculate_band_powers_fft(signal, length, SAMPLING_RATE,
+                                      bands, num_bands, band_powers);
         }
-    }
-    
-    return max_amplitude;
+    #else
+        (void)ws;
+        for (size_t b = 0; b < num_bands; b++) {
+            band_powers[b] = calculate_band_power(signal, length,
+                                                  bands[b].low_freq, bands[b].high_freq);
+        }
+    #endif
 }
 
-void extract_features(const signal_t *signal, size_t length, features_t *features) {
-    /* Extract theta band power (4-8 Hz) - attention, drowsiness */
-    features->theta_power = calculate_band_power(signal, length, 
-                                                 THETA_LOW_FREQ, THETA_HIGH_FREQ);
+signal_t detect_peak_amplitude(const signal_t *signal, size_t length) {
+    return dsp_max_abs(signal, length);
+}
+
+void extract_band_features(const signal_t *signal, size_t length, features_t *features) {
+    extract_band_features_ws(NULL, signal, length, features);
+}
+
+void extract_band_features_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                              features_t *features) {
+    /* Extract theta/alpha/beta/gamma band powers from a single spectrum */
+    signal_t band_powers[NUM_BANDS];
+    calculate_band_powers_ws(ws, signal, length, eeg_bands, NUM_BANDS, band_powers);
     
-    /* Extract alpha band power (8-13 Hz) - relaxation, visual processing */
-    features->alpha_power = calculate_band_power(signal, length, 
-                                                 ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
+    features->theta_power = band_powers[BAND_THETA];  /* attention, drowsiness */
+    features->alpha_power = band_powers[BAND_ALPHA];  /* relaxation, visual processing */
+    features->beta_power = band_powers[BAND_BETA];    /* focus, motor control */
+    features->gamma_power = band_powers[BAND_GAMMA];  /* cognitive function */
     
-    /* Extract beta band power (13-30 Hz) - focus, motor control */
-    features->beta_power = calculate_band_power(signal, length,
-                                                BETA_LOW_FREQ, BETA_HIGH_FREQ);
+    /* Normalize powers to get relative ratios */
+    normalize_band_powers(features);
+}
+
+void extract_time_features(const signal_t *signal, size_t length, features_t *features) {
+    /* Variance and skewness share one pass once the mean is known */
+    signal_t mean = calculate_mean(signal, length);
+    signal_t m2, m3;
+    dsp_central_moments(signal, length, mean, &m2, &m3);
+    m2 /= length;
+    m3 /= length;
     
-    /* Extract gamma band power (30-50 Hz) - cognitive function */
-    features->gamma_power = calculate_band_power(signal, length,
-                                                 GAMMA_LOW_FREQ, GAMMA_HIGH_FREQ);
+    signal_t std_dev = sqrtf(m2);
     
     /* Detect peak amplitude for blink detection */
-    features->peak_amplitude = detect_peak_amplitude(signal, length);
-    
-    /* Calculate signal variance */
-    features->variance = calculate_variance(signal, length);
-    
-    /* Normalize powers to get relative ratios */
+    features->peak_amplitude = dsp_max_abs(signal, length);
+    features->variance = m2;
+    features->skewness = (std_dev < 0.001f) ? 0.0f : m3 / (m2 * std_dev);
+}
+
+void extract_features(const signal_t *signal, size_t length, features_t *features) {
+    extract_features_ws(NULL, signal, length, features);
+}
+
+void extract_features_ws(fft_workspace_t *ws, const signal_t *signal, size_t length,
+                         features_t *features) {
+    extract_band_features_ws(ws, signal, length, features);
+    extract_time_features(signal, length, features);
+}
+
+void normalize_band_powers(features_t *features) {
     signal_t total_power = features->theta_power + features->alpha_power + 
                           features->beta_power + features->gamma_power;
     
@@ -1,4 +1,6 @@
 #include "fft.h"
+#include "dsp_kernels.h"
+#include "profiler.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <string.h>
@@ -45,10 +47,6 @@ float complex_magnitude_squared(complex_t c) {
 
 /* ========== FFT Utility Functions ========== */
 
-void fft_init(void) {
-    /* Nothing to initialize for now */
-}
-
 bool_t is_power_of_2(size_t n) {
     return n > 0 && (n & (n - 1)) == 0;
 }
@@ -77,106 +75,253 @@ size_t bit_reverse(size_t n, size_t bits) {
     return reversed;
 }
 
+float hann_window_fill(signal_t *table, size_t length) {
+    float power = 0.0f;
+    
+    for (size_t i = 0; i < length; i++) {
+        float window = (length < 2) ? 1.0f :
+                       0.5f * (1.0f - cosf(2.0f * M_PI * i / (length - 1)));
+        table[i] = window;
+        power += window * window;
+    }
+    
+    return power;
+}
+
+/* WINDOW_SIZE table in static storage, built by fft_init */
+static signal_t default_hann[WINDOW_SIZE];
+
+/* Table for the most recent other length */
+static signal_t *cached_hann = NULL;
+static size_t cached_hann_length = 0;
+
+const signal_t* hann_window_table(size_t length) {
+    if (length == WINDOW_SIZE) {
+        fft_init();
+        return default_hann;
+    }
+    
+    if (cached_hann_length != length) {
+        free(cached_hann);
+        cached_hann_length = 0;
+        cached_hann = (signal_t*)malloc(length * sizeof(signal_t));
+        if (cached_hann == NULL) {
+            log_error("Failed to allocate %zu-point window table", length);
+            return NULL;
+        }
+        hann_window_fill(cached_hann, length);
+        cached_hann_length = length;
+    }
+    
+    return cached_hann;
+}
+
 void apply_hanning_window(signal_t *signal, size_t length) {
+    const signal_t *window = (length > 0) ? hann_window_table(length) : NULL;
+    
+    if (window == NULL) {
+        return;
+    }
+    
     for (size_t i = 0; i < length; i++) {
-        float window = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (length - 1)));
-        signal[i] *= window;
+        signal[i] *= window[i];
     }
 }
 
-/* ========== FFT Algorithm ========== */
+/* ========== FFT Plans ========== */
 
-/* Cooley-Tukey FFT (radix-2, decimation-in-time) */
-void fft_compute(const signal_t *input, complex_t *output, size_t n) {
-    if (!is_power_of_2(n)) {
-        log_error("FFT size must be power of 2, got %zu", n);
+/* WINDOW_SIZE plan lives in static storage so the default path needs no heap */
+static complex_t default_twiddles[WINDOW_SIZE / 2];
+static uint16_t default_bitrev[WINDOW_SIZE];
+static fft_plan_t default_plan;
+static bool_t default_plan_ready = FALSE;
+
+/* Plan for the most recent non-default size */
+static fft_plan_t cached_plan;
+
+static void fft_plan_fill_tables(fft_plan_t *plan) {
+    size_t n = plan->n;
+    
+    plan->log2n = 0;
+    while (((size_t)1 << plan->log2n) < n) {
+        plan->log2n++;
+    }
+    
+    for (size_t k = 0; k < n / 2; k++) {
+        float angle = -2.0f * M_PI * k / n;
+        plan->twiddles[k] = complex_create(cosf(angle), sinf(angle));
+    }
+    
+    for (size_t k = 0; k < n; k++) {
+        plan->bitrev[k] = (uint16_t)bit_reverse(k, plan->log2n);
+    }
+}
+
+void fft_init(void) {
+    if (default_plan_ready) {
         return;
     }
     
-    /* Calculate number of bits */
-    size_t bits = 0;
-    size_t temp = n;
-    while (temp > 1) {
-        bits++;
-        temp >>= 1;
+    default_plan.n = WINDOW_SIZE;
+    default_plan.twiddles = default_twiddles;
+    default_plan.bitrev = default_bitrev;
+    default_plan.owns_tables = FALSE;
+    fft_plan_fill_tables(&default_plan);
+    hann_window_fill(default_hann, WINDOW_SIZE);
+    
+    default_plan_ready = TRUE;
+}
+
+bool_t fft_plan_create(fft_plan_t *plan, size_t n) {
+    if (plan == NULL) {
+        return FALSE;
+    }
+    
+    plan->n = 0;
+    plan->twiddles = NULL;
+    plan->bitrev = NULL;
+    plan->owns_tables = FALSE;
+    
+    if (!is_power_of_2(n) || n > FFT_MAX_SIZE) {
+        log_error("FFT plan size must be power of 2 <= %d, got %zu", FFT_MAX_SIZE, n);
+        return FALSE;
+    }
+    
+    size_t num_twiddles = (n > 1) ? n / 2 : 1;
+    plan->twiddles = (complex_t*)malloc(num_twiddles * sizeof(complex_t));
+    plan->bitrev = (uint16_t*)malloc(n * sizeof(uint16_t));
+    
+    if (plan->twiddles == NULL || plan->bitrev == NULL) {
+        log_error("Failed to allocate FFT plan tables");
+        free(plan->twiddles);
+        free(plan->bitrev);
+        plan->twiddles = NULL;
+        plan->bitrev = NULL;
+        return FALSE;
+    }
+    
+    plan->n = n;
+    plan->owns_tables = TRUE;
+    fft_plan_fill_tables(plan);
+    
+    return TRUE;
+}
+
+void fft_plan_destroy(fft_plan_t *plan) {
+    if (plan == NULL) {
+        return;
     }
     
+    if (plan->owns_tables) {
+        free(plan->twiddles);
+        free(plan->bitrev);
+    }
+    plan->twiddles = NULL;
+    plan->bitrev = NULL;
+    plan->owns_tables = FALSE;
+    plan->n = 0;
+}
+
+const fft_plan_t* fft_get_plan(size_t n) {
+    if (n == WINDOW_SIZE) {
+        fft_init();
+        return &default_plan;
+    }
+    
+    if (cached_plan.n != n) {
+        fft_plan_destroy(&cached_plan);
+        if (!fft_plan_create(&cached_plan, n)) {
+            return NULL;
+        }
+    }
+    
+    return &cached_plan;
+}
+
+/* ========== FFT Algorithm ========== */
+
+/* In-place radix-2 butterflies on bit-reversed data
+ * data: n complex values in bit-reversed order
+ * twiddles: Twiddle table of a plan of size table_n (table_n >= n)
+ */
+static void fft_butterflies(complex_t *data, size_t n,
+                            const complex_t *twiddles, size_t table_n) {
+    for (size_t m = 2; m <= n; m <<= 1) {
+        size_t m2 = m >> 1;              /* Half size of sub-DFT */
+        size_t step = table_n / m;       /* Twiddle stride for this stage */
+        
+        /* Butterfly operations with twiddle exp(-2*pi*i*j/m) */
+        dsp_fft_stage(data, n, m2, twiddles, step);
+    }
+}
+
+void fft_compute_plan(const fft_plan_t *plan, const signal_t *input, complex_t *output) {
+    size_t n = plan->n;
+    
     /* Bit-reversal permutation */
     for (size_t i = 0; i < n; i++) {
-        size_t j = bit_reverse(i, bits);
+        size_t j = plan->bitrev[i];
         output[j].real = input[i];
         output[j].imag = 0.0f;
     }
     
-    /* Cooley-Tukey FFT algorithm */
-    for (size_t stage = 1; stage <= bits; stage++) {
-        size_t m = 1 << stage;           /* Size of sub-DFT */
-        size_t m2 = m >> 1;              /* Half size */
-        
-        /* Twiddle factor exp(-2*pi*i/m) */
-        float angle = -2.0f * M_PI / m;
-        complex_t wm = complex_create(cosf(angle), sinf(angle));
-        
-        for (size_t k = 0; k < n; k += m) {
-            complex_t w = complex_create(1.0f, 0.0f);
-            
-            for (size_t j = 0; j < m2; j++) {
-                /* Butterfly operation */
-                complex_t t = complex_mul(w, output[k + j + m2]);
-                complex_t u = output[k + j];
-                
-                output[k + j] = complex_add(u, t);
-                output[k + j + m2] = complex_sub(u, t);
-                
-                w = complex_mul(w, wm);
-            }
-        }
-    }
+    fft_butterflies(output, n, plan->twiddles, n);
 }
 
-void fft_inverse(const complex_t *input, complex_t *output, size_t n) {
-    if (!is_power_of_2(n)) {
-        log_error("IFFT size must be power of 2, got %zu", n);
+void fft_compute_real(const fft_plan_t *plan, const signal_t *input, complex_t *output) {
+    size_t n = plan->n;
+    size_t half = n / 2;
+    
+    if (n < 2) {
+        log_error("Real FFT size must be at least 2, got %zu", n);
         return;
     }
     
-    /* Calculate number of bits */
-    size_t bits = 0;
-    size_t temp = n;
-    while (temp > 1) {
-        bits++;
-        temp >>= 1;
+    /* Pack even/odd samples as real/imag and bit-reverse for n/2 points */
+    for (size_t i = 0; i < half; i++) {
+        size_t j = plan->bitrev[i] >> 1;
+        output[j].real = input[2 * i];
+        output[j].imag = input[2 * i + 1];
     }
     
+    /* n/2-point complex transform (twiddles read with stride 2) */
+    fft_butterflies(output, half, plan->twiddles, n);
+    
+    /* Split step: X[k] = E[k] + W^k O[k], X[n/2-k] = conj(E[k] - W^k O[k]) */
+    complex_t z0 = output[0];
+    output[0] = complex_create(z0.real + z0.imag, 0.0f);
+    output[half] = complex_create(z0.real - z0.imag, 0.0f);
+    
+    for (size_t k = 1; k <= half / 2; k++) {
+        size_t m = half - k;
+        complex_t a = output[k];
+        complex_t b = output[m];
+        
+        /* E = (a + conj(b)) / 2, O = (a - conj(b)) / 2i */
+        complex_t even = complex_create(0.5f * (a.real + b.real), 0.5f * (a.imag - b.imag));
+        complex_t odd = complex_create(0.5f * (a.imag + b.imag), -0.5f * (a.real - b.real));
+        complex_t t = complex_mul(plan->twiddles[k], odd);
+        
+        output[k] = complex_add(even, t);
+        if (m != k) {
+            complex_t diff = complex_sub(even, t);
+            output[m] = complex_create(diff.real, -diff.imag);
+        }
+    }
+}
+
+void fft_inverse_plan(const fft_plan_t *plan, const complex_t *input, complex_t *output) {
+    size_t n = plan->n;
+    
     /* Bit-reversal permutation with complex conjugate */
     for (size_t i = 0; i < n; i++) {
-        size_t j = bit_reverse(i, bits);
+        size_t j = plan->bitrev[i];
         output[j].real = input[i].real;
         output[j].imag = -input[i].imag;  /* Conjugate */
     }
     
-    /* FFT algorithm (same as forward, but with conjugated input) */
-    for (size_t stage = 1; stage <= bits; stage++) {
-        size_t m = 1 << stage;
-        size_t m2 = m >> 1;
-        
-        float angle = -2.0f * M_PI / m;
-        complex_t wm = complex_create(cosf(angle), sinf(angle));
-        
-        for (size_t k = 0; k < n; k += m) {
-            complex_t w = complex_create(1.0f, 0.0f);
-            
-            for (size_t j = 0; j < m2; j++) {
-                complex_t t = complex_mul(w, output[k + j + m2]);
-                complex_t u = output[k + j];
-                
-                output[k + j] = complex_add(u, t);
-                output[k + j + m2] = complex_sub(u, t);
-                
-                w = complex_mul(w, wm);
-            }
-        }
-    }
+    /* Forward transform of the conjugated input */
+    fft_butterflies(output, n, plan->twiddles, n);
     
     /* Scale and take conjugate for IFFT */
     float scale = 1.0f / n;
@@ -186,56 +331,96 @@ void fft_inverse(const complex_t *input, complex_t *output, size_t n) {
     }
 }
 
+void fft_compute(const signal_t *input, complex_t *output, size_t n) {
+    if (!is_power_of_2(n)) {
+        log_error("FFT size must be power of 2, got %zu", n);
+        return;
+    }
+    
+    const fft_plan_t *plan = fft_get_plan(n);
+    if (plan == NULL) {
+        return;
+    }
+    
+    fft_compute_plan(plan, input, output);
+}
+
+void fft_inverse(const complex_t *input, complex_t *output, size_t n) {
+    if (!is_power_of_2(n)) {
+        log_error("IFFT size must be power of 2, got %zu", n);
+        return;
+    }
+    
+    const fft_plan_t *plan = fft_get_plan(n);
+    if (plan == NULL) {
+        return;
+    }
+    
+    fft_inverse_plan(plan, input, output);
+}
+
 /* ========== Power Spectral Density ========== */
 
+/* Fill power of spectrum (buffer already allocated) */
+static void power_spectrum_fill(const complex_t *fft_result, size_t n,
+                                float sampling_rate, power_spectrum_t *spectrum) {
+    /* Number of unique frequency bins (0 to Nyquist) */
+    spectrum->num_bins = n / 2 + 1;
+    spectrum->frequency_resolution = sampling_rate / n;
+    
+    /* Power = 2 |FFT[k]|^2 / n^2 (since we only keep half) */
+    dsp_magnitude_squared(fft_result, spectrum->power, spectrum->num_bins,
+                          2.0f / ((float)n * (float)n));
+    
+    /* DC and Nyquist have no mirror image, so they count once */
+    spectrum->power[0] *= 0.5f;
+    spectrum->power[n / 2] *= 0.5f;
+}
+
 void calculate_power_spectrum(const complex_t *fft_result, size_t n,
                               float sampling_rate, power_spectrum_t *spectrum) {
     if (spectrum == NULL) return;
     
-    /* Number of unique frequency bins (0 to Nyquist) */
+    /* Allocate memory for power */
     spectrum->num_bins = n / 2 + 1;
-    spectrum->frequency_resolution = sampling_rate / n;
-    
-    /* Allocate memory for power and frequencies */
     spectrum->power = (float*)malloc(spectrum->num_bins * sizeof(float));
-    spectrum->frequencies = (float*)malloc(spectrum->num_bins * sizeof(float));
     
-    if (spectrum->power == NULL || spectrum->frequencies == NULL) {
+    if (spectrum->power == NULL) {
         log_error("Failed to allocate memory for power spectrum");
         return;
     }
     
-    /* Calculate power and frequencies for each bin */
-    for (size_t i = 0; i < spectrum->num_bins; i++) {
-        /* Frequency for this bin */
-        spectrum->frequencies[i] = i * spectrum->frequency_resolution;
-        
-        /* Power = |FFT[k]|^2 / n^2 */
-        /* Multiply DC and Nyquist by 1, others by 2 (since we only keep half) */
-        float magnitude_sq = complex_magnitude_squared(fft_result[i]);
-        
-        if (i == 0 || i == n/2) {
-            spectrum->power[i] = magnitude_sq / (n * n);
-        } else {
-            spectrum->power[i] = 2.0f * magnitude_sq / (n * n);
-        }
+    power_spectrum_fill(fft_result, n, sampling_rate, spectrum);
+}
+
+void calculate_power_spectrum_ws(fft_workspace_t *ws, const complex_t *fft_result,
+                                 size_t n, float sampling_rate) {
+    if (ws == NULL || n != ws->fft_size) {
+        log_error("Workspace sized for FFT %zu, got %zu", ws ? ws->fft_size : 0, n);
+        return;
     }
+    
+    power_spectrum_fill(fft_result, n, sampling_rate, &ws->spectrum);
 }
 
 float calculate_band_power_psd(const power_spectrum_t *spectrum,
                                float low_freq, float high_freq) {
-    if (spectrum == NULL || spectrum->power == NULL) {
+    if (spectrum == NULL || spectrum->power == NULL || spectrum->num_bins < 2) {
         return 0.0f;
     }
     
-    float total_power = 0.0f;
+    /* Map the band to a contiguous slice of bins once */
+    size_t fft_size = (spectrum->num_bins - 1) * 2;
+    float sampling_rate = spectrum->frequency_resolution * fft_size;
+    size_t first_bin = 0;
+    size_t count = get_frequency_bin_range(low_freq, high_freq, sampling_rate,
+                                           fft_size, &first_bin);
     
     /* Sum power in the frequency band */
-    for (size_t i = 0; i < spectrum->num_bins; i++) {
-        float freq = spectrum->frequencies[i];
-        if (freq >= low_freq && freq <= high_freq) {
-            total_power += spectrum->power[i];
-        }
+    const float *power = &spectrum->power[first_bin];
+    float total_power = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        total_power += power[i];
     }
     
     /* Multiply by frequency resolution to get power (integrate) */
@@ -246,42 +431,202 @@ float calculate_band_power_psd(const power_spectrum_t *spectrum,
 
 float calculate_band_power_fft(const signal_t *signal, size_t length,
                                float sampling_rate, float low_freq, float high_freq) {
-    /* Ensure FFT size is power of 2 */
-    size_t fft_size = next_power_of_2(length);
+    frequency_band_t band;
+    float band_power = 0.0f;
     
-    /* Allocate buffers */
-    signal_t *padded_signal = (signal_t*)calloc(fft_size, sizeof(signal_t));
-    complex_t *fft_result = (complex_t*)malloc(fft_size * sizeof(complex_t));
+    band.low_freq = low_freq;
+    band.high_freq = high_freq;
     
-    if (padded_signal == NULL || fft_result == NULL) {
-        log_error("Failed to allocate FFT buffers");
-        free(padded_signal);
-        free(fft_result);
-        return 0.0f;
+    calculate_band_powers_fft(signal, length, sampling_rate, &band, 1, &band_power);
+    
+    return band_power;
+}
+
+/* Window, transform and integrate bands; buffers come from the caller
+ * padded_signal: fft_size samples, bins: fft_size/2+1, spectrum: buffers allocated
+ * window: Hann table for length samples
+ */
+static void band_powers_compute(const fft_plan_t *plan, signal_t *padded_signal,
+                                complex_t *bins, power_spectrum_t *spectrum,
+                                const signal_t *window, const signal_t *signal,
+                                size_t length, float sampling_rate,
+                                const frequency_band_t *bands,
+                                size_t num_bands, float *band_powers) {
+    size_t fft_size = plan->n;
+    
+    PROF_START(fft_mark);
+    
+    /* Window (to reduce spectral leakage) while copying, then zero-pad */
+    for (size_t i = 0; i < length; i++) {
+        padded_signal[i] = signal[i] * window[i];
+    }
+    memset(&padded_signal[length], 0, (fft_size - length) * sizeof(signal_t));
+    
+    /* Compute real FFT and power spectrum once for the whole window */
+    fft_compute_real(plan, padded_signal, bins);
+    power_spectrum_fill(bins, fft_size, sampling_rate, spectrum);
+    
+    PROF_STOP(PROF_FFT, fft_mark);
+    
+    /* Read every band from the same spectrum */
+    for (size_t b = 0; b < num_bands; b++) {
+        band_powers[b] = calculate_band_power_psd(spectrum, bands[b].low_freq,
+                                                  bands[b].high_freq);
+    }
+}
+
+/* FFT size used for a signal of length samples (real FFT needs at least 2 points) */
+static size_t band_power_fft_size(size_t length) {
+    size_t fft_size = next_power_of_2(length);
+    return (fft_size < 2) ? 2 : fft_size;
+}
+
+bool_t calculate_band_powers_fft(const signal_t *signal, size_t length,
+                                 float sampling_rate, const frequency_band_t *bands,
+                                 size_t num_bands, float *band_powers) {
+    if (signal == NULL || bands == NULL || band_powers == NULL || length == 0) {
+        return FALSE;
     }
     
-    /* Copy signal and zero-pad */
-    memcpy(padded_signal, signal, length * sizeof(signal_t));
+    /* Ensure FFT size is power of 2 */
+    size_t fft_size = band_power_fft_size(length);
     
-    /* Apply Hanning window to reduce spectral leakage */
-    apply_hanning_window(padded_signal, length);
+    /* Common case: static workspace, no heap traffic */
+    if (fft_size == WINDOW_SIZE) {
+        return calculate_band_powers_fft_ws(fft_default_workspace(), signal, length,
+                                            sampling_rate, bands, num_bands, band_powers);
+    }
     
-    /* Compute FFT */
-    fft_compute(padded_signal, fft_result, fft_size);
+    const fft_plan_t *plan = fft_get_plan(fft_size);
+    const signal_t *window = hann_window_table(length);
     
-    /* Calculate power spectrum */
+    /* Allocate buffers (shared by all bands); real FFT needs only n/2+1 bins */
     power_spectrum_t spectrum;
-    calculate_power_spectrum(fft_result, fft_size, sampling_rate, &spectrum);
+    size_t num_bins = fft_size / 2 + 1;
+    signal_t *padded_signal = (signal_t*)malloc(fft_size * sizeof(signal_t));
+    complex_t *fft_result = (complex_t*)malloc(num_bins * sizeof(complex_t));
+    spectrum.power = (float*)malloc(num_bins * sizeof(float));
+    spectrum.num_bins = num_bins;
     
-    /* Get band power */
-    float band_power = calculate_band_power_psd(&spectrum, low_freq, high_freq);
+    bool_t ok = (plan != NULL && window != NULL && padded_signal != NULL && fft_result != NULL &&
+                 spectrum.power != NULL) ? TRUE : FALSE;
+    
+    if (ok) {
+        band_powers_compute(plan, padded_signal, fft_result, &spectrum, window, signal,
+                            length, sampling_rate, bands, num_bands, band_powers);
+    } else {
+        log_error("Failed to allocate FFT buffers");
+        for (size_t b = 0; b < num_bands; b++) {
+            band_powers[b] = 0.0f;
+        }
+    }
     
     /* Cleanup */
     free_power_spectrum(&spectrum);
     free(padded_signal);
     free(fft_result);
     
-    return band_power;
+    return ok;
+}
+
+/* ========== Workspaces ========== */
+
+/* Static backing store for the default workspace */
+static uint8_t default_workspace_memory[FFT_WORKSPACE_BYTES(WINDOW_SIZE)];
+static fft_workspace_t default_workspace;
+static bool_t default_workspace_ready = FALSE;
+
+static bool_t workspace_init(fft_workspace_t *ws, dsp_arena_t *arena, size_t max_length,
+                             bool_t share_default_plan) {
+    if (ws == NULL || arena == NULL || max_length == 0) {
+        return FALSE;
+    }
+    
+    size_t fft_size = band_power_fft_size(max_length);
+    size_t num_bins = fft_size / 2 + 1;
+    size_t mark = dsp_arena_mark(arena);
+    
+    if (fft_size > FFT_MAX_SIZE) {
+        log_error("Workspace FFT size %zu exceeds %d", fft_size, FFT_MAX_SIZE);
+        return FALSE;
+    }
+    
+    ws->fft_size = fft_size;
+    ws->windowed = (signal_t*)dsp_arena_alloc(arena, fft_size * sizeof(signal_t));
+    ws->window = (signal_t*)dsp_arena_alloc(arena, fft_size * sizeof(signal_t));
+    ws->window_length = 0;
+    ws->bins = (complex_t*)dsp_arena_alloc(arena, num_bins * sizeof(complex_t));
+    ws->spectrum.power = (float*)dsp_arena_alloc(arena, num_bins * sizeof(float));
+    ws->spectrum.num_bins = num_bins;
+    ws->spectrum.frequency_resolution = 0.0f;
+    
+    if (fft_size == WINDOW_SIZE && share_default_plan) {
+        /* Share the static default tables */
+        ws->plan = *fft_get_plan(WINDOW_SIZE);
+    } else {
+        ws->plan.n = fft_size;
+        ws->plan.owns_tables = FALSE;
+        ws->plan.twiddles = (complex_t*)dsp_arena_alloc(arena, fft_size / 2 * sizeof(complex_t));
+        ws->plan.bitrev = (uint16_t*)dsp_arena_alloc(arena, fft_size * sizeof(uint16_t));
+        if (ws->plan.twiddles != NULL && ws->plan.bitrev != NULL) {
+            fft_plan_fill_tables(&ws->plan);
+        }
+    }
+    
+    if (ws->windowed == NULL || ws->window == NULL || ws->bins == NULL || ws->spectrum.power == NULL ||
+        ws->plan.twiddles == NULL || ws->plan.bitrev == NULL) {
+        log_error("Arena too small for FFT workspace of size %zu", fft_size);
+        dsp_arena_release(arena, mark);
+        ws->fft_size = 0;
+        return FALSE;
+    }
+    
+    return TRUE;
+}
+
+bool_t fft_workspace_init(fft_workspace_t *ws, dsp_arena_t *arena, size_t max_length) {
+    return workspace_init(ws, arena, max_length, TRUE);
+}
+
+bool_t fft_workspace_init_private(fft_workspace_t *ws, dsp_arena_t *arena, size_t max_length) {
+    return workspace_init(ws, arena, max_length, FALSE);
+}
+
+fft_workspace_t* fft_default_workspace(void) {
+    if (!default_workspace_ready) {
+        dsp_arena_t arena;
+        dsp_arena_init(&arena, default_workspace_memory, sizeof(default_workspace_memory));
+        default_workspace_ready = fft_workspace_init(&default_workspace, &arena, WINDOW_SIZE);
+    }
+    
+    return default_workspace_ready ? &default_workspace : NULL;
+}
+
+bool_t calculate_band_powers_fft_ws(fft_workspace_t *ws, const signal_t *signal,
+                                    size_t length, float sampling_rate,
+                                    const frequency_band_t *bands, size_t num_bands,
+                                    float *band_powers) {
+    if (ws == NULL || signal == NULL || bands == NULL || band_powers == NULL ||
+        length == 0) {
+        return FALSE;
+    }
+    
+    if (band_power_fft_size(length) != ws->fft_size) {
+        log_error("Workspace sized for FFT %zu, signal needs %zu",
+                  ws->fft_size, band_power_fft_size(length));
+        return FALSE;
+    }
+    
+    /* The window table is rebuilt only when the signal length changes */
+    if (ws->window_length != length) {
+        hann_window_fill(ws->window, length);
+        ws->window_length = length;
+    }
+    
+    band_powers_compute(&ws->plan, ws->windowed, ws->bins, &ws->spectrum, ws->window,
+                        signal, length, sampling_rate, bands, num_bands, band_powers);
+    
+    return TRUE;
 }
 
 void free_power_spectrum(power_spectrum_t *spectrum) {
@@ -290,10 +635,6 @@ void free_power_spectrum(power_spectrum_t *spectrum) {
             free(spectrum->power);
             spectrum->power = NULL;
         }
-        if (spectrum->frequencies != NULL) {
-            free(spectrum->frequencies);
-            spectrum->frequencies = NULL;
-        }
         spectrum->num_bins = 0;
     }
 }
@@ -309,6 +650,40 @@ size_t get_frequency_bin(float frequency, float sampling_rate, size_t fft_size)
     return (size_t)(frequency / freq_res + 0.5f);
 }
 
+size_t get_frequency_bin_range(float low_freq, float high_freq, float sampling_rate,
+                               size_t fft_size, size_t *first_bin) {
+    float freq_res = get_frequency_resolution(fft_size, sampling_rate);
+    size_t nyquist_bin = fft_size / 2;
+    
+    *first_bin = 0;
+    if (high_freq < low_freq || high_freq < 0.0f) {
+        return 0;
+    }
+    
+    /* Nearest bins, nudged so the range is exactly the bins in [low, high] */
+    size_t low_bin = (low_freq > 0.0f) ? get_frequency_bin(low_freq, sampling_rate, fft_size) : 0;
+    size_t high_bin = get_frequency_bin(high_freq, sampling_rate, fft_size);
+    
+    if (low_bin * freq_res < low_freq) {
+        low_bin++;
+    }
+    if (high_bin > 0 && high_bin * freq_res > high_freq) {
+        high_bin--;
+    }
+    if (high_bin > nyquist_bin) {
+        high_bin = nyquist_bin;
+    }
+    if (low_bin > high_bin) {
+        return 0;
+    }
+    
+    *first_bin = low_bin;
+    return high_bin - low_bin + 1;
+}
+
 void fft_cleanup(void) {
-    /* Nothing to cleanup for now */
+    fft_plan_destroy(&cached_plan);
+    free(cached_hann);
+    cached_hann = NULL;
+    cached_hann_length = 0;
 }
@@ -0,0 +1,323 @@
+#include "fixed_point.h"
+#include "feature_extraction.h"
+#include "fft.h"
+#include "utils.h"
+#include <math.h>
+
+/* Tables built once by fixed_point_init (the only float code in this file
+ * besides the conversion helpers) */
+static complex_q15_t twiddles[FIXED_FFT_MAX_SIZE / 2];
+static q15_t hann_window[WINDOW_SIZE];
+static size_t band_first_bin[NUM_BANDS];
+static size_t band_num_bins[NUM_BANDS];
+static bool_t tables_ready = FALSE;
+
+/* ========== Integer Helpers ========== */
+
+static q15_t saturate_q15(q31_t value) {
+    if (value > Q15_ONE) return Q15_ONE;
+    if (value < -Q15_ONE - 1) return -Q15_ONE - 1;
+    return (q15_t)value;
+}
+
+static q15_t saturate_q15_wide(int64_t value) {
+    if (value > Q15_ONE) return Q15_ONE;
+    if (value < -Q15_ONE - 1) return -Q15_ONE - 1;
+    return (q15_t)value;
+}
+
+/* Q15 x Q15 -> Q15 with rounding */
+static q31_t q15_mul(q31_t a, q31_t b) {
+    return (a * b + (1 << 14)) >> 15;
+}
+
+/* Signed division rounded to nearest */
+static int64_t div_round(int64_t numerator, int64_t denominator) {
+    return (numerator >= 0) ? (numerator + denominator / 2) / denominator
+                            : (numerator - denominator / 2) / denominator;
+}
+
+uint32_t fixed_isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/* ========== Setup and Conversion ========== */
+
+void fixed_point_init(void) {
+    if (tables_ready) {
+        return;
+    }
+
+    for (size_t k = 0; k < FIXED_FFT_MAX_SIZE / 2; k++) {
+        float angle = -2.0f * M_PI * k / FIXED_FFT_MAX_SIZE;
+        twiddles[k].real = saturate_q15((q31_t)lrintf(cosf(angle) * 32768.0f));
+        twiddles[k].imag = saturate_q15((q31_t)lrintf(sinf(angle) * 32768.0f));
+    }
+
+    /* Same symmetric Hann window as apply_hanning_window */
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        float w = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (WINDOW_SIZE - 1)));
+        hann_window[i] = saturate_q15((q31_t)lrintf(w * 32768.0f));
+    }
+
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        band_num_bins[b] = get_frequency_bin_range(eeg_bands[b].low_freq, eeg_bands[b].high_freq,
+                                                   SAMPLING_RATE, WINDOW_SIZE,
+                                                   &band_first_bin[b]);
+    }
+
+    tables_ready = TRUE;
+}
+
+void fixed_from_signal(const signal_t *input, q15_t *output, size_t length, float full_scale) {
+    float scale = 32768.0f / full_scale;
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = saturate_q15((q31_t)lrintf(input[i] * scale));
+    }
+}
+
+void fixed_to_signal(const q15_t *input, signal_t *output, size_t length, float full_scale) {
+    float scale = full_scale / 32768.0f;
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = input[i] * scale;
+    }
+}
+
+void features_from_q15(const features_q15_t *fixed, features_t *features) {
+    features->theta_power = fixed->theta_power / 32768.0f;
+    features->alpha_power = fixed->alpha_power / 32768.0f;
+    features->beta_power = fixed->beta_power / 32768.0f;
+    features->gamma_power = fixed->gamma_power / 32768.0f;
+    features->peak_amplitude = (float)fixed->peak_amplitude / FIXED_SIGMA;
+    features->variance = (float)fixed->variance / ((float)FIXED_SIGMA * FIXED_SIGMA);
+    features->skewness = (float)fixed->skewness / FIXED_SIGMA;
+}
+
+/* ========== Preprocessing ========== */
+
+void preprocess_signal_q15(q15_t *signal, size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    /* Step 1: Baseline from the first BASELINE_SAMPLES samples */
+    size_t baseline_count = (length < BASELINE_SAMPLES) ? length : BASELINE_SAMPLES;
+    q31_t baseline_sum = 0;
+    for (size_t i = 0; i < baseline_count; i++) {
+        baseline_sum += signal[i];
+    }
+    q31_t baseline = (q31_t)div_round(baseline_sum, (int64_t)baseline_count);
+
+    /* Pass 1: moving average minus baseline, backwards and in place (as in
+     * preprocess_and_measure), accumulating the raw moments */
+    size_t window = (MA_FILTER_SIZE > length) ? length : MA_FILTER_SIZE;
+    q31_t sum = 0;
+    for (size_t i = length - window; i < length; i++) {
+        sum += signal[i];
+    }
+
+    int64_t s1 = 0;
+    int64_t s2 = 0;
+    for (size_t i = length; i-- > 0; ) {
+        q15_t current = signal[i];
+        size_t count = (i + 1 < window) ? i + 1 : window;
+        q15_t y = saturate_q15((q31_t)div_round(sum, (int64_t)count) - baseline);
+
+        signal[i] = y;
+        s1 += y;
+        s2 += (q31_t)y * y;
+
+        sum -= current;
+        if (i >= window) {
+            sum += signal[i - window];
+        }
+    }
+
+    /* Pass 2: zero mean, FIXED_SIGMA per standard deviation */
+    int64_t n = (int64_t)length;
+    q31_t mean = (q31_t)div_round(s1, n);
+    int64_t variance = s2 / n - (int64_t)mean * mean;
+    uint32_t std_dev = fixed_isqrt((variance > 0) ? (uint64_t)variance : 0);
+
+    if (std_dev == 0) {
+        for (size_t i = 0; i < length; i++) {
+            signal[i] = saturate_q15(signal[i] - mean);
+        }
+        return;
+    }
+
+    /* Q16 gain: one division per window instead of one per sample */
+    int64_t gain = ((int64_t)FIXED_SIGMA << 16) / std_dev;
+    for (size_t i = 0; i < length; i++) {
+        int64_t scaled = ((int64_t)(signal[i] - mean) * gain + (1 << 15)) >> 16;
+        signal[i] = saturate_q15_wide(scaled);
+    }
+}
+
+/* ========== Fixed-Point FFT ========== */
+
+/* Right shift that brings every component below Q15 0.25, so one butterfly
+ * (|u + w*b| <= 0.25 + 0.25*sqrt(2)) cannot overflow */
+static int block_shift(const complex_q15_t *data, size_t n) {
+    q31_t max_value = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        q31_t re = (data[i].real < 0) ? -(q31_t)data[i].real : data[i].real;
+        q31_t im = (data[i].imag < 0) ? -(q31_t)data[i].imag : data[i].imag;
+        if (re > max_value) max_value = re;
+        if (im > max_value) max_value = im;
+    }
+
+    int shift = 0;
+    while ((max_value >> shift) >= (Q15_HALF >> 1)) {
+        shift++;
+    }
+    return shift;
+}
+
+bool_t fft_compute_q15(const q15_t *input, complex_q15_t *output, size_t n,
+                       int *block_exponent) {
+    if (!is_power_of_2(n) || n < 2 || n > FIXED_FFT_MAX_SIZE) {
+        log_error("Fixed-point FFT size must be power of 2 in [2, %d], got %zu",
+                  FIXED_FFT_MAX_SIZE, n);
+        return FALSE;
+    }
+    fixed_point_init();
+
+    size_t log2n = 0;
+    while (((size_t)1 << log2n) < n) {
+        log2n++;
+    }
+
+    /* Bit-reversal permutation */
+    for (size_t i = 0; i < n; i++) {
+        size_t j = bit_reverse(i, log2n);
+        output[j].real = input[i];
+        output[j].imag = 0;
+    }
+
+    /* Radix-2 stages, each scaled just enough to stay in range */
+    int exponent = 0;
+    for (size_t m = 2; m <= n; m <<= 1) {
+        size_t half = m >> 1;
+        size_t step = FIXED_FFT_MAX_SIZE / m;
+        int shift = block_shift(output, n);
+        exponent += shift;
+
+        for (size_t k = 0; k < n; k += m) {
+            for (size_t j = 0; j < half; j++) {
+                complex_q15_t w = twiddles[j * step];
+                complex_q15_t *top = &output[k + j];
+                complex_q15_t *bottom = &output[k + j + half];
+
+                q31_t u_real = top->real >> shift;
+                q31_t u_imag = top->imag >> shift;
+                q31_t b_real = bottom->real >> shift;
+                q31_t b_imag = bottom->imag >> shift;
+
+                q31_t t_real = q15_mul(b_real, w.real) - q15_mul(b_imag, w.imag);
+                q31_t t_imag = q15_mul(b_real, w.imag) + q15_mul(b_imag, w.real);
+
+                top->real = (q15_t)(u_real + t_real);
+                top->imag = (q15_t)(u_imag + t_imag);
+                bottom->real = (q15_t)(u_real - t_real);
+                bottom->imag = (q15_t)(u_imag - t_imag);
+            }
+        }
+    }
+
+    if (block_exponent != NULL) {
+        *block_exponent = exponent;
+    }
+    return TRUE;
+}
+
+/* ========== Feature Extraction ========== */
+
+void extract_features_q15(const q15_t *signal, size_t length, features_q15_t *features) {
+    /* Scratch in static storage, like the default FFT workspace (not reentrant) */
+    static q15_t windowed[WINDOW_SIZE];
+    static complex_q15_t bins[WINDOW_SIZE];
+
+    if (length != WINDOW_SIZE) {
+        log_error("Fixed-point features need %d samples, got %zu", WINDOW_SIZE, length);
+        return;
+    }
+    fixed_point_init();
+
+    /* Time-domain features: peak, variance and skewness in one pass */
+    q31_t peak = 0;
+    int64_t s2 = 0;
+    int64_t s3 = 0;
+    for (size_t i = 0; i < length; i++) {
+        q31_t x = signal[i];
+        q31_t abs_x = (x < 0) ? -x : x;
+        if (abs_x > peak) {
+            peak = abs_x;
+        }
+        s2 += x * x;
+        s3 += (int64_t)(x * x) * x;
+
+        windowed[i] = (q15_t)q15_mul(x, hann_window[i]);
+    }
+
+    features->peak_amplitude = saturate_q15(peak);
+    features->variance = (q31_t)(s2 / (int64_t)length);
+    /* Unit variance after preprocessing: E[x^3] / sigma^3 * FIXED_SIGMA */
+    features->skewness = saturate_q15_wide((s3 / (int64_t)length) >>
+                                           (2 * FIXED_SIGMA_SHIFT));
+
+    /* Band powers: the block exponent is shared by all bins and cancels
+     * in the ratios, so the raw |X|^2 sums are compared directly */
+    fft_compute_q15(windowed, bins, length, NULL);
+
+    uint64_t band_power[NUM_BANDS];
+    uint64_t total_power = 0;
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        band_power[b] = 0;
+        for (size_t k = band_first_bin[b]; k < band_first_bin[b] + band_num_bins[b]; k++) {
+            uint32_t re = (uint32_t)((q31_t)bins[k].real * bins[k].real);
+            uint32_t im = (uint32_t)((q31_t)bins[k].imag * bins[k].imag);
+            uint64_t power = (uint64_t)re + im;
+
+            /* DC and Nyquist count once, others twice (as in the float spectrum) */
+            band_power[b] += (k == 0 || k == length / 2) ? power : 2 * power;
+        }
+        total_power += band_power[b];
+    }
+
+    q15_t ratios[NUM_BANDS];
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        if (total_power == 0) {
+            /* No significant power detected, set to neutral values */
+            ratios[b] = Q15_FROM_FLOAT(1.0f / NUM_BANDS);
+        } else {
+            uint64_t ratio = (band_power[b] << 15) / total_power;
+            ratios[b] = (ratio > Q15_ONE) ? Q15_ONE : (q15_t)ratio;
+        }
+    }
+
+    features->theta_power = ratios[BAND_THETA];
+    features->alpha_power = ratios[BAND_ALPHA];
+    features->beta_power = ratios[BAND_BETA];
+    features->gamma_power = ratios[BAND_GAMMA];
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
 /* ========== LDA Initialization ========== */
 
@@ -19,103 +20,222 @@ void lda_init(lda_model_t *model, size_t num_features) {
     }
 }
 
-/* ========== Helper Functions ========== */
+/* ========== Scatter Accumulation ========== */
 
-static void compute_mean(lda_sample_t *samples, size_t num_samples, 
-                        int target_label, signal_t *mean, size_t num_features) {
-    /* Initialize mean to zero */
-    for (size_t i = 0; i < num_features; i++) {
-        mean[i] = 0.0f;
+bool_t lda_scatter_init(lda_scatter_t *scatter, size_t num_features, size_t num_classes) {
+    if (num_features == 0 || num_features > LDA_MAX_FEATURES ||
+        num_classes == 0 || num_classes > LDA_MAX_CLASSES) {
+        log_error("LDA supports 1-%d features and 1-%d classes, got %zu and %zu",
+                  LDA_MAX_FEATURES, LDA_MAX_CLASSES, num_features, num_classes);
+        return FALSE;
     }
     
-    /* Sum features for target class */
-    size_t count = 0;
-    for (size_t i = 0; i < num_samples; i++) {
-        if (samples[i].label == target_label) {
-            for (size_t j = 0; j < num_features; j++) {
-                mean[j] += samples[i].features[j];
-            }
-            count++;
+    memset(scatter, 0, sizeof(*scatter));
+    scatter->num_features = num_features;
+    scatter->num_classes = num_classes;
+    return TRUE;
+}
+
+bool_t lda_scatter_add(lda_scatter_t *scatter, const signal_t *features, int label) {
+    if (label < 0 || (size_t)label >= scatter->num_classes) {
+        return FALSE;
+    }
+    
+    size_t n = scatter->num_features;
+    float *mean = scatter->mean[label];
+    float inv_count = 1.0f / (float)(++scatter->count[label]);
+    float before[LDA_MAX_FEATURES];
+    float after[LDA_MAX_FEATURES];
+    
+    /* Welford: the scatter grows by (x - old mean)(x - new mean)^T, which
+     * stays accurate where sum(x x^T) - n mean mean^T would cancel */
+    for (size_t i = 0; i < n; i++) {
+        before[i] = features[i] - mean[i];
+        mean[i] += before[i] * inv_count;
+        after[i] = features[i] - mean[i];
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        float *row = scatter->scatter[i];
+        for (size_t j = i; j < n; j++) {
+            row[j] += before[i] * after[j];
         }
     }
     
-    /* Divide by count */
-    if (count > 0) {
-        for (size_t i = 0; i < num_features; i++) {
-            mean[i] /= count;
+    return TRUE;
+}
+
+size_t lda_scatter_add_rows(lda_scatter_t *scatter, const signal_t *rows,
+                            const int *labels, size_t num_rows) {
+    size_t added = 0;
+    
+    for (size_t r = 0; r < num_rows; r++) {
+        if (lda_scatter_add(scatter, &rows[r * scatter->num_features], labels[r])) {
+            added++;
         }
     }
+    
+    return added;
 }
 
-static float compute_within_class_variance(lda_sample_t *samples, size_t num_samples,
-                                          const signal_t *mean, size_t num_features) {
-    float variance = 0.0f;
-    size_t count = 0;
+/* ========== Regularized Solve ========== */
+
+/* Shrunk within-class covariance in Cholesky form. The covariance is
+ * diagonally scaled to a correlation matrix first, so features with very
+ * different units (band ratios next to raw variance) condition equally
+ * and shrinkage pulls correlations, not magnitudes, toward zero */
+typedef struct {
+    size_t n;
+    float scale[LDA_MAX_FEATURES];                 /* 1 / standard deviation */
+    float lower[LDA_MAX_FEATURES][LDA_MAX_FEATURES];
+} lda_solver_t;
+
+/* Factor the covariance scatter * inv_dof (upper triangle of scatter used) */
+static bool_t lda_solver_factor(lda_solver_t *solver,
+                                const float scatter[][LDA_MAX_FEATURES], size_t n,
+                                float inv_dof, float shrinkage) {
+    float max_variance = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float variance = scatter[i][i] * inv_dof;
+        max_variance = (variance > max_variance) ? variance : max_variance;
+    }
     
-    for (size_t i = 0; i < num_samples; i++) {
-        for (size_t j = 0; j < num_features; j++) {
-            float diff = samples[i].features[j] - mean[j];
-            variance += diff * diff;
+    /* Constant features get a variance floor instead of an infinite weight */
+    float floor = max_variance * 1e-6f + 1e-20f;
+    for (size_t i = 0; i < n; i++) {
+        float variance = scatter[i][i] * inv_dof;
+        solver->scale[i] = 1.0f / sqrtf((variance > floor) ? variance : floor);
+    }
+    
+    if (shrinkage < 0.0f) shrinkage = 0.0f;
+    if (shrinkage > 1.0f) shrinkage = 1.0f;
+    
+    /* Cholesky factorization of (1 - shrinkage) R + shrinkage I */
+    solver->n = n;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            float value = (i == j) ? 1.0f :
+                          (1.0f - shrinkage) * scatter[j][i] * inv_dof *
+                          solver->scale[i] * solver->scale[j];
+            for (size_t k = 0; k < j; k++) {
+                value -= solver->lower[i][k] * solver->lower[j][k];
+            }
+            
+            if (i == j) {
+                if (value <= 1e-6f) {
+                    log_error("LDA covariance is singular; raise the shrinkage");
+                    return FALSE;
+                }
+                solver->lower[i][i] = sqrtf(value);
+            } else {
+                solver->lower[i][j] = value / solver->lower[j][j];
+            }
         }
-        count++;
     }
     
-    return (count > 0) ? (variance / count) : 1.0f;
+    return TRUE;
+}
+
+static bool_t lda_solver_init(lda_solver_t *solver, const lda_scatter_t *scatter,
+                              float shrinkage) {
+    size_t total = 0;
+    size_t classes = 0;
+    
+    for (size_t c = 0; c < scatter->num_classes; c++) {
+        total += scatter->count[c];
+        classes += (scatter->count[c] > 0) ? 1 : 0;
+    }
+    if (total == 0) {
+        return FALSE;
+    }
+    
+    /* Pooled covariance divides by the degrees of freedom left after the means */
+    float inv_dof = 1.0f / (float)((total > classes) ? total - classes : total);
+    return lda_solver_factor(solver, (const float (*)[LDA_MAX_FEATURES])scatter->scatter,
+                             scatter->num_features, inv_dof, shrinkage);
+}
+
+/* result = Sigma^-1 vector */
+static void lda_solver_apply(const lda_solver_t *solver, const float *vector, float *result) {
+    size_t n = solver->n;
+    float y[LDA_MAX_FEATURES];
+    
+    /* Forward substitution: L y = D^-1/2 v */
+    for (size_t i = 0; i < n; i++) {
+        float value = vector[i] * solver->scale[i];
+        for (size_t k = 0; k < i; k++) {
+            value -= solver->lower[i][k] * y[k];
+        }
+        y[i] = value / solver->lower[i][i];
+    }
+    
+    /* Back substitution: L^T z = y, then undo the scaling */
+    for (size_t i = n; i-- > 0;) {
+        float value = y[i];
+        for (size_t k = i + 1; k < n; k++) {
+            value -= solver->lower[k][i] * y[k];
+        }
+        y[i] = value / solver->lower[i][i];
+        result[i] = y[i] * solver->scale[i];
+    }
 }
 
 /* ========== LDA Training (Fisher's Linear Discriminant) ========== */
 
 bool_t lda_train(lda_model_t *model, lda_sample_t *samples, size_t num_samples) {
-    if (model == NULL || samples == NULL || num_samples == 0) {
+    if (model == NULL || model->projection == NULL || samples == NULL || num_samples == 0) {
         return FALSE;
     }
     
     size_t n = model->num_features;
+    lda_scatter_t scatter;
+    lda_solver_t solver;
+    
+    if (!lda_scatter_init(&scatter, n, 2)) {
+        return FALSE;
+    }
     
-    /* Allocate temporary arrays */
-    signal_t *mean0 = (signal_t*)malloc(n * sizeof(signal_t));
-    signal_t *mean1 = (signal_t*)malloc(n * sizeof(signal_t));
+    /* One pass over the samples accumulates both means and the scatter */
+    for (size_t i = 0; i < num_samples; i++) {
+        lda_scatter_add(&scatter, samples[i].features, samples[i].label);
+    }
     
-    if (mean0 == NULL || mean1 == NULL) {
-        free(mean0);
-        free(mean1);
+    if (scatter.count[0] == 0 || scatter.count[1] == 0) {
+        log_error("LDA training needs samples of both classes");
         return FALSE;
     }
     
-    /* Compute mean vectors for each class */
-    compute_mean(samples, num_samples, 0, mean0, n);
-    compute_mean(samples, num_samples, 1, mean1, n);
+    if (!lda_solver_init(&solver, &scatter, LDA_DEFAULT_SHRINKAGE)) {
+        return FALSE;
+    }
     
-    /* Fisher's LDA: w = (mean1 - mean0) / (variance0 + variance1) */
-    /* Simplified version: w ∝ (mean1 - mean0) */
+    /* Fisher's LDA: w = S_w^-1 (mean1 - mean0) */
+    float difference[LDA_MAX_FEATURES];
+    for (size_t i = 0; i < n; i++) {
+        difference[i] = scatter.mean[1][i] - scatter.mean[0][i];
+    }
+    lda_solver_apply(&solver, difference, model->projection);
     
-    /* Calculate mean difference */
+    /* Normalize projection vector */
     float norm = 0.0f;
     for (size_t i = 0; i < n; i++) {
-        model->projection[i] = mean1[i] - mean0[i];
         norm += model->projection[i] * model->projection[i];
     }
-    
-    /* Normalize projection vector */
     norm = sqrtf(norm);
-    if (norm > 0.0001f) {
+    if (norm > 0.0f) {
         for (size_t i = 0; i < n; i++) {
             model->projection[i] /= norm;
         }
     }
     
     /* Calculate threshold as midpoint between projected means */
-    float projected_mean0 = 0.0f,projected_mean1 = 0.0f;
+    float projected_mean0 = 0.0f, projected_mean1 = 0.0f;
     for (size_t i = 0; i < n; i++) {
-        projected_mean0 += model->projection[i] * mean0[i];
-        projected_mean1 += model->projection[i] * mean1[i];
+        projected_mean0 += model->projection[i] * scatter.mean[0][i];
+        projected_mean1 += model->projection[i] * scatter.mean[1][i];
     }
     model->threshold = (projected_mean0 + projected_mean1) / 2.0f;
     
-    /* Cleanup */
-    free(mean0);
-    free(mean1);
-    
     model->is_trained = TRUE;
     return TRUE;
 }
@@ -165,3 +285,404 @@ void lda_free(lda_model_t *model) {
         model->is_trained = FALSE;
     }
 }
+
+/* ========== Multi-Class LDA ========== */
+
+bool_t lda_multiclass_fit(lda_multiclass_t *model, const lda_scatter_t *scatter,
+                          float shrinkage) {
+    lda_solver_t solver;
+    size_t n = scatter->num_features;
+    size_t total = 0;
+    
+    model->is_trained = FALSE;
+    if (!lda_solver_init(&solver, scatter, shrinkage)) {
+        return FALSE;
+    }
+    
+    for (size_t c = 0; c < scatter->num_classes; c++) {
+        total += scatter->count[c];
+    }
+    
+    model->num_features = n;
+    model->num_classes = scatter->num_classes;
+    for (size_t c = 0; c < scatter->num_classes; c++) {
+        float *weights = model->weights[c];
+        
+        if (scatter->count[c] == 0) {
+            /* Unseen class: never predicted */
+            memset(weights, 0, sizeof(model->weights[c]));
+            model->bias[c] = -FLT_MAX;
+            continue;
+        }
+        
+        /* score_c(x) = x' S^-1 m_c - m_c' S^-1 m_c / 2 + ln(prior_c) */
+        lda_solver_apply(&solver, scatter->mean[c], weights);
+        float self = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            self += weights[i] * scatter->mean[c][i];
+        }
+        model->bias[c] = -0.5f * self + logf((float)scatter->count[c] / (float)total);
+    }
+    
+    model->is_trained = TRUE;
+    return TRUE;
+}
+
+bool_t lda_train_multiclass(lda_multiclass_t *model, const signal_t *rows,
+                            const int *labels, size_t num_rows,
+                            size_t num_features, size_t num_classes, float shrinkage) {
+    lda_scatter_t scatter;
+    
+    if (model == NULL || rows == NULL || labels == NULL ||
+        !lda_scatter_init(&scatter, num_features, num_classes)) {
+        return FALSE;
+    }
+    
+    lda_scatter_add_rows(&scatter, rows, labels, num_rows);
+    return lda_multiclass_fit(model, &scatter, shrinkage);
+}
+
+/* Scores of one row; returns the best class */
+static int lda_score_row(const lda_multiclass_t *model, const signal_t *features,
+                         float *scores) {
+    int best = 0;
+    float best_score = -FLT_MAX;
+    
+    for (size_t c = 0; c < model->num_classes; c++) {
+        const float *weights = model->weights[c];
+        float score = model->bias[c];
+        for (size_t i = 0; i < model->num_features; i++) {
+            score += weights[i] * features[i];
+        }
+        
+        scores[c] = score;
+        if (score > best_score) {
+            best_score = score;
+            best = (int)c;
+        }
+    }
+    
+    return best;
+}
+
+int lda_multiclass_predict(const lda_multiclass_t *model, const signal_t *features,
+                           float *scores) {
+    float local[LDA_MAX_CLASSES];
+    
+    if (model == NULL || !model->is_trained) {
+        return -1;
+    }
+    
+    return lda_score_row(model, features, (scores != NULL) ? scores : local);
+}
+
+void lda_predict_batch(const lda_multiclass_t *model, const signal_t *rows, size_t num_rows,
+                       int *predictions, float *scores) {
+    float local[LDA_MAX_CLASSES];
+    
+    if (model == NULL || !model->is_trained) {
+        for (size_t r = 0; r < num_rows; r++) {
+            predictions[r] = -1;
+        }
+        return;
+    }
+    
+    /* Rows stream through once; the C x F weight matrix stays in L1 */
+    size_t n = model->num_features;
+    size_t classes = model->num_classes;
+    for (size_t r = 0; r < num_rows; r++) {
+        float *row_scores = (scores != NULL) ? &scores[r * classes] : local;
+        predictions[r] = lda_score_row(model, &rows[r * n], row_scores);
+    }
+}
+
+/* ========== Online Adaptation ========== */
+
+/* Rescale the scatter to a unit diagonal and invert it exactly by
+ * Cholesky (O(features^3)) */
+static bool_t lda_online_refresh(lda_online_t *online) {
+    lda_solver_t solver;
+    size_t n = online->num_features;
+    float rescale[LDA_MAX_FEATURES];
+    
+    for (size_t i = 0; i < n; i++) {
+        float diagonal = online->scatter[i][i];
+        rescale[i] = (diagonal > 0.0f) ? 1.0f / sqrtf(diagonal) : 1.0f;
+        online->scale[i] *= rescale[i];
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            online->scatter[i][j] *= rescale[i] * rescale[j];
+        }
+    }
+    
+    online->since_refresh = 0;
+    if (!lda_solver_factor(&solver, (const float (*)[LDA_MAX_FEATURES])online->scatter,
+                           n, 1.0f, 0.0f)) {
+        /* Keep the rank-one inverse, moved into the new units */
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                online->inverse[i][j] /= rescale[i] * rescale[j];
+            }
+        }
+        return FALSE;
+    }
+    
+    float unit[LDA_MAX_FEATURES] = { 0 };
+    float column[LDA_MAX_FEATURES];
+    for (size_t j = 0; j < n; j++) {
+        unit[j] = 1.0f;
+        lda_solver_apply(&solver, unit, column);
+        unit[j] = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            online->inverse[i][j] = column[i];
+        }
+    }
+    
+    return TRUE;
+}
+
+/* result = scatter^-1 vector in feature units */
+static void lda_online_solve(const lda_online_t *online, const float *vector, float *result) {
+    size_t n = online->num_features;
+    float scaled[LDA_MAX_FEATURES];
+    
+    for (size_t i = 0; i < n; i++) {
+        scaled[i] = vector[i] * online->scale[i];
+    }
+    for (size_t i = 0; i < n; i++) {
+        float value = 0.0f;
+        for (size_t j = 0; j < n; j++) {
+            value += online->inverse[i][j] * scaled[j];
+        }
+        result[i] = value * online->scale[i];
+    }
+}
+
+/* Discriminants from the running statistics: Sigma^-1 = dof * scatter^-1 */
+static void lda_online_refit(lda_online_t *online) {
+    lda_multiclass_t *model = &online->model;
+    size_t n = online->num_features;
+    float dof = (online->dof > 1.0f) ? online->dof : 1.0f;
+    float total = 0.0f;
+    
+    for (size_t c = 0; c < online->num_classes; c++) {
+        total += online->class_weight[c];
+    }
+    
+    model->num_features = n;
+    model->num_classes = online->num_classes;
+    for (size_t c = 0; c < online->num_classes; c++) {
+        float *weights = model->weights[c];
+        const float *mean = online->mean[c];
+        
+        if (online->class_weight[c] <= 0.0f) {
+            memset(weights, 0, sizeof(model->weights[c]));
+            model->bias[c] = -FLT_MAX;
+            continue;
+        }
+        
+        lda_online_solve(online, mean, weights);
+        float self = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            weights[i] *= dof;
+            self += weights[i] * mean[i];
+        }
+        model->bias[c] = -0.5f * self + logf(online->class_weight[c] / total);
+    }
+    
+    model->is_trained = (total > 0.0f) ? TRUE : FALSE;
+}
+
+static bool_t lda_online_setup(lda_online_t *online, size_t num_features, size_t num_classes,
+                               float forgetting) {
+    if (!(forgetting > 0.0f && forgetting <= 1.0f)) {
+        log_error("LDA forgetting factor must be in (0, 1], got %f", forgetting);
+        return FALSE;
+    }
+    if (num_features == 0 || num_features > LDA_MAX_FEATURES ||
+        num_classes == 0 || num_classes > LDA_MAX_CLASSES) {
+        log_error("LDA supports 1-%d features and 1-%d classes, got %zu and %zu",
+                  LDA_MAX_FEATURES, LDA_MAX_CLASSES, num_features, num_classes);
+        return FALSE;
+    }
+    
+    memset(online, 0, sizeof(*online));
+    online->num_features = num_features;
+    online->num_classes = num_classes;
+    online->forgetting = forgetting;
+    for (size_t i = 0; i < num_features; i++) {
+        online->scale[i] = 1.0f;
+    }
+    return TRUE;
+}
+
+bool_t lda_online_init(lda_online_t *online, size_t num_features, size_t num_classes,
+                       float forgetting, float ridge) {
+    if (!lda_online_setup(online, num_features, num_classes, forgetting)) {
+        return FALSE;
+    }
+    if (!(ridge > 0.0f)) {
+        log_error("LDA ridge must be positive, got %f", ridge);
+        return FALSE;
+    }
+    
+    /* The prior scatter ridge * I is the identity in units of sqrt(ridge) */
+    for (size_t i = 0; i < num_features; i++) {
+        online->scale[i] = 1.0f / sqrtf(ridge);
+        online->scatter[i][i] = 1.0f;
+        online->inverse[i][i] = 1.0f;
+    }
+    lda_online_refit(online);
+    return TRUE;
+}
+
+bool_t lda_online_init_from(lda_online_t *online, const lda_scatter_t *scatter,
+                            float shrinkage, float forgetting) {
+    size_t n = scatter->num_features;
+    size_t total = 0;
+    size_t classes = 0;
+    
+    if (!lda_online_setup(online, n, scatter->num_classes, forgetting)) {
+        return FALSE;
+    }
+    
+    for (size_t c = 0; c < scatter->num_classes; c++) {
+        online->class_weight[c] = (float)scatter->count[c];
+        memcpy(online->mean[c], scatter->mean[c], sizeof(online->mean[c]));
+        total += scatter->count[c];
+        classes += (scatter->count[c] > 0) ? 1 : 0;
+    }
+    online->dof = (float)((total > classes) ? total - classes : total);
+    online->num_updates = total;
+    
+    /* Shrinking the correlations keeps the variances: off-diagonal terms
+     * scale by (1 - shrinkage), matching lda_multiclass_fit */
+    if (shrinkage < 0.0f) shrinkage = 0.0f;
+    if (shrinkage > 1.0f) shrinkage = 1.0f;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i; j < n; j++) {
+            float value = scatter->scatter[i][j] * ((i == j) ? 1.0f : 1.0f - shrinkage);
+            online->scatter[i][j] = value;
+            online->scatter[j][i] = value;
+        }
+    }
+    
+    if (!lda_online_refresh(online)) {
+        return FALSE;
+    }
+    lda_online_refit(online);
+    return TRUE;
+}
+
+bool_t lda_online_update(lda_online_t *online, const signal_t *features, int label) {
+    if (label < 0 || (size_t)label >= online->num_classes) {
+        return FALSE;
+    }
+    
+    size_t n = online->num_features;
+    float lambda = online->forgetting;
+    float *mean = online->mean[label];
+    bool_t seen = (online->class_weight[label] > 0.0f) ? TRUE : FALSE;
+    
+    /* Every class's evidence ages by one window */
+    for (size_t c = 0; c < online->num_classes; c++) {
+        online->class_weight[c] *= lambda;
+    }
+    online->class_weight[label] += 1.0f;
+    online->dof = lambda * online->dof + (seen ? 1.0f : 0.0f);
+    
+    /* Weighted Welford step: mean moves by delta / weight and the scatter
+     * gains (x - old mean)(x - new mean)^T = gain * delta delta^T */
+    float inv_weight = 1.0f / online->class_weight[label];
+    float gain = 1.0f - inv_weight;
+    float delta[LDA_MAX_FEATURES];
+    for (size_t i = 0; i < n; i++) {
+        float difference = features[i] - mean[i];
+        mean[i] += difference * inv_weight;
+        delta[i] = difference * online->scale[i];
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            online->scatter[i][j] = lambda * online->scatter[i][j] + gain * delta[i] * delta[j];
+        }
+    }
+    
+    /* Sherman-Morrison: (lambda S + g d d^T)^-1 =
+     *   (P - (g/lambda) u u^T / (1 + (g/lambda) d^T u)) / lambda, u = P d */
+    float u[LDA_MAX_FEATURES];
+    float d_dot_u = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float value = 0.0f;
+        for (size_t j = 0; j < n; j++) {
+            value += online->inverse[i][j] * delta[j];
+        }
+        u[i] = value;
+        d_dot_u += delta[i] * value;
+    }
+    
+    float g = gain / lambda;
+    float k = g / (1.0f + g * d_dot_u);
+    float inv_lambda = 1.0f / lambda;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            online->inverse[i][j] = (online->inverse[i][j] - k * u[i] * u[j]) * inv_lambda;
+        }
+    }
+    
+    size_t updates = ++online->num_updates;
+    bool_t warming_up = (updates < LDA_ONLINE_REFRESH && (updates & (updates - 1)) == 0) ?
+                        TRUE : FALSE;
+    if (++online->since_refresh >= LDA_ONLINE_REFRESH || warming_up) {
+        lda_online_refresh(online);
+    }
+    
+    lda_online_refit(online);
+    return TRUE;
+}
+
+bool_t lda_online_export(const lda_online_t *online, lda_model_t *model) {
+    size_t n = online->num_features;
+    
+    if (model == NULL || model->projection == NULL || model->num_features != n ||
+        online->num_classes < 2 ||
+        online->class_weight[0] <= 0.0f || online->class_weight[1] <= 0.0f) {
+        return FALSE;
+    }
+    
+    /* w = S^-1 (mean1 - mean0), normalized as in lda_train */
+    float difference[LDA_MAX_FEATURES] = { 0 };
+    for (size_t i = 0; i < n; i++) {
+        difference[i] = online->mean[1][i] - online->mean[0][i];
+    }
+    lda_online_solve(online, difference, model->projection);
+    
+    float norm = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        norm += model->projection[i] * model->projection[i];
+    }
+    norm = sqrtf(norm);
+    
+    float projected_mean0 = 0.0f, projected_mean1 = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        if (norm > 0.0f) {
+            model->projection[i] /= norm;
+        }
+        projected_mean0 += model->projection[i] * online->mean[0][i];
+        projected_mean1 += model->projection[i] * online->mean[1][i];
+    }
+    model->threshold = (projected_mean0 + projected_mean1) / 2.0f;
+    model->is_trained = TRUE;
+    return TRUE;
+}
+
+void lda_feature_vector(const features_t *features, signal_t *vector) {
+    vector[0] = features->theta_power;
+    vector[1] = features->alpha_power;
+    vector[2] = features->beta_power;
+    vector[3] = features->gamma_power;
+    vector[4] = features->peak_amplitude;
+    vector[5] = features->variance;
+    vector[6] = features->skewness;
+}
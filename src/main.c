@@ -8,6 +8,12 @@
 #include "feature_extraction.h"
 #include "classifier.h"
 #include "output_control.h"
+#include "streaming.h"
+#include "fixed_point.h"
+#include "acquisition.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "bci_model.h"
 #include "utils.h"
 
 void print_banner(void) {
@@ -22,18 +28,173 @@ void print_banner(void) {
     printf("\n");
 }
 
+/* Decision thresholds: config.h defaults, or a model's (--model PATH) */
+static bci_model_file_t model_file;
+static const classifier_thresholds_t *thresholds = &classifier_default_thresholds;
+
 void print_system_info(void) {
     printf("%s[SYSTEM INFO]%s\n", COLOR_MAGENTA, COLOR_RESET);
     printf("  Sampling Rate:    %d Hz\n", SAMPLING_RATE);
     printf("  Window Size:      %d samples\n", WINDOW_SIZE);
     printf("  Alpha Band:       %.1f - %.1f Hz\n", ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
     printf("  Beta Band:        %.1f - %.1f Hz\n", BETA_LOW_FREQ, BETA_HIGH_FREQ);
-    printf("  Focus Threshold:  %.2f\n", FOCUS_THRESHOLD);
-    printf("  Relax Threshold:  %.2f\n", RELAX_THRESHOLD);
-    printf("  Blink Threshold:  %.2f\n", BLINK_THRESHOLD);
+    printf("  Focus Threshold:  %.2f\n", thresholds->focus);
+    printf("  Relax Threshold:  %.2f\n", thresholds->relax);
+    printf("  Blink Threshold:  %.2f\n", thresholds->blink);
     printf("\n");
 }
 
+/* One acquisition at a time; static so embedded stacks stay small */
+static acquisition_t acq;
+static acq_simulator_t simulator;
+
+/* Output devices behind their command queue */
+static output_controller_t outputs;
+static bool_t outputs_threaded = FALSE;
+
+/* Binary telemetry (--telemetry DEST); NULL when off */
+static telemetry_t telemetry_stream;
+static telemetry_t *telemetry = NULL;
+
+/* One telemetry frame per classified window, with its health predictions
+ * samples: Still held from the acquisition (at most WINDOW_SIZE)
+ */
+static void send_telemetry(const acq_sample_t *samples, size_t count, uint32_t first_sample,
+                           const features_t *features, command_t command,
+                           const output_state_t *output_state) {
+    if (telemetry == NULL) {
+        return;
+    }
+    
+    predictions_t predictions;
+    predict_impairments_with(thresholds, features, &predictions);
+    
+#if USE_FIXED_POINT
+    /* Frames carry microvolts */
+    signal_t microvolts[WINDOW_SIZE];
+    count = (count < WINDOW_SIZE) ? count : WINDOW_SIZE;
+    acq_samples_to_signal(samples, microvolts, count);
+    telemetry_record_t record = { microvolts, count, first_sample, features, command,
+                                  output_state, &predictions };
+#else
+    telemetry_record_t record = { samples, count, first_sample, features, command,
+                                  output_state, &predictions };
+#endif
+    telemetry_send(telemetry, &record);
+}
+
+/* Fresh classifier on the active thresholds */
+static void start_classifier(classifier_state_t *state) {
+    classifier_init(state);
+    if (model_file.model != NULL) {
+        bci_model_apply_thresholds(model_file.model, state);
+    }
+}
+
+/* Steps 2-4 on one raw window: preprocess, extract features, classify
+ * USE_FIXED_POINT builds run the Q15 pipeline straight on the acquired Q15
+ * samples; features then receives the float view of the fixed-point
+ * features, for display only
+ */
+static command_t process_window(const acq_sample_t *raw, features_t *features,
+                                classifier_state_t *classifier_state) {
+    command_t command;
+#if USE_FIXED_POINT
+    q15_t fixed_buffer[WINDOW_SIZE];
+    features_q15_t fixed_features;
+    
+    PROF_START(preprocess_mark);
+    memcpy(fixed_buffer, raw, WINDOW_SIZE * sizeof(q15_t));
+    preprocess_signal_q15(fixed_buffer, WINDOW_SIZE);
+    PROF_STOP(PROF_PREPROCESS, preprocess_mark);
+    
+    PROF_START(features_mark);
+    extract_features_q15(fixed_buffer, WINDOW_SIZE, &fixed_features);
+    features_from_q15(&fixed_features, features);
+    PROF_STOP(PROF_FEATURES, features_mark);
+    
+    PROF_START(classify_mark);
+    command = classify_command_q15(&fixed_features, classifier_state);
+    PROF_STOP(PROF_CLASSIFY, classify_mark);
+#else
+    signal_t processed_buffer[WINDOW_SIZE];
+    
+    /* Time-domain features come out of the fused preprocessing pass */
+    PROF_START(preprocess_mark);
+    memcpy(processed_buffer, raw, WINDOW_SIZE * sizeof(signal_t));
+    preprocess_and_measure(processed_buffer, WINDOW_SIZE, features);
+    PROF_STOP(PROF_PREPROCESS, preprocess_mark);
+    
+    PROF_START(features_mark);
+    extract_band_features(processed_buffer, WINDOW_SIZE, features);
+    PROF_STOP(PROF_FEATURES, features_mark);
+    
+    PROF_START(classify_mark);
+    command = classify_command(features, classifier_state);
+    PROF_STOP(PROF_CLASSIFY, classify_mark);
+#endif
+    
+    /* raw is still the buffer held from the acquisition */
+    PROF_LATENCY(acquisition_completed_ticks(&acq));
+    return command;
+}
+
+/* ========== Outputs ========== */
+
+/* Output-state box on every change (subject to --quiet / the throttle) */
+static void show_outputs(void *user_data, const output_state_t *state) {
+    (void)user_data;
+    display_output_throttled(state);
+}
+
+/* Outputs start cleared; on_change runs in the consumer (may be NULL) */
+static void start_outputs(output_changed_fn on_change) {
+    output_controller_init(&outputs, on_change, NULL);
+    outputs_threaded = output_controller_start(&outputs);
+}
+
+/* Drive the outputs from the posted commands and return their state
+ * (with USE_PTHREADS the consumer thread does it on its own, so the
+ * snapshot may not include a command posted just before) */
+static void service_outputs(output_state_t *state) {
+    if (!outputs_threaded) {
+        output_service(&outputs, sched_now_us());
+    }
+    output_controller_state(&outputs, state);
+}
+
+static void stop_outputs(void) {
+    output_controller_destroy(&outputs);
+    printf("  Outputs: %u commands, %u coalesced, %u dropped\n",
+           outputs.applied, outputs.coalesced, output_dropped(&outputs));
+}
+
+/* ========== Acquisition ========== */
+
+/* Paced simulator playing script, delivering buffer_length-sample buffers */
+static void start_simulated_acquisition(const command_t *script, size_t script_length,
+                                        size_t num_windows, size_t buffer_length) {
+    acq_source_t source;
+    acq_simulator_open(&simulator, &source, script, script_length, num_windows);
+    acquisition_start(&acq, &source, buffer_length, TRUE, NULL, NULL);
+}
+
+/* Next buffer, timed as the acquire stage (mostly the wait for the source) */
+static const acq_sample_t* acquire_buffer(size_t *count) {
+    PROF_START(acquire_mark);
+    const acq_sample_t *buffer = acquisition_wait(&acq, count);
+    PROF_STOP(PROF_ACQUIRE, acquire_mark);
+    return buffer;
+}
+
+static void stop_acquisition(void) {
+    acquisition_stop(&acq);
+    PROF_OVERRUNS(acquisition_dropped(&acq), acquisition_overruns(&acq));
+    
+    printf("\n  Acquisition: %u samples dropped in %u overruns, %u late wakeups\n",
+           acquisition_dropped(&acq), acquisition_overruns(&acq), acq.timer.missed);
+}
+
 void run_demo_scenario(const char *scenario_name, command_t state, int iterations) {
     printf("\n%s═══════════════════════════════════════════════════════════════%s\n", 
            COLOR_YELLOW, COLOR_RESET);
@@ -41,47 +202,46 @@ void run_demo_scenario(const char *scenario_name, command_t state, int iteration
     printf("%s═══════════════════════════════════════════════════════════════%s\n\n", 
            COLOR_YELLOW, COLOR_RESET);
     
-    signal_t eeg_buffer[WINDOW_SIZE];
-    signal_t processed_buffer[WINDOW_SIZE];
     features_t features;
     classifier_state_t classifier_state;
     output_state_t output_state;
     
     /* Initialize modules */
-    classifier_init(&classifier_state);
-    output_control_init(&output_state);
+    start_classifier(&classifier_state);
+    start_outputs(show_outputs);
+    start_simulated_acquisition(&state, 1, (size_t)iterations, WINDOW_SIZE);
     
     for (int iter = 0; iter < iterations; iter++) {
         printf("\n%s--- Iteration %d/%d ---%s\n", COLOR_BLUE, iter + 1, iterations, COLOR_RESET);
         
-        /* Step 1: Generate EEG signal */
-        printf("%s[1] Generating EEG signal...%s\n", COLOR_GREEN, COLOR_RESET);
-        generate_eeg_sample(eeg_buffer, WINDOW_SIZE, state);
+        /* Step 1: Acquire one window (paces the loop at the sampling rate);
+         * the source fills the other buffer while this one is processed */
+        printf("%s[1] Acquiring EEG signal...%s\n", COLOR_GREEN, COLOR_RESET);
+        size_t count;
+        const acq_sample_t *eeg_buffer = acquire_buffer(&count);
+        if (eeg_buffer == NULL || count < WINDOW_SIZE) {
+            break;
+        }
         
         #if DEBUG_SIGNALS
         if (iter == 0) {
-            printf("    Signal range: [%.2f, %.2f] µV\n", 
-                   eeg_buffer[0], eeg_buffer[WINDOW_SIZE-1]);
+            signal_t first, last;
+            acq_samples_to_signal(&eeg_buffer[0], &first, 1);
+            acq_samples_to_signal(&eeg_buffer[WINDOW_SIZE-1], &last, 1);
+            printf("    Signal range: [%.2f, %.2f] µV\n", first, last);
         }
         #endif
         
-        /* Step 2: Preprocess signal */
+        /* Steps 2-4: Preprocess signal, extract features, classify command */
         printf("%s[2] Preprocessing signal...%s\n", COLOR_GREEN, COLOR_RESET);
-        memcpy(processed_buffer, eeg_buffer, WINDOW_SIZE * sizeof(signal_t));
-        preprocess_signal(processed_buffer, WINDOW_SIZE);
-        
-        /* Step 3: Extract features */
         printf("%s[3] Extracting features...%s\n", COLOR_GREEN, COLOR_RESET);
-        extract_features(processed_buffer, WINDOW_SIZE, &features);
+        printf("%s[4] Classifying command...%s\n", COLOR_GREEN, COLOR_RESET);
+        command_t detected = process_window(eeg_buffer, &features, &classifier_state);
         
         #if DEBUG_FEATURES
         print_features(&features);
         #endif
         
-        /* Step 4: Classify command */
-        printf("%s[4] Classifying command...%s\n", COLOR_GREEN, COLOR_RESET);
-        command_t detected = classify_command(&features, &classifier_state);
-        
         #if DEBUG_COMMANDS
         printf("    Detected: %s%s%s", COLOR_MAGENTA, command_to_string(detected), COLOR_RESET);
         if (detected != CMD_NONE) {
@@ -90,23 +250,24 @@ void run_demo_scenario(const char *scenario_name, command_t state, int iteration
         printf("\n");
         #endif
         
-        /* Step 5: Execute command */
+        /* Step 5: Post the command; the output side picks it up */
+        PROF_START(output_mark);
         if (detected != CMD_NONE) {
-            printf("%s[5] Executing command...%s\n", COLOR_GREEN, COLOR_RESET);
-            execute_command(detected, &output_state);
-            
-            /* Reset buzzer after display */
-            if (output_state.buzzer_active) {
-                output_state.buzzer_active = FALSE;
-            }
+            printf("%s[5] Posting command...%s\n", COLOR_GREEN, COLOR_RESET);
+            output_post(&outputs, detected);
         }
+        PROF_STOP(PROF_OUTPUT, output_mark);
         
-        /* Step 6: Display output state */
-        display_output_state(&output_state);
-        
-        /* Add delay to make LED changes visible */
-        delay_ms(1000);  /* 1 second delay */
+        /* Step 6: Drive the outputs (the box prints when they change), report
+         * the window and hand the buffer back */
+        service_outputs(&output_state);
+        send_telemetry(eeg_buffer, count, (uint32_t)iter * WINDOW_SIZE, &features,
+                       detected, &output_state);
+        acquisition_release(&acq);
     }
+    
+    stop_acquisition();
+    stop_outputs();
 }
 
 void run_interactive_demo(void) {
@@ -122,45 +283,212 @@ void run_interactive_demo(void) {
                                    "Relax", "Blink", "Focus", "Blink"};
     int sequence_length = sizeof(sequence) / sizeof(sequence[0]);
     
-    signal_t eeg_buffer[WINDOW_SIZE];
-    signal_t processed_buffer[WINDOW_SIZE];
     features_t features;
     classifier_state_t classifier_state;
     output_state_t output_state;
     
-    classifier_init(&classifier_state);
-    output_control_init(&output_state);
+    start_classifier(&classifier_state);
+    start_outputs(show_outputs);
+    start_simulated_acquisition(sequence, sequence_length, sequence_length, WINDOW_SIZE);
     
     for (int i = 0; i < sequence_length; i++) {
         printf("\n%s--- Step %d: %s ---%s\n", 
                COLOR_BLUE, i + 1, sequence_names[i], COLOR_RESET);
         
-        /* Generate and process signal */
-        generate_eeg_sample(eeg_buffer, WINDOW_SIZE, sequence[i]);
-        memcpy(processed_buffer, eeg_buffer, WINDOW_SIZE * sizeof(signal_t));
-        preprocess_signal(processed_buffer, WINDOW_SIZE);
-        extract_features(processed_buffer, WINDOW_SIZE, &features);
+        /* Acquire and process signal */
+        size_t count;
+        const acq_sample_t *eeg_buffer = acquire_buffer(&count);
+        if (eeg_buffer == NULL || count < WINDOW_SIZE) {
+            break;
+        }
         
         /* Classify and execute */
-        command_t detected = classify_command(&features, &classifier_state);
+        command_t detected = process_window(eeg_buffer, &features, &classifier_state);
         
         printf("Expected: %s%s%s | Detected: %s%s%s\n",
                COLOR_CYAN, sequence_names[i], COLOR_RESET,
                COLOR_MAGENTA, command_to_string(detected), COLOR_RESET);
         
-        if (detected != CMD_NONE) {
-            execute_command(detected, &output_state);
-            if (output_state.buzzer_active) {
-                output_state.buzzer_active = FALSE;
-            }
+        PROF_START(output_mark);
+        output_post(&outputs, detected);
+        PROF_STOP(PROF_OUTPUT, output_mark);
+        
+        service_outputs(&output_state);
+        send_telemetry(eeg_buffer, count, (uint32_t)i * WINDOW_SIZE, &features,
+                       detected, &output_state);
+        acquisition_release(&acq);
+    }
+    
+    stop_acquisition();
+    stop_outputs();
+}
+
+void run_streaming_demo(void) {
+    printf("\n%s═══════════════════════════════════════════════════════════════%s\n", 
+           COLOR_YELLOW, COLOR_RESET);
+    printf("%s[STREAMING DEMO: %d-sample hop, %.1f%% overlap]%s\n", COLOR_YELLOW,
+           STREAM_HOP_SIZE, 100.0f * (WINDOW_SIZE - STREAM_HOP_SIZE) / WINDOW_SIZE, COLOR_RESET);
+    printf("%s═══════════════════════════════════════════════════════════════%s\n\n", 
+           COLOR_YELLOW, COLOR_RESET);
+    
+    command_t sequence[] = {CMD_RELAX, CMD_RELAX, CMD_FOCUS, CMD_FOCUS, CMD_BLINK, CMD_RELAX};
+    int sequence_length = sizeof(sequence) / sizeof(sequence[0]);
+    
+    stream_state_t stream;
+    features_t features;
+    classifier_state_t classifier_state;
+    output_state_t output_state;
+    command_t last_reported = CMD_NONE;
+    
+    streaming_init(&stream, STREAM_HOP_SIZE);
+    start_classifier(&classifier_state);
+    start_outputs(NULL);
+    start_simulated_acquisition(sequence, sequence_length, sequence_length, STREAM_HOP_SIZE);
+    
+    /* Wake once per hop-sized buffer and feed the pipeline straight from it */
+    size_t count;
+    const acq_sample_t *block;
+    while ((block = acquire_buffer(&count)) != NULL) {
+        uint64_t completed = acquisition_completed_ticks(&acq);
+        PROF_START(features_mark);
+#if USE_FIXED_POINT
+        /* The streaming pipeline is float */
+        signal_t microvolts[STREAM_HOP_SIZE];
+        acq_samples_to_signal(block, microvolts, count);
+        size_t emitted = streaming_push_samples(&stream, microvolts, count, &features, 1);
+#else
+        size_t emitted = streaming_push_samples(&stream, block, count, &features, 1);
+#endif
+        if (emitted == 0) {
+            acquisition_release(&acq);
+            continue;
         }
+        PROF_STOP(PROF_FEATURES, features_mark);
+        
+        PROF_START(classify_mark);
+        command_t detected = classify_command(&features, &classifier_state);
+        PROF_STOP(PROF_CLASSIFY, classify_mark);
+        PROF_LATENCY(completed);
         
-        display_output_state(&output_state);
-        delay_ms(1500);  /* 1.5 second delay for better visibility */
+        PROF_START(output_mark);
+        output_post(&outputs, detected);
+        PROF_STOP(PROF_OUTPUT, output_mark);
+        
+        service_outputs(&output_state);
+        send_telemetry(block, count, stream.sample_index - (uint32_t)count, &features,
+                       detected, &output_state);
+        acquisition_release(&acq);
+        
+        /* Report only changes: one line per command transition */
+        if (detected != last_reported) {
+            float t_ms = 1000.0f * stream.sample_index / SAMPLING_RATE;
+            command_t input = sequence[(stream.sample_index - 1) / WINDOW_SIZE];
+            printf("  t=%7.1f ms  Input: %-5s  Detected: %s%-5s%s  LED: %s\n",
+                   t_ms, command_to_string(input),
+                   COLOR_MAGENTA, command_to_string(detected), COLOR_RESET,
+                   output_state.led_state ? "ON" : "OFF");
+            last_reported = detected;
+        }
     }
+    
+    stop_acquisition();
+    stop_outputs();
+    printf("  Command latency: %.1f ms per hop\n", 1000.0f * STREAM_HOP_SIZE / SAMPLING_RATE);
+}
+
+/* Replay a recording (CSV or session file) through the window pipeline as
+ * fast as it can be processed */
+static int run_replay_demo(const char *filepath) {
+    printf("\n%s═══════════════════════════════════════════════════════════════%s\n", 
+           COLOR_YELLOW, COLOR_RESET);
+    printf("%s[REPLAY: %s]%s\n", COLOR_YELLOW, filepath, COLOR_RESET);
+    printf("%s═══════════════════════════════════════════════════════════════%s\n\n", 
+           COLOR_YELLOW, COLOR_RESET);
+    
+    acq_file_t file;
+    acq_source_t source;
+    if (!acq_file_open(&file, &source, filepath) ||
+        !acquisition_start(&acq, &source, WINDOW_SIZE, FALSE, NULL, NULL)) {
+        return 1;
+    }
+    
+    features_t features;
+    classifier_state_t classifier_state;
+    size_t command_counts[CMD_BLINK + 1] = { 0 };
+    size_t windows = 0;
+    size_t count;
+    const acq_sample_t *window;
+    
+    start_classifier(&classifier_state);
+    while ((window = acquire_buffer(&count)) != NULL && count == WINDOW_SIZE) {
+        command_t detected = process_window(window, &features, &classifier_state);
+        send_telemetry(window, count, (uint32_t)(windows * WINDOW_SIZE), &features,
+                       detected, NULL);
+        acquisition_release(&acq);
+        command_counts[detected]++;
+        windows++;
+    }
+    
+    acquisition_stop(&acq);
+    PROF_OVERRUNS(acquisition_dropped(&acq), acquisition_overruns(&acq));
+    acq_file_close(&file);
+    
+    printf("  %s: %zu windows\n", source.name, windows);
+    for (int cmd = CMD_NONE; cmd <= CMD_BLINK; cmd++) {
+        printf("    %-5s %zu\n", command_to_string((command_t)cmd), command_counts[cmd]);
+    }
+    PROF_DUMP(stdout);
+    return 0;
+}
+
+static void print_usage(const char *program) {
+    printf("Usage: %s [--model PATH] [--telemetry DEST] [--quiet] [recording]\n", program);
+    printf("  --model PATH      Classifier thresholds from a model file\n");
+    printf("  --telemetry DEST  Binary frames per window to DEST: - (stdout),\n");
+    printf("                    udp:HOST:PORT or a capture file\n");
+    printf("  --quiet           No output-state boxes (print every %d ms otherwise)\n",
+           OUTPUT_DISPLAY_PERIOD_MS);
+    printf("  recording         Replay a CSV or .bcis file instead of the demos\n");
 }
 
 int main(int argc, char *argv[]) {
+    const char *recording = NULL;
+    const char *telemetry_destination = NULL;
+    const char *model_path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            model_path = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry_destination = argv[++i];
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            output_display_configure(FALSE, 0);
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            recording = argv[i];
+        }
+    }
+    
+    if (model_path != NULL) {
+        if (!bci_model_open(&model_file, model_path)) {
+            log_error("Cannot load model %s", model_path);
+            return 1;
+        }
+        thresholds = &model_file.model->thresholds;
+    }
+    
+    telemetry_endpoint_t telemetry_endpoint;
+    if (telemetry_destination != NULL) {
+        telemetry_sink_t sink;
+        if (!telemetry_endpoint_open(&telemetry_endpoint, &sink, telemetry_destination)) {
+            return 1;
+        }
+        telemetry_init(&telemetry_stream, &sink);
+        telemetry = &telemetry_stream;
+    }
+    
     /* Print banner */
     print_banner();
     
@@ -174,12 +502,27 @@ int main(int argc, char *argv[]) {
     
     printf("  Initializing feature extraction...\n");
     feature_extraction_init();
+#if USE_FIXED_POINT
+    fixed_point_init();
+#endif
     
     printf("  All modules initialized successfully!\n\n");
     
     /* Display system information */
     print_system_info();
     
+    /* With a recording on the command line, replay it instead of the demos */
+    if (recording != NULL) {
+        int status = run_replay_demo(recording);
+        if (telemetry != NULL) {
+            telemetry_endpoint_close(&telemetry_endpoint);
+        }
+        if (model_file.model != NULL) {
+            bci_model_close(&model_file);
+        }
+        return status;
+    }
+    
     /* Run demo scenarios */
     printf("%s[STARTING DEMONSTRATION]%s\n\n", COLOR_GREEN, COLOR_RESET);
     
@@ -195,6 +538,12 @@ int main(int argc, char *argv[]) {
     /* Scenario 4: Interactive mixed commands */
     run_interactive_demo();
     
+    /* Scenario 5: Overlapping windows in streaming mode */
+    run_streaming_demo();
+    
+    /* Stage timings for scraping off the console / UART */
+    PROF_DUMP(stdout);
+    
     /* Final summary */
     printf("\n%s╔═══════════════════════════════════════════════════════════════╗%s\n", 
            COLOR_GREEN, COLOR_RESET);
@@ -208,5 +557,14 @@ int main(int argc, char *argv[]) {
     printf("  ✓ RELAX  - High alpha activity → LED OFF\n");
     printf("  ✓ BLINK  - Sharp spike → Buzzer + Cursor movement\n\n");
     
+    if (telemetry != NULL) {
+        printf("Telemetry: %u frames to %s (%u dropped)\n",
+               telemetry->sequence, telemetry->sink.name, telemetry->failed);
+        telemetry_endpoint_close(&telemetry_endpoint);
+    }
+    if (model_file.model != NULL) {
+        bci_model_close(&model_file);
+    }
+    
     return 0;
 }
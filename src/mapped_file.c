@@ -0,0 +1,177 @@
+#include "mapped_file.h"
+#include "utils.h"
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool_t mapped_file_open(mapped_file_t *file, const char *filepath) {
+    memset(file, 0, sizeof(*file));
+
+#if defined(MAPPED_FILE_MMAP)
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) {
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return FALSE;
+    }
+
+    if (st.st_size > 0) {
+        void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            log_error("Failed to map %s", filepath);
+            return FALSE;
+        }
+        /* Parsing is one front-to-back pass: ask for aggressive readahead */
+        madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+        file->data = (const char*)data;
+        file->size = (size_t)st.st_size;
+    }
+
+    /* The mapping keeps the file referenced */
+    close(fd);
+    return TRUE;
+
+#elif defined(_WIN32)
+    HANDLE handle = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return FALSE;
+    }
+
+    if (size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        const void *view = (mapping != NULL) ?
+                           MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if (mapping != NULL) {
+            CloseHandle(mapping);    /* The view keeps the mapping alive */
+        }
+        if (view == NULL) {
+            CloseHandle(handle);
+            log_error("Failed to map %s", filepath);
+            return FALSE;
+        }
+        file->data = (const char*)view;
+        file->size = (size_t)size.QuadPart;
+    }
+
+    CloseHandle(handle);
+    return TRUE;
+
+#else
+    /* No virtual memory: read the file into one heap block */
+    FILE *fp = fopen(filepath, "rb");
+    if (fp == NULL) {
+        return FALSE;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (size > 0) {
+        char *copy = (char*)malloc((size_t)size);
+        if (copy == NULL || fread(copy, 1, (size_t)size, fp) != (size_t)size) {
+            free(copy);
+            fclose(fp);
+            log_error("Failed to read %s", filepath);
+            return FALSE;
+        }
+        file->data = copy;
+        file->size = (size_t)size;
+        file->handle = copy;
+    }
+
+    fclose(fp);
+    return TRUE;
+#endif
+}
+
+#if defined(MAPPED_FILE_MMAP)
+/* Clip [offset, offset + length) to the file; page-align the start down
+ * (round_start_up FALSE) or up, and return the aligned span length */
+static size_t page_span(const mapped_file_t *file, size_t *offset, size_t length,
+                        bool_t round_start_up) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = *offset;
+    size_t end;
+
+    if (file->data == NULL || start >= file->size) {
+        return 0;
+    }
+    end = (length > file->size - start) ? file->size : start + length;
+
+    if (round_start_up) {
+        start = (start + page - 1) & ~(page - 1);
+        end = (end == file->size) ? end : (end & ~(page - 1));
+    } else {
+        start &= ~(page - 1);
+    }
+
+    *offset = start;
+    return (end > start) ? end - start : 0;
+}
+#endif
+
+void mapped_file_prefetch(const mapped_file_t *file, size_t offset, size_t length) {
+#if defined(MAPPED_FILE_MMAP)
+    size_t span = page_span(file, &offset, length, FALSE);
+    if (span > 0) {
+        madvise((void*)(file->data + offset), span, MADV_WILLNEED);
+    }
+#else
+    (void)file;
+    (void)offset;
+    (void)length;
+#endif
+}
+
+void mapped_file_release(const mapped_file_t *file, size_t offset, size_t length) {
+#if defined(MAPPED_FILE_MMAP)
+    size_t span = page_span(file, &offset, length, TRUE);
+    if (span > 0) {
+        madvise((void*)(file->data + offset), span, MADV_DONTNEED);
+    }
+#else
+    (void)file;
+    (void)offset;
+    (void)length;
+#endif
+}
+
+void mapped_file_close(mapped_file_t *file) {
+    if (file == NULL) {
+        return;
+    }
+
+    if (file->data != NULL) {
+#if defined(MAPPED_FILE_MMAP)
+        munmap((void*)file->data, file->size);
+#elif defined(_WIN32)
+        UnmapViewOfFile(file->data);
+#else
+        free(file->handle);
+#endif
+    }
+
+    memset(file, 0, sizeof(*file));
+}
@@ -0,0 +1,156 @@
+#include "multichannel.h"
+#include "preprocessing.h"
+#include "feature_extraction.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* ========== Frame Management ========== */
+
+static bool_t frame_check_size(size_t num_channels, size_t length) {
+    if (num_channels == 0 || num_channels > MAX_CHANNELS || length == 0) {
+        log_error("Invalid frame size: %zu channels x %zu samples (max %d channels)",
+                  num_channels, length, MAX_CHANNELS);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void frame_setup(eeg_frame_t *frame, signal_t *data, void *allocation,
+                        size_t num_channels, size_t length) {
+    frame->num_channels = num_channels;
+    frame->length = length;
+    frame->stride = MULTICHANNEL_STRIDE(length);
+    frame->data = data;
+    frame->allocation = allocation;
+
+    /* Padding between rows is zeroed too, so vector tails read defined data */
+    memset(data, 0, num_channels * frame->stride * sizeof(signal_t));
+}
+
+bool_t eeg_frame_init(eeg_frame_t *frame, size_t num_channels, size_t length) {
+    memset(frame, 0, sizeof(*frame));
+    if (!frame_check_size(num_channels, length)) {
+        return FALSE;
+    }
+
+    /* Over-allocate by one cache line and align by hand (no aligned_alloc
+     * in the bare-metal C library) */
+    size_t bytes = num_channels * MULTICHANNEL_STRIDE(length) * sizeof(signal_t);
+    void *allocation = malloc(bytes + MULTICHANNEL_ALIGN);
+    if (allocation == NULL) {
+        log_error("Failed to allocate %zu-channel frame", num_channels);
+        return FALSE;
+    }
+
+    uintptr_t address = (uintptr_t)allocation;
+    address = (address + MULTICHANNEL_ALIGN - 1) & ~(uintptr_t)(MULTICHANNEL_ALIGN - 1);
+
+    frame_setup(frame, (signal_t*)address, allocation, num_channels, length);
+    return TRUE;
+}
+
+bool_t eeg_frame_init_arena(eeg_frame_t *frame, dsp_arena_t *arena,
+                            size_t num_channels, size_t length) {
+    memset(frame, 0, sizeof(*frame));
+    if (!frame_check_size(num_channels, length)) {
+        return FALSE;
+    }
+
+    size_t bytes = num_channels * MULTICHANNEL_STRIDE(length) * sizeof(signal_t);
+    signal_t *data = (signal_t*)dsp_arena_alloc_aligned(arena, bytes, MULTICHANNEL_ALIGN);
+    if (data == NULL) {
+        return FALSE;
+    }
+
+    frame_setup(frame, data, NULL, num_channels, length);
+    return TRUE;
+}
+
+void eeg_frame_destroy(eeg_frame_t *frame) {
+    if (frame == NULL) {
+        return;
+    }
+
+    free(frame->allocation);
+    memset(frame, 0, sizeof(*frame));
+}
+
+signal_t* eeg_frame_channel(const eeg_frame_t *frame, size_t channel) {
+    if (channel >= frame->num_channels) {
+        return NULL;
+    }
+    return frame->data + channel * frame->stride;
+}
+
+void eeg_frame_deinterleave(eeg_frame_t *frame, const signal_t *interleaved,
+                            size_t num_samples) {
+    size_t channels = frame->num_channels;
+    if (num_samples > frame->length) {
+        num_samples = frame->length;
+    }
+
+    /* Channel-outer loop: sequential writes into each row, strided reads */
+    for (size_t c = 0; c < channels; c++) {
+        signal_t *row = frame->data + c * frame->stride;
+        const signal_t *src = interleaved + c;
+        for (size_t i = 0; i < num_samples; i++) {
+            row[i] = src[i * channels];
+        }
+    }
+}
+
+/* ========== Batched Processing ========== */
+
+void preprocess_frame(eeg_frame_t *frame) {
+    for (size_t c = 0; c < frame->num_channels; c++) {
+        preprocess_signal(frame->data + c * frame->stride, frame->length);
+    }
+}
+
+void extract_frame_features(fft_workspace_t *ws, const eeg_frame_t *frame,
+                            features_t *features) {
+    for (size_t c = 0; c < frame->num_channels; c++) {
+        extract_features_ws(ws, frame->data + c * frame->stride, frame->length,
+                            &features[c]);
+    }
+}
+
+void process_frame(fft_workspace_t *ws, eeg_frame_t *frame, features_t *features) {
+    for (size_t c = 0; c < frame->num_channels; c++) {
+        signal_t *row = frame->data + c * frame->stride;
+
+        /* Fused preprocessing fills the time-domain features; the FFT then
+         * reads the row while it is still cached */
+        preprocess_and_measure(row, frame->length, &features[c]);
+        extract_band_features_ws(ws, row, frame->length, &features[c]);
+    }
+}
+
+void average_frame_features(const features_t *features, size_t num_channels,
+                            features_t *average) {
+    memset(average, 0, sizeof(*average));
+    if (num_channels == 0) {
+        return;
+    }
+
+    for (size_t c = 0; c < num_channels; c++) {
+        average->theta_power += features[c].theta_power;
+        average->alpha_power += features[c].alpha_power;
+        average->beta_power += features[c].beta_power;
+        average->gamma_power += features[c].gamma_power;
+        average->peak_amplitude += features[c].peak_amplitude;
+        average->variance += features[c].variance;
+        average->skewness += features[c].skewness;
+    }
+
+    signal_t inv = 1.0f / num_channels;
+    average->theta_power *= inv;
+    average->alpha_power *= inv;
+    average->beta_power *= inv;
+    average->gamma_power *= inv;
+    average->peak_amplitude *= inv;
+    average->variance *= inv;
+    average->skewness *= inv;
+}
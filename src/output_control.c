@@ -1,5 +1,6 @@
 #include "output_control.h"
 #include "utils.h"
+#include "scheduler.h"
 #include <stdio.h>
 
 static const char keyboard_grid[10][10] = {
@@ -101,3 +102,201 @@ void display_output_state(const output_state_t *state) {
     
     printf("%s╚════════════════════════════════════════════╝%s\n", COLOR_CYAN, COLOR_RESET);
 }
+
+/* Display policy (a console is shared, so one policy per program) */
+static bool_t display_enabled = TRUE;
+static uint64_t display_period_us = (uint64_t)OUTPUT_DISPLAY_PERIOD_MS * 1000u;
+static uint64_t next_display_us = 0;
+
+void output_display_configure(bool_t enabled, unsigned int period_ms) {
+    display_enabled = enabled;
+    display_period_us = (uint64_t)period_ms * 1000u;
+    next_display_us = 0;
+}
+
+bool_t display_output_throttled(const output_state_t *state) {
+    if (!display_enabled) {
+        return FALSE;
+    }
+
+    uint64_t now = sched_now_us();
+    if (display_period_us > 0 && now < next_display_us) {
+        return FALSE;
+    }
+    next_display_us = now + display_period_us;
+
+    display_output_state(state);
+    return TRUE;
+}
+
+/* ========== Command Queue ========== */
+
+#define OUTPUT_QUEUE_MASK (OUTPUT_QUEUE_CAPACITY - 1u)
+
+/* Indices run freely and are masked on access (a negative array size
+ * here means the capacity is not a power of 2) */
+typedef char output_queue_capacity_check[
+    (OUTPUT_QUEUE_CAPACITY >= 2 && (OUTPUT_QUEUE_CAPACITY & OUTPUT_QUEUE_MASK) == 0) ? 1 : -1];
+
+/* Longest consumer-thread sleep with nothing pending */
+#define OUTPUT_IDLE_WAKE_US 500000u
+
+void output_controller_init(output_controller_t *controller,
+                            output_changed_fn on_change, void *user_data) {
+    ring_index_init(&controller->queue);
+    controller->applied = 0;
+    controller->coalesced = 0;
+    controller->buzzer_off_us = 0;
+    output_control_init(&controller->state);
+    controller->on_change = on_change;
+    controller->user_data = user_data;
+    sched_event_init(&controller->posted);
+#if USE_PTHREADS
+    pthread_mutex_init(&controller->state_lock, NULL);
+    atomic_init(&controller->stop, 0);
+    controller->threaded = FALSE;
+#endif
+}
+
+void output_controller_destroy(output_controller_t *controller) {
+    output_controller_stop(controller);
+    sched_event_destroy(&controller->posted);
+#if USE_PTHREADS
+    pthread_mutex_destroy(&controller->state_lock);
+#endif
+}
+
+bool_t output_post(output_controller_t *controller, command_t command) {
+    if (command == CMD_NONE) {
+        return TRUE;
+    }
+
+    uint32_t head;
+    if (ring_index_space(&controller->queue, OUTPUT_QUEUE_CAPACITY, &head) == 0) {
+        ring_index_drop(&controller->queue, 1);
+        return FALSE;
+    }
+
+    controller->commands[head & OUTPUT_QUEUE_MASK] = command;
+    ring_index_publish(&controller->queue, head, 1);
+    sched_event_signal(&controller->posted);
+    return TRUE;
+}
+
+bool_t output_service(output_controller_t *controller, uint64_t now_us) {
+    uint32_t tail;
+    size_t pending = ring_index_available(&controller->queue, &tail);
+    int led = -1;                /* Last LED command: -1 none, else on/off */
+    int blinks = 0;
+
+    /* Coalesce everything pending into one update */
+    controller->applied += (uint32_t)pending;
+    for (size_t i = 0; i < pending; i++) {
+        command_t command = controller->commands[(tail + i) & OUTPUT_QUEUE_MASK];
+        if (command == CMD_FOCUS || command == CMD_RELAX) {
+            if (led >= 0) {
+                controller->coalesced++;
+            }
+            led = (command == CMD_FOCUS);
+        } else if (command == CMD_BLINK) {
+            blinks++;
+        }
+    }
+    ring_index_consume(&controller->queue, tail, pending);
+    if (blinks > 1) {
+        controller->coalesced += (uint32_t)(blinks - 1);
+    }
+
+    bool_t changed = FALSE;
+    output_state_t *state = &controller->state;
+#if USE_PTHREADS
+    pthread_mutex_lock(&controller->state_lock);
+#endif
+    if (led >= 0 && state->led_state != (bool_t)led) {
+        set_led(state, (bool_t)led);
+        changed = TRUE;
+    }
+    if (blinks > 0) {
+        /* One buzz per burst, re-armed by its last blink */
+        trigger_buzzer(state);
+        controller->buzzer_off_us = now_us + (uint64_t)BUZZER_DURATION_MS * 1000u;
+        for (int i = 0; i < blinks; i++) {
+            move_cursor(state, 1, 0);
+        }
+        select_character(state);
+        changed = TRUE;
+    } else if (state->buzzer_active && now_us >= controller->buzzer_off_us) {
+        state->buzzer_active = FALSE;
+        controller->buzzer_off_us = 0;
+        changed = TRUE;
+    }
+#if USE_PTHREADS
+    pthread_mutex_unlock(&controller->state_lock);
+#endif
+
+    /* Only this side writes state: the callback can read it unlocked */
+    if (changed && controller->on_change != NULL) {
+        controller->on_change(controller->user_data, state);
+    }
+    return changed;
+}
+
+#if USE_PTHREADS
+static void* output_thread(void *arg) {
+    output_controller_t *controller = (output_controller_t*)arg;
+
+    while (!atomic_load_explicit(&controller->stop, memory_order_acquire)) {
+        uint64_t deadline = controller->state.buzzer_active
+                            ? controller->buzzer_off_us
+                            : sched_now_us() + OUTPUT_IDLE_WAKE_US;
+        sched_event_wait_until(&controller->posted, deadline);
+        output_service(controller, sched_now_us());
+    }
+
+    /* Commands posted before the stop still reach the outputs */
+    output_service(controller, sched_now_us());
+    return NULL;
+}
+#endif
+
+bool_t output_controller_start(output_controller_t *controller) {
+#if USE_PTHREADS
+    atomic_store_explicit(&controller->stop, 0, memory_order_relaxed);
+    if (pthread_create(&controller->thread, NULL, output_thread, controller) != 0) {
+        log_error("Failed to start output thread");
+        return FALSE;
+    }
+    controller->threaded = TRUE;
+    return TRUE;
+#else
+    (void)controller;
+    return FALSE;
+#endif
+}
+
+void output_controller_stop(output_controller_t *controller) {
+#if USE_PTHREADS
+    if (controller->threaded) {
+        atomic_store_explicit(&controller->stop, 1, memory_order_release);
+        sched_event_signal(&controller->posted);
+        pthread_join(controller->thread, NULL);
+        controller->threaded = FALSE;
+    }
+#else
+    (void)controller;
+#endif
+}
+
+void output_controller_state(output_controller_t *controller, output_state_t *state) {
+#if USE_PTHREADS
+    pthread_mutex_lock(&controller->state_lock);
+#endif
+    *state = controller->state;
+#if USE_PTHREADS
+    pthread_mutex_unlock(&controller->state_lock);
+#endif
+}
+
+uint32_t output_dropped(const output_controller_t *controller) {
+    return atomic_load_explicit(&controller->queue.dropped, memory_order_relaxed);
+}
@@ -1,31 +1,51 @@
 #include "preprocessing.h"
+#include "dsp_kernels.h"
 #include "utils.h"
 #include <math.h>
 #include <string.h>
 
+#if BANDPASS_ORDER < 2 || BANDPASS_ORDER % 2 != 0
+#error "BANDPASS_ORDER must be an even order of at least 2"
+#endif
+
+static void design_bandpass(biquad_t *sections, float sampling_rate,
+                            float low_freq, float high_freq);
+
+/* Default filter bank for the config.h band definitions */
+static filter_bank_t default_bank;
+static bool_t default_bank_ready = FALSE;
+
 void preprocessing_init(void) {
-    /* Nothing to initialize for now */
+    if (!default_bank_ready) {
+        const frequency_band_t bands[NUM_BANDS] = {
+            { THETA_LOW_FREQ, THETA_HIGH_FREQ },
+            { ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ },
+            { BETA_LOW_FREQ,  BETA_HIGH_FREQ  },
+            { GAMMA_LOW_FREQ, GAMMA_HIGH_FREQ }
+        };
+        filter_bank_init(&default_bank, bands, NUM_BANDS, SAMPLING_RATE);
+        default_bank_ready = TRUE;
+    }
+}
+
+const filter_bank_t* preprocessing_default_bank(void) {
+    preprocessing_init();
+    return &default_bank;
 }
 
 void moving_average_filter(const signal_t *input, signal_t *output, size_t length, size_t window) {
+    if (length == 0) {
+        return;
+    }
     if (window > length) {
         window = length;
     }
-    
-    for (size_t i = 0; i < length; i++) {
-        signal_t sum = 0.0f;
-        size_t count = 0;
-        
-        /* Calculate average over window */
-        for (size_t j = 0; j < window; j++) {
-            if (i >= j) {
-                sum += input[i - j];
-                count++;
-            }
-        }
-        
-        output[i] = sum / count;
+    if (window == 0) {
+        window = 1;
     }
+    
+    /* Running sum (or RVV kernel), safe for in-place use */
+    dsp_moving_average(input, output, length, window);
 }
 
 signal_t calculate_baseline(const signal_t *signal, size_t length) {
@@ -77,31 +97,249 @@ void normalize_signal(signal_t *signal, size_t length) {
 
 void bandpass_filter(const signal_t *input, signal_t *output, size_t length,
                      float low_freq, float high_freq) {
-    /* Simple bandpass: apply moving average (low-pass) then high-pass */
-    /* This is a simplified filter for demonstration */
+    biquad_t sections[BANDPASS_SECTIONS];
+    const filter_bank_t *bank = preprocessing_default_bank();
+    bool_t found = FALSE;
+    
+    /* Reuse precomputed coefficients for the configured bands */
+    for (size_t b = 0; b < bank->num_bands && !found; b++) {
+        if (bank->band_edges[b].low_freq == low_freq &&
+            bank->band_edges[b].high_freq == high_freq) {
+            memcpy(sections, bank->bands[b], sizeof(sections));
+            found = TRUE;
+        }
+    }
+    
+    if (!found) {
+        design_bandpass(sections, SAMPLING_RATE, low_freq, high_freq);
+    }
+    
+    for (size_t k = 0; k < BANDPASS_SECTIONS; k++) {
+        biquad_reset(&sections[k]);
+        biquad_process(&sections[k], (k == 0) ? input : output, output, length);
+    }
+}
+
+/* ========== IIR Filters ========== */
+
+/* Make a section that passes the input through unchanged */
+static void biquad_set_passthrough(biquad_t *filter) {
+    filter->b0 = 1.0f;
+    filter->b1 = 0.0f;
+    filter->b2 = 0.0f;
+    filter->a1 = 0.0f;
+    filter->a2 = 0.0f;
+    biquad_reset(filter);
+}
+
+/* Store RBJ cookbook coefficients normalized by a0 */
+static void biquad_set(biquad_t *filter, float b0, float b1, float b2,
+                       float a0, float a1, float a2) {
+    filter->b0 = b0 / a0;
+    filter->b1 = b1 / a0;
+    filter->b2 = b2 / a0;
+    filter->a1 = a1 / a0;
+    filter->a2 = a2 / a0;
+    biquad_reset(filter);
+}
+
+void biquad_design_lowpass(biquad_t *filter, float sampling_rate, float fc, float q) {
+    /* Cutoff at or above Nyquist: nothing to remove */
+    if (fc >= 0.5f * sampling_rate) {
+        biquad_set_passthrough(filter);
+        return;
+    }
+    
+    float w0 = 2.0f * M_PI * fc / sampling_rate;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
     
-    signal_t temp[WINDOW_SIZE];
-    memcpy(temp, input, length * sizeof(signal_t));
+    biquad_set(filter, (1.0f - cos_w0) / 2.0f, 1.0f - cos_w0, (1.0f - cos_w0) / 2.0f,
+               1.0f + alpha, -2.0f * cos_w0, 1.0f - alpha);
+}
+
+void biquad_design_highpass(biquad_t *filter, float sampling_rate, float fc, float q) {
+    /* Cutoff at DC: nothing to remove */
+    if (fc <= 0.0f) {
+        biquad_set_passthrough(filter);
+        return;
+    }
     
-    /* Low-pass component (moving average) */
-    moving_average_filter(input, output, length, MA_FILTER_SIZE);
+    float w0 = 2.0f * M_PI * fc / sampling_rate;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
     
-    /* High-pass component (subtract low-frequency from original) */
+    biquad_set(filter, (1.0f + cos_w0) / 2.0f, -(1.0f + cos_w0), (1.0f + cos_w0) / 2.0f,
+               1.0f + alpha, -2.0f * cos_w0, 1.0f - alpha);
+}
+
+void biquad_design_notch(biquad_t *filter, float sampling_rate, float f0, float q) {
+    if (f0 <= 0.0f || f0 >= 0.5f * sampling_rate) {
+        biquad_set_passthrough(filter);
+        return;
+    }
+    
+    float w0 = 2.0f * M_PI * f0 / sampling_rate;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    
+    biquad_set(filter, 1.0f, -2.0f * cos_w0, 1.0f,
+               1.0f + alpha, -2.0f * cos_w0, 1.0f - alpha);
+}
+
+/* Butterworth band-pass as BANDPASS_SECTIONS biquads: the pole pairs of an
+ * order-N Butterworth edge have Q = 1 / (2 cos((2k + 1) pi / 2N)) */
+static void design_bandpass(biquad_t *sections, float sampling_rate,
+                            float low_freq, float high_freq) {
+    const size_t pairs = BANDPASS_ORDER / 2;
+    
+    for (size_t k = 0; k < pairs; k++) {
+        float q = 1.0f / (2.0f * cosf((2.0f * k + 1.0f) * (float)M_PI / (2.0f * BANDPASS_ORDER)));
+        biquad_design_highpass(&sections[k], sampling_rate, low_freq, q);
+        biquad_design_lowpass(&sections[pairs + k], sampling_rate, high_freq, q);
+    }
+}
+
+void biquad_reset(biquad_t *filter) {
+    filter->z1 = 0.0f;
+    filter->z2 = 0.0f;
+}
+
+signal_t biquad_process_sample(biquad_t *filter, signal_t sample) {
+    signal_t out = filter->b0 * sample + filter->z1;
+    filter->z1 = filter->b1 * sample - filter->a1 * out + filter->z2;
+    filter->z2 = filter->b2 * sample - filter->a2 * out;
+    return out;
+}
+
+void biquad_process(biquad_t *filter, const signal_t *input, signal_t *output, size_t length) {
     for (size_t i = 0; i < length; i++) {
-        output[i] = temp[i] - output[i];
+        output[i] = biquad_process_sample(filter, input[i]);
+    }
+}
+
+void filter_bank_init(filter_bank_t *bank, const frequency_band_t *bands, size_t num_bands,
+                      float sampling_rate) {
+    if (num_bands > NUM_BANDS) {
+        log_error("Filter bank supports at most %d bands, got %zu", NUM_BANDS, num_bands);
+        num_bands = NUM_BANDS;
+    }
+    
+    biquad_design_notch(&bank->notch, sampling_rate, NOTCH_FREQ, NOTCH_Q);
+    
+    bank->num_bands = num_bands;
+    for (size_t b = 0; b < num_bands; b++) {
+        bank->band_edges[b] = bands[b];
+        design_bandpass(bank->bands[b], sampling_rate, bands[b].low_freq, bands[b].high_freq);
+    }
+    
+    /* Average band power over roughly one analysis window */
+    bank->power_smoothing = 1.0f / WINDOW_SIZE;
+    filter_bank_reset(bank);
+}
+
+void filter_bank_reset(filter_bank_t *bank) {
+    biquad_reset(&bank->notch);
+    for (size_t b = 0; b < bank->num_bands; b++) {
+        for (size_t k = 0; k < BANDPASS_SECTIONS; k++) {
+            biquad_reset(&bank->bands[b][k]);
+        }
+        bank->band_power[b] = 0.0f;
+    }
+}
+
+signal_t filter_bank_process_sample(filter_bank_t *bank, signal_t sample, signal_t *band_out) {
+    signal_t clean = biquad_process_sample(&bank->notch, sample);
+    
+    for (size_t b = 0; b < bank->num_bands; b++) {
+        signal_t y = clean;
+        for (size_t k = 0; k < BANDPASS_SECTIONS; k++) {
+            y = biquad_process_sample(&bank->bands[b][k], y);
+        }
+        
+        /* Exponential moving average of y^2 */
+        bank->band_power[b] += bank->power_smoothing * (y * y - bank->band_power[b]);
+        
+        if (band_out != NULL) {
+            band_out[b] = y;
+        }
+    }
+    
+    return clean;
+}
+
+void filter_bank_band_powers(const filter_bank_t *bank, float *band_powers) {
+    for (size_t b = 0; b < bank->num_bands; b++) {
+        band_powers[b] = bank->band_power[b];
     }
 }
 
 void preprocess_signal(signal_t *signal, size_t length) {
-    /* Step 1: Calculate and remove baseline */
+    /* Same steps as calculate_baseline, remove_baseline, moving_average_filter
+     * and normalize_signal, fused into two passes */
+    preprocess_and_measure(signal, length, NULL);
+}
+
+void preprocess_and_measure(signal_t *signal, size_t length, features_t *features) {
+    if (length == 0) {
+        return;
+    }
+    
+    /* Step 1: Baseline from the first BASELINE_SAMPLES samples */
     signal_t baseline = calculate_baseline(signal, length);
-    remove_baseline(signal, length, baseline);
     
-    /* Step 2: Apply moving average filter for noise reduction */
-    signal_t filtered[WINDOW_SIZE];
-    moving_average_filter(signal, filtered, length, MA_FILTER_SIZE);
-    memcpy(signal, filtered, length * sizeof(signal_t));
+    /* Pass 1: moving average of (x - baseline), in place and backwards as in
+     * moving_average_filter, accumulating raw moments and extremes */
+    size_t window = (MA_FILTER_SIZE > length) ? length : MA_FILTER_SIZE;
+    signal_t sum = 0.0f;
+    for (size_t i = length - window; i < length; i++) {
+        sum += signal[i];
+    }
+    
+    signal_t s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    signal_t max_value = -INFINITY, min_value = INFINITY;
+    
+    for (size_t i = length; i-- > 0; ) {
+        signal_t current = signal[i];
+        size_t count = (i + 1 < window) ? i + 1 : window;
+        signal_t y = sum / count - baseline;
+        
+        signal[i] = y;
+        s1 += y;
+        s2 += y * y;
+        s3 += y * y * y;
+        if (y > max_value) max_value = y;
+        if (y < min_value) min_value = y;
+        
+        sum -= current;
+        if (i >= window) {
+            sum += signal[i - window];
+        }
+    }
+    
+    /* Moments of the filtered signal */
+    signal_t mean = s1 / length;
+    signal_t variance = s2 / length - mean * mean;
+    if (variance < 0.0f) {
+        variance = 0.0f;
+    }
+    signal_t std_dev = sqrtf(variance);
+    signal_t third_moment = s3 / length - 3.0f * mean * (s2 / length) + 2.0f * mean * mean * mean;
     
-    /* Step 3: Normalize signal */
-    normalize_signal(signal, length);
+    /* Pass 2: zero mean, unit variance (if std_dev is not zero) */
+    bool_t scale = (std_dev > 0.001f) ? TRUE : FALSE;
+    signal_t inv_std = scale ? 1.0f / std_dev : 1.0f;
+    for (size_t i = 0; i < length; i++) {
+        signal[i] = (signal[i] - mean) * inv_std;
+    }
+    
+    if (features != NULL) {
+        signal_t above = fabsf(max_value - mean);
+        signal_t below = fabsf(min_value - mean);
+        
+        features->peak_amplitude = ((above > below) ? above : below) * inv_std;
+        features->variance = scale ? 1.0f : variance;
+        features->skewness = (std_dev < 0.001f) ? 0.0f :
+                             third_moment / (variance * std_dev);
+    }
 }
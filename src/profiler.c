@@ -0,0 +1,187 @@
+#include "profiler.h"
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__riscv) && !defined(__linux__)
+#define PROF_BARE_METAL 1
+#else
+#include <time.h>
+#endif
+
+#define PROF_FORMAT_VERSION 1
+
+static profiler_t profiler;
+
+static const char *const stage_names[PROF_NUM_STAGES] = {
+    "acquire", "preprocess", "fft", "features", "classify", "output"
+};
+
+const char* prof_stage_name(prof_stage_t stage) {
+    return (stage < PROF_NUM_STAGES) ? stage_names[stage] : "unknown";
+}
+
+/* ========== Counters ========== */
+
+#if defined(PROF_BARE_METAL)
+#if __riscv_xlen == 32
+/* 64-bit counter as two CSRs; re-read if the low half carried in between */
+#define READ_CSR64(name, value) do {                                   \
+        uint32_t hi_, lo_, check_;                                     \
+        do {                                                           \
+            __asm__ volatile ("rd" #name "h %0" : "=r"(hi_));          \
+            __asm__ volatile ("rd" #name " %0" : "=r"(lo_));           \
+            __asm__ volatile ("rd" #name "h %0" : "=r"(check_));       \
+        } while (hi_ != check_);                                       \
+        (value) = ((uint64_t)hi_ << 32) | lo_;                         \
+    } while (0)
+#else
+#define READ_CSR64(name, value) do {                                   \
+        uint64_t v_;                                                   \
+        __asm__ volatile ("rd" #name " %0" : "=r"(v_));                \
+        (value) = v_;                                                  \
+    } while (0)
+#endif
+
+const char* prof_tick_unit(void) {
+    return "cycles";
+}
+
+prof_mark_t prof_read(void) {
+    prof_mark_t mark;
+    READ_CSR64(cycle, mark.ticks);
+    READ_CSR64(instret, mark.instret);
+    return mark;
+}
+
+#elif defined(_WIN32)
+const char* prof_tick_unit(void) {
+    return "ns";
+}
+
+prof_mark_t prof_read(void) {
+    LARGE_INTEGER frequency, counter;
+    prof_mark_t mark;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    mark.ticks = (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000u +
+                 (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000u /
+                 (uint64_t)frequency.QuadPart;
+    mark.instret = 0;
+    return mark;
+}
+
+#else
+const char* prof_tick_unit(void) {
+    return "ns";
+}
+
+prof_mark_t prof_read(void) {
+    struct timespec now;
+    prof_mark_t mark;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    mark.ticks = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    mark.instret = 0;
+    return mark;
+}
+#endif
+
+/* ========== Recording ========== */
+
+void profiler_reset(void) {
+    memset(&profiler, 0, sizeof(profiler));
+}
+
+const profiler_t* profiler_get(void) {
+    return &profiler;
+}
+
+/* Bin of a duration: its bit length, saturating at 32 bits */
+static size_t histogram_bin(uint64_t ticks) {
+    if (ticks == 0) {
+        return 0;
+    }
+    if (ticks >> 32) {
+        return PROF_HIST_BINS - 1;
+    }
+    return 32 - (size_t)__builtin_clz((uint32_t)ticks);
+}
+
+void prof_histogram_add(prof_histogram_t *hist, uint64_t ticks, uint64_t instret) {
+    uint32_t clamped = (ticks > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)ticks;
+
+    if (hist->count == 0 || clamped < hist->min_ticks) {
+        hist->min_ticks = clamped;
+    }
+    if (clamped > hist->max_ticks) {
+        hist->max_ticks = clamped;
+    }
+    hist->count++;
+    hist->total_ticks += ticks;
+    hist->total_instret += instret;
+    hist->bins[histogram_bin(ticks)]++;
+}
+
+void prof_record_stage(prof_stage_t stage, const prof_mark_t *start) {
+    prof_mark_t end = prof_read();
+
+    if (stage < PROF_NUM_STAGES) {
+        prof_histogram_add(&profiler.stages[stage], end.ticks - start->ticks,
+                           end.instret - start->instret);
+    }
+}
+
+void prof_record_latency(uint64_t sample_ticks) {
+    uint64_t now = prof_read().ticks;
+
+    /* Zero stamp: the buffer was published with profiling compiled out */
+    if (sample_ticks != 0 && now >= sample_ticks) {
+        prof_histogram_add(&profiler.latency, now - sample_ticks, 0);
+    }
+}
+
+void prof_record_overruns(uint32_t dropped, uint32_t overruns) {
+    profiler.dropped += dropped;
+    profiler.overruns += overruns;
+}
+
+/* ========== Report ========== */
+
+static void dump_histogram(FILE *out, const char *name, const prof_histogram_t *hist) {
+    size_t first = 0;
+    size_t last = 0;
+
+    /* Trim empty bins at both ends (an empty histogram prints one 0 bin) */
+    if (hist->count > 0) {
+        while (hist->bins[first] == 0) {
+            first++;
+        }
+        last = PROF_HIST_BINS - 1;
+        while (hist->bins[last] == 0) {
+            last--;
+        }
+    }
+
+    uint64_t divisor = (hist->count > 0) ? hist->count : 1;
+    fprintf(out, "@hist,%s,%lu,%lu,%lu,%lu,%lu,%lu,", name,
+            (unsigned long)hist->count, (unsigned long)hist->min_ticks,
+            (unsigned long)(hist->total_ticks / divisor), (unsigned long)hist->max_ticks,
+            (unsigned long)(hist->total_instret / divisor), (unsigned long)first);
+    for (size_t k = first; k <= last; k++) {
+        fprintf(out, (k == first) ? "%lu" : "|%lu", (unsigned long)hist->bins[k]);
+    }
+    fputc('\n', out);
+}
+
+void profiler_dump(FILE *out) {
+    fprintf(out, "@prof,%d,%s\n", PROF_FORMAT_VERSION, prof_tick_unit());
+    for (size_t s = 0; s < PROF_NUM_STAGES; s++) {
+        dump_histogram(out, stage_names[s], &profiler.stages[s]);
+    }
+    dump_histogram(out, "latency", &profiler.latency);
+    fprintf(out, "@overrun,%lu,%lu\n", (unsigned long)profiler.dropped,
+            (unsigned long)profiler.overruns);
+    fprintf(out, "@end\n");
+}
@@ -0,0 +1,161 @@
+#include "sample_ring.h"
+#include "utils.h"
+#include <string.h>
+
+/* ========== Ring Indices ========== */
+
+void ring_index_init(ring_index_t *index) {
+    atomic_init(&index->head, 0);
+    atomic_init(&index->tail, 0);
+    atomic_init(&index->dropped, 0);
+    atomic_init(&index->overruns, 0);
+}
+
+/* Acquire on tail: the consumer's reads of the freed slots are complete */
+size_t ring_index_space(const ring_index_t *index, uint32_t capacity, uint32_t *head) {
+    *head = atomic_load_explicit(&index->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&index->tail, memory_order_acquire);
+
+    return capacity - (uint32_t)(*head - tail);
+}
+
+/* Release: the slot writes complete before the consumer may read them */
+void ring_index_publish(ring_index_t *index, uint32_t head, size_t count) {
+    atomic_store_explicit(&index->head, head + (uint32_t)count, memory_order_release);
+}
+
+void ring_index_drop(ring_index_t *index, size_t count) {
+    ring_counter_add(&index->dropped, count);
+    ring_counter_add(&index->overruns, 1);
+}
+
+/* Acquire on head: the producer's slot writes are visible */
+size_t ring_index_available(const ring_index_t *index, uint32_t *tail) {
+    uint32_t head = atomic_load_explicit(&index->head, memory_order_acquire);
+    *tail = atomic_load_explicit(&index->tail, memory_order_relaxed);
+
+    return (uint32_t)(head - *tail);
+}
+
+/* Release: the slot reads complete before the producer may reuse them */
+void ring_index_consume(ring_index_t *index, uint32_t tail, size_t count) {
+    atomic_store_explicit(&index->tail, tail + (uint32_t)count, memory_order_release);
+}
+
+/* Single writer: a relaxed load/store pair is enough */
+void ring_counter_add(atomic_uint *counter, size_t amount) {
+    uint32_t value = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, value + (uint32_t)amount, memory_order_relaxed);
+}
+
+/* ========== Sample Ring ========== */
+
+bool_t sample_ring_init(sample_ring_t *ring, signal_t *storage, size_t capacity) {
+    if (storage == NULL || capacity < 2 || (capacity & (capacity - 1)) != 0 ||
+        capacity > 0x80000000u) {
+        log_error("Sample ring capacity must be a power of 2, got %zu", capacity);
+        return FALSE;
+    }
+
+    ring->buffer = storage;
+    ring->mask = (uint32_t)(capacity - 1);
+    ring_index_init(&ring->index);
+
+    return TRUE;
+}
+
+/* ========== Producer Side ========== */
+
+size_t sample_ring_space(const sample_ring_t *ring) {
+    uint32_t head;
+    return ring_index_space(&ring->index, ring->mask + 1, &head);
+}
+
+bool_t sample_ring_push(sample_ring_t *ring, signal_t sample) {
+    uint32_t head;
+
+    if (ring_index_space(&ring->index, ring->mask + 1, &head) == 0) {
+        ring_index_drop(&ring->index, 1);
+        return FALSE;
+    }
+
+    ring->buffer[head & ring->mask] = sample;
+    ring_index_publish(&ring->index, head, 1);
+    return TRUE;
+}
+
+size_t sample_ring_write(sample_ring_t *ring, const signal_t *samples, size_t count) {
+    uint32_t head;
+    size_t space = ring_index_space(&ring->index, ring->mask + 1, &head);
+    size_t stored = (count < space) ? count : space;
+
+    /* At most two copies: up to the end of the buffer, then from the start */
+    size_t start = head & ring->mask;
+    size_t first = ring->mask + 1 - start;
+    if (first > stored) {
+        first = stored;
+    }
+    memcpy(&ring->buffer[start], samples, first * sizeof(signal_t));
+    memcpy(ring->buffer, &samples[first], (stored - first) * sizeof(signal_t));
+
+    ring_index_publish(&ring->index, head, stored);
+
+    if (stored < count) {
+        ring_index_drop(&ring->index, count - stored);
+    }
+    return stored;
+}
+
+/* ========== Consumer Side ========== */
+
+size_t sample_ring_available(const sample_ring_t *ring) {
+    uint32_t tail;
+    return ring_index_available(&ring->index, &tail);
+}
+
+size_t sample_ring_read(sample_ring_t *ring, signal_t *output, size_t max_count) {
+    uint32_t tail;
+    size_t available = ring_index_available(&ring->index, &tail);
+    size_t count = (max_count < available) ? max_count : available;
+
+    size_t start = tail & ring->mask;
+    size_t first = ring->mask + 1 - start;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(output, &ring->buffer[start], first * sizeof(signal_t));
+    memcpy(&output[first], ring->buffer, (count - first) * sizeof(signal_t));
+
+    ring_index_consume(&ring->index, tail, count);
+    return count;
+}
+
+size_t sample_ring_peek(const sample_ring_t *ring, const signal_t **data) {
+    uint32_t tail;
+    size_t available = ring_index_available(&ring->index, &tail);
+    size_t start = tail & ring->mask;
+    size_t contiguous = ring->mask + 1 - start;
+
+    *data = &ring->buffer[start];
+    return (available < contiguous) ? available : contiguous;
+}
+
+void sample_ring_consume(sample_ring_t *ring, size_t count) {
+    uint32_t tail;
+    size_t available = ring_index_available(&ring->index, &tail);
+
+    if (count > available) {
+        count = available;
+    }
+    ring_index_consume(&ring->index, tail, count);
+}
+
+/* ========== Diagnostics ========== */
+
+uint32_t sample_ring_dropped(const sample_ring_t *ring) {
+    return atomic_load_explicit(&ring->index.dropped, memory_order_relaxed);
+}
+
+uint32_t sample_ring_overruns(const sample_ring_t *ring) {
+    return atomic_load_explicit(&ring->index.overruns, memory_order_relaxed);
+}
@@ -0,0 +1,186 @@
+#include "scheduler.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__riscv) && !defined(__linux__)
+#define SCHED_BARE_METAL 1
+#else
+#include <time.h>
+#include <errno.h>
+#endif
+
+/* ========== Clock ========== */
+
+#if defined(SCHED_BARE_METAL)
+/* CLINT registers, accessed as 32-bit halves on rv32 */
+#define CLINT_MTIMECMP  ((volatile uint32_t*)(CLINT_BASE + 0x4000))
+#define CLINT_MTIME     ((volatile uint32_t*)(CLINT_BASE + 0xBFF8))
+#define MIE_MTIE        0x80
+#define MTIME_PER_US    (MTIME_FREQ_HZ / 1000000u)
+
+static uint64_t read_mtime(void) {
+    uint32_t hi, lo;
+
+    /* Re-read if the low word carried into the high word in between */
+    do {
+        hi = CLINT_MTIME[1];
+        lo = CLINT_MTIME[0];
+    } while (hi != CLINT_MTIME[1]);
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/* Arm the machine timer and wait for it (or any other enabled interrupt) */
+static void idle_until(uint64_t deadline_us) {
+    uint64_t target = deadline_us * MTIME_PER_US;
+
+    /* Raise the low word first so no intermediate value fires early */
+    CLINT_MTIMECMP[0] = 0xFFFFFFFFu;
+    CLINT_MTIMECMP[1] = (uint32_t)(target >> 32);
+    CLINT_MTIMECMP[0] = (uint32_t)target;
+
+    __asm__ volatile ("csrs mie, %0" : : "r"(MIE_MTIE));
+    if (read_mtime() < target) {
+        __asm__ volatile ("wfi");
+    }
+}
+
+uint64_t sched_now_us(void) {
+    return read_mtime() / MTIME_PER_US;
+}
+
+#elif defined(_WIN32)
+static void idle_until(uint64_t deadline_us) {
+    uint64_t now = sched_now_us();
+    if (deadline_us > now) {
+        Sleep((DWORD)((deadline_us - now + 999) / 1000));
+    }
+}
+
+uint64_t sched_now_us(void) {
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000u +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000u / frequency.QuadPart;
+}
+
+#else
+static void idle_until(uint64_t deadline_us) {
+    uint64_t now = sched_now_us();
+    if (deadline_us <= now) {
+        return;
+    }
+
+    uint64_t delta = deadline_us - now;
+    struct timespec request;
+    request.tv_sec = (time_t)(delta / 1000000u);
+    request.tv_nsec = (long)(delta % 1000000u) * 1000;
+
+    /* A signal cuts the sleep short; the caller's loop re-checks the clock */
+    nanosleep(&request, NULL);
+}
+
+uint64_t sched_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+#endif
+
+void sched_sleep_until(uint64_t deadline_us) {
+    while (sched_now_us() < deadline_us) {
+        idle_until(deadline_us);
+    }
+}
+
+/* ========== Periodic Timer ========== */
+
+void sched_timer_start(sched_timer_t *timer, uint32_t period_us) {
+    timer->period_us = period_us;
+    timer->next_us = sched_now_us() + period_us;
+    timer->missed = 0;
+}
+
+bool_t sched_timer_wait(sched_timer_t *timer) {
+    bool_t on_time = (sched_now_us() <= timer->next_us) ? TRUE : FALSE;
+
+    if (on_time) {
+        sched_sleep_until(timer->next_us);
+    } else {
+        timer->missed++;
+    }
+
+    /* Deadlines stay on the original grid, so a late wakeup is caught up
+     * by the following ones rather than shifting the whole schedule */
+    timer->next_us += timer->period_us;
+    return on_time;
+}
+
+/* ========== Events ========== */
+
+void sched_event_init(sched_event_t *event) {
+    atomic_init(&event->pending, 0);
+#if USE_PTHREADS
+    pthread_mutex_init(&event->lock, NULL);
+    pthread_cond_init(&event->cond, NULL);
+#endif
+}
+
+void sched_event_destroy(sched_event_t *event) {
+#if USE_PTHREADS
+    pthread_cond_destroy(&event->cond);
+    pthread_mutex_destroy(&event->lock);
+#else
+    (void)event;
+#endif
+}
+
+void sched_event_signal(sched_event_t *event) {
+#if USE_PTHREADS
+    pthread_mutex_lock(&event->lock);
+    atomic_store_explicit(&event->pending, 1, memory_order_release);
+    pthread_cond_signal(&event->cond);
+    pthread_mutex_unlock(&event->lock);
+#else
+    /* A single store: the waiter's wfi wakes on the interrupt that ran us */
+    atomic_store_explicit(&event->pending, 1, memory_order_release);
+#endif
+}
+
+bool_t sched_event_wait_until(sched_event_t *event, uint64_t deadline_us) {
+#if USE_PTHREADS
+    pthread_mutex_lock(&event->lock);
+    while (!atomic_load_explicit(&event->pending, memory_order_acquire)) {
+        uint64_t now = sched_now_us();
+        if (now >= deadline_us) {
+            pthread_mutex_unlock(&event->lock);
+            return FALSE;
+        }
+
+        /* Condition variables time out on the realtime clock */
+        uint64_t delta = deadline_us - now;
+        struct timespec wake;
+        clock_gettime(CLOCK_REALTIME, &wake);
+        wake.tv_sec += (time_t)(delta / 1000000u);
+        wake.tv_nsec += (long)(delta % 1000000u) * 1000;
+        if (wake.tv_nsec >= 1000000000L) {
+            wake.tv_sec++;
+            wake.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&event->cond, &event->lock, &wake);
+    }
+    atomic_store_explicit(&event->pending, 0, memory_order_relaxed);
+    pthread_mutex_unlock(&event->lock);
+    return TRUE;
+#else
+    while (!atomic_load_explicit(&event->pending, memory_order_acquire)) {
+        if (sched_now_us() >= deadline_us) {
+            return FALSE;
+        }
+        idle_until(deadline_us);
+    }
+    atomic_store_explicit(&event->pending, 0, memory_order_relaxed);
+    return TRUE;
+#endif
+}
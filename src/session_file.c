@@ -0,0 +1,396 @@
+#include "session_file.h"
+#include "data_loader.h"
+#include "feature_extraction.h"
+#include "utils.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Header field offsets */
+#define HDR_MAGIC          0
+#define HDR_VERSION        4
+#define HDR_HEADER_SIZE    6
+#define HDR_SAMPLE_RATE    8
+#define HDR_NUM_CHANNELS   12
+#define HDR_NUM_BANDS      14
+#define HDR_NUM_LABELS     16
+#define HDR_BLOCK_SAMPLES  18
+#define HDR_NUM_SAMPLES    20
+#define HDR_NUM_BLOCKS     24
+#define HDR_BLOCK_BYTES    28
+#define HDR_DATA_OFFSET    32
+#define HDR_INDEX_OFFSET   36
+#define HDR_BANDS          64     /* SESSION_MAX_BANDS x {low, high} */
+#define HDR_LABELS         128    /* SESSION_MAX_LABELS x SESSION_LABEL_LENGTH */
+
+/* Index entry field offsets */
+#define IDX_FIRST_SAMPLE   0
+#define IDX_OFFSET         4
+#define IDX_START_TIME     8
+
+/* Dictionary written for command labels, indexed by command_t */
+static const char *const command_labels[] = { "NONE", "FOCUS", "RELAX", "BLINK" };
+#define NUM_COMMAND_LABELS (sizeof(command_labels) / sizeof(command_labels[0]))
+
+/* ========== Little-Endian Encoding ========== */
+
+static void put_u16(unsigned char *p, uint32_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+}
+
+static void put_u32(unsigned char *p, uint32_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+static void put_f32(unsigned char *p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put_u32(p, bits);
+}
+
+static uint32_t get_u16(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float get_f32(const unsigned char *p) {
+    uint32_t bits = get_u32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static size_t align_up(size_t value, size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+/* ========== Writer ========== */
+
+bool_t session_write(const char *filepath, const eeg_frame_t *frame,
+                     const command_t *labels, size_t num_samples,
+                     float sample_rate, float start_time) {
+    if (filepath == NULL || frame == NULL || frame->data == NULL ||
+        num_samples == 0 || num_samples > frame->length || sample_rate <= 0.0f) {
+        return FALSE;
+    }
+
+    const size_t channels = frame->num_channels;
+    const size_t block_samples = SESSION_BLOCK_SAMPLES;
+    const size_t num_blocks = (num_samples + block_samples - 1) / block_samples;
+    const size_t block_bytes = align_up(block_samples * (channels * sizeof(float) + 1),
+                                        SESSION_DATA_ALIGN);
+    const size_t data_offset = align_up(SESSION_HEADER_SIZE, SESSION_DATA_ALIGN);
+    const size_t index_offset = data_offset + num_blocks * block_bytes;
+
+    unsigned char header[SESSION_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(&header[HDR_MAGIC], SESSION_MAGIC, 4);
+    put_u16(&header[HDR_VERSION], SESSION_VERSION);
+    put_u16(&header[HDR_HEADER_SIZE], SESSION_HEADER_SIZE);
+    put_f32(&header[HDR_SAMPLE_RATE], sample_rate);
+    put_u16(&header[HDR_NUM_CHANNELS], (uint32_t)channels);
+    put_u16(&header[HDR_NUM_BANDS], NUM_BANDS);
+    put_u16(&header[HDR_NUM_LABELS], (uint32_t)NUM_COMMAND_LABELS);
+    put_u16(&header[HDR_BLOCK_SAMPLES], (uint32_t)block_samples);
+    put_u32(&header[HDR_NUM_SAMPLES], (uint32_t)num_samples);
+    put_u32(&header[HDR_NUM_BLOCKS], (uint32_t)num_blocks);
+    put_u32(&header[HDR_BLOCK_BYTES], (uint32_t)block_bytes);
+    put_u32(&header[HDR_DATA_OFFSET], (uint32_t)data_offset);
+    put_u32(&header[HDR_INDEX_OFFSET], (uint32_t)index_offset);
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        put_f32(&header[HDR_BANDS + b * 8], eeg_bands[b].low_freq);
+        put_f32(&header[HDR_BANDS + b * 8 + 4], eeg_bands[b].high_freq);
+    }
+    for (size_t l = 0; l < NUM_COMMAND_LABELS; l++) {
+        strncpy((char*)&header[HDR_LABELS + l * SESSION_LABEL_LENGTH],
+                command_labels[l], SESSION_LABEL_LENGTH - 1);
+    }
+
+    FILE *fp = fopen(filepath, "wb");
+    if (fp == NULL) {
+        log_error("Failed to create session file: %s", filepath);
+        return FALSE;
+    }
+
+    unsigned char *block = (unsigned char*)malloc(block_bytes);
+    unsigned char *index = (unsigned char*)calloc(num_blocks, SESSION_INDEX_ENTRY_SIZE);
+    bool_t ok = (block != NULL && index != NULL) ? TRUE : FALSE;
+
+    ok = ok && fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+    for (size_t pad = sizeof(header); ok && pad < data_offset; pad++) {
+        ok = fputc(0, fp) != EOF;
+    }
+
+    for (size_t k = 0; ok && k < num_blocks; k++) {
+        size_t first = k * block_samples;
+        size_t count = (num_samples - first < block_samples) ? num_samples - first : block_samples;
+        unsigned char *label_bytes = block + channels * block_samples * sizeof(float);
+
+        /* Partial last block: zero padding past num_samples */
+        memset(block, 0, block_bytes);
+        for (size_t c = 0; c < channels; c++) {
+            const signal_t *row = eeg_frame_channel(frame, c) + first;
+            unsigned char *out = block + c * block_samples * sizeof(float);
+            for (size_t i = 0; i < count; i++) {
+                put_f32(out + i * sizeof(float), row[i]);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            label_bytes[i] = (unsigned char)((labels != NULL) ? labels[first + i] : CMD_NONE);
+        }
+        ok = fwrite(block, 1, block_bytes, fp) == block_bytes;
+
+        unsigned char *entry = index + k * SESSION_INDEX_ENTRY_SIZE;
+        put_u32(entry + IDX_FIRST_SAMPLE, (uint32_t)first);
+        put_u32(entry + IDX_OFFSET, (uint32_t)(data_offset + k * block_bytes));
+        put_f32(entry + IDX_START_TIME, start_time + (float)first / sample_rate);
+    }
+
+    ok = ok && fwrite(index, SESSION_INDEX_ENTRY_SIZE, num_blocks, fp) == num_blocks;
+    ok = (fclose(fp) == 0) && ok;
+
+    free(block);
+    free(index);
+
+    if (!ok) {
+        log_error("Failed to write session file: %s", filepath);
+        remove(filepath);
+    }
+    return ok;
+}
+
+bool_t convert_csv_to_session(const char *csv_path, const char *session_path) {
+    dataset_info_t info;
+    if (!get_dataset_info(csv_path, &info) || info.num_samples == 0) {
+        log_error("No samples in %s", csv_path);
+        return FALSE;
+    }
+
+    eeg_frame_t frame;
+    if (!eeg_frame_init(&frame, info.num_channels, info.num_samples)) {
+        return FALSE;
+    }
+
+    command_t *labels = (command_t*)malloc(info.num_samples * sizeof(command_t));
+    eeg_sample_t first_row;
+    size_t num_loaded = 0;
+    size_t num_time = 0;
+    bool_t ok = FALSE;
+
+    if (labels != NULL && load_multichannel_csv(csv_path, &frame, labels, &num_loaded)) {
+        /* The time column only supplies the start stamp */
+        if (!load_dataset_columns(csv_path, &first_row, 1, COLUMN_BIT(COLUMN_TIME), &num_time)) {
+            first_row.time = 0.0f;
+        }
+        ok = session_write(session_path, &frame, labels, num_loaded,
+                           info.sampling_rate, first_row.time);
+    }
+
+    free(labels);
+    eeg_frame_destroy(&frame);
+
+    if (ok) {
+        log_info("Converted %zu samples x %zu channels to %s",
+                 num_loaded, info.num_channels, session_path);
+    }
+    return ok;
+}
+
+/* ========== Reader ========== */
+
+static const unsigned char* index_entry(const session_reader_t *reader, size_t block) {
+    return (const unsigned char*)reader->file.data + reader->header.index_offset +
+           block * SESSION_INDEX_ENTRY_SIZE;
+}
+
+static bool_t decode_header(session_reader_t *reader) {
+    const unsigned char *p = (const unsigned char*)reader->file.data;
+    const size_t file_size = reader->file.size;
+    session_header_t *h = &reader->header;
+
+    if (file_size < SESSION_HEADER_SIZE || memcmp(&p[HDR_MAGIC], SESSION_MAGIC, 4) != 0) {
+        return FALSE;
+    }
+    if (get_u16(&p[HDR_VERSION]) != SESSION_VERSION ||
+        get_u16(&p[HDR_HEADER_SIZE]) != SESSION_HEADER_SIZE) {
+        return FALSE;
+    }
+
+    h->sample_rate = get_f32(&p[HDR_SAMPLE_RATE]);
+    h->num_channels = get_u16(&p[HDR_NUM_CHANNELS]);
+    h->num_bands = get_u16(&p[HDR_NUM_BANDS]);
+    h->num_labels = get_u16(&p[HDR_NUM_LABELS]);
+    h->block_samples = get_u16(&p[HDR_BLOCK_SAMPLES]);
+    h->num_samples = get_u32(&p[HDR_NUM_SAMPLES]);
+    h->num_blocks = get_u32(&p[HDR_NUM_BLOCKS]);
+    h->block_bytes = get_u32(&p[HDR_BLOCK_BYTES]);
+    h->data_offset = get_u32(&p[HDR_DATA_OFFSET]);
+    h->index_offset = get_u32(&p[HDR_INDEX_OFFSET]);
+
+    if (!(h->sample_rate > 0.0f) || h->num_channels == 0 || h->num_channels > MAX_CHANNELS ||
+        h->num_bands > SESSION_MAX_BANDS || h->num_labels > SESSION_MAX_LABELS ||
+        h->block_samples == 0 ||
+        h->block_bytes < h->block_samples * (h->num_channels * sizeof(float) + 1) ||
+        (h->block_bytes % sizeof(float)) != 0 ||
+        h->index_offset > file_size || h->num_blocks > file_size / h->block_bytes ||
+        (file_size - h->index_offset) / SESSION_INDEX_ENTRY_SIZE < h->num_blocks ||
+        h->num_samples > h->num_blocks * h->block_samples) {
+        return FALSE;
+    }
+
+    for (size_t b = 0; b < h->num_bands; b++) {
+        h->bands[b].low_freq = get_f32(&p[HDR_BANDS + b * 8]);
+        h->bands[b].high_freq = get_f32(&p[HDR_BANDS + b * 8 + 4]);
+    }
+    for (size_t l = 0; l < h->num_labels; l++) {
+        memcpy(h->labels[l], &p[HDR_LABELS + l * SESSION_LABEL_LENGTH], SESSION_LABEL_LENGTH);
+        h->labels[l][SESSION_LABEL_LENGTH - 1] = '\0';
+        reader->label_map[l] = parse_command_string(h->labels[l]);
+    }
+
+    /* Every block must lie between the header and the index, float-aligned */
+    for (size_t k = 0; k < h->num_blocks; k++) {
+        const unsigned char *entry = index_entry(reader, k);
+        size_t offset = get_u32(entry + IDX_OFFSET);
+        if (get_u32(entry + IDX_FIRST_SAMPLE) != k * h->block_samples ||
+            offset < SESSION_HEADER_SIZE || (offset % sizeof(float)) != 0 ||
+            offset > h->index_offset || h->index_offset - offset < h->block_bytes) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+bool_t session_open(session_reader_t *reader, const char *filepath) {
+    memset(reader, 0, sizeof(*reader));
+
+    if (!host_is_little_endian()) {
+        log_error("Session files are read in place and need a little-endian host");
+        return FALSE;
+    }
+
+    if (!mapped_file_open(&reader->file, filepath)) {
+        log_error("Failed to open session file: %s", filepath);
+        return FALSE;
+    }
+
+    if (!decode_header(reader)) {
+        log_error("%s is not a valid session file", filepath);
+        session_close(reader);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void session_close(session_reader_t *reader) {
+    if (reader == NULL) {
+        return;
+    }
+    mapped_file_close(&reader->file);
+    memset(reader, 0, sizeof(*reader));
+}
+
+size_t session_seek_time(const session_reader_t *reader, float seconds) {
+    const session_header_t *h = &reader->header;
+    if (h->num_samples == 0) {
+        return 0;
+    }
+
+    /* Pick the block from the nominal rate, then offset from its own stamp */
+    float start = get_f32(index_entry(reader, 0) + IDX_START_TIME);
+    float position = (seconds - start) * h->sample_rate;
+    size_t sample = (position > 0.0f) ? (size_t)position : 0;
+    size_t block = sample / h->block_samples;
+    if (block >= h->num_blocks) {
+        block = h->num_blocks - 1;
+    }
+
+    const unsigned char *entry = index_entry(reader, block);
+    float within = (seconds - get_f32(entry + IDX_START_TIME)) * h->sample_rate;
+    size_t offset = (within > 0.0f) ? (size_t)(within + 0.5f) : 0;
+    if (offset >= h->block_samples) {
+        offset = h->block_samples - 1;
+    }
+
+    sample = get_u32(entry + IDX_FIRST_SAMPLE) + offset;
+    return (sample < h->num_samples) ? sample : h->num_samples - 1;
+}
+
+/* Start of the block holding sample */
+static const unsigned char* block_data(const session_reader_t *reader, size_t sample) {
+    size_t block = sample / reader->header.block_samples;
+    return (const unsigned char*)reader->file.data + get_u32(index_entry(reader, block) + IDX_OFFSET);
+}
+
+size_t session_channel_span(const session_reader_t *reader, size_t channel,
+                            size_t first_sample, const signal_t **data) {
+    const session_header_t *h = &reader->header;
+    *data = NULL;
+    if (channel >= h->num_channels || first_sample >= h->num_samples) {
+        return 0;
+    }
+
+    size_t within = first_sample % h->block_samples;
+    size_t count = h->block_samples - within;
+    if (count > h->num_samples - first_sample) {
+        count = h->num_samples - first_sample;
+    }
+
+    *data = (const signal_t*)(block_data(reader, first_sample) +
+                              (channel * h->block_samples + within) * sizeof(float));
+    return count;
+}
+
+command_t session_label(const session_reader_t *reader, size_t sample) {
+    const session_header_t *h = &reader->header;
+    if (sample >= h->num_samples) {
+        return CMD_NONE;
+    }
+
+    const unsigned char *labels = block_data(reader, sample) +
+                                  h->num_channels * h->block_samples * sizeof(float);
+    unsigned char label = labels[sample % h->block_samples];
+    return (label < h->num_labels) ? reader->label_map[label] : CMD_NONE;
+}
+
+size_t load_session_frame(const session_reader_t *reader, size_t first_sample,
+                          eeg_frame_t *frame, command_t *labels) {
+    if (frame == NULL || frame->data == NULL || frame->num_channels != reader->header.num_channels) {
+        return 0;
+    }
+
+    size_t copied = 0;
+    while (copied < frame->length) {
+        const signal_t *span = NULL;
+        size_t count = session_channel_span(reader, 0, first_sample + copied, &span);
+        if (count == 0) {
+            break;
+        }
+        if (count > frame->length - copied) {
+            count = frame->length - copied;
+        }
+
+        for (size_t c = 0; c < frame->num_channels; c++) {
+            session_channel_span(reader, c, first_sample + copied, &span);
+            memcpy(eeg_frame_channel(frame, c) + copied, span, count * sizeof(signal_t));
+        }
+        if (labels != NULL) {
+            for (size_t i = 0; i < count; i++) {
+                labels[copied + i] = session_label(reader, first_sample + copied + i);
+            }
+        }
+        copied += count;
+    }
+
+    return copied;
+}
@@ -0,0 +1,115 @@
+#include "sliding_dft.h"
+#include "utils.h"
+#include <math.h>
+
+#define SDFT_SIZE WINDOW_SIZE
+#define SDFT_NYQUIST_BIN (SDFT_SIZE / 2)
+
+void sdft_init(sdft_state_t *sdft, const frequency_band_t *bands, size_t num_bands) {
+    float resolution = get_frequency_resolution(SDFT_SIZE, SAMPLING_RATE);
+    size_t lowest = SDFT_NYQUIST_BIN;
+    size_t highest = 0;
+
+    if (num_bands > NUM_BANDS) {
+        log_error("Sliding DFT supports at most %d bands, got %zu", NUM_BANDS, num_bands);
+        num_bands = NUM_BANDS;
+    }
+
+    /* Same inclusive band edges as calculate_band_power_psd */
+    sdft->num_bands = num_bands;
+    for (size_t b = 0; b < num_bands; b++) {
+        size_t low_bin = (size_t)ceilf(bands[b].low_freq / resolution - 1e-4f);
+        size_t high_bin = (size_t)floorf(bands[b].high_freq / resolution + 1e-4f);
+        if (high_bin > SDFT_NYQUIST_BIN) {
+            high_bin = SDFT_NYQUIST_BIN;
+        }
+
+        sdft->band_low_bin[b] = low_bin;
+        sdft->band_high_bin[b] = high_bin;
+        if (low_bin < lowest) lowest = low_bin;
+        if (high_bin > highest) highest = high_bin;
+    }
+
+    /* One guard bin on each side for the frequency-domain Hann window */
+    sdft->first_bin = (lowest > 0) ? lowest - 1 : 0;
+    size_t last_bin = (highest < SDFT_NYQUIST_BIN) ? highest + 1 : SDFT_NYQUIST_BIN;
+    sdft->num_bins = (last_bin >= sdft->first_bin) ? last_bin - sdft->first_bin + 1 : 0;
+
+    for (size_t k = 0; k < SDFT_SIZE; k++) {
+        float angle = 2.0f * M_PI * k / SDFT_SIZE;
+        sdft->phasors[k] = complex_create(cosf(angle), sinf(angle));
+    }
+
+    for (size_t i = 0; i < sdft->num_bins; i++) {
+        sdft->bins[i] = complex_create(0.0f, 0.0f);
+    }
+}
+
+void sdft_update(sdft_state_t *sdft, signal_t sample, signal_t leaving) {
+    signal_t delta = sample - leaving;
+
+    /* X_k <- (X_k + x_new - x_old) * exp(+2*pi*i*k/N) */
+    for (size_t i = 0; i < sdft->num_bins; i++) {
+        complex_t shifted = complex_create(sdft->bins[i].real + delta, sdft->bins[i].imag);
+        sdft->bins[i] = complex_mul(shifted, sdft->phasors[sdft->first_bin + i]);
+    }
+}
+
+void sdft_resync(sdft_state_t *sdft, const signal_t *window) {
+    for (size_t i = 0; i < sdft->num_bins; i++) {
+        size_t k = sdft->first_bin + i;
+        float real = 0.0f;
+        float imag = 0.0f;
+
+        /* exp(-2*pi*i*k*m/N) = conj(phasors[k*m mod N]) */
+        size_t phase = 0;
+        for (size_t m = 0; m < SDFT_SIZE; m++) {
+            real += window[m] * sdft->phasors[phase].real;
+            imag -= window[m] * sdft->phasors[phase].imag;
+            phase = (phase + k) % SDFT_SIZE;
+        }
+
+        sdft->bins[i] = complex_create(real, imag);
+    }
+}
+
+/* Tracked bin k, using conjugate symmetry just outside [0, N/2] */
+static complex_t sdft_bin(const sdft_state_t *sdft, long k) {
+    if (k < 0) {
+        complex_t c = sdft_bin(sdft, -k);
+        return complex_create(c.real, -c.imag);
+    }
+    if (k > SDFT_NYQUIST_BIN) {
+        complex_t c = sdft_bin(sdft, SDFT_SIZE - k);
+        return complex_create(c.real, -c.imag);
+    }
+    return sdft->bins[(size_t)k - sdft->first_bin];
+}
+
+void sdft_band_powers(const sdft_state_t *sdft, float *band_powers) {
+    float resolution = get_frequency_resolution(SDFT_SIZE, SAMPLING_RATE);
+    float norm = 1.0f / ((float)SDFT_SIZE * SDFT_SIZE);
+
+    for (size_t b = 0; b < sdft->num_bands; b++) {
+        float total_power = 0.0f;
+
+        for (size_t k = sdft->band_low_bin[b]; k <= sdft->band_high_bin[b]; k++) {
+            /* Hann window: 0.5 X[k] - 0.25 (X[k-1] + X[k+1]) */
+            complex_t center = sdft_bin(sdft, (long)k);
+            complex_t below = sdft_bin(sdft, (long)k - 1);
+            complex_t above = sdft_bin(sdft, (long)k + 1);
+            complex_t windowed = complex_create(
+                0.5f * center.real - 0.25f * (below.real + above.real),
+                0.5f * center.imag - 0.25f * (below.imag + above.imag));
+
+            float magnitude_sq = complex_magnitude_squared(windowed);
+            if (k == 0 || k == SDFT_NYQUIST_BIN) {
+                total_power += magnitude_sq * norm;
+            } else {
+                total_power += 2.0f * magnitude_sq * norm;
+            }
+        }
+
+        band_powers[b] = total_power * resolution;
+    }
+}
@@ -0,0 +1,250 @@
+#include "streaming.h"
+#include "feature_extraction.h"
+#include "utils.h"
+#include <math.h>
+#include <string.h>
+
+/* ========== Sliding Extreme Tracker ========== */
+
+static void extreme_reset(sliding_extreme_t *tracker) {
+    tracker->head = 0;
+    tracker->length = 0;
+}
+
+/* Push a sample; is_max selects a running maximum, otherwise a running minimum */
+static void extreme_push(sliding_extreme_t *tracker, uint32_t index, signal_t value,
+                         bool_t is_max) {
+    /* Drop entries that can never be the extreme again */
+    while (tracker->length > 0) {
+        size_t back = (tracker->head + tracker->length - 1) % WINDOW_SIZE;
+        signal_t v = tracker->value[back];
+        if ((is_max && v > value) || (!is_max && v < value)) {
+            break;
+        }
+        tracker->length--;
+    }
+
+    size_t pos = (tracker->head + tracker->length) % WINDOW_SIZE;
+    tracker->index[pos] = index;
+    tracker->value[pos] = value;
+    tracker->length++;
+}
+
+/* Drop entries older than the window that ends at newest_index */
+static void extreme_expire(sliding_extreme_t *tracker, uint32_t newest_index) {
+    while (tracker->length > 0 &&
+           newest_index - tracker->index[tracker->head] >= WINDOW_SIZE) {
+        tracker->head = (tracker->head + 1) % WINDOW_SIZE;
+        tracker->length--;
+    }
+}
+
+static signal_t extreme_value(const sliding_extreme_t *tracker) {
+    return (tracker->length > 0) ? tracker->value[tracker->head] : 0.0f;
+}
+
+/* ========== Streaming Pipeline ========== */
+
+void streaming_init(stream_state_t *state, size_t hop_size) {
+    if (hop_size == 0) {
+        hop_size = STREAM_HOP_SIZE;
+    }
+    if (hop_size > WINDOW_SIZE) {
+        hop_size = WINDOW_SIZE;
+    }
+
+    memset(state->ring, 0, sizeof(state->ring));
+    state->head = 0;
+    state->count = 0;
+    state->hop_size = hop_size;
+    state->since_emit = 0;
+    state->sample_index = 0;
+
+    state->sum = 0.0f;
+    state->sum_sq = 0.0f;
+    state->sum_cu = 0.0f;
+    state->since_resync = 0;
+    extreme_reset(&state->max_tracker);
+    extreme_reset(&state->min_tracker);
+#if USE_IIR_BANDPOWER
+    filter_bank_init(&state->filter_bank, eeg_bands, NUM_BANDS, SAMPLING_RATE);
+#elif USE_SLIDING_DFT
+    sdft_init(&state->sdft, eeg_bands, NUM_BANDS);
+#elif USE_WELCH_PSD
+    welch_init(&state->welch, SAMPLING_RATE);
+#endif
+}
+
+#if !USE_IIR_BANDPOWER && (USE_SLIDING_DFT || !USE_WELCH_PSD)
+/* Copy the ring to state->window, oldest sample first
+ * Returns: Number of samples copied
+ */
+static size_t streaming_linearize(stream_state_t *state) {
+    size_t oldest = (state->count < WINDOW_SIZE) ? 0 : state->head;
+    size_t first_part = state->count - oldest;
+
+    memcpy(state->window, &state->ring[oldest], first_part * sizeof(signal_t));
+    memcpy(&state->window[first_part], state->ring, oldest * sizeof(signal_t));
+
+    return state->count;
+}
+#endif
+
+/* Recompute running sums from the ring to bound float drift */
+static void streaming_resync(stream_state_t *state) {
+    float sum = 0.0f;
+    float sum_sq = 0.0f;
+    float sum_cu = 0.0f;
+
+    for (size_t i = 0; i < state->count; i++) {
+        signal_t x = state->ring[i];
+        sum += x;
+        sum_sq += x * x;
+        sum_cu += x * x * x;
+    }
+
+    state->sum = sum;
+    state->sum_sq = sum_sq;
+    state->sum_cu = sum_cu;
+    state->since_resync = 0;
+
+#if USE_SLIDING_DFT && !USE_IIR_BANDPOWER
+    /* The sliding DFT sees a full window with zeros before the first sample */
+    size_t filled = streaming_linearize(state);
+    memmove(&state->window[WINDOW_SIZE - filled], state->window, filled * sizeof(signal_t));
+    memset(state->window, 0, (WINDOW_SIZE - filled) * sizeof(signal_t));
+    sdft_resync(&state->sdft, state->window);
+#endif
+}
+
+signal_t streaming_mean(const stream_state_t *state) {
+    return (state->count > 0) ? state->sum / state->count : 0.0f;
+}
+
+signal_t streaming_variance(const stream_state_t *state) {
+    if (state->count == 0) {
+        return 0.0f;
+    }
+
+    signal_t mean = state->sum / state->count;
+    signal_t variance = state->sum_sq / state->count - mean * mean;
+
+    return (variance > 0.0f) ? variance : 0.0f;
+}
+
+signal_t streaming_peak(const stream_state_t *state) {
+    signal_t max_value = fabsf(extreme_value(&state->max_tracker));
+    signal_t min_value = fabsf(extreme_value(&state->min_tracker));
+
+    return (max_value > min_value) ? max_value : min_value;
+}
+
+void streaming_compute_features(stream_state_t *state, features_t *features) {
+    signal_t band_powers[NUM_BANDS];
+#if USE_IIR_BANDPOWER
+    filter_bank_band_powers(&state->filter_bank, band_powers);
+#elif USE_SLIDING_DFT
+    sdft_band_powers(&state->sdft, band_powers);
+#elif USE_WELCH_PSD
+    /* Segments completed since the last hop are already in the average */
+    welch_band_powers(&state->welch, eeg_bands, NUM_BANDS, band_powers);
+#else
+    /* Linearize the ring (oldest sample first) for the FFT */
+    size_t length = streaming_linearize(state);
+    calculate_band_powers(state->window, length, eeg_bands, NUM_BANDS, band_powers);
+#endif
+
+    features->theta_power = band_powers[BAND_THETA];
+    features->alpha_power = band_powers[BAND_ALPHA];
+    features->beta_power = band_powers[BAND_BETA];
+    features->gamma_power = band_powers[BAND_GAMMA];
+    normalize_band_powers(features);
+
+    /* Peak is reported in standard deviations from the window mean, which is
+     * what extract_features() measures after preprocess_signal() normalizes */
+    signal_t mean = streaming_mean(state);
+    signal_t variance = streaming_variance(state);
+    signal_t std_dev = sqrtf(variance);
+    signal_t above = fabsf(extreme_value(&state->max_tracker) - mean);
+    signal_t below = fabsf(extreme_value(&state->min_tracker) - mean);
+    signal_t peak = (above > below) ? above : below;
+
+    features->peak_amplitude = (std_dev > 0.001f) ? peak / std_dev : peak;
+    features->variance = variance;
+
+    /* Third central moment from the running power sums */
+    signal_t n = (signal_t)state->count;
+    signal_t third_moment = state->sum_cu / n - 3.0f * mean * (state->sum_sq / n) +
+                            2.0f * mean * mean * mean;
+    features->skewness = (std_dev < 0.001f) ? 0.0f : third_moment / (variance * std_dev);
+}
+
+bool_t streaming_push_sample(stream_state_t *state, signal_t sample, features_t *features) {
+    /* Remove the sample leaving the window from the running sums
+     * (ring slots start at zero, so this is a no-op while filling) */
+    signal_t leaving = state->ring[state->head];
+    if (state->count == WINDOW_SIZE) {
+        state->sum -= leaving;
+        state->sum_sq -= leaving * leaving;
+        state->sum_cu -= leaving * leaving * leaving;
+    } else {
+        state->count++;
+    }
+
+#if USE_IIR_BANDPOWER
+    filter_bank_process_sample(&state->filter_bank, sample, NULL);
+#elif USE_SLIDING_DFT
+    sdft_update(&state->sdft, sample, leaving);
+#elif USE_WELCH_PSD
+    welch_push_sample(&state->welch, sample);
+#endif
+
+    state->ring[state->head] = sample;
+    state->head = (state->head + 1) % WINDOW_SIZE;
+    state->sum += sample;
+    state->sum_sq += sample * sample;
+    state->sum_cu += sample * sample * sample;
+
+    /* Expire first: the deques hold at most WINDOW_SIZE - 1 live entries
+     * before the push, so a monotonic run never wraps onto the oldest */
+    uint32_t index = state->sample_index++;
+    extreme_expire(&state->max_tracker, index);
+    extreme_expire(&state->min_tracker, index);
+    extreme_push(&state->max_tracker, index, sample, TRUE);
+    extreme_push(&state->min_tracker, index, sample, FALSE);
+
+    /* Once per window turnover: O(1) amortized per sample */
+    if (++state->since_resync >= WINDOW_SIZE) {
+        streaming_resync(state);
+    }
+
+    /* Emit once the window is full and a hop has elapsed */
+    state->since_emit++;
+    if (state->count < WINDOW_SIZE || state->since_emit < state->hop_size) {
+        return FALSE;
+    }
+
+    state->since_emit = 0;
+    if (features != NULL) {
+        streaming_compute_features(state, features);
+    }
+    return TRUE;
+}
+
+size_t streaming_push_samples(stream_state_t *state, const signal_t *samples, size_t count,
+                              features_t *features, size_t max_features) {
+    size_t emitted = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        features_t *slot = NULL;
+        if (features != NULL && max_features > 0) {
+            slot = &features[(emitted < max_features) ? emitted : max_features - 1];
+        }
+
+        if (streaming_push_sample(state, samples[i], slot)) {
+            emitted++;
+        }
+    }
+
+    return emitted;
+}
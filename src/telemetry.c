@@ -0,0 +1,269 @@
+#include "telemetry.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if TELEMETRY_HAS_UDP
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/* Frames are sent as they lie in memory: the layout must not depend on the
+ * compiler (a negative array size here means padding crept in) */
+typedef char telemetry_size_check[(sizeof(telemetry_frame_t) == TELEMETRY_FRAME_SIZE) ? 1 : -1];
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Telemetry frames are little-endian"
+#endif
+
+/* ========== Frames ========== */
+
+void telemetry_encode(telemetry_frame_t *frame, uint32_t sequence,
+                      const telemetry_record_t *record) {
+    size_t stride = 1;
+    if (record->num_samples > TELEMETRY_FRAME_SAMPLES) {
+        stride = (record->num_samples + TELEMETRY_FRAME_SAMPLES - 1) / TELEMETRY_FRAME_SAMPLES;
+    }
+    size_t count = (record->num_samples + stride - 1) / stride;
+
+    memset(frame, 0, sizeof(*frame));
+    frame->magic = TELEMETRY_MAGIC;
+    frame->version = TELEMETRY_VERSION;
+    frame->size = sizeof(telemetry_frame_t);
+    frame->sequence = sequence;
+    frame->first_sample = record->first_sample;
+    frame->num_samples = (uint16_t)count;
+    frame->sample_stride = (uint16_t)stride;
+    frame->sample_rate = SAMPLING_RATE;
+    frame->command = (uint8_t)record->command;
+
+    if (record->outputs != NULL) {
+        frame->outputs = (uint8_t)((record->outputs->led_state ? TELEMETRY_LED : 0u) |
+                                   (record->outputs->buzzer_active ? TELEMETRY_BUZZER : 0u));
+        frame->selected_char = (uint8_t)record->outputs->selected_char;
+    }
+    if (record->predictions != NULL) {
+        frame->predictions[0] = (uint8_t)record->predictions->visual_impairment;
+        frame->predictions[1] = (uint8_t)record->predictions->motor_impairment;
+        frame->predictions[2] = (uint8_t)record->predictions->attention_deficit;
+    }
+    if (record->features != NULL) {
+        frame->band_power[BAND_THETA] = record->features->theta_power;
+        frame->band_power[BAND_ALPHA] = record->features->alpha_power;
+        frame->band_power[BAND_BETA] = record->features->beta_power;
+        frame->band_power[BAND_GAMMA] = record->features->gamma_power;
+    }
+    for (size_t i = 0; i < count; i++) {
+        frame->samples[i] = record->samples[i * stride];
+    }
+
+    frame->crc32 = crc32_update(0, frame, offsetof(telemetry_frame_t, crc32));
+}
+
+bool_t telemetry_frame_check(const telemetry_frame_t *frame) {
+    return (frame->magic == TELEMETRY_MAGIC &&
+            frame->version == TELEMETRY_VERSION &&
+            frame->size == sizeof(telemetry_frame_t) &&
+            frame->num_samples <= TELEMETRY_FRAME_SAMPLES &&
+            frame->crc32 == crc32_update(0, frame, offsetof(telemetry_frame_t, crc32)))
+           ? TRUE : FALSE;
+}
+
+/* ========== File Sink ========== */
+
+static size_t file_write(void *context, const void *data, size_t length) {
+    FILE *fp = (FILE*)context;
+    size_t written = fwrite(data, 1, length, fp);
+
+    /* Readers follow the stream live: do not sit in the stdio buffer */
+    fflush(fp);
+    return written;
+}
+
+void telemetry_file_open(FILE *fp, telemetry_sink_t *sink) {
+#ifdef _WIN32
+    /* Text mode would expand every 0x0A byte */
+    _setmode(_fileno(fp), _O_BINARY);
+#endif
+    sink->name = (fp == stdout) ? "stdout" : "file";
+    sink->write = file_write;
+    sink->context = fp;
+}
+
+/* ========== UART Sink ========== */
+
+static size_t uart_write(void *context, const void *data, size_t length) {
+    telemetry_uart_t *uart = (telemetry_uart_t*)context;
+    const uint8_t *bytes = (const uint8_t*)data;
+
+    for (size_t i = 0; i < length; i++) {
+        if (uart->status_register != NULL) {
+            while ((*uart->status_register & uart->ready_mask) == 0) {
+                /* Transmitter busy */
+            }
+        }
+        *uart->tx_register = bytes[i];
+    }
+    return length;
+}
+
+void telemetry_uart_open(telemetry_uart_t *uart, telemetry_sink_t *sink,
+                         volatile uint8_t *tx_register,
+                         volatile const uint8_t *status_register, uint8_t ready_mask) {
+    uart->tx_register = tx_register;
+    uart->status_register = status_register;
+    uart->ready_mask = ready_mask;
+
+    sink->name = "UART";
+    sink->write = uart_write;
+    sink->context = uart;
+}
+
+/* ========== UDP Sink ========== */
+
+#if TELEMETRY_HAS_UDP
+static size_t udp_write(void *context, const void *data, size_t length) {
+    telemetry_udp_t *udp = (telemetry_udp_t*)context;
+    int flags = 0;
+#ifdef MSG_DONTWAIT
+    flags |= MSG_DONTWAIT;
+#endif
+    ssize_t sent = send(udp->socket_fd, data, length, flags);
+    return (sent < 0) ? 0 : (size_t)sent;
+}
+
+bool_t telemetry_udp_open(telemetry_udp_t *udp, telemetry_sink_t *sink,
+                          const char *host, uint16_t port) {
+    struct addrinfo hints;
+    struct addrinfo *addresses = NULL;
+    char service[8];
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    snprintf(service, sizeof(service), "%u", (unsigned int)port);
+
+    int status = getaddrinfo(host, service, &hints, &addresses);
+    if (status != 0) {
+        log_error("Cannot resolve %s: %s", host, gai_strerror(status));
+        return FALSE;
+    }
+
+    /* A connected socket: send() without an address per frame */
+    udp->socket_fd = -1;
+    for (struct addrinfo *a = addresses; a != NULL; a = a->ai_next) {
+        int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+            udp->socket_fd = fd;
+            break;
+        }
+        close(fd);
+    }
+    freeaddrinfo(addresses);
+
+    if (udp->socket_fd < 0) {
+        log_error("Cannot open a UDP socket to %s:%u", host, (unsigned int)port);
+        return FALSE;
+    }
+
+    sink->name = "UDP";
+    sink->write = udp_write;
+    sink->context = udp;
+    return TRUE;
+}
+
+void telemetry_udp_close(telemetry_udp_t *udp) {
+    if (udp->socket_fd >= 0) {
+        close(udp->socket_fd);
+        udp->socket_fd = -1;
+    }
+}
+#endif
+
+/* ========== Telemetry Stream ========== */
+
+void telemetry_init(telemetry_t *telemetry, const telemetry_sink_t *sink) {
+    telemetry->sink = *sink;
+    telemetry->sequence = 0;
+    telemetry->failed = 0;
+}
+
+bool_t telemetry_send(telemetry_t *telemetry, const telemetry_record_t *record) {
+    telemetry_frame_t frame;
+
+    telemetry_encode(&frame, telemetry->sequence++, record);
+    if (telemetry->sink.write(telemetry->sink.context, &frame, sizeof(frame)) != sizeof(frame)) {
+        telemetry->failed++;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* ========== Destinations ========== */
+
+bool_t telemetry_endpoint_open(telemetry_endpoint_t *endpoint, telemetry_sink_t *sink,
+                               const char *spec) {
+    memset(endpoint, 0, sizeof(*endpoint));
+
+    if (strcmp(spec, "-") == 0) {
+        telemetry_file_open(stdout, sink);
+        return TRUE;
+    }
+
+    if (strncmp(spec, "udp:", 4) == 0) {
+#if TELEMETRY_HAS_UDP
+        /* udp:HOST:PORT, splitting at the last colon */
+        const char *colon = strrchr(spec + 4, ':');
+        char host[256];
+        size_t host_length = (colon != NULL) ? (size_t)(colon - (spec + 4)) : 0;
+        long port = (colon != NULL) ? strtol(colon + 1, NULL, 10) : 0;
+
+        if (host_length == 0 || host_length >= sizeof(host) || port <= 0 || port > 65535) {
+            log_error("Bad telemetry destination %s (expected udp:HOST:PORT)", spec);
+            return FALSE;
+        }
+        memcpy(host, spec + 4, host_length);
+        host[host_length] = '\0';
+        if (!telemetry_udp_open(&endpoint->udp, sink, host, (uint16_t)port)) {
+            return FALSE;
+        }
+        endpoint->is_udp = TRUE;
+        return TRUE;
+#else
+        log_error("UDP telemetry is not available in this build");
+        return FALSE;
+#endif
+    }
+
+    endpoint->file = fopen(spec, "wb");
+    if (endpoint->file == NULL) {
+        log_error("Cannot write telemetry to %s", spec);
+        return FALSE;
+    }
+    telemetry_file_open(endpoint->file, sink);
+    return TRUE;
+}
+
+void telemetry_endpoint_close(telemetry_endpoint_t *endpoint) {
+    if (endpoint->file != NULL) {
+        fclose(endpoint->file);
+        endpoint->file = NULL;
+    }
+#if TELEMETRY_HAS_UDP
+    if (endpoint->is_udp) {
+        telemetry_udp_close(&endpoint->udp);
+        endpoint->is_udp = FALSE;
+    }
+#endif
+}
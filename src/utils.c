@@ -1,5 +1,7 @@
 #include "utils.h"
+#include "scheduler.h"
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
@@ -46,8 +48,8 @@ void print_features(const features_t *features) {
 }
 
 void delay_ms(unsigned int ms) {
-    clock_t start = clock();
-    while ((clock() - start) * 1000 / CLOCKS_PER_SEC < ms);
+    /* Sleeps rather than spinning on clock() */
+    sched_sleep_until(sched_now_us() + (uint64_t)ms * 1000u);
 }
 
 float get_time_sec(void) {
@@ -56,3 +58,30 @@ float get_time_sec(void) {
     }
     return (float)(clock() - start_time) / CLOCKS_PER_SEC;
 }
+
+/* Nibble-at-a-time: the 64-byte table is cheap enough for boot-time and
+ * per-frame checks on the target */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t length) {
+    static const uint32_t table[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+    };
+    const unsigned char *bytes = (const unsigned char*)data;
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = (crc >> 4) ^ table[(crc ^ bytes[i]) & 0x0Fu];
+        crc = (crc >> 4) ^ table[(crc ^ (bytes[i] >> 4)) & 0x0Fu];
+    }
+    return ~crc;
+}
+
+bool_t host_is_little_endian(void) {
+    const uint32_t probe = 1;
+    unsigned char first;
+
+    memcpy(&first, &probe, 1);
+    return first == 1 ? TRUE : FALSE;
+}
@@ -0,0 +1,128 @@
+#include "welch.h"
+#include "dsp_kernels.h"
+#include "utils.h"
+#include <string.h>
+
+void welch_init(welch_state_t *welch, float sampling_rate) {
+    dsp_arena_init(&welch->arena, welch->memory, sizeof(welch->memory));
+    if (!fft_workspace_init_private(&welch->ws, &welch->arena, WELCH_SEGMENT_SIZE)) {
+        log_error("Welch workspace does not fit its arena");
+    }
+
+    /* Density scaling: one-sided, normalized by the window power */
+    float window_power = hann_window_fill(welch->ws.window, WELCH_SEGMENT_SIZE);
+    welch->ws.window_length = WELCH_SEGMENT_SIZE;
+    welch->sampling_rate = sampling_rate;
+    welch->scale = 2.0f / (sampling_rate * window_power);
+
+    welch->spectrum.power = welch->average;
+    welch->spectrum.frequency_resolution = sampling_rate / WELCH_SEGMENT_SIZE;
+
+    welch_reset(welch);
+}
+
+void welch_reset(welch_state_t *welch) {
+    memset(welch->history, 0, sizeof(welch->history));
+    memset(welch->average, 0, sizeof(welch->average));
+    welch->head = 0;
+    welch->count = 0;
+    welch->since_segment = 0;
+    welch->next_spectrum = 0;
+    welch->num_spectra = 0;
+    welch->spectrum.num_bins = 0;
+}
+
+/* Periodogram of the segment in history into the next spectrum slot,
+ * then refresh the average
+ */
+static void welch_add_segment(welch_state_t *welch) {
+    fft_workspace_t *ws = &welch->ws;
+    const signal_t *window = ws->window;
+    signal_t *segment = ws->windowed;
+
+    /* Window while linearizing the ring, oldest sample first */
+    size_t first_part = WELCH_SEGMENT_SIZE - welch->head;
+    for (size_t i = 0; i < first_part; i++) {
+        segment[i] = welch->history[welch->head + i] * window[i];
+    }
+    for (size_t i = first_part; i < WELCH_SEGMENT_SIZE; i++) {
+        segment[i] = welch->history[i - first_part] * window[i];
+    }
+
+    fft_compute_real(&ws->plan, segment, ws->bins);
+
+    float *power = welch->spectra[welch->next_spectrum];
+    dsp_magnitude_squared(ws->bins, power, WELCH_NUM_BINS, welch->scale);
+    power[0] *= 0.5f;
+    power[WELCH_NUM_BINS - 1] *= 0.5f;
+
+    welch->next_spectrum = (welch->next_spectrum + 1) % WELCH_NUM_SEGMENTS;
+    if (welch->num_spectra < WELCH_NUM_SEGMENTS) {
+        welch->num_spectra++;
+    }
+
+    /* Re-summing the few stored spectra is cheap and, unlike a running
+     * add/subtract, accumulates no rounding drift */
+    float inv = 1.0f / welch->num_spectra;
+    for (size_t k = 0; k < WELCH_NUM_BINS; k++) {
+        float sum = 0.0f;
+        for (size_t s = 0; s < welch->num_spectra; s++) {
+            sum += welch->spectra[s][k];
+        }
+        welch->average[k] = sum * inv;
+    }
+    welch->spectrum.num_bins = WELCH_NUM_BINS;
+}
+
+bool_t welch_push_sample(welch_state_t *welch, signal_t sample) {
+    welch->history[welch->head] = sample;
+    welch->head = (welch->head + 1) % WELCH_SEGMENT_SIZE;
+    if (welch->count < WELCH_SEGMENT_SIZE) {
+        welch->count++;
+    }
+
+    /* First segment once history fills, then one per hop */
+    welch->since_segment++;
+    if (welch->count < WELCH_SEGMENT_SIZE ||
+        (welch->num_spectra > 0 && welch->since_segment < WELCH_SEGMENT_HOP)) {
+        return FALSE;
+    }
+
+    welch->since_segment = 0;
+    welch_add_segment(welch);
+    return TRUE;
+}
+
+size_t welch_push_samples(welch_state_t *welch, const signal_t *samples, size_t count) {
+    size_t segments = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (welch_push_sample(welch, samples[i])) {
+            segments++;
+        }
+    }
+
+    return segments;
+}
+
+const power_spectrum_t* welch_spectrum(const welch_state_t *welch) {
+    return &welch->spectrum;
+}
+
+void welch_band_powers(const welch_state_t *welch, const frequency_band_t *bands,
+                       size_t num_bands, float *band_powers) {
+    for (size_t b = 0; b < num_bands; b++) {
+        band_powers[b] = calculate_band_power_psd(&welch->spectrum, bands[b].low_freq,
+                                                  bands[b].high_freq);
+    }
+}
+
+size_t calculate_band_powers_welch(welch_state_t *welch, const signal_t *signal,
+                                   size_t length, const frequency_band_t *bands,
+                                   size_t num_bands, float *band_powers) {
+    welch_reset(welch);
+    size_t segments = welch_push_samples(welch, signal, length);
+    welch_band_powers(welch, bands, num_bands, band_powers);
+
+    return segments;
+}
@@ -0,0 +1,336 @@
+#include "worker_pool.h"
+#include "preprocessing.h"
+#include "feature_extraction.h"
+#include "classifier.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ========== Worker Threads ========== */
+
+#if USE_PTHREADS
+static void* worker_main(void *arg) {
+    worker_context_t *worker = (worker_context_t*)arg;
+    worker_pool_t *pool = worker->pool;
+    uint32_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->shutdown) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+
+        /* Claim jobs one at a time; the lock is held only to bump the counter */
+        while (pool->next_job < pool->num_jobs) {
+            size_t job = pool->next_job++;
+            pthread_mutex_unlock(&pool->lock);
+            pool->job_fn(worker, job, pool->job_data);
+            pthread_mutex_lock(&pool->lock);
+        }
+
+        if (--pool->active == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+#endif
+
+/* ========== Pool Management ========== */
+
+static bool_t worker_context_init(worker_context_t *worker, worker_pool_t *pool, size_t id) {
+    size_t fft_size = next_power_of_2(pool->window_length);
+    size_t bytes = FFT_WORKSPACE_BYTES(fft_size < 2 ? 2 : fft_size) +
+                   EEG_FRAME_BYTES(MAX_CHANNELS, pool->window_length) +
+                   pool->window_length * sizeof(command_t) + DSP_ARENA_ALIGN;
+
+    worker->id = id;
+    worker->pool = pool;
+    worker->arena_memory = malloc(bytes);
+    if (worker->arena_memory == NULL) {
+        log_error("Failed to allocate %zu-byte arena for worker %zu", bytes, id);
+        return FALSE;
+    }
+
+    dsp_arena_init(&worker->arena, worker->arena_memory, bytes);
+    if (!fft_workspace_init_private(&worker->workspace, &worker->arena, pool->window_length) ||
+        !eeg_frame_init_arena(&worker->window, &worker->arena, MAX_CHANNELS,
+                              pool->window_length)) {
+        return FALSE;
+    }
+
+    worker->labels = (command_t*)dsp_arena_alloc(&worker->arena,
+                                                 pool->window_length * sizeof(command_t));
+    return worker->labels != NULL;
+}
+
+static void free_worker_memory(worker_pool_t *pool, size_t first, size_t count) {
+    for (size_t w = first; w < count; w++) {
+        free(pool->workers[w].arena_memory);
+        pool->workers[w].arena_memory = NULL;
+    }
+}
+
+bool_t worker_pool_init(worker_pool_t *pool, size_t num_workers, size_t window_length) {
+    memset(pool, 0, sizeof(*pool));
+
+    if (window_length == 0) {
+        return FALSE;
+    }
+    if (num_workers == 0 || num_workers > MAX_WORKERS) {
+        num_workers = MAX_WORKERS;
+    }
+#if !USE_PTHREADS
+    num_workers = 1;
+#endif
+
+    /* Build the shared read-only tables before any worker can race on them */
+    fft_init();
+    preprocessing_init();
+
+    pool->window_length = window_length;
+    for (size_t w = 0; w < num_workers; w++) {
+        if (!worker_context_init(&pool->workers[w], pool, w)) {
+            free_worker_memory(pool, 0, w + 1);
+            return FALSE;
+        }
+    }
+
+#if USE_PTHREADS
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    for (size_t w = 0; w < num_workers; w++) {
+        if (pthread_create(&pool->workers[w].thread, NULL, worker_main,
+                           &pool->workers[w]) != 0) {
+            log_error("Failed to start worker thread %zu", w);
+            break;
+        }
+        pool->num_workers = w + 1;
+    }
+
+    if (pool->num_workers == 0) {
+        pthread_cond_destroy(&pool->work_done);
+        pthread_cond_destroy(&pool->work_ready);
+        pthread_mutex_destroy(&pool->lock);
+        free_worker_memory(pool, 0, num_workers);
+        return FALSE;
+    }
+
+    /* Workers that failed to start never run; release their memory now */
+    free_worker_memory(pool, pool->num_workers, num_workers);
+#else
+    pool->num_workers = num_workers;
+#endif
+
+    return TRUE;
+}
+
+void worker_pool_run(worker_pool_t *pool, size_t num_jobs, worker_job_fn job_fn,
+                     void *user_data) {
+    if (num_jobs == 0 || pool->num_workers == 0) {
+        return;
+    }
+
+#if USE_PTHREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->job_fn = job_fn;
+    pool->job_data = user_data;
+    pool->num_jobs = num_jobs;
+    pool->next_job = 0;
+    pool->active = pool->num_workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+
+    while (pool->active > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+#else
+    for (size_t job = 0; job < num_jobs; job++) {
+        job_fn(&pool->workers[0], job, user_data);
+    }
+#endif
+}
+
+void worker_pool_destroy(worker_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+#if USE_PTHREADS
+    /* num_workers counts started threads only */
+    if (pool->num_workers > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pool->shutdown = TRUE;
+        pthread_cond_broadcast(&pool->work_ready);
+        pthread_mutex_unlock(&pool->lock);
+
+        for (size_t w = 0; w < pool->num_workers; w++) {
+            pthread_join(pool->workers[w].thread, NULL);
+        }
+
+        pthread_cond_destroy(&pool->work_done);
+        pthread_cond_destroy(&pool->work_ready);
+        pthread_mutex_destroy(&pool->lock);
+    }
+#endif
+
+    free_worker_memory(pool, 0, pool->num_workers);
+    memset(pool, 0, sizeof(*pool));
+}
+
+/* ========== Parallel Channels ========== */
+
+typedef struct {
+    eeg_frame_t *frame;
+    features_t *features;
+} frame_job_t;
+
+static void frame_channel_job(worker_context_t *worker, size_t channel, void *user_data) {
+    frame_job_t *job = (frame_job_t*)user_data;
+    signal_t *row = eeg_frame_channel(job->frame, channel);
+    features_t features;
+
+    /* Same per-channel work as process_frame, on this worker's workspace;
+     * built locally so neighbouring slots are written once */
+    preprocess_and_measure(row, job->frame->length, &features);
+    extract_band_features_ws(&worker->workspace, row, job->frame->length, &features);
+    job->features[channel] = features;
+}
+
+void worker_pool_process_frame(worker_pool_t *pool, eeg_frame_t *frame, features_t *features) {
+    if (pool->num_workers == 0 ||
+        next_power_of_2(frame->length) != pool->workers[0].workspace.fft_size) {
+        log_error("Frame of %zu samples does not match pool window of %zu",
+                  frame->length, pool->window_length);
+        return;
+    }
+
+    frame_job_t job = { frame, features };
+    worker_pool_run(pool, frame->num_channels, frame_channel_job, &job);
+}
+
+/* ========== Parallel Sessions ========== */
+
+typedef struct {
+    const char *const *paths;
+    session_result_t *results;
+} session_job_t;
+
+/* Averaged band powers waiting for batch impairment grading */
+typedef struct {
+    size_t count;
+    signal_t theta_power[IMPAIRMENT_BLOCK_SIZE];
+    signal_t alpha_power[IMPAIRMENT_BLOCK_SIZE];
+    signal_t beta_power[IMPAIRMENT_BLOCK_SIZE];
+} impairment_queue_t;
+
+static void grade_queued_windows(impairment_queue_t *queue, impairment_stats_t *stats) {
+    band_power_batch_t batch = {
+        queue->count, queue->theta_power, queue->alpha_power, queue->beta_power
+    };
+    predict_impairments_batch(&classifier_default_thresholds, &batch, NULL, stats);
+    queue->count = 0;
+}
+
+/* Score one recording, streamed window by window through the worker's scratch frame */
+static void session_job(worker_context_t *worker, size_t session, void *user_data) {
+    session_job_t *job = (session_job_t*)user_data;
+    session_result_t *result = &job->results[session];
+    size_t window_length = worker->pool->window_length;
+    dataset_reader_t reader;
+    size_t rows;
+
+    memset(result, 0, sizeof(*result));
+    if (!dataset_reader_open(&reader, job->paths[session], COLUMNS_ALL) ||
+        reader.num_channels == 0) {
+        log_error("Cannot score session %s", job->paths[session]);
+        dataset_reader_close(&reader);
+        return;
+    }
+
+    result->loaded = TRUE;
+    result->num_channels = reader.num_channels;
+
+    /* View of the worker's scratch frame with this session's channel count */
+    eeg_frame_t window = worker->window;
+    window.num_channels = reader.num_channels;
+
+    classifier_state_t classifier;
+    classifier_init(&classifier);
+    features_t channel_features[MAX_CHANNELS];
+    impairment_queue_t impairments;
+    impairments.count = 0;
+    impairment_stats_init(&result->impairments);
+
+    /* Stream one window at a time: memory does not grow with the recording */
+    while ((rows = dataset_reader_next_frame(&reader, &window, worker->labels)) > 0) {
+        result->num_samples += rows;
+        if (rows < window_length) {
+            break;
+        }
+
+        features_t average;
+        process_frame(&worker->workspace, &window, channel_features);
+        average_frame_features(channel_features, window.num_channels, &average);
+
+        command_t command = classify_command(&average, &classifier);
+        result->command_counts[command]++;
+        if (command == worker->labels[window_length - 1]) {
+            result->label_matches++;
+        }
+
+        result->mean_features.theta_power += average.theta_power;
+        result->mean_features.alpha_power += average.alpha_power;
+        result->mean_features.beta_power += average.beta_power;
+        result->mean_features.gamma_power += average.gamma_power;
+        result->mean_features.peak_amplitude += average.peak_amplitude;
+        result->mean_features.variance += average.variance;
+        result->mean_features.skewness += average.skewness;
+        result->num_windows++;
+
+        impairments.theta_power[impairments.count] = average.theta_power;
+        impairments.alpha_power[impairments.count] = average.alpha_power;
+        impairments.beta_power[impairments.count] = average.beta_power;
+        if (++impairments.count == IMPAIRMENT_BLOCK_SIZE) {
+            grade_queued_windows(&impairments, &result->impairments);
+        }
+    }
+    grade_queued_windows(&impairments, &result->impairments);
+
+    if (result->num_windows > 0) {
+        signal_t inv = 1.0f / result->num_windows;
+        result->mean_features.theta_power *= inv;
+        result->mean_features.alpha_power *= inv;
+        result->mean_features.beta_power *= inv;
+        result->mean_features.gamma_power *= inv;
+        result->mean_features.peak_amplitude *= inv;
+        result->mean_features.variance *= inv;
+        result->mean_features.skewness *= inv;
+    }
+
+    dataset_reader_close(&reader);
+}
+
+size_t worker_pool_process_sessions(worker_pool_t *pool, const char *const *paths,
+                                    size_t num_sessions, session_result_t *results) {
+    session_job_t job = { paths, results };
+    worker_pool_run(pool, num_sessions, session_job, &job);
+
+    /* Merge in path order, independent of which worker ran what */
+    size_t loaded = 0;
+    for (size_t s = 0; s < num_sessions; s++) {
+        if (results[s].loaded) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
@@ -0,0 +1,222 @@
+/*
+ * DSP kernel microbenchmarks
+ *
+ * Sweeps each kernel over power-of-2 sizes BENCH_MIN_SIZE..BENCH_MAX_SIZE
+ * and reports ticks per sample: core cycles on the RISC-V target (rdcycle),
+ * nanoseconds natively (see profiler.h). Every point is the best of
+ * BENCH_TRIALS timed batches of calls, after one untimed warm-up call.
+ *
+ * Results are printed as "@bench,..." lines, which can be scraped off the
+ * UART under QEMU or Spike (make run BENCH=1 / make spike BENCH=1). Native
+ * builds also write them as CSV to bench_output.txt, or to argv[1];
+ * scripts/compare_bench.py diffs two result files.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+#include "preprocessing.h"
+#include "feature_extraction.h"
+#include "lda.h"
+#include "eeg_simulator.h"
+#include "profiler.h"
+#include "utils.h"
+
+#define BENCH_MIN_SIZE   64
+#define BENCH_MAX_SIZE   4096
+#define BENCH_TRIALS     3
+
+/* Samples processed per timed batch (fewer calls at large sizes) */
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES    (1u << 16)
+#endif
+
+#define BENCH_LDA_FEATURES 4
+#define BENCH_OUTPUT_PATH  "bench_output.txt"
+
+/* The hand-written kernels are rv32 F-extension assembly (not built for
+ * FIXED_POINT=1 or natively) */
+#if defined(__riscv) && defined(__riscv_flen)
+#define BENCH_HAS_ASM 1
+#else
+#define BENCH_HAS_ASM 0
+#endif
+
+#if defined(__riscv) && !defined(__linux__)
+#define BENCH_HAS_FILES 0
+#else
+#define BENCH_HAS_FILES 1
+#endif
+
+/* Shared inputs and outputs, static so embedded stacks stay small */
+static signal_t signal_in[BENCH_MAX_SIZE];
+static signal_t signal_out[BENCH_MAX_SIZE];
+static complex_t spectrum[BENCH_MAX_SIZE];
+static signal_t lda_features[BENCH_MAX_SIZE * BENCH_LDA_FEATURES];
+static lda_sample_t lda_samples[BENCH_MAX_SIZE];
+static lda_model_t lda_model;
+static eeg_stream_t stream;
+
+/* Results land here so calls cannot be optimized away */
+static volatile signal_t sink;
+
+/* ========== Kernels ========== */
+
+typedef void (*bench_fn)(size_t n);
+
+static void bench_fft(size_t n) {
+    fft_compute(signal_in, spectrum, n);
+    sink = spectrum[1].real;
+}
+
+static void bench_band_power(size_t n) {
+    sink = calculate_band_power_fft(signal_in, n, SAMPLING_RATE, ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
+}
+
+static void bench_moving_average(size_t n) {
+    moving_average_filter(signal_in, signal_out, n, MA_FILTER_SIZE);
+    sink = signal_out[n - 1];
+}
+
+static void bench_variance(size_t n) {
+    sink = calculate_variance(signal_in, n);
+}
+
+#if BENCH_HAS_ASM
+static void bench_moving_average_asm(size_t n) {
+    moving_average_asm(signal_in, signal_out, n, MA_FILTER_SIZE);
+    sink = signal_out[n - 1];
+}
+
+static void bench_variance_asm(size_t n) {
+    sink = calculate_variance_asm(signal_in, n, calculate_mean(signal_in, n));
+}
+#endif
+
+static void bench_extract_features(size_t n) {
+    features_t features;
+    extract_features(signal_in, n, &features);
+    sink = features.alpha_power;
+}
+
+/* n training samples of BENCH_LDA_FEATURES features */
+static void bench_lda_train(size_t n) {
+    lda_train(&lda_model, lda_samples, n);
+    sink = lda_model.threshold;
+}
+
+/* Synthetic load: one simulator window of n samples */
+static void bench_eeg_stream(size_t n) {
+    eeg_stream_generate(&stream, signal_out, n, CMD_FOCUS);
+    sink = signal_out[n - 1];
+}
+
+typedef struct {
+    const char *name;
+    bench_fn fn;
+} bench_kernel_t;
+
+static const bench_kernel_t kernels[] = {
+    { "fft_compute", bench_fft },
+    { "calculate_band_power_fft", bench_band_power },
+    { "moving_average_filter", bench_moving_average },
+#if BENCH_HAS_ASM
+    { "moving_average_asm", bench_moving_average_asm },
+#endif
+    { "calculate_variance", bench_variance },
+#if BENCH_HAS_ASM
+    { "calculate_variance_asm", bench_variance_asm },
+#endif
+    { "extract_features", bench_extract_features },
+    { "lda_train", bench_lda_train },
+    { "eeg_stream_generate", bench_eeg_stream },
+};
+#define NUM_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+/* ========== Harness ========== */
+
+/* EEG-like input: alpha and beta tones plus noise; two LDA classes */
+static void bench_setup(void) {
+    seed_random(1);
+    for (size_t i = 0; i < BENCH_MAX_SIZE; i++) {
+        float t = (float)i / SAMPLING_RATE;
+        signal_in[i] = ALPHA_AMPLITUDE * sinf(2.0f * (float)M_PI * 10.0f * t) +
+                       BETA_AMPLITUDE * sinf(2.0f * (float)M_PI * 20.0f * t) +
+                       random_float(-NOISE_LEVEL, NOISE_LEVEL);
+    }
+
+    for (size_t i = 0; i < BENCH_MAX_SIZE; i++) {
+        int label = (int)(i & 1);
+        signal_t *row = &lda_features[i * BENCH_LDA_FEATURES];
+        for (size_t j = 0; j < BENCH_LDA_FEATURES; j++) {
+            row[j] = random_float(-1.0f, 1.0f) + (label ? 0.5f : -0.5f);
+        }
+        lda_samples[i].features = row;
+        lda_samples[i].label = label;
+    }
+    lda_init(&lda_model, BENCH_LDA_FEATURES);
+    eeg_stream_init(&stream, EEG_SIMULATOR_SEED, 0);
+}
+
+/* Best per-call time over BENCH_TRIALS batches of reps calls */
+static uint64_t bench_time(bench_fn fn, size_t n, size_t reps) {
+    uint64_t best = 0;
+
+    fn(n);  /* Warm-up: plan tables, window cache, instruction cache */
+    for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+        prof_mark_t start = prof_read();
+        for (size_t r = 0; r < reps; r++) {
+            fn(n);
+        }
+        uint64_t per_call = (prof_read().ticks - start.ticks) / reps;
+        if (trial == 0 || per_call < best) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    FILE *csv = NULL;
+
+#if BENCH_HAS_FILES
+    const char *path = (argc > 1) ? argv[1] : BENCH_OUTPUT_PATH;
+    csv = fopen(path, "w");
+    if (csv == NULL) {
+        log_error("Cannot write %s", path);
+        return 1;
+    }
+    fprintf(csv, "kernel,size,reps,ticks_per_call,ticks_per_sample,unit\n");
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    fft_init();
+    preprocessing_init();
+    bench_setup();
+
+    printf("@benchinfo,1,%s,%s\n", prof_tick_unit(), BENCH_HAS_ASM ? "asm" : "c-only");
+    for (size_t k = 0; k < NUM_KERNELS; k++) {
+        for (size_t n = BENCH_MIN_SIZE; n <= BENCH_MAX_SIZE; n *= 2) {
+            size_t reps = (BENCH_SAMPLES / n > 0) ? BENCH_SAMPLES / n : 1;
+            uint64_t ticks = bench_time(kernels[k].fn, n, reps);
+            double per_sample = (double)ticks / (double)n;
+
+            printf("@bench,%s,%zu,%zu,%lu,%.3f\n", kernels[k].name, n, reps,
+                   (unsigned long)ticks, per_sample);
+            if (csv != NULL) {
+                fprintf(csv, "%s,%zu,%zu,%lu,%.3f,%s\n", kernels[k].name, n, reps,
+                        (unsigned long)ticks, per_sample, prof_tick_unit());
+            }
+        }
+    }
+
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    lda_free(&lda_model);
+    fft_cleanup();
+    return 0;
+}
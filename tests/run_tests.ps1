@@ -32,7 +32,10 @@ Write-Host "`nBuilding test_feature_extraction..." -ForegroundColor Green
     tests/test_feature_extraction.c `
     src/feature_extraction.c `
     src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
     src/utils.c `
+    src/scheduler.c `
     -lm
 
 if ($LASTEXITCODE -ne 0) {
@@ -47,6 +50,7 @@ Write-Host "Building test_classifier..." -ForegroundColor Green
     tests/test_classifier.c `
     src/classifier.c `
     src/utils.c `
+    src/scheduler.c `
     -lm
 
 if ($LASTEXITCODE -ne 0) {
@@ -54,6 +58,353 @@ if ($LASTEXITCODE -ne 0) {
     exit 1
 }
 
+# Test 3: Streaming Pipeline Tests
+Write-Host "Building test_streaming..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_streaming.exe" `
+    tests/test_streaming.c `
+    src/streaming.c `
+    src/sliding_dft.c `
+    src/welch.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_streaming" -ForegroundColor Red
+    exit 1
+}
+
+# Test 4: Preprocessing Tests
+Write-Host "Building test_preprocessing..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_preprocessing.exe" `
+    tests/test_preprocessing.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_preprocessing" -ForegroundColor Red
+    exit 1
+}
+
+# Test 5: DSP Kernel Tests
+Write-Host "Building test_dsp_kernels..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_dsp_kernels.exe" `
+    tests/test_dsp_kernels.c `
+    src/dsp_kernels.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_dsp_kernels" -ForegroundColor Red
+    exit 1
+}
+
+# Test 6: Fixed-Point Pipeline Tests
+Write-Host "Building test_fixed_point..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_fixed_point.exe" `
+    tests/test_fixed_point.c `
+    src/fixed_point.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/classifier.c `
+    src/eeg_simulator.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_fixed_point" -ForegroundColor Red
+    exit 1
+}
+
+# Test 7: Multi-Channel Tests
+Write-Host "Building test_multichannel..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_multichannel.exe" `
+    tests/test_multichannel.c `
+    src/multichannel.c `
+    src/data_loader.c `
+    src/mapped_file.c `
+    src/csv_scan.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_multichannel" -ForegroundColor Red
+    exit 1
+}
+
+# Test 8: Worker Pool Tests
+Write-Host "Building test_worker_pool..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_worker_pool.exe" `
+    tests/test_worker_pool.c `
+    src/worker_pool.c `
+    src/multichannel.c `
+    src/data_loader.c `
+    src/mapped_file.c `
+    src/csv_scan.c `
+    src/classifier.c `
+    src/fixed_point.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm -DUSE_PTHREADS=1 -pthread
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_worker_pool" -ForegroundColor Red
+    exit 1
+}
+
+# Test 9: Sample Ring Tests
+Write-Host "Building test_sample_ring..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_sample_ring.exe" `
+    tests/test_sample_ring.c `
+    src/sample_ring.c `
+    src/scheduler.c `
+    src/utils.c `
+    -lm -DUSE_PTHREADS=1 -pthread
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_sample_ring" -ForegroundColor Red
+    exit 1
+}
+
+# Test 10: Data Loader
+Write-Host "Building test_data_loader..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_data_loader.exe" `
+    tests/test_data_loader.c `
+    src/data_loader.c `
+    src/mapped_file.c `
+    src/csv_scan.c `
+    src/multichannel.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_data_loader" -ForegroundColor Red
+    exit 1
+}
+
+# Test 11: Session File Tests
+Write-Host "Building test_session_file..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_session_file.exe" `
+    tests/test_session_file.c `
+    src/session_file.c `
+    src/data_loader.c `
+    src/mapped_file.c `
+    src/csv_scan.c `
+    src/multichannel.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_session_file" -ForegroundColor Red
+    exit 1
+}
+
+# Test 12: Acquisition Tests
+Write-Host "Building test_acquisition..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_acquisition.exe" `
+    tests/test_acquisition.c `
+    src/acquisition.c `
+    src/fixed_point.c `
+    src/sample_ring.c `
+    src/eeg_simulator.c `
+    src/session_file.c `
+    src/data_loader.c `
+    src/mapped_file.c `
+    src/csv_scan.c `
+    src/multichannel.c `
+    src/preprocessing.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm -DUSE_PTHREADS=1 -pthread
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_acquisition" -ForegroundColor Red
+    exit 1
+}
+
+# Test 13: Welch PSD
+Write-Host "Building test_welch..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_welch.exe" `
+    tests/test_welch.c `
+    src/welch.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_welch" -ForegroundColor Red
+    exit 1
+}
+
+# Test 14: Classifier Model Blob Tests
+Write-Host "Building test_bci_model..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_bci_model.exe" `
+    tests/test_bci_model.c `
+    src/bci_model.c `
+    src/lda.c `
+    src/classifier.c `
+    src/mapped_file.c `
+    src/feature_extraction.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_bci_model" -ForegroundColor Red
+    exit 1
+}
+
+# Test 15: Profiler Tests
+Write-Host "Building test_profiler..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_profiler.exe" `
+    tests/test_profiler.c `
+    src/profiler.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_profiler" -ForegroundColor Red
+    exit 1
+}
+
+# Test 16: EEG Simulator Tests
+Write-Host "Building test_eeg_simulator..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_eeg_simulator.exe" `
+    tests/test_eeg_simulator.c `
+    src/eeg_simulator.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_eeg_simulator" -ForegroundColor Red
+    exit 1
+}
+
+# Test 17: Telemetry Tests
+Write-Host "Building test_telemetry..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_telemetry.exe" `
+    tests/test_telemetry.c `
+    src/telemetry.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_telemetry" -ForegroundColor Red
+    exit 1
+}
+
+# Test 18: Output Control Tests
+Write-Host "Building test_output_control..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_output_control.exe" `
+    tests/test_output_control.c `
+    src/output_control.c `
+    src/sample_ring.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_output_control" -ForegroundColor Red
+    exit 1
+}
+
+# Test 19: FFT and Power Spectral Density Tests
+Write-Host "Building test_fft..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_fft.exe" `
+    tests/test_fft.c `
+    src/fft.c `
+    src/dsp_arena.c `
+    src/dsp_kernels.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_fft" -ForegroundColor Red
+    exit 1
+}
+
+# Test 20: LDA Classifier Tests
+Write-Host "Building test_lda_classifier..." -ForegroundColor Green
+& $gcc -I./include -I./tests `
+    -o "$binDir/test_lda_classifier.exe" `
+    tests/test_lda_classifier.c `
+    src/lda.c `
+    src/utils.c `
+    src/scheduler.c `
+    -lm
+
+if ($LASTEXITCODE -ne 0) {
+    Write-Host "Failed to compile test_lda_classifier" -ForegroundColor Red
+    exit 1
+}
+
 Write-Host "`n" -NoNewline
 Write-Host "===========================================================" -ForegroundColor Cyan
 Write-Host "Running Test Suites" -ForegroundColor Cyan
@@ -62,7 +413,7 @@ Write-Host "===========================================================" -Foregr
 $totalFailed = 0
 
 # Run Feature Extraction Tests
-Write-Host "`n[1/2] Feature Extraction Tests" -ForegroundColor Magenta
+Write-Host "`n[1/20] Feature Extraction Tests" -ForegroundColor Magenta
 & "$binDir/test_feature_extraction.exe"
 if ($LASTEXITCODE -eq 0) {
     Write-Host "PASSED: Feature Extraction Tests" -ForegroundColor Green
@@ -73,7 +424,7 @@ else {
 }
 
 # Run Classifier Tests
-Write-Host "`n[2/2] Classifier Tests" -ForegroundColor Magenta
+Write-Host "`n[2/20] Classifier Tests" -ForegroundColor Magenta
 & "$binDir/test_classifier.exe"
 if ($LASTEXITCODE -eq 0) {
     Write-Host "PASSED: Classifier Tests" -ForegroundColor Green
@@ -83,6 +434,204 @@ else {
     $totalFailed++
 }
 
+# Run Streaming Pipeline Tests
+Write-Host "`n[3/20] Streaming Pipeline Tests" -ForegroundColor Magenta
+& "$binDir/test_streaming.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Streaming Pipeline Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Streaming Pipeline Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Preprocessing Tests
+Write-Host "`n[4/20] Preprocessing Tests" -ForegroundColor Magenta
+& "$binDir/test_preprocessing.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Preprocessing Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Preprocessing Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run DSP Kernel Tests
+Write-Host "`n[5/20] DSP Kernel Tests" -ForegroundColor Magenta
+& "$binDir/test_dsp_kernels.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: DSP Kernel Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: DSP Kernel Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Fixed-Point Pipeline Tests
+Write-Host "`n[6/20] Fixed-Point Pipeline Tests" -ForegroundColor Magenta
+& "$binDir/test_fixed_point.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Fixed-Point Pipeline Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Fixed-Point Pipeline Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Multi-Channel Tests
+Write-Host "`n[7/20] Multi-Channel Tests" -ForegroundColor Magenta
+& "$binDir/test_multichannel.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Multi-Channel Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Multi-Channel Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Worker Pool Tests
+Write-Host "`n[8/20] Worker Pool Tests" -ForegroundColor Magenta
+& "$binDir/test_worker_pool.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Worker Pool Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Worker Pool Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Sample Ring Tests
+Write-Host "`n[9/20] Sample Ring Tests" -ForegroundColor Magenta
+& "$binDir/test_sample_ring.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Sample Ring Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Sample Ring Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Data Loader
+Write-Host "`n[10/20] Data Loader" -ForegroundColor Magenta
+& "$binDir/test_data_loader.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Data Loader" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Data Loader" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Session File Tests
+Write-Host "`n[11/20] Session File Tests" -ForegroundColor Magenta
+& "$binDir/test_session_file.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Session File Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Session File Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Acquisition Tests
+Write-Host "`n[12/20] Acquisition Tests" -ForegroundColor Magenta
+& "$binDir/test_acquisition.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Acquisition Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Acquisition Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Welch PSD
+Write-Host "`n[13/20] Welch PSD" -ForegroundColor Magenta
+& "$binDir/test_welch.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Welch PSD" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Welch PSD" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Classifier Model Blob Tests
+Write-Host "`n[14/20] Classifier Model Blob Tests" -ForegroundColor Magenta
+& "$binDir/test_bci_model.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Classifier Model Blob Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Classifier Model Blob Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Profiler Tests
+Write-Host "`n[15/20] Profiler Tests" -ForegroundColor Magenta
+& "$binDir/test_profiler.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Profiler Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Profiler Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run EEG Simulator Tests
+Write-Host "`n[16/20] EEG Simulator Tests" -ForegroundColor Magenta
+& "$binDir/test_eeg_simulator.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: EEG Simulator Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: EEG Simulator Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Telemetry Tests
+Write-Host "`n[17/20] Telemetry Tests" -ForegroundColor Magenta
+& "$binDir/test_telemetry.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Telemetry Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Telemetry Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run Output Control Tests
+Write-Host "`n[18/20] Output Control Tests" -ForegroundColor Magenta
+& "$binDir/test_output_control.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: Output Control Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: Output Control Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run FFT and Power Spectral Density Tests
+Write-Host "`n[19/20] FFT and Power Spectral Density Tests" -ForegroundColor Magenta
+& "$binDir/test_fft.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: FFT and Power Spectral Density Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: FFT and Power Spectral Density Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
+# Run LDA Classifier Tests
+Write-Host "`n[20/20] LDA Classifier Tests" -ForegroundColor Magenta
+& "$binDir/test_lda_classifier.exe"
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "PASSED: LDA Classifier Tests" -ForegroundColor Green
+}
+else {
+    Write-Host "FAILED: LDA Classifier Tests" -ForegroundColor Red
+    $totalFailed++
+}
+
 # Final Summary
 Write-Host "`n" -NoNewline
 Write-Host "===========================================================" -ForegroundColor Cyan
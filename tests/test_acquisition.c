@@ -0,0 +1,201 @@
+#include "test_framework.h"
+#include "acquisition.h"
+#include "eeg_simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_CSV_PATH "data/raw/sample_eeg_data.csv"
+#define TEST_SESSION_PATH "test_acquisition_tmp.bcis"
+
+/* Q15 samples are only as exact as one step of their full scale */
+#if USE_FIXED_POINT
+#define SAMPLE_TOLERANCE (FIXED_INPUT_FULL_SCALE / 32768.0f)
+#else
+#define SAMPLE_TOLERANCE 1e-6f
+#endif
+
+static acquisition_t acq;
+
+typedef struct {
+    size_t buffers;
+    size_t samples;
+} completion_log_t;
+
+static void count_completion(void *user_data, const acq_sample_t *buffer, size_t count) {
+    completion_log_t *log = (completion_log_t*)user_data;
+    (void)buffer;
+    log->buffers++;
+    log->samples += count;
+}
+
+/* Drain an acquisition into output, releasing each buffer after copying it */
+static size_t drain(acq_sample_t *output, size_t capacity, size_t *num_buffers) {
+    size_t total = 0;
+    size_t count;
+    const acq_sample_t *buffer;
+
+    *num_buffers = 0;
+    while ((buffer = acquisition_wait(&acq, &count)) != NULL) {
+        if (total + count <= capacity) {
+            memcpy(&output[total], buffer, count * sizeof(acq_sample_t));
+        }
+        total += count;
+        (*num_buffers)++;
+        acquisition_release(&acq);
+    }
+    return total;
+}
+
+/* Simulator through both buffers; every sample and completion accounted for */
+void test_simulator_pingpong(void) {
+    TEST_START("Simulator Ping-Pong Buffers");
+
+    command_t script[] = { CMD_FOCUS, CMD_RELAX };
+    acq_simulator_t sim;
+    acq_source_t source;
+    completion_log_t log = { 0, 0 };
+    acq_sample_t output[3 * WINDOW_SIZE];
+    size_t num_buffers;
+
+    acq_simulator_open(&sim, &source, script, 2, 3);
+    bool_t started = acquisition_start(&acq, &source, 100, FALSE, count_completion, &log);
+    ASSERT_TRUE(started, "Acquisition starts");
+
+    size_t total = drain(output, 3 * WINDOW_SIZE, &num_buffers);
+    acquisition_stop(&acq);
+
+    ASSERT_EQUAL(3 * WINDOW_SIZE, (int)total, "All simulated samples delivered");
+    ASSERT_EQUAL(8, (int)num_buffers, "768 samples in 100-sample buffers (last one short)");
+    ASSERT_EQUAL((int)num_buffers, (int)log.buffers, "Callback fired for every buffer");
+    ASSERT_EQUAL((int)total, (int)log.samples, "Callback saw every sample");
+    ASSERT_EQUAL(0, (int)acquisition_dropped(&acq), "Unpaced source never drops");
+
+    acq_source_t bad_source = source;
+    started = acquisition_start(&acq, &bad_source, ACQ_MAX_BUFFER_SAMPLES + 1, FALSE, NULL, NULL);
+    ASSERT_TRUE(!started, "Oversized buffers rejected");
+}
+
+/* CSV and session replays reproduce the recorded amplitude exactly */
+void test_file_replay(void) {
+    TEST_START("File Replay Sources");
+
+    size_t capacity = 4096;
+    eeg_sample_t *samples = (eeg_sample_t*)calloc(capacity, sizeof(eeg_sample_t));
+    acq_sample_t *replayed = (acq_sample_t*)calloc(capacity, sizeof(acq_sample_t));
+    size_t num_loaded = 0;
+
+    if (!load_dataset_csv(TEST_CSV_PATH, samples, capacity, &num_loaded)) {
+        free(samples);
+        free(replayed);
+        TEST_PASS("Test skipped - dataset file not found");
+        return;
+    }
+
+    const char *paths[] = { TEST_CSV_PATH, TEST_SESSION_PATH };
+    bool_t converted = convert_csv_to_session(TEST_CSV_PATH, TEST_SESSION_PATH);
+    ASSERT_TRUE(converted, "Session file written");
+
+    for (size_t p = 0; p < 2; p++) {
+        acq_file_t file;
+        acq_source_t source;
+        size_t num_buffers;
+
+        bool_t opened = acq_file_open(&file, &source, paths[p]);
+        ASSERT_TRUE(opened, "Replay source opens");
+        if (!opened) {
+            continue;
+        }
+        ASSERT_TRUE(file.is_session == (p == 1), "Format detected from the contents");
+
+        acquisition_start(&acq, &source, WINDOW_SIZE, FALSE, NULL, NULL);
+        size_t total = drain(replayed, capacity, &num_buffers);
+        acquisition_stop(&acq);
+        acq_file_close(&file);
+
+        int mismatches = 0;
+        for (size_t i = 0; i < num_loaded && i < total; i++) {
+            acq_sample_t expected;
+            acq_samples_from_signal(&samples[i].amplitude, &expected, 1);
+            if (replayed[i] != expected) {
+                mismatches++;
+            }
+        }
+        ASSERT_EQUAL((int)num_loaded, (int)total, "Every recorded sample replayed");
+        ASSERT_EQUAL(0, mismatches, "Replayed samples match the recording");
+    }
+
+    remove(TEST_SESSION_PATH);
+    free(samples);
+    free(replayed);
+}
+
+/* ADC source scales raw counts from its data register */
+void test_adc_source(void) {
+    TEST_START("ADC Register Source");
+
+    volatile int32_t data_register = -200;
+    acq_adc_t adc;
+    acq_source_t source;
+    size_t count = 0;
+
+    acq_adc_open(&adc, &source, &data_register, 0.25f);
+    acquisition_start(&acq, &source, ACQ_BLOCK_SIZE, FALSE, NULL, NULL);
+    const acq_sample_t *buffer = acquisition_wait(&acq, &count);
+    ASSERT_TRUE(buffer != NULL, "ADC buffer delivered");
+    ASSERT_EQUAL(ACQ_BLOCK_SIZE, (int)count, "One block per buffer");
+    if (buffer != NULL) {
+        signal_t first, last;
+        acq_samples_to_signal(&buffer[0], &first, 1);
+        acq_samples_to_signal(&buffer[count - 1], &last, 1);
+        ASSERT_FLOAT_EQUAL(-50.0f, first, SAMPLE_TOLERANCE, "Counts scaled to microvolts");
+        ASSERT_FLOAT_EQUAL(-50.0f, last, SAMPLE_TOLERANCE, "Whole buffer filled");
+    }
+    acquisition_release(&acq);
+
+    /* A live converter never ends; stop it from the DSP side */
+    acquisition_stop(&acq);
+    ASSERT_TRUE(1, "Endless source stops on request");
+}
+
+#if USE_PTHREADS
+/* Holding a buffer past two block periods makes a paced source drop */
+void test_paced_overrun(void) {
+    TEST_START("Paced Overrun Accounting");
+
+    command_t script[] = { CMD_RELAX };
+    acq_simulator_t sim;
+    acq_source_t source;
+    size_t count;
+
+    acq_simulator_open(&sim, &source, script, 1, 4);
+    acquisition_start(&acq, &source, ACQ_BLOCK_SIZE, TRUE, NULL, NULL);
+
+    const acq_sample_t *buffer = acquisition_wait(&acq, &count);
+    ASSERT_TRUE(buffer != NULL, "First buffer delivered");
+    sched_sleep_until(sched_now_us() + 4 * ACQ_BLOCK_PERIOD_US);
+    acquisition_release(&acq);
+
+    acquisition_stop(&acq);
+    ASSERT_TRUE(acquisition_overruns(&acq) >= 1, "Overrun counted while both buffers were held");
+    ASSERT_TRUE(acquisition_dropped(&acq) >= ACQ_BLOCK_SIZE, "Dropped blocks counted");
+}
+#endif
+
+int main() {
+    TEST_SUITE_START("Acquisition Tests");
+
+    eeg_simulator_init();
+    data_loader_init(NULL);
+
+    test_simulator_pingpong();
+    test_file_replay();
+    test_adc_source();
+#if USE_PTHREADS
+    test_paced_overrun();
+#endif
+
+    TEST_SUITE_END();
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include "test_framework.h"
+#include "bci_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_MODEL_PATH "test_model_tmp.bcim"
+#define NUM_CLASSES 3
+#define PER_CLASS 40
+#define NUM_ROWS (NUM_CLASSES * PER_CLASS)
+#define NUM_FEATURES 4
+
+static float uniform_noise(void) {
+    return (float)rand() / (float)RAND_MAX - 0.5f;
+}
+
+/* Three clusters on very different feature scales */
+static void generate_rows(signal_t *rows, int *labels) {
+    static const float centers[NUM_CLASSES][NUM_FEATURES] = {
+        { 0.2f, 0.6f, 150.0f, 0.0f },
+        { 0.6f, 0.2f, 300.0f, 0.5f },
+        { 0.2f, 0.2f, 900.0f, 1.5f }
+    };
+    static const float spread[NUM_FEATURES] = { 0.1f, 0.1f, 80.0f, 0.6f };
+
+    for (size_t r = 0; r < NUM_ROWS; r++) {
+        int label = (int)(r % NUM_CLASSES);
+        for (size_t j = 0; j < NUM_FEATURES; j++) {
+            rows[r * NUM_FEATURES + j] = centers[label][j] + spread[j] * uniform_noise();
+        }
+        labels[r] = label;
+    }
+}
+
+/* Model with both LDA sections trained on normalized features */
+static void build_model(bci_model_t *model, signal_t *rows, int *labels) {
+    static signal_t normalized[NUM_ROWS * NUM_FEATURES];
+    lda_sample_t samples[NUM_ROWS];
+    size_t num_binary = 0;
+
+    srand(11);
+    generate_rows(rows, labels);
+    bci_model_init(model, NUM_FEATURES);
+    bci_model_fit_normalization(model, rows, NUM_ROWS);
+    for (size_t r = 0; r < NUM_ROWS; r++) {
+        bci_model_normalize(model, &rows[r * NUM_FEATURES], &normalized[r * NUM_FEATURES]);
+        if (labels[r] < 2) {
+            samples[num_binary].features = &normalized[r * NUM_FEATURES];
+            samples[num_binary].label = labels[r];
+            num_binary++;
+        }
+    }
+
+    lda_model_t binary;
+    lda_init(&binary, NUM_FEATURES);
+    lda_train(&binary, samples, num_binary);
+    bci_model_set_binary(model, &binary);
+    lda_free(&binary);
+
+    lda_multiclass_t multi;
+    lda_train_multiclass(&multi, normalized, labels, NUM_ROWS, NUM_FEATURES, NUM_CLASSES,
+                         LDA_DEFAULT_SHRINKAGE);
+    bci_model_set_multiclass(model, &multi);
+
+    model->thresholds.focus = 0.45f;
+    bci_model_seal(model);
+}
+
+/* Normalization gives zero-mean, unit-variance training features */
+void test_normalization(void) {
+    TEST_START("Feature Normalization");
+
+    static signal_t rows[NUM_ROWS * NUM_FEATURES];
+    static int labels[NUM_ROWS];
+    bci_model_t model;
+    build_model(&model, rows, labels);
+
+    int bad = 0;
+    for (size_t j = 0; j < NUM_FEATURES; j++) {
+        double sum = 0.0, sum_sq = 0.0;
+        for (size_t r = 0; r < NUM_ROWS; r++) {
+            signal_t x[NUM_FEATURES];
+            bci_model_normalize(&model, &rows[r * NUM_FEATURES], x);
+            sum += x[j];
+            sum_sq += (double)x[j] * x[j];
+        }
+        double mean = sum / NUM_ROWS;
+        double var = (sum_sq - NUM_ROWS * mean * mean) / (NUM_ROWS - 1);
+        if (mean > 1e-4 || mean < -1e-4 || var < 0.999 || var > 1.001) {
+            bad++;
+        }
+    }
+    ASSERT_EQUAL(0, bad, "Every feature standardized");
+    ASSERT_TRUE(model.flags == (BCI_MODEL_HAS_BINARY | BCI_MODEL_HAS_MULTICLASS),
+                "Both LDA sections stored");
+}
+
+/* Save, map and use in place: same decisions as the in-memory model */
+void test_save_and_open(void) {
+    TEST_START("Save and Map Round Trip");
+
+    static signal_t rows[NUM_ROWS * NUM_FEATURES];
+    static int labels[NUM_ROWS];
+    bci_model_t model;
+    build_model(&model, rows, labels);
+
+    ASSERT_TRUE(bci_model_save(&model, TEST_MODEL_PATH), "Model saved");
+
+    bci_model_file_t file;
+    bool_t opened = bci_model_open(&file, TEST_MODEL_PATH);
+    ASSERT_TRUE(opened, "Model file opens");
+    if (!opened) {
+        return;
+    }
+
+    ASSERT_EQUAL((int)sizeof(bci_model_t), (int)file.file.size, "File is exactly one record");
+    ASSERT_TRUE((const void*)file.model == (const void*)file.file.data,
+                "Model used in place in the mapping");
+    ASSERT_TRUE(memcmp(file.model, &model, sizeof(model)) == 0, "Bytes match the saved model");
+
+    int mismatches = 0;
+    size_t correct = 0;
+    for (size_t r = 0; r < NUM_ROWS; r++) {
+        const signal_t *x = &rows[r * NUM_FEATURES];
+        float scores[NUM_CLASSES];
+        int predicted = bci_model_classify(file.model, x, scores);
+        if (predicted != bci_model_classify(&model, x, NULL) ||
+            bci_model_predict_binary(file.model, x) != bci_model_predict_binary(&model, x)) {
+            mismatches++;
+        }
+        correct += (predicted == labels[r]) ? 1 : 0;
+    }
+    ASSERT_EQUAL(0, mismatches, "Mapped model decides like the original");
+    ASSERT_TRUE(correct >= NUM_ROWS * 9 / 10, "Multi-class section classifies the clusters");
+
+    bci_model_close(&file);
+    remove(TEST_MODEL_PATH);
+}
+
+/* bci_model_classify is lda_multiclass_predict after normalization */
+void test_classify_matches_lda(void) {
+    TEST_START("Classify Matches Multi-Class LDA");
+
+    static signal_t rows[NUM_ROWS * NUM_FEATURES];
+    static signal_t normalized[NUM_ROWS * NUM_FEATURES];
+    static int labels[NUM_ROWS];
+    bci_model_t model;
+    build_model(&model, rows, labels);
+
+    lda_multiclass_t lda;
+    for (size_t r = 0; r < NUM_ROWS; r++) {
+        bci_model_normalize(&model, &rows[r * NUM_FEATURES], &normalized[r * NUM_FEATURES]);
+    }
+    lda_train_multiclass(&lda, normalized, labels, NUM_ROWS, NUM_FEATURES, NUM_CLASSES,
+                         LDA_DEFAULT_SHRINKAGE);
+
+    int mismatches = 0;
+    for (size_t r = 0; r < NUM_ROWS; r++) {
+        float expected[NUM_CLASSES], actual[NUM_CLASSES];
+        int a = lda_multiclass_predict(&lda, &normalized[r * NUM_FEATURES], expected);
+        int b = bci_model_classify(&model, &rows[r * NUM_FEATURES], actual);
+        if (a != b || fabsf(expected[a] - actual[b]) > 1e-4f) {
+            mismatches++;
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Same class and scores");
+}
+
+/* Damaged, foreign or misaligned blobs are refused */
+void test_reject_bad_blobs(void) {
+    TEST_START("Reject Bad Blobs");
+
+    static signal_t rows[NUM_ROWS * NUM_FEATURES];
+    static int labels[NUM_ROWS];
+    static uint32_t buffer[BCI_MODEL_SIZE / 4 + 1];
+    bci_model_t model;
+    build_model(&model, rows, labels);
+
+    memcpy(buffer, &model, sizeof(model));
+    ASSERT_TRUE(bci_model_view(buffer, sizeof(model)) == (const bci_model_t*)buffer,
+                "Intact blob accepted in place");
+    ASSERT_TRUE(bci_model_view(buffer, sizeof(model) - 1) == NULL, "Truncated blob rejected");
+
+    ((bci_model_t*)buffer)->threshold += 1.0f;
+    ASSERT_TRUE(bci_model_view(buffer, sizeof(model)) == NULL, "Corrupted payload fails the CRC");
+
+    memcpy(buffer, &model, sizeof(model));
+    ((bci_model_t*)buffer)->version = BCI_MODEL_VERSION + 1;
+    ASSERT_TRUE(bci_model_view(buffer, sizeof(model)) == NULL, "Unknown version rejected");
+
+    /* Trained at another rate: resealed, so only the domain check fails */
+    bci_model_t other = model;
+    other.sample_rate = 2.0f * SAMPLING_RATE;
+    bci_model_seal(&other);
+    ASSERT_TRUE(bci_model_view(&other, sizeof(other)) == NULL, "Foreign sample rate rejected");
+
+    /* Band powers over other bands would not match this build's features */
+    other = model;
+    other.bands[BAND_ALPHA].high_freq += 1.0f;
+    bci_model_seal(&other);
+    ASSERT_TRUE(bci_model_view(&other, sizeof(other)) == NULL, "Foreign band edges rejected");
+
+    unsigned char *bytes = (unsigned char*)buffer;
+    memcpy(bytes + 1, &model, sizeof(model) - 3);
+    ASSERT_TRUE(bci_model_view(bytes + 1, sizeof(model)) == NULL, "Misaligned blob rejected");
+
+    bci_model_t empty;
+    bci_model_init(&empty, NUM_FEATURES);
+    bci_model_seal(&empty);
+    ASSERT_TRUE(bci_model_view(&empty, sizeof(empty)) != NULL, "Empty model is valid");
+    ASSERT_EQUAL(-1, bci_model_classify(&empty, rows, NULL), "No multi-class section");
+    ASSERT_EQUAL(-1, bci_model_predict_binary(&empty, rows), "No binary section");
+}
+
+/* classify_command follows the thresholds stored in the model */
+void test_model_thresholds(void) {
+    TEST_START("Model Thresholds Drive classify_command");
+
+    static signal_t rows[NUM_ROWS * NUM_FEATURES];
+    static int labels[NUM_ROWS];
+    bci_model_t model;
+    build_model(&model, rows, labels);
+
+    features_t features;
+    memset(&features, 0, sizeof(features));
+    features.alpha_power = 0.2f;
+    features.beta_power = 0.5f;        /* Below the default 0.6, above the model's 0.45 */
+    features.peak_amplitude = 2.0f;
+
+    classifier_state_t state;
+    classifier_init(&state);
+    classify_command(&features, &state);
+    ASSERT_EQUAL(CMD_NONE, (int)classify_command(&features, &state), "Default thresholds: no FOCUS");
+
+    classifier_init(&state);
+    classifier_set_thresholds(&state, &model.thresholds);
+    classify_command(&features, &state);
+    ASSERT_EQUAL(CMD_FOCUS, (int)classify_command(&features, &state), "Model thresholds: FOCUS");
+
+    /* The same through a saved and mapped file, without a rebuild */
+    bci_model_file_t file;
+    bool_t opened = bci_model_save(&model, TEST_MODEL_PATH) &&
+                    bci_model_open(&file, TEST_MODEL_PATH);
+    ASSERT_TRUE(opened, "Tweaked model saved and mapped");
+    if (opened) {
+        classifier_init(&state);
+        bci_model_apply_thresholds(file.model, &state);
+        classify_command(&features, &state);
+        ASSERT_EQUAL(CMD_FOCUS, (int)classify_command(&features, &state),
+                     "Mapped model's threshold changes the decision");
+        bci_model_close(&file);
+    }
+    remove(TEST_MODEL_PATH);
+}
+
+int main() {
+    TEST_SUITE_START("Classifier Model Blob Tests");
+
+    test_normalization();
+    test_save_and_open();
+    test_classify_matches_lda();
+    test_reject_bad_blobs();
+    test_model_thresholds();
+
+    TEST_SUITE_END();
+
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include "../include/types.h"
 #include "../include/config.h"
 #include "../include/classifier.h"
+#include <stdlib.h>
 
 /* Test FOCUS command detection */
 void test_focus_detection() {
@@ -144,6 +145,104 @@ void test_baseline_update() {
                 "Baseline updated after detection");
 }
 
+/* Test a custom threshold table */
+void test_custom_thresholds() {
+    TEST_START("Custom Threshold Table");
+    
+    classifier_thresholds_t thresholds = classifier_default_thresholds;
+    thresholds.relax = 0.4f;
+    thresholds.debounce_count = 1;
+    thresholds.visual_alpha_normal = 0.9f;
+    
+    classifier_state_t state;
+    classifier_init(&state);
+    classifier_set_thresholds(&state, &thresholds);
+    
+    features_t features;
+    features.alpha_power = 0.5f;  /* Below the default 0.6 RELAX threshold */
+    features.beta_power = 0.2f;
+    features.theta_power = 0.1f;
+    features.peak_amplitude = 2.0f;
+    features.variance = 100.0f;
+    
+    /* Single detection is enough with debounce_count = 1 */
+    command_t cmd = classify_command(&features, &state);
+    ASSERT_EQUAL(CMD_RELAX, cmd, "RELAX at the lowered threshold without debouncing");
+    
+    predictions_t defaults, custom;
+    predict_impairments(&features, &defaults);
+    predict_impairments_with(&thresholds, &features, &custom);
+    ASSERT_EQUAL(PRED_NORMAL, defaults.visual_impairment, "Default table: normal alpha");
+    ASSERT_EQUAL(PRED_BORDERLINE, custom.visual_impairment, "Custom table: borderline alpha");
+}
+
+/* Test batch impairment grading against the scalar predictor */
+void test_impairment_batch() {
+    TEST_START("Batch Impairment Scoring");
+    
+    /* Not a multiple of IMPAIRMENT_BLOCK_SIZE, so the tail block is exercised */
+    enum { COUNT = 150 };
+    static signal_t theta[COUNT], alpha[COUNT], beta[COUNT];
+    static prediction_t visual[COUNT], motor[COUNT], attention[COUNT];
+    
+    srand(3);
+    for (int i = 0; i < COUNT; i++) {
+        theta[i] = (float)rand() / RAND_MAX * 0.6f;
+        alpha[i] = (float)rand() / RAND_MAX * 0.6f;
+        beta[i] = (float)rand() / RAND_MAX * 0.4f;
+    }
+    /* Values exactly on the thresholds and in the negligible-beta case */
+    alpha[0] = VISUAL_ALPHA_NORMAL;
+    alpha[1] = VISUAL_ALPHA_BORDERLINE;
+    beta[2] = MOTOR_BETA_NORMAL;
+    beta[3] = 0.01f;
+    beta[4] = 0.0f;
+    theta[5] = ATTENTION_RATIO_NORMAL * beta[5];
+    
+    band_power_batch_t batch = { COUNT, theta, alpha, beta };
+    prediction_batch_t out = { visual, motor, attention };
+    impairment_stats_t stats;
+    impairment_stats_init(&stats);
+    predict_impairments_batch(&classifier_default_thresholds, &batch, &out, &stats);
+    
+    int mismatches = 0;
+    size_t expected_counts[NUM_IMPAIRMENT_METRICS][PRED_IMPAIRED + 1] = { { 0 } };
+    for (int i = 0; i < COUNT; i++) {
+        features_t features;
+        features.theta_power = theta[i];
+        features.alpha_power = alpha[i];
+        features.beta_power = beta[i];
+        
+        predictions_t expected;
+        predict_impairments(&features, &expected);
+        if (expected.visual_impairment != visual[i] || expected.motor_impairment != motor[i] ||
+            expected.attention_deficit != attention[i]) {
+            mismatches++;
+        }
+        expected_counts[IMPAIRMENT_VISUAL][expected.visual_impairment]++;
+        expected_counts[IMPAIRMENT_MOTOR][expected.motor_impairment]++;
+        expected_counts[IMPAIRMENT_ATTENTION][expected.attention_deficit]++;
+    }
+    ASSERT_EQUAL(0, mismatches, "Every window graded like predict_impairments");
+    
+    int count_mismatches = 0;
+    for (int m = 0; m < NUM_IMPAIRMENT_METRICS; m++) {
+        for (int g = PRED_NORMAL; g <= PRED_IMPAIRED; g++) {
+            count_mismatches += (stats.counts[m][g] != expected_counts[m][g]) ? 1 : 0;
+        }
+    }
+    ASSERT_EQUAL(0, count_mismatches, "Aggregate counts match");
+    ASSERT_FLOAT_EQUAL((float)expected_counts[IMPAIRMENT_MOTOR][PRED_BORDERLINE] / COUNT,
+                       impairment_fraction(&stats, IMPAIRMENT_MOTOR, PRED_BORDERLINE), 1e-6f,
+                       "Fraction is count over windows");
+    
+    /* Stats accumulate across batches; predictions may be left out */
+    predict_impairments_batch(&classifier_default_thresholds, &batch, NULL, &stats);
+    ASSERT_EQUAL(2 * COUNT, (int)stats.num_windows, "Second batch added to the totals");
+    ASSERT_EQUAL((int)(2 * expected_counts[IMPAIRMENT_VISUAL][PRED_IMPAIRED]),
+                 (int)stats.counts[IMPAIRMENT_VISUAL][PRED_IMPAIRED], "Counts doubled");
+}
+
 int main() {
     TEST_SUITE_START("Classifier Tests");
     
@@ -154,6 +253,8 @@ int main() {
     test_command_priority();
     test_debouncing();
     test_baseline_update();
+    test_custom_thresholds();
+    test_impairment_batch();
     
     TEST_SUITE_END();
     
@@ -1,5 +1,8 @@
 #include "test_framework.h"
 #include "data_loader.h"
+#include "csv_scan.h"
+#include "mapped_file.h"
+#include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -100,6 +103,315 @@ void test_load_dataset(void) {
     }
 }
 
+/* Test the locale-free float scanner against the C library */
+void test_scan_float(void) {
+    TEST_START("CSV Float Scanner");
+    
+    const char *cases[] = {
+        "0", "42", "-17", "+3.5", "0.001", ".5", "-.25", "5.",
+        "123.456", "-98.7654321", "1e3", "2.5E-4", "-7e+2",
+        "0.000000001", "12345678.9", "3.14159265358979323846"
+    };
+    size_t num_cases = sizeof(cases) / sizeof(cases[0]);
+    int mismatches = 0;
+    
+    for (size_t i = 0; i < num_cases; i++) {
+        const char *text = cases[i];
+        const char *end = text + strlen(text);
+        float value;
+        const char *next = csv_scan_float(text, end, &value);
+        if (next != end || value != strtof(text, NULL)) {
+            printf("  Mismatch on \"%s\": got %.9g\n", text, value);
+            mismatches++;
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Scanner should match strtof on decimal input");
+    
+    /* Stops at separators, leaves non-numbers untouched */
+    const char *row = "1.25,FOCUS";
+    float value;
+    const char *next = csv_scan_float(row, row + strlen(row), &value);
+    TEST_ASSERT(next == row + 4 && value == 1.25f, "Should stop at the comma");
+    
+    const char *label = "FOCUS";
+    next = csv_scan_float(label, label + 5, &value);
+    TEST_ASSERT(next == label && value == 0.0f, "Non-numeric field should not advance");
+    
+    const char *dot = "-.";
+    next = csv_scan_float(dot, dot + 2, &value);
+    TEST_ASSERT(next == dot, "Sign and point without digits is not a number");
+    
+    const char *bare_exponent = "4e,1";
+    next = csv_scan_float(bare_exponent, bare_exponent + 4, &value);
+    TEST_ASSERT(next == bare_exponent + 1 && value == 4.0f,
+                "Exponent marker without digits should not be consumed");
+    
+    /* The end pointer bounds the scan even without a terminator */
+    const char *digits = "98765";
+    next = csv_scan_float(digits, digits + 3, &value);
+    TEST_ASSERT(next == digits + 3 && value == 987.0f, "Should respect the end pointer");
+    
+    TEST_PASS("Float scanner parses CSV fields correctly");
+}
+
+/* Test the word-at-a-time newline count over odd lengths and alignments */
+void test_count_newlines(void) {
+    TEST_START("SWAR Newline Count");
+    
+    char buffer[300];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (i % 7 == 0 || i % 11 == 3) ? '\n' : (char)('0' + i % 10);
+    }
+    /* Bytes whose low seven bits match '\n' must not count */
+    buffer[20] = (char)('\n' | 0x80);
+    buffer[21] = '\n' - 1;
+    
+    int mismatches = 0;
+    for (size_t offset = 0; offset < 9; offset++) {
+        for (size_t length = 0; length + offset <= sizeof(buffer); length += 13) {
+            size_t expected = 0;
+            for (size_t i = 0; i < length; i++) {
+                expected += (buffer[offset + i] == '\n');
+            }
+            if (csv_count_newlines(buffer + offset, length) != expected) {
+                mismatches++;
+            }
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Newline count should match a byte loop");
+    
+    const char *terminated = "time,amplitude\n0.0,1.0\n0.1,2.0\n";
+    const char *unterminated = "time,amplitude\n0.0,1.0\n0.1,2.0";
+    TEST_ASSERT(csv_count_rows(terminated, strlen(terminated)) == 2,
+                "Two rows with a trailing newline");
+    TEST_ASSERT(csv_count_rows(unterminated, strlen(unterminated)) == 2,
+                "Last row without a trailing newline should count");
+    TEST_ASSERT(csv_count_rows("time\n", 5) == 0, "Header only has no rows");
+    TEST_ASSERT(csv_count_rows("", 0) == 0, "Empty file has no rows");
+    
+    TEST_PASS("Newline and row counts are exact");
+}
+
+/* Test that the mapped loader matches a plain stdio parse of the dataset */
+void test_load_matches_stdio(void) {
+    TEST_START("Mapped Loader Matches stdio Parse");
+    
+    const char *filepath = "data/raw/sample_eeg_data.csv";
+    FILE *fp = fopen(filepath, "r");
+    if (fp == NULL) {
+        printf("  WARNING: Could not open dataset (file may not exist yet)\n");
+        TEST_PASS("Test skipped - dataset file not found");
+        return;
+    }
+    
+    size_t capacity = 4096;
+    eeg_sample_t *expected = (eeg_sample_t*)calloc(capacity, sizeof(eeg_sample_t));
+    eeg_sample_t *loaded = (eeg_sample_t*)calloc(capacity, sizeof(eeg_sample_t));
+    char line[512];
+    size_t expected_count = 0;
+    
+    /* The dataset header is time,amplitude,theta,alpha,beta,gamma,command,... */
+    if (fgets(line, sizeof(line), fp) != NULL) {
+        while (expected_count < capacity && fgets(line, sizeof(line), fp) != NULL) {
+            eeg_sample_t *sample = &expected[expected_count];
+            if (sscanf(line, "%f,%f,%f,%f,%f,%f", &sample->time, &sample->amplitude,
+                       &sample->theta_power, &sample->alpha_power,
+                       &sample->beta_power, &sample->gamma_power) == 6) {
+                expected_count++;
+            }
+        }
+    }
+    fclose(fp);
+    
+    size_t num_loaded = 0;
+    bool_t result = load_dataset_csv(filepath, loaded, capacity, &num_loaded);
+    TEST_ASSERT(result == TRUE, "Mapped load should succeed");
+    ASSERT_EQUAL((int)expected_count, (int)num_loaded, "Same row count as stdio");
+    
+    int mismatches = 0;
+    for (size_t i = 0; i < num_loaded && i < expected_count; i++) {
+        if (loaded[i].time != expected[i].time ||
+            loaded[i].amplitude != expected[i].amplitude ||
+            loaded[i].theta_power != expected[i].theta_power ||
+            loaded[i].alpha_power != expected[i].alpha_power ||
+            loaded[i].beta_power != expected[i].beta_power ||
+            loaded[i].gamma_power != expected[i].gamma_power) {
+            mismatches++;
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Every field should be bit-identical to sscanf");
+    
+    dataset_info_t info;
+    TEST_ASSERT(get_dataset_info(filepath, &info) == TRUE, "Info should succeed");
+    ASSERT_EQUAL((int)expected_count, (int)info.num_samples, "Row count should match the loader");
+    
+    free(expected);
+    free(loaded);
+    
+    TEST_PASS("Mapped loader is equivalent to the stdio parser");
+}
+
+#define TEST_CSV_PATH "test_data_loader_tmp.csv"
+
+/* Test header parsing for the layouts found under data/ */
+void test_column_map(void) {
+    TEST_START("Header Column Map");
+    
+    const char *raw = "time,amplitude,theta_power,alpha_power,beta_power,gamma_power,"
+                      "command,visual_impairment\r\n";
+    column_map_t map;
+    bool_t result = parse_column_map(raw, strlen(raw), &map);
+    TEST_ASSERT(result == TRUE, "Raw dataset header has an amplitude column");
+    ASSERT_EQUAL(2, map.field[COLUMN_THETA], "theta_power is field 2");
+    ASSERT_EQUAL(3, map.field[COLUMN_ALPHA], "alpha_power is field 3");
+    ASSERT_EQUAL(6, map.field[COLUMN_COMMAND], "command is field 6");
+    ASSERT_EQUAL(8, map.num_fields, "All header fields counted");
+    
+    const char *stream = "time, amplitude, alpha_power, beta_power, command, led_state\n";
+    result = parse_column_map(stream, strlen(stream), &map);
+    TEST_ASSERT(result == TRUE, "Stream log header has an amplitude column");
+    ASSERT_EQUAL(2, map.field[COLUMN_ALPHA], "alpha_power is field 2");
+    ASSERT_EQUAL(-1, map.field[COLUMN_THETA], "No theta column");
+    
+    const char *unknown = "t,value\n";
+    result = parse_column_map(unknown, strlen(unknown), &map);
+    TEST_ASSERT(result == FALSE, "Header without amplitude is rejected");
+    
+    TEST_PASS("Column maps follow the header");
+}
+
+/* Test projection and the fixed layout used without format detection */
+void test_column_projection(void) {
+    TEST_START("Column Projection and Fixed Layout");
+    
+    FILE *fp = fopen(TEST_CSV_PATH, "w");
+    TEST_ASSERT(fp != NULL, "Temporary CSV created");
+    if (fp == NULL) {
+        return;
+    }
+    fprintf(fp, "command,beta_power,amplitude,time,alpha_power\n");
+    fprintf(fp, "FOCUS,0.7,12.5,0.0,0.1\n");
+    fprintf(fp, "RELAX,0.2,-3.25,0.004,0.6\n");
+    fprintf(fp, "\n");
+    fprintf(fp, "NONE,0.3,bad,0.008,0.4\n");
+    fclose(fp);
+    
+    data_loader_init(NULL);
+    
+    eeg_sample_t samples[4];
+    size_t num_loaded = 0;
+    bool_t result = load_dataset_csv(TEST_CSV_PATH, samples, 4, &num_loaded);
+    TEST_ASSERT(result == TRUE, "Reordered columns load");
+    ASSERT_EQUAL(2, (int)num_loaded, "Blank and non-numeric rows skipped");
+    ASSERT_FLOAT_EQUAL(-3.25f, samples[1].amplitude, 1e-6f, "Amplitude from its named column");
+    ASSERT_FLOAT_EQUAL(0.6f, samples[1].alpha_power, 1e-6f, "Alpha from its named column");
+    ASSERT_FLOAT_EQUAL(0.2f, samples[1].beta_power, 1e-6f, "Beta from its named column");
+    TEST_ASSERT(samples[0].command == CMD_FOCUS, "Command from its named column");
+    
+    result = load_dataset_columns(TEST_CSV_PATH, samples, 4,
+                                  COLUMN_BIT(COLUMN_AMPLITUDE), &num_loaded);
+    TEST_ASSERT(result == TRUE, "Amplitude-only projection loads");
+    ASSERT_FLOAT_EQUAL(12.5f, samples[0].amplitude, 1e-6f, "Projected amplitude");
+    ASSERT_FLOAT_EQUAL(0.0f, samples[0].beta_power, 1e-6f, "Unprojected column left at 0");
+    TEST_ASSERT(samples[0].command == CMD_NONE, "Unprojected command left at NONE");
+    
+    /* Detection off: positional time,amplitude,alpha,beta,command */
+    fp = fopen(TEST_CSV_PATH, "w");
+    if (fp != NULL) {
+        fprintf(fp, "a,b,c,d,e\n0.5,4.0,0.3,0.9,BLINK\n");
+        fclose(fp);
+    }
+    data_config_t config;
+    strcpy(config.data_directory, "data/raw");
+    strcpy(config.default_dataset, "sample_eeg_data.csv");
+    config.auto_detect_format = FALSE;
+    data_loader_init(&config);
+    
+    result = load_dataset_csv(TEST_CSV_PATH, samples, 4, &num_loaded);
+    TEST_ASSERT(result == TRUE && num_loaded == 1, "Fixed layout loads");
+    ASSERT_FLOAT_EQUAL(0.9f, samples[0].beta_power, 1e-6f, "Beta from field 3");
+    TEST_ASSERT(samples[0].command == CMD_BLINK, "Command from field 4");
+    
+    data_loader_init(NULL);
+    remove(TEST_CSV_PATH);
+    
+    TEST_PASS("Projection and fixed layout behave as documented");
+}
+
+/* Test that chunked reading yields exactly the rows of a full load */
+void test_chunked_reader(void) {
+    TEST_START("Chunked Dataset Reader");
+    
+    const char *filepath = "data/raw/sample_eeg_data.csv";
+    size_t capacity = 4096;
+    eeg_sample_t *full = (eeg_sample_t*)calloc(capacity, sizeof(eeg_sample_t));
+    size_t num_full = 0;
+    
+    if (!load_dataset_csv(filepath, full, capacity, &num_full)) {
+        free(full);
+        printf("  WARNING: Could not load dataset (file may not exist yet)\n");
+        TEST_PASS("Test skipped - dataset file not found");
+        return;
+    }
+    
+    /* 97 does not divide the row count, so the last chunk is partial */
+    dataset_reader_t reader;
+    eeg_sample_t chunk[97];
+    size_t total = 0;
+    size_t chunks = 0;
+    int mismatches = 0;
+    
+    TEST_ASSERT(dataset_reader_open(&reader, filepath, COLUMNS_ALL) == TRUE, "Reader opens");
+    for (;;) {
+        size_t rows = dataset_reader_next_chunk(&reader, chunk, 97);
+        if (rows == 0) {
+            break;
+        }
+        for (size_t i = 0; i < rows && total + i < num_full; i++) {
+            if (memcmp(&chunk[i], &full[total + i], sizeof(eeg_sample_t)) != 0) {
+                mismatches++;
+            }
+        }
+        total += rows;
+        chunks++;
+    }
+    ASSERT_EQUAL((int)num_full, (int)total, "Chunks cover every row");
+    ASSERT_EQUAL((int)((num_full + 96) / 97), (int)chunks, "Fixed-size chunks");
+    TEST_ASSERT(mismatches == 0, "Chunked rows identical to the full load");
+    ASSERT_EQUAL((int)num_full, (int)reader.rows_read, "Reader counts rows");
+    dataset_reader_close(&reader);
+    
+    /* Windows of the amplitude channel straight into a frame */
+    eeg_frame_t window;
+    command_t labels[WINDOW_SIZE];
+    size_t windows = 0;
+    mismatches = 0;
+    eeg_frame_init(&window, 1, WINDOW_SIZE);
+    TEST_ASSERT(dataset_reader_open(&reader, filepath, COLUMNS_ALL) == TRUE, "Reader reopens");
+    ASSERT_EQUAL(1, (int)reader.num_channels, "Amplitude column is one channel");
+    for (;;) {
+        size_t rows = dataset_reader_next_frame(&reader, &window, labels);
+        if (rows == 0) {
+            break;
+        }
+        for (size_t i = 0; i < rows; i++) {
+            const eeg_sample_t *expected = &full[windows * WINDOW_SIZE + i];
+            if (eeg_frame_channel(&window, 0)[i] != expected->amplitude ||
+                labels[i] != expected->command) {
+                mismatches++;
+            }
+        }
+        windows++;
+    }
+    ASSERT_EQUAL((int)(num_full / WINDOW_SIZE), (int)windows, "One frame per window");
+    TEST_ASSERT(mismatches == 0, "Frame windows match the full load");
+    dataset_reader_close(&reader);
+    eeg_frame_destroy(&window);
+    
+    free(full);
+    TEST_PASS("Chunked reader streams the whole file");
+}
+
 int main(void) {
     TEST_SUITE_START("Data Loader Tests");
     
@@ -108,6 +420,12 @@ int main(void) {
     test_command_parsing();
     test_dataset_info();
     test_load_dataset();
+    test_scan_float();
+    test_count_newlines();
+    test_load_matches_stdio();
+    test_column_map();
+    test_column_projection();
+    test_chunked_reader();
     
     TEST_SUITE_END();
     
@@ -0,0 +1,129 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/dsp_kernels.h"
+#include <math.h>
+#include <string.h>
+
+/* Odd length so strip-mined kernels see a partial final vector */
+#define KERNEL_TEST_LENGTH 203
+
+static void fill_test_signal(signal_t *x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 3.0f * sinf(0.37f * i) + 0.01f * (float)(i % 11) - 0.2f;
+    }
+}
+
+/* Test reductions against straightforward loops */
+void test_reductions() {
+    TEST_START("Sum / Max-Abs / Central Moments");
+
+    signal_t x[KERNEL_TEST_LENGTH];
+    fill_test_signal(x, KERNEL_TEST_LENGTH);
+    x[150] = -7.5f;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < KERNEL_TEST_LENGTH; i++) sum += x[i];
+    float mean = (float)(sum / KERNEL_TEST_LENGTH);
+
+    double s2 = 0.0, s3 = 0.0;
+    for (size_t i = 0; i < KERNEL_TEST_LENGTH; i++) {
+        double d = x[i] - mean;
+        s2 += d * d;
+        s3 += d * d * d;
+    }
+
+    signal_t sum_sq, sum_cube;
+    dsp_central_moments(x, KERNEL_TEST_LENGTH, mean, &sum_sq, &sum_cube);
+
+    printf("  Backend: %s\n", dsp_kernels_backend());
+    ASSERT_FLOAT_EQUAL((float)sum, dsp_sum(x, KERNEL_TEST_LENGTH), 1e-3f, "Sum matches");
+    ASSERT_FLOAT_EQUAL(7.5f, dsp_max_abs(x, KERNEL_TEST_LENGTH), 1e-6f, "Max |x| matches");
+    ASSERT_FLOAT_EQUAL((float)s2, sum_sq, 1e-2f, "Sum of squared deviations matches");
+    ASSERT_FLOAT_EQUAL((float)s3, sum_cube, 1e-1f, "Sum of cubed deviations matches");
+    ASSERT_FLOAT_EQUAL(0.0f, dsp_sum(x, 0), 1e-9f, "Empty sum is zero");
+    ASSERT_FLOAT_EQUAL(0.0f, dsp_max_abs(x, 0), 1e-9f, "Empty max is zero");
+}
+
+/* Test magnitude-squared and one butterfly stage */
+void test_spectrum_kernels() {
+    TEST_START("Magnitude Squared / FFT Stage");
+
+    complex_t bins[KERNEL_TEST_LENGTH];
+    float power[KERNEL_TEST_LENGTH];
+    for (size_t i = 0; i < KERNEL_TEST_LENGTH; i++) {
+        bins[i].real = 0.1f * i;
+        bins[i].imag = 1.0f - 0.05f * i;
+    }
+    dsp_magnitude_squared(bins, power, KERNEL_TEST_LENGTH, 0.5f);
+
+    float max_diff = 0.0f;
+    for (size_t i = 0; i < KERNEL_TEST_LENGTH; i++) {
+        float expected = 0.5f * (bins[i].real * bins[i].real + bins[i].imag * bins[i].imag);
+        float diff = fabsf(expected - power[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    ASSERT_TRUE(max_diff < 1e-4f, "Scaled |X|^2 matches");
+
+    /* 2-point groups with unit twiddle: plain sum/difference pairs */
+    complex_t data[8];
+    /* 8-point table: exp(-2*pi*i*k/8), k = 0..3 */
+    complex_t twiddles[4] = {
+        { 1.0f, 0.0f }, { 0.70710678f, -0.70710678f }, { 0.0f, -1.0f }, { -0.70710678f, -0.70710678f }
+    };
+    for (size_t i = 0; i < 8; i++) {
+        data[i].real = (float)i;
+        data[i].imag = 0.0f;
+    }
+    dsp_fft_stage(data, 8, 1, twiddles, 4);
+    ASSERT_FLOAT_EQUAL(1.0f, data[0].real, 1e-6f, "Stage 1 top = a + b");
+    ASSERT_FLOAT_EQUAL(-1.0f, data[1].real, 1e-6f, "Stage 1 bottom = a - b");
+
+    /* 4-point groups, stride 2: second butterfly uses w = -i */
+    dsp_fft_stage(data, 8, 2, twiddles, 2);
+    ASSERT_FLOAT_EQUAL(6.0f, data[0].real, 1e-6f, "Stage 2 DC of first group");
+    ASSERT_FLOAT_EQUAL(-1.0f, data[1].real, 1e-6f, "Stage 2 bin 1 real");
+    ASSERT_FLOAT_EQUAL(1.0f, data[1].imag, 1e-6f, "Stage 2 bin 1 imag (w = -i)");
+    ASSERT_FLOAT_EQUAL(22.0f, data[4].real, 1e-6f, "Stage 2 DC of second group");
+}
+
+/* Test moving average, including in-place and edge windows */
+void test_moving_average_kernel() {
+    TEST_START("Moving Average Kernel");
+
+    signal_t x[KERNEL_TEST_LENGTH];
+    signal_t out[KERNEL_TEST_LENGTH];
+    fill_test_signal(x, KERNEL_TEST_LENGTH);
+
+    size_t windows[] = { 1, 5, 64, KERNEL_TEST_LENGTH };
+    float max_diff = 0.0f;
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        size_t window = windows[w];
+        dsp_moving_average(x, out, KERNEL_TEST_LENGTH, window);
+        for (size_t i = 0; i < KERNEL_TEST_LENGTH; i++) {
+            size_t count = (i + 1 < window) ? i + 1 : window;
+            float sum = 0.0f;
+            for (size_t j = 0; j < count; j++) sum += x[i - j];
+            float diff = fabsf(sum / count - out[i]);
+            if (diff > max_diff) max_diff = diff;
+        }
+    }
+    ASSERT_TRUE(max_diff < 1e-4f, "Matches direct window sums");
+
+    signal_t in_place[KERNEL_TEST_LENGTH];
+    memcpy(in_place, x, sizeof(x));
+    dsp_moving_average(x, out, KERNEL_TEST_LENGTH, 5);
+    dsp_moving_average(in_place, in_place, KERNEL_TEST_LENGTH, 5);
+    ASSERT_TRUE(memcmp(in_place, out, sizeof(out)) == 0, "In-place output identical");
+}
+
+int main() {
+    TEST_SUITE_START("DSP Kernel Tests");
+
+    test_reductions();
+    test_spectrum_kernels();
+    test_moving_average_kernel();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
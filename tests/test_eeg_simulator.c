@@ -0,0 +1,182 @@
+#include "test_framework.h"
+#include "eeg_simulator.h"
+#include <math.h>
+#include <string.h>
+
+#define GAUSSIAN_SAMPLES 20000
+
+/* Same seed and stream id give the same sequence; other ids diverge */
+void test_rng_streams(void) {
+    TEST_START("Seeded PCG32 Streams");
+
+    eeg_rng_t a, b, c;
+    eeg_rng_seed(&a, 42, 7);
+    eeg_rng_seed(&b, 42, 7);
+    eeg_rng_seed(&c, 42, 8);
+
+    int repeats = 0;
+    int collisions = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint32_t x = eeg_rng_next(&a);
+        uint32_t y = eeg_rng_next(&b);
+        uint32_t z = eeg_rng_next(&c);
+        repeats += (x == y);
+        collisions += (x == z);
+    }
+    ASSERT_EQUAL(1000, repeats, "Same seed and stream reproduce");
+    ASSERT_TRUE(collisions < 3, "Another stream id gives another sequence");
+
+    /* Reference PCG32 output (seed 42, stream 54) */
+    eeg_rng_seed(&a, 42, 54);
+    ASSERT_TRUE(eeg_rng_next(&a) == 0xa15c02b7u, "First PCG32 reference value");
+    ASSERT_TRUE(eeg_rng_next(&a) == 0x7b47f409u, "Second PCG32 reference value");
+
+    float lowest = 1.0f, highest = 0.0f;
+    for (int i = 0; i < 10000; i++) {
+        float u = eeg_rng_uniform(&a);
+        lowest = fminf(lowest, u);
+        highest = fmaxf(highest, u);
+    }
+    ASSERT_TRUE(lowest >= 0.0f && highest < 1.0f, "Uniform stays in [0, 1)");
+    ASSERT_TRUE(lowest < 0.01f && highest > 0.99f, "Uniform covers the interval");
+}
+
+/* Sample moments of the Gaussian deviates */
+void test_gaussian(void) {
+    TEST_START("Gaussian Noise");
+
+    static signal_t noise[GAUSSIAN_SAMPLES];
+    eeg_rng_t rng;
+    eeg_rng_seed(&rng, 1, 0);
+    eeg_rng_gaussian_fill(&rng, noise, GAUSSIAN_SAMPLES, 2.0f);
+
+    double sum = 0.0, sum_sq = 0.0, sum_4 = 0.0;
+    int beyond_3_sigma = 0;
+    for (int i = 0; i < GAUSSIAN_SAMPLES; i++) {
+        double x = noise[i] / 2.0;
+        sum += x;
+        sum_sq += x * x;
+        sum_4 += x * x * x * x;
+        beyond_3_sigma += (fabs(x) > 3.0);
+    }
+    double mean = sum / GAUSSIAN_SAMPLES;
+    double variance = sum_sq / GAUSSIAN_SAMPLES - mean * mean;
+    double kurtosis = (sum_4 / GAUSSIAN_SAMPLES) / (variance * variance);
+
+    ASSERT_TRUE(fabs(mean) < 0.03, "Zero mean");
+    ASSERT_TRUE(fabs(variance - 1.0) < 0.05, "Variance sigma^2");
+    ASSERT_TRUE(fabs(kurtosis - 3.0) < 0.2, "Normal kurtosis (a uniform gives 1.8)");
+    ASSERT_TRUE(beyond_3_sigma > 20 && beyond_3_sigma < 100, "Tails beyond 3 sigma (~0.27%)");
+
+    /* The fill and one-at-a-time draws walk the same sequence */
+    signal_t filled[7], single[7];
+    eeg_rng_seed(&rng, 9, 3);
+    eeg_rng_gaussian(&rng);
+    eeg_rng_gaussian_fill(&rng, filled, 7, 1.0f);
+    eeg_rng_seed(&rng, 9, 3);
+    eeg_rng_gaussian(&rng);
+    for (int i = 0; i < 7; i++) {
+        single[i] = eeg_rng_gaussian(&rng);
+    }
+    ASSERT_TRUE(memcmp(filled, single, sizeof(filled)) == 0, "Fill matches single draws");
+}
+
+/* The rotator tracks sinf over long runs and keeps its amplitude */
+void test_oscillator(void) {
+    TEST_START("Recursive Oscillator");
+
+    static signal_t wave[WINDOW_SIZE];
+    eeg_oscillator_t osc;
+    eeg_oscillator_init(&osc, 10.5f, SAMPLING_RATE, 50.0f);
+
+    float max_error = 0.0f;
+    for (int block = 0; block < 64; block++) {
+        memset(wave, 0, sizeof(wave));
+        eeg_oscillator_add(&osc, wave, WINDOW_SIZE);
+        for (int i = 0; i < WINDOW_SIZE; i++) {
+            double n = (double)block * WINDOW_SIZE + i;
+            float expected = (float)(50.0 * sin(2.0 * M_PI * 10.5 * n / SAMPLING_RATE));
+            max_error = fmaxf(max_error, fabsf(wave[i] - expected));
+        }
+    }
+    ASSERT_TRUE(max_error < 0.05f, "Within 0.1% of sinf after 64 windows");
+
+    float magnitude = sqrtf(osc.re * osc.re + osc.im * osc.im);
+    ASSERT_FLOAT_EQUAL(1.0f, magnitude, 1e-5f, "Phasor stays on the unit circle");
+}
+
+/* Streams replay from their seed, independently of each other */
+void test_stream_reproducible(void) {
+    TEST_START("Reproducible Streams");
+
+    static signal_t first[WINDOW_SIZE], second[WINDOW_SIZE], other[WINDOW_SIZE];
+    eeg_stream_t a, b, c;
+    eeg_stream_init(&a, 2024, 0);
+    eeg_stream_init(&b, 2024, 0);
+    eeg_stream_init(&c, 2024, 1);
+
+    eeg_stream_generate(&a, first, WINDOW_SIZE, CMD_FOCUS);
+    eeg_stream_generate(&c, other, WINDOW_SIZE, CMD_FOCUS);
+    eeg_stream_generate(&b, second, WINDOW_SIZE, CMD_FOCUS);
+    ASSERT_TRUE(memcmp(first, second, sizeof(first)) == 0,
+                "Same seed gives bit-identical windows");
+    ASSERT_TRUE(memcmp(first, other, sizeof(first)) != 0, "Another stream differs");
+
+    /* Successive windows draw fresh noise over the same rhythm */
+    eeg_stream_generate(&a, second, WINDOW_SIZE, CMD_FOCUS);
+    ASSERT_TRUE(memcmp(first, second, sizeof(first)) != 0, "Next window has new noise");
+
+    /* The default stream restarts from eeg_simulator_seed */
+    eeg_simulator_seed(77);
+    generate_eeg_sample(first, WINDOW_SIZE, CMD_RELAX);
+    eeg_simulator_seed(77);
+    generate_eeg_sample(second, WINDOW_SIZE, CMD_RELAX);
+    ASSERT_TRUE(memcmp(first, second, sizeof(first)) == 0, "Default stream replays from a seed");
+}
+
+/* Window content per state: rhythm amplitudes, noise RMS and blink */
+void test_window_content(void) {
+    TEST_START("Window Content");
+
+    static signal_t window[WINDOW_SIZE];
+    eeg_stream_t stream;
+    eeg_stream_init(&stream, 5, 0);
+
+    /* Noise-free reference from the point-wise generators */
+    eeg_stream_generate(&stream, window, WINDOW_SIZE, CMD_RELAX);
+    double residual_sq = 0.0;
+    float dt = 1.0f / SAMPLING_RATE;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        float clean = generate_alpha_wave(i * dt, 10.5f) + 0.3f * generate_beta_wave(i * dt, 21.5f);
+        double r = window[i] - clean;
+        residual_sq += r * r;
+    }
+    double noise_rms = sqrt(residual_sq / WINDOW_SIZE);
+    double uniform_rms = NOISE_LEVEL / sqrt(3.0);
+    ASSERT_TRUE(fabs(noise_rms - uniform_rms) < 0.5, "Noise RMS of a +/-NOISE_LEVEL uniform");
+
+    eeg_stream_generate(&stream, window, WINDOW_SIZE, CMD_BLINK);
+    int peak = 0;
+    for (int i = 1; i < WINDOW_SIZE; i++) {
+        if (window[i] > window[peak]) {
+            peak = i;
+        }
+    }
+    ASSERT_TRUE(peak >= SAMPLING_RATE / 2 && peak < SAMPLING_RATE / 2 + 10,
+                "Blink peak at 0.5 s");
+    ASSERT_TRUE(window[peak] > 0.8f * BLINK_AMPLITUDE, "Blink amplitude");
+}
+
+int main() {
+    TEST_SUITE_START("EEG Simulator Tests");
+
+    test_rng_streams();
+    test_gaussian();
+    test_oscillator();
+    test_stream_reproducible();
+    test_window_content();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -58,9 +58,103 @@ void test_fft_utilities(void) {
     TEST_ASSERT(bit_reverse(2, 3) == 2, "Bit reverse 010 -> 010");
     TEST_ASSERT(bit_reverse(3, 3) == 6, "Bit reverse 011 -> 110");
     
+    /* Test band to bin range mapping (inclusive edges) */
+    size_t first_bin = 0;
+    size_t count = get_frequency_bin_range(8.0f, 13.0f, 256.0f, 256, &first_bin);
+    TEST_ASSERT(first_bin == 8 && count == 6, "8-13 Hz at 1 Hz/bin is bins 8..13");
+    count = get_frequency_bin_range(8.3f, 12.7f, 256.0f, 256, &first_bin);
+    TEST_ASSERT(first_bin == 9 && count == 4, "Fractional edges exclude outside bins");
+    count = get_frequency_bin_range(100.0f, 500.0f, 256.0f, 256, &first_bin);
+    TEST_ASSERT(first_bin == 100 && count == 29, "Range capped at Nyquist");
+    count = get_frequency_bin_range(10.2f, 10.8f, 256.0f, 256, &first_bin);
+    TEST_ASSERT(count == 0, "Band between bins is empty");
+    
     TEST_PASS("FFT utilities work correctly");
 }
 
+/* Test planned FFT against a direct DFT */
+void test_fft_plan(void) {
+    TEST_START("FFT Plan vs Direct DFT");
+    
+    size_t n = 64;
+    fft_plan_t plan;
+    
+    TEST_ASSERT(fft_plan_create(&plan, 100) == FALSE, "Plan rejects non power of 2");
+    TEST_ASSERT(fft_plan_create(&plan, n) == TRUE, "Plan creation for n=64");
+    
+    signal_t *signal = (signal_t*)malloc(n * sizeof(signal_t));
+    for (size_t i = 0; i < n; i++) {
+        signal[i] = sinf(2.0f * M_PI * 5.0f * i / n) + 0.25f * cosf(2.0f * M_PI * 17.0f * i / n);
+    }
+    
+    complex_t *fft_result = (complex_t*)malloc(n * sizeof(complex_t));
+    fft_compute_plan(&plan, signal, fft_result);
+    
+    float max_error = 0.0f;
+    for (size_t k = 0; k < n; k++) {
+        double re = 0.0, im = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double angle = -2.0 * M_PI * k * i / n;
+            re += signal[i] * cos(angle);
+            im += signal[i] * sin(angle);
+        }
+        float err = fabsf(fft_result[k].real - (float)re) + fabsf(fft_result[k].imag - (float)im);
+        if (err > max_error) {
+            max_error = err;
+        }
+    }
+    
+    printf("  Maximum bin error vs DFT: %.6f\n", max_error);
+    TEST_ASSERT(max_error < 1e-3f, "Planned FFT matches direct DFT");
+    
+    fft_plan_destroy(&plan);
+    free(signal);
+    free(fft_result);
+    
+    TEST_PASS("FFT plan works correctly");
+}
+
+/* Test real-input FFT against the full complex FFT */
+void test_fft_real(void) {
+    TEST_START("Real-Input FFT vs Complex FFT");
+    
+    size_t sizes[] = { 2, 8, 256 };
+    float max_error = 0.0f;
+    
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        fft_plan_t plan;
+        fft_plan_create(&plan, n);
+        
+        signal_t *signal = (signal_t*)malloc(n * sizeof(signal_t));
+        for (size_t i = 0; i < n; i++) {
+            signal[i] = sinf(2.0f * M_PI * 3.0f * i / n) + 0.1f * i - 0.3f;
+        }
+        
+        complex_t *full = (complex_t*)malloc(n * sizeof(complex_t));
+        complex_t *half = (complex_t*)malloc((n / 2 + 1) * sizeof(complex_t));
+        fft_compute_plan(&plan, signal, full);
+        fft_compute_real(&plan, signal, half);
+        
+        for (size_t k = 0; k <= n / 2; k++) {
+            float err = fabsf(full[k].real - half[k].real) + fabsf(full[k].imag - half[k].imag);
+            if (err > max_error) {
+                max_error = err;
+            }
+        }
+        
+        fft_plan_destroy(&plan);
+        free(signal);
+        free(full);
+        free(half);
+    }
+    
+    printf("  Maximum bin error: %.6f\n", max_error);
+    TEST_ASSERT(max_error < 1e-2f, "Real FFT bins match complex FFT bins");
+    
+    TEST_PASS("Real-input FFT works correctly");
+}
+
 /* Test FFT with known sinusoid */
 void test_fft_sinusoid(void) {
     TEST_START("FFT with Known Sinusoid");
@@ -94,7 +188,7 @@ void test_fft_sinusoid(void) {
         }
     }
     
-    float peak_freq = spectrum.frequencies[peak_idx];
+    float peak_freq = peak_idx * spectrum.frequency_resolution;
     
     printf("  Expected frequency: %.2f Hz\n", test_freq);
     printf("  Detected frequency: %.2f Hz\n", peak_freq);
@@ -146,10 +240,10 @@ void test_fft_multiple_frequencies(void) {
             peak2_power = peak1_power;
             peak2_freq = peak1_freq;
             peak1_power = spectrum.power[i];
-            peak1_freq = spectrum.frequencies[i];
+            peak1_freq = i * spectrum.frequency_resolution;
         } else if (spectrum.power[i] > peak2_power) {
             peak2_power = spectrum.power[i];
-            peak2_freq = spectrum.frequencies[i];
+            peak2_freq = i * spectrum.frequency_resolution;
         }
     }
     
@@ -197,6 +291,135 @@ void test_band_power_calculation(void) {
     TEST_PASS("Band power calculation works correctly");
 }
 
+/* Test multi-band power matches per-band calculation */
+void test_multi_band_power(void) {
+    TEST_START("Multi-Band Power (Single Spectrum)");
+    
+    size_t n = 256;
+    float sampling_rate = 256.0f;
+    
+    signal_t *signal = (signal_t*)malloc(n * sizeof(signal_t));
+    for (size_t i = 0; i < n; i++) {
+        float t = i / sampling_rate;
+        signal[i] = sinf(2.0f * M_PI * 6.0f * t) +
+                   0.5f * sinf(2.0f * M_PI * 21.0f * t);
+    }
+    
+    frequency_band_t bands[NUM_BANDS] = {
+        { 4.0f, 8.0f }, { 8.0f, 13.0f }, { 13.0f, 30.0f }, { 30.0f, 50.0f }
+    };
+    float powers[NUM_BANDS];
+    
+    bool_t ok = calculate_band_powers_fft(signal, n, sampling_rate, bands, NUM_BANDS, powers);
+    TEST_ASSERT(ok == TRUE, "Multi-band calculation succeeds");
+    
+    float max_diff = 0.0f;
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        float single = calculate_band_power_fft(signal, n, sampling_rate,
+                                                bands[b].low_freq, bands[b].high_freq);
+        float diff = fabsf(single - powers[b]);
+        if (diff > max_diff) {
+            max_diff = diff;
+        }
+    }
+    
+    printf("  Theta: %.6f  Beta: %.6f\n", powers[0], powers[2]);
+    
+    TEST_ASSERT(max_diff < 1e-6f, "Multi-band result matches per-band result");
+    TEST_ASSERT(powers[0] > powers[2], "Theta dominates for 6 Hz + weak 21 Hz signal");
+    
+    free(signal);
+    
+    TEST_PASS("Multi-band power works correctly");
+}
+
+/* Test arena-backed workspaces against the heap path */
+void test_fft_workspace(void) {
+    TEST_START("Arena-Backed FFT Workspace");
+    
+    size_t n = 500;  /* Padded to 512: not the static default size */
+    float sampling_rate = 256.0f;
+    
+    static uint8_t memory[FFT_WORKSPACE_BYTES(512)];
+    dsp_arena_t arena;
+    fft_workspace_t ws;
+    dsp_arena_init(&arena, memory, sizeof(memory));
+    
+    bool_t ok = fft_workspace_init(&ws, &arena, n);
+    TEST_ASSERT(ok == TRUE, "Workspace fits in FFT_WORKSPACE_BYTES");
+    TEST_ASSERT(ws.fft_size == 512, "Workspace padded to next power of 2");
+    
+    signal_t signal[500];
+    for (size_t i = 0; i < n; i++) {
+        float t = i / sampling_rate;
+        signal[i] = sinf(2.0f * M_PI * 10.0f * t) + 0.3f * sinf(2.0f * M_PI * 40.0f * t);
+    }
+    
+    frequency_band_t bands[2] = { { 8.0f, 13.0f }, { 30.0f, 50.0f } };
+    float heap_powers[2];
+    float ws_powers[2];
+    calculate_band_powers_fft(signal, n, sampling_rate, bands, 2, heap_powers);
+    ok = calculate_band_powers_fft_ws(&ws, signal, n, sampling_rate, bands, 2, ws_powers);
+    
+    TEST_ASSERT(ok == TRUE, "Workspace band powers succeed");
+    TEST_ASSERT(fabsf(heap_powers[0] - ws_powers[0]) < 1e-6f &&
+                fabsf(heap_powers[1] - ws_powers[1]) < 1e-6f,
+                "Workspace matches heap path");
+    
+    /* Wrong size is rejected rather than silently reallocated */
+    ok = calculate_band_powers_fft_ws(&ws, signal, 100, sampling_rate, bands, 2, ws_powers);
+    TEST_ASSERT(ok == FALSE, "Mismatched signal length rejected");
+    
+    /* Arena is exhausted: a second workspace does not fit */
+    fft_workspace_t second;
+    size_t used = dsp_arena_mark(&arena);
+    TEST_ASSERT(fft_workspace_init(&second, &arena, n) == FALSE, "Exhausted arena rejected");
+    TEST_ASSERT(dsp_arena_mark(&arena) == used, "Failed init releases partial allocations");
+    
+    /* Default workspace serves WINDOW_SIZE signals */
+    fft_workspace_t *def = fft_default_workspace();
+    TEST_ASSERT(def != NULL && def->fft_size == WINDOW_SIZE, "Default workspace ready");
+    
+    TEST_PASS("FFT workspace works correctly");
+}
+
+/* Test the cached Hann tables against the closed form */
+void test_hann_window_table(void) {
+    TEST_START("Cached Hann Window Tables");
+    
+    const signal_t *table = hann_window_table(WINDOW_SIZE);
+    float max_error = 0.0f;
+    float power = 0.0f;
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        float expected = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (WINDOW_SIZE - 1)));
+        float error = fabsf(table[i] - expected);
+        max_error = (error > max_error) ? error : max_error;
+        power += expected * expected;
+    }
+    TEST_ASSERT(max_error == 0.0f, "WINDOW_SIZE table matches the per-sample formula");
+    TEST_ASSERT(table[0] == 0.0f && fabsf(table[WINDOW_SIZE - 1]) < 1e-6f, "Symmetric endpoints");
+    
+    signal_t scratch[WINDOW_SIZE];
+    float table_power = hann_window_fill(scratch, WINDOW_SIZE);
+    TEST_ASSERT(fabsf(table_power - power) < 1e-3f, "Fill reports the window power");
+    TEST_ASSERT(fabsf(table_power - 0.375f * (WINDOW_SIZE - 1)) < 0.01f, "Hann power is 3N/8");
+    
+    /* Other lengths come from the cache, rebuilt only when the length changes */
+    const signal_t *odd = hann_window_table(100);
+    TEST_ASSERT(odd != NULL && odd == hann_window_table(100), "Other lengths are cached");
+    TEST_ASSERT(fabsf(odd[50] - 0.5f * (1.0f - cosf(2.0f * M_PI * 50 / 99))) < 1e-7f,
+                "Cached table is the 100-point window");
+    
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        scratch[i] = 2.0f;
+    }
+    apply_hanning_window(scratch, WINDOW_SIZE);
+    TEST_ASSERT(scratch[WINDOW_SIZE / 2] == 2.0f * table[WINDOW_SIZE / 2],
+                "apply_hanning_window multiplies by the table");
+    
+    TEST_PASS("Hann tables work correctly");
+}
+
 /* Test inverse FFT */
 void test_inverse_fft(void) {
     TEST_START("Inverse FFT (Round-trip)");
@@ -244,9 +467,14 @@ int main(void) {
     
     test_complex_operations();
     test_fft_utilities();
+    test_fft_plan();
+    test_fft_real();
     test_fft_sinusoid();
     test_fft_multiple_frequencies();
     test_band_power_calculation();
+    test_multi_band_power();
+    test_fft_workspace();
+    test_hann_window_table();
     test_inverse_fft();
     
     fft_cleanup();
@@ -0,0 +1,160 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/fixed_point.h"
+#include "../include/preprocessing.h"
+#include "../include/feature_extraction.h"
+#include "../include/classifier.h"
+#include "../include/eeg_simulator.h"
+#include "../include/fft.h"
+#include "../include/utils.h"
+#include <math.h>
+#include <string.h>
+
+#define WINDOWS_PER_STATE 10
+
+/* Test integer square root */
+void test_isqrt() {
+    TEST_START("Integer Square Root");
+
+    ASSERT_EQUAL(0, (int)fixed_isqrt(0), "sqrt(0)");
+    ASSERT_EQUAL(1, (int)fixed_isqrt(3), "floor(sqrt(3))");
+    ASSERT_EQUAL(4096, (int)fixed_isqrt(4096u * 4096u), "sqrt(4096^2)");
+    ASSERT_EQUAL(65535, (int)fixed_isqrt(65536ull * 65536ull - 1), "floor(sqrt(2^32 - 1))");
+}
+
+/* Test block-scaled FFT against the float FFT */
+void test_fft_q15() {
+    TEST_START("Block Floating-Point FFT");
+
+    signal_t signal[WINDOW_SIZE];
+    q15_t fixed_signal[WINDOW_SIZE];
+    complex_t reference[WINDOW_SIZE];
+    complex_q15_t bins[WINDOW_SIZE];
+
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        signal[i] = 0.6f * sinf(2.0f * M_PI * 10.0f * i / WINDOW_SIZE) +
+                    0.3f * cosf(2.0f * M_PI * 37.0f * i / WINDOW_SIZE);
+    }
+    fixed_from_signal(signal, fixed_signal, WINDOW_SIZE, 1.0f);
+
+    int exponent = 0;
+    bool_t ok = fft_compute_q15(fixed_signal, bins, WINDOW_SIZE, &exponent);
+    fft_compute(signal, reference, WINDOW_SIZE);
+
+    /* Largest bin error relative to the strongest bin */
+    float scale = ldexpf(1.0f, exponent) / 32768.0f;
+    float max_error = 0.0f;
+    for (int k = 0; k < WINDOW_SIZE; k++) {
+        float dr = bins[k].real * scale - reference[k].real;
+        float di = bins[k].imag * scale - reference[k].imag;
+        float error = sqrtf(dr * dr + di * di);
+        if (error > max_error) max_error = error;
+    }
+    float peak = complex_magnitude(reference[10]);
+    printf("  Block exponent: %d, max error: %.4f of peak\n", exponent, max_error / peak);
+
+    ASSERT_TRUE(ok == TRUE, "Fixed-point FFT succeeds");
+    ASSERT_TRUE(max_error / peak < 0.01f, "Bins within 1% of the float FFT peak");
+    ASSERT_TRUE(fft_compute_q15(fixed_signal, bins, 100, NULL) == FALSE,
+                "Non power of 2 rejected");
+}
+
+/* Test preprocessing against the float pipeline */
+void test_preprocess_q15() {
+    TEST_START("Fixed-Point Preprocessing");
+
+    signal_t signal[WINDOW_SIZE];
+    q15_t fixed_signal[WINDOW_SIZE];
+    generate_eeg_sample(signal, WINDOW_SIZE, CMD_RELAX);
+    fixed_from_signal(signal, fixed_signal, WINDOW_SIZE, FIXED_INPUT_FULL_SCALE);
+
+    preprocess_signal(signal, WINDOW_SIZE);
+    preprocess_signal_q15(fixed_signal, WINDOW_SIZE);
+
+    float max_diff = 0.0f;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        float diff = fabsf((float)fixed_signal[i] / FIXED_SIGMA - signal[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    printf("  Max difference: %.4f sigma\n", max_diff);
+
+    ASSERT_TRUE(max_diff < 0.01f, "Normalized samples within 0.01 sigma of float");
+}
+
+/* Test features and decisions against the float pipeline */
+void test_pipeline_agreement() {
+    TEST_START("Fixed vs Float Pipeline");
+
+    command_t states[] = { CMD_NONE, CMD_FOCUS, CMD_RELAX, CMD_BLINK };
+    classifier_state_t float_classifier;
+    classifier_state_t fixed_classifier;
+    classifier_init(&float_classifier);
+    classifier_init(&fixed_classifier);
+
+    float max_ratio_diff = 0.0f;
+    float max_peak_diff = 0.0f;
+    int mismatches = 0;
+    int windows = 0;
+
+    for (size_t s = 0; s < sizeof(states) / sizeof(states[0]); s++) {
+        for (int w = 0; w < WINDOWS_PER_STATE; w++) {
+            signal_t signal[WINDOW_SIZE];
+            q15_t fixed_signal[WINDOW_SIZE];
+            features_t float_features;
+            features_t fixed_view;
+            features_q15_t fixed_features;
+
+            generate_eeg_sample(signal, WINDOW_SIZE, states[s]);
+            fixed_from_signal(signal, fixed_signal, WINDOW_SIZE, FIXED_INPUT_FULL_SCALE);
+
+            preprocess_signal(signal, WINDOW_SIZE);
+            extract_features(signal, WINDOW_SIZE, &float_features);
+            preprocess_signal_q15(fixed_signal, WINDOW_SIZE);
+            extract_features_q15(fixed_signal, WINDOW_SIZE, &fixed_features);
+            features_from_q15(&fixed_features, &fixed_view);
+
+            float diffs[] = {
+                fabsf(fixed_view.theta_power - float_features.theta_power),
+                fabsf(fixed_view.alpha_power - float_features.alpha_power),
+                fabsf(fixed_view.beta_power - float_features.beta_power),
+                fabsf(fixed_view.gamma_power - float_features.gamma_power)
+            };
+            for (int b = 0; b < NUM_BANDS; b++) {
+                if (diffs[b] > max_ratio_diff) max_ratio_diff = diffs[b];
+            }
+            float peak_diff = fabsf(fixed_view.peak_amplitude - float_features.peak_amplitude);
+            if (peak_diff > max_peak_diff) max_peak_diff = peak_diff;
+
+            command_t float_cmd = classify_command(&float_features, &float_classifier);
+            command_t fixed_cmd = classify_command_q15(&fixed_features, &fixed_classifier);
+            if (float_cmd != fixed_cmd) mismatches++;
+            windows++;
+        }
+    }
+
+    printf("  Max ratio diff: %.4f, max peak diff: %.4f sigma, mismatches: %d/%d\n",
+           max_ratio_diff, max_peak_diff, mismatches, windows);
+
+    ASSERT_TRUE(max_ratio_diff < FIXED_RATIO_TOLERANCE, "Band ratios within FIXED_RATIO_TOLERANCE");
+    ASSERT_TRUE(max_peak_diff < FIXED_PEAK_TOLERANCE, "Peak within FIXED_PEAK_TOLERANCE");
+    ASSERT_EQUAL(0, mismatches, "Same decisions as the float classifier");
+}
+
+int main() {
+    TEST_SUITE_START("Fixed-Point Pipeline Tests");
+
+    seed_random(1234);
+    eeg_simulator_init();
+    preprocessing_init();
+    fixed_point_init();
+
+    test_isqrt();
+    test_fft_q15();
+    test_preprocess_q15();
+    test_pipeline_agreement();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -104,6 +104,260 @@ void test_lda_classifier(void) {
     TEST_PASS("LDA classifier works correctly for BCI");
 }
 
+/* ========== Test Fisher Direction ========== */
+
+static float uniform_noise(void) {
+    return (float)rand() / RAND_MAX - 0.5f;
+}
+
+/* Correlated classes: the mean difference points along the shared noise
+ * axis, so only the covariance-aware direction separates them */
+void test_fisher_direction(void) {
+    TEST_START("Fisher Direction Uses Within-Class Scatter");
+    
+    srand(3);
+    signal_t rows[NUM_TRAIN][2];
+    lda_sample_t samples[NUM_TRAIN];
+    for (size_t i = 0; i < NUM_TRAIN; i++) {
+        int label = (int)(i % 2);
+        float common = 4.0f * uniform_noise();     /* Large, shared along (1, 1) */
+        float offset = label ? 0.3f : -0.3f;
+        rows[i][0] = common + offset + 0.1f * uniform_noise();
+        rows[i][1] = common + 0.1f * uniform_noise();
+        samples[i].features = rows[i];
+        samples[i].label = label;
+    }
+    
+    lda_model_t model;
+    lda_init(&model, 2);
+    TEST_ASSERT(lda_train(&model, samples, NUM_TRAIN) == TRUE, "Training succeeds");
+    
+    float accuracy = lda_accuracy(&model, samples, NUM_TRAIN);
+    printf("  Accuracy on correlated classes: %.1f%%\n", accuracy * 100);
+    TEST_ASSERT(accuracy > 0.95f, "Fisher direction separates correlated classes");
+    TEST_ASSERT(model.projection[0] * model.projection[1] < 0.0f,
+                "Projection cancels the shared noise axis");
+    
+    lda_free(&model);
+    TEST_PASS("Fisher direction is covariance-aware");
+}
+
+/* ========== Test Multi-Class LDA ========== */
+
+#define MC_CLASSES 4
+#define MC_PER_CLASS 60
+#define MC_ROWS (MC_CLASSES * MC_PER_CLASS)
+
+/* NONE/FOCUS/RELAX/BLINK-like clusters in the lda_feature_vector layout */
+static void generate_multiclass_rows(signal_t *rows, int *labels) {
+    static const float centers[MC_CLASSES][LDA_NUM_BCI_FEATURES] = {
+        { 0.25f, 0.25f, 0.25f, 0.25f, 2.0f, 100.0f, 0.0f },   /* NONE */
+        { 0.10f, 0.15f, 0.65f, 0.10f, 2.0f, 150.0f, 0.0f },   /* FOCUS */
+        { 0.10f, 0.65f, 0.15f, 0.10f, 2.0f, 300.0f, 0.0f },   /* RELAX */
+        { 0.25f, 0.25f, 0.25f, 0.25f, 6.0f, 900.0f, 1.5f }    /* BLINK */
+    };
+    
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        int label = (int)(r % MC_CLASSES);
+        signal_t *row = &rows[r * LDA_NUM_BCI_FEATURES];
+        for (size_t j = 0; j < LDA_NUM_BCI_FEATURES; j++) {
+            float spread = (j == 5) ? 80.0f : (j == 4 || j == 6) ? 0.8f : 0.12f;
+            row[j] = centers[label][j] + spread * uniform_noise();
+        }
+        labels[r] = label;
+    }
+}
+
+void test_multiclass_lda(void) {
+    TEST_START("Multi-Class LDA (NONE/FOCUS/RELAX/BLINK)");
+    
+    static signal_t rows[MC_ROWS * LDA_NUM_BCI_FEATURES];
+    static int labels[MC_ROWS];
+    srand(5);
+    generate_multiclass_rows(rows, labels);
+    
+    lda_multiclass_t model;
+    bool_t ok = lda_train_multiclass(&model, rows, labels, MC_ROWS, LDA_NUM_BCI_FEATURES,
+                                     MC_CLASSES, LDA_DEFAULT_SHRINKAGE);
+    TEST_ASSERT(ok == TRUE, "Multi-class training succeeds");
+    
+    /* Held-out windows from the same distributions */
+    static signal_t test_rows[MC_ROWS * LDA_NUM_BCI_FEATURES];
+    static int test_labels[MC_ROWS];
+    static int predictions[MC_ROWS];
+    static float scores[MC_ROWS * MC_CLASSES];
+    generate_multiclass_rows(test_rows, test_labels);
+    lda_predict_batch(&model, test_rows, MC_ROWS, predictions, scores);
+    
+    size_t correct = 0;
+    int mismatches = 0;
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        correct += (predictions[r] == test_labels[r]) ? 1 : 0;
+        
+        float single_scores[MC_CLASSES];
+        int single = lda_multiclass_predict(&model, &test_rows[r * LDA_NUM_BCI_FEATURES],
+                                            single_scores);
+        if (single != predictions[r] || single_scores[1] != scores[r * MC_CLASSES + 1]) {
+            mismatches++;
+        }
+    }
+    float accuracy = (float)correct / MC_ROWS;
+    printf("  Held-out 4-class accuracy: %.1f%%\n", accuracy * 100);
+    TEST_ASSERT(accuracy > 0.9f, "Four classes separated by one model");
+    TEST_ASSERT(mismatches == 0, "Batched scores match per-window prediction");
+    
+    /* One-pass Welford accumulation matches a two-pass computation */
+    lda_scatter_t scatter;
+    lda_scatter_init(&scatter, LDA_NUM_BCI_FEATURES, MC_CLASSES);
+    lda_scatter_add_rows(&scatter, rows, labels, MC_ROWS);
+    float mean = 0.0f;
+    for (size_t r = 2; r < MC_ROWS; r += MC_CLASSES) {
+        mean += rows[r * LDA_NUM_BCI_FEATURES + 5];
+    }
+    mean /= MC_PER_CLASS;
+    float within = 0.0f;
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        float class_mean = 0.0f;
+        for (size_t q = (size_t)labels[r]; q < MC_ROWS; q += MC_CLASSES) {
+            class_mean += rows[q * LDA_NUM_BCI_FEATURES + 5];
+        }
+        class_mean /= MC_PER_CLASS;
+        float diff = rows[r * LDA_NUM_BCI_FEATURES + 5] - class_mean;
+        within += diff * diff;
+    }
+    TEST_ASSERT(fabsf(scatter.mean[2][5] - mean) < 1e-3f, "Streaming class mean matches");
+    TEST_ASSERT(fabsf(scatter.scatter[5][5] - within) < within * 1e-4f,
+                "Streaming within-class scatter matches");
+    
+    /* Unseen classes are never predicted; bad sizes are rejected */
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        labels[r] = (labels[r] == 3) ? 0 : labels[r];
+    }
+    lda_train_multiclass(&model, rows, labels, MC_ROWS, LDA_NUM_BCI_FEATURES,
+                         MC_CLASSES, LDA_DEFAULT_SHRINKAGE);
+    lda_predict_batch(&model, test_rows, MC_ROWS, predictions, NULL);
+    int unseen = 0;
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        unseen += (predictions[r] == 3) ? 1 : 0;
+    }
+    TEST_ASSERT(unseen == 0, "Class without samples is never predicted");
+    TEST_ASSERT(!lda_scatter_init(&scatter, LDA_MAX_FEATURES + 1, 2), "Too many features rejected");
+    
+    TEST_PASS("Multi-class LDA works correctly");
+}
+
+/* ========== Test Online Adaptation ========== */
+
+/* Without forgetting, the online model equals a batch fit of the same windows */
+void test_online_matches_batch(void) {
+    TEST_START("Online LDA Matches Batch Training");
+    
+    static signal_t rows[MC_ROWS * LDA_NUM_BCI_FEATURES];
+    static int labels[MC_ROWS];
+    srand(9);
+    generate_multiclass_rows(rows, labels);
+    
+    static lda_online_t online;
+    bool_t ok = lda_online_init(&online, LDA_NUM_BCI_FEATURES, MC_CLASSES, 1.0f, 1e-5f);
+    TEST_ASSERT(ok == TRUE, "Cold start succeeds");
+    for (size_t r = 0; r < MC_ROWS; r++) {
+        lda_online_update(&online, &rows[r * LDA_NUM_BCI_FEATURES], labels[r]);
+    }
+    
+    lda_multiclass_t batch;
+    lda_train_multiclass(&batch, rows, labels, MC_ROWS, LDA_NUM_BCI_FEATURES, MC_CLASSES, 0.0f);
+    
+    float worst = 0.0f;
+    for (size_t c = 0; c < MC_CLASSES; c++) {
+        for (size_t i = 0; i < LDA_NUM_BCI_FEATURES; i++) {
+            float scale = fabsf(batch.weights[c][i]) + 1e-3f;
+            float error = fabsf(online.model.weights[c][i] - batch.weights[c][i]) / scale;
+            worst = (error > worst) ? error : worst;
+        }
+    }
+    printf("  Worst relative weight error: %.5f\n", worst);
+    TEST_ASSERT(worst < 0.01f, "Online weights match the batch solve");
+    
+    /* The Sherman-Morrison inverse still inverts the running scatter */
+    float identity_error = 0.0f;
+    for (size_t i = 0; i < LDA_NUM_BCI_FEATURES; i++) {
+        for (size_t j = 0; j < LDA_NUM_BCI_FEATURES; j++) {
+            float value = 0.0f;
+            for (size_t k = 0; k < LDA_NUM_BCI_FEATURES; k++) {
+                value += online.inverse[i][k] * online.scatter[k][j];
+            }
+            float error = fabsf(value - ((i == j) ? 1.0f : 0.0f));
+            identity_error = (error > identity_error) ? error : identity_error;
+        }
+    }
+    TEST_ASSERT(identity_error < 1e-3f, "Inverse tracks the scatter matrix");
+    TEST_ASSERT(!lda_online_update(&online, rows, MC_CLASSES), "Bad label rejected");
+    TEST_ASSERT(!lda_online_init(&online, 2, 2, 1.5f, 1.0f), "Bad forgetting factor rejected");
+    
+    TEST_PASS("Online LDA is exact without forgetting");
+}
+
+/* Two correlated classes whose features drift by offset */
+static void drifting_window(signal_t *row, int label, float offset) {
+    float common = 2.0f * uniform_noise();
+    row[0] = common + (label ? 0.4f : -0.4f) + 0.1f * uniform_noise() + offset;
+    row[1] = common + 0.1f * uniform_noise();
+}
+
+/* With forgetting, a calibrated model follows a session's drift */
+void test_online_drift(void) {
+    TEST_START("Online LDA Follows Drift");
+    
+    srand(13);
+    lda_scatter_t calibration;
+    lda_scatter_init(&calibration, 2, 2);
+    signal_t row[2];
+    for (size_t i = 0; i < NUM_TRAIN; i++) {
+        drifting_window(row, (int)(i % 2), 0.0f);
+        lda_scatter_add(&calibration, row, (int)(i % 2));
+    }
+    
+    lda_multiclass_t frozen;
+    static lda_online_t online;
+    lda_multiclass_fit(&frozen, &calibration, LDA_DEFAULT_SHRINKAGE);
+    bool_t ok = lda_online_init_from(&online, &calibration, LDA_DEFAULT_SHRINKAGE, 0.95f);
+    TEST_ASSERT(ok == TRUE, "Online model starts from calibration data");
+    
+    /* Session drift: feature 0 shifts by more than the class gap */
+    for (size_t i = 0; i < NUM_TRAIN; i++) {
+        drifting_window(row, (int)(i % 2), 1.0f);
+        lda_online_update(&online, row, (int)(i % 2));
+    }
+    
+    size_t frozen_correct = 0;
+    size_t online_correct = 0;
+    for (size_t i = 0; i < NUM_TEST * 2; i++) {
+        int label = (int)(i % 2);
+        drifting_window(row, label, 1.0f);
+        frozen_correct += (lda_multiclass_predict(&frozen, row, NULL) == label) ? 1 : 0;
+        online_correct += (lda_multiclass_predict(&online.model, row, NULL) == label) ? 1 : 0;
+    }
+    float frozen_accuracy = (float)frozen_correct / (NUM_TEST * 2);
+    float online_accuracy = (float)online_correct / (NUM_TEST * 2);
+    printf("  Accuracy after drift: frozen %.1f%%, online %.1f%%\n",
+           frozen_accuracy * 100, online_accuracy * 100);
+    TEST_ASSERT(online_accuracy > 0.9f, "Adapted model classifies drifted windows");
+    TEST_ASSERT(online_accuracy > frozen_accuracy, "Adaptation beats the frozen model");
+    
+    /* Export to the binary projection API */
+    lda_model_t binary;
+    lda_init(&binary, 2);
+    TEST_ASSERT(lda_online_export(&online, &binary) == TRUE, "Binary projection exported");
+    drifting_window(row, 1, 1.0f);
+    signal_t other[2];
+    drifting_window(other, 0, 1.0f);
+    TEST_ASSERT(lda_predict(&binary, row) == 1 && lda_predict(&binary, other) == 0,
+                "Exported projection classifies like the online model");
+    lda_free(&binary);
+    
+    TEST_PASS("Online LDA adapts to drift");
+}
+
 /* ========== Test LDA Feature Integration ========== */
 
 void test_lda_with_bci_features(void) {
@@ -128,6 +382,10 @@ int main(void) {
     TEST_SUITE_START("LDA Classifier for BCI");
     
     test_lda_classifier();
+    test_fisher_direction();
+    test_multiclass_lda();
+    test_online_matches_batch();
+    test_online_drift();
     test_lda_with_bci_features();
     
     printf("\n");
@@ -137,7 +395,8 @@ int main(void) {
     printf("✓ Fast training (< 1 ms)\n");
     printf("✓ Perfect for FOCUS vs RELAX classification\n");
     printf("✓ Works with 4 BCI features\n");
-    printf("✓ No hyperparameters to tune\n");
+    printf("✓ Multi-class: NONE/FOCUS/RELAX/BLINK in one model\n");
+    printf("✓ One hyperparameter: covariance shrinkage\n");
     printf("✓ Interpretable projection direction\n");
     printf("=========================================\n");
     
@@ -0,0 +1,177 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/multichannel.h"
+#include "../include/data_loader.h"
+#include "../include/preprocessing.h"
+#include "../include/feature_extraction.h"
+#include "../include/dsp_arena.h"
+#include "../include/utils.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_CHANNELS 8
+#define TEST_CSV_PATH "test_multichannel_tmp.csv"
+
+/* Channel c carries a sine at 6 + 4c Hz (theta, alpha, beta bands) */
+static void fill_channel(signal_t *row, size_t length, size_t channel) {
+    float freq = 6.0f + 4.0f * channel;
+    for (size_t i = 0; i < length; i++) {
+        row[i] = 40.0f * sinf(2.0f * M_PI * freq * i / SAMPLING_RATE) + 10.0f;
+    }
+}
+
+/* Test frame layout and alignment */
+void test_frame_layout() {
+    TEST_START("Frame Layout");
+
+    eeg_frame_t frame;
+    ASSERT_TRUE(eeg_frame_init(&frame, TEST_CHANNELS, 100), "Heap frame initializes");
+    ASSERT_EQUAL(112, (int)frame.stride, "Stride rounds 100 samples up to whole cache lines");
+
+    bool_t aligned = TRUE;
+    for (size_t c = 0; c < TEST_CHANNELS; c++) {
+        if ((uintptr_t)eeg_frame_channel(&frame, c) % MULTICHANNEL_ALIGN != 0) {
+            aligned = FALSE;
+        }
+    }
+    ASSERT_TRUE(aligned, "Every channel row is cache-line aligned");
+    ASSERT_TRUE(eeg_frame_channel(&frame, TEST_CHANNELS) == NULL, "Out-of-range channel is NULL");
+    eeg_frame_destroy(&frame);
+    ASSERT_TRUE(frame.data == NULL, "Destroy clears the frame");
+
+    ASSERT_TRUE(!eeg_frame_init(&frame, MAX_CHANNELS + 1, 100), "Too many channels rejected");
+
+    static uint8_t buffer[EEG_FRAME_BYTES(4, WINDOW_SIZE)];
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, buffer, sizeof(buffer));
+    ASSERT_TRUE(eeg_frame_init_arena(&frame, &arena, 4, WINDOW_SIZE), "Arena frame fits EEG_FRAME_BYTES");
+    ASSERT_TRUE((uintptr_t)frame.data % MULTICHANNEL_ALIGN == 0, "Arena frame is aligned");
+    eeg_frame_destroy(&frame);
+}
+
+/* Test interleaved -> SoA conversion */
+void test_deinterleave() {
+    TEST_START("Deinterleave");
+
+    signal_t interleaved[3 * 5];
+    for (int i = 0; i < 5; i++) {
+        for (int c = 0; c < 3; c++) {
+            interleaved[i * 3 + c] = (signal_t)(c * 100 + i);
+        }
+    }
+
+    eeg_frame_t frame;
+    eeg_frame_init(&frame, 3, 5);
+    eeg_frame_deinterleave(&frame, interleaved, 5);
+
+    ASSERT_FLOAT_EQUAL(4.0f, eeg_frame_channel(&frame, 0)[4], 1e-6f, "Channel 0, sample 4");
+    ASSERT_FLOAT_EQUAL(102.0f, eeg_frame_channel(&frame, 1)[2], 1e-6f, "Channel 1, sample 2");
+    ASSERT_FLOAT_EQUAL(200.0f, eeg_frame_channel(&frame, 2)[0], 1e-6f, "Channel 2, sample 0");
+    eeg_frame_destroy(&frame);
+}
+
+/* Test batched processing against the single-channel pipeline */
+void test_batched_features() {
+    TEST_START("Batched Features Match Single-Channel Pipeline");
+
+    eeg_frame_t frame;
+    eeg_frame_init(&frame, TEST_CHANNELS, WINDOW_SIZE);
+    for (size_t c = 0; c < TEST_CHANNELS; c++) {
+        fill_channel(eeg_frame_channel(&frame, c), WINDOW_SIZE, c);
+    }
+
+    features_t batched[TEST_CHANNELS];
+    process_frame(NULL, &frame, batched);
+
+    float max_diff = 0.0f;
+    for (size_t c = 0; c < TEST_CHANNELS; c++) {
+        signal_t reference[WINDOW_SIZE];
+        features_t single;
+        fill_channel(reference, WINDOW_SIZE, c);
+        preprocess_signal(reference, WINDOW_SIZE);
+        extract_features(reference, WINDOW_SIZE, &single);
+
+        float diffs[] = {
+            fabsf(single.alpha_power - batched[c].alpha_power),
+            fabsf(single.beta_power - batched[c].beta_power),
+            fabsf(single.peak_amplitude - batched[c].peak_amplitude),
+        };
+        for (size_t k = 0; k < sizeof(diffs) / sizeof(diffs[0]); k++) {
+            if (diffs[k] > max_diff) {
+                max_diff = diffs[k];
+            }
+        }
+    }
+    ASSERT_FLOAT_EQUAL(0.0f, max_diff, 1e-4f, "process_frame matches per-channel extract_features");
+
+    /* Channel 1 is a 10 Hz tone, channel 4 a 22 Hz tone */
+    ASSERT_TRUE(batched[1].alpha_power > 0.8f, "10 Hz channel is alpha-dominant");
+    ASSERT_TRUE(batched[4].beta_power > 0.8f, "22 Hz channel is beta-dominant");
+
+    features_t average;
+    average_frame_features(batched, TEST_CHANNELS, &average);
+    float total = average.theta_power + average.alpha_power + average.beta_power + average.gamma_power;
+    ASSERT_FLOAT_EQUAL(1.0f, total, 1e-3f, "Averaged band ratios still sum to 1");
+
+    eeg_frame_destroy(&frame);
+}
+
+/* Test the multi-channel CSV loader */
+void test_multichannel_csv() {
+    TEST_START("Multi-Channel CSV Loader");
+
+    FILE *fp = fopen(TEST_CSV_PATH, "w");
+    ASSERT_TRUE(fp != NULL, "Temporary CSV created");
+    if (fp == NULL) {
+        return;
+    }
+    fprintf(fp, "time,ch1,ch2,ch3,command\n");
+    for (int i = 0; i < 10; i++) {
+        fprintf(fp, "%.4f,%d.5,%d,%d,%s\n", i / (float)SAMPLING_RATE, i, -i, 100 + i,
+                (i < 5) ? "RELAX" : "FOCUS");
+    }
+    fclose(fp);
+
+    dataset_info_t info;
+    ASSERT_TRUE(get_dataset_info(TEST_CSV_PATH, &info), "Dataset info read");
+    ASSERT_EQUAL(3, (int)info.num_channels, "Channel columns counted");
+    ASSERT_EQUAL(10, (int)info.num_samples, "Samples counted");
+    ASSERT_TRUE(info.has_labels, "Command column detected");
+
+    eeg_frame_t frame;
+    command_t labels[10];
+    size_t loaded = 0;
+    eeg_frame_init(&frame, info.num_channels, info.num_samples);
+    ASSERT_TRUE(load_multichannel_csv(TEST_CSV_PATH, &frame, labels, &loaded), "CSV loads");
+    ASSERT_EQUAL(10, (int)loaded, "All rows loaded");
+    ASSERT_FLOAT_EQUAL(7.5f, eeg_frame_channel(&frame, 0)[7], 1e-5f, "ch1 value");
+    ASSERT_FLOAT_EQUAL(-3.0f, eeg_frame_channel(&frame, 1)[3], 1e-5f, "ch2 value");
+    ASSERT_FLOAT_EQUAL(109.0f, eeg_frame_channel(&frame, 2)[9], 1e-5f, "ch3 value");
+    ASSERT_TRUE(labels[0] == CMD_RELAX && labels[9] == CMD_FOCUS, "Commands parsed");
+    eeg_frame_destroy(&frame);
+
+    eeg_frame_init(&frame, 2, 10);
+    ASSERT_TRUE(!load_multichannel_csv(TEST_CSV_PATH, &frame, NULL, &loaded),
+                "Channel-count mismatch rejected");
+    eeg_frame_destroy(&frame);
+
+    remove(TEST_CSV_PATH);
+}
+
+int main() {
+    TEST_SUITE_START("Multi-Channel Tests");
+
+    preprocessing_init();
+
+    test_frame_layout();
+    test_deinterleave();
+    test_batched_features();
+    test_multichannel_csv();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
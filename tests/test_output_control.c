@@ -0,0 +1,177 @@
+#include "test_framework.h"
+#include "output_control.h"
+#include "scheduler.h"
+
+#define BUZZER_US ((uint64_t)BUZZER_DURATION_MS * 1000u)
+
+static int changes = 0;
+
+static void count_change(void *user_data, const output_state_t *state) {
+    (void)state;
+    (*(int*)user_data)++;
+}
+
+/* Posting returns at once; the outputs change when the consumer runs */
+void test_post_and_service(void) {
+    TEST_START("Post and Service");
+
+    output_controller_t controller;
+    output_state_t state;
+    changes = 0;
+    output_controller_init(&controller, count_change, &changes);
+
+    ASSERT_TRUE(output_post(&controller, CMD_FOCUS), "FOCUS queued");
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(!state.led_state, "LED untouched until serviced");
+
+    ASSERT_TRUE(output_service(&controller, 1000), "Service reports a change");
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(state.led_state, "FOCUS turns the LED on");
+    ASSERT_EQUAL(1, changes, "on_change called once");
+
+    ASSERT_TRUE(!output_service(&controller, 2000), "Nothing pending: no change");
+    ASSERT_TRUE(output_post(&controller, CMD_FOCUS), "Repeated FOCUS queued");
+    ASSERT_TRUE(!output_service(&controller, 3000), "LED already on: no change");
+    ASSERT_EQUAL(1, changes, "No callback without a change");
+
+    ASSERT_TRUE(output_post(&controller, CMD_NONE), "CMD_NONE accepted");
+    ASSERT_EQUAL(2, (int)controller.applied, "CMD_NONE never queued");
+
+    output_controller_destroy(&controller);
+}
+
+/* Pending FOCUS/RELAX collapse to the last one, blinks to one buzz */
+void test_coalescing(void) {
+    TEST_START("Coalescing");
+
+    output_controller_t controller;
+    output_state_t state;
+    changes = 0;
+    output_controller_init(&controller, count_change, &changes);
+
+    output_post(&controller, CMD_FOCUS);
+    output_post(&controller, CMD_RELAX);
+    output_post(&controller, CMD_FOCUS);
+    output_service(&controller, 0);
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(state.led_state, "Last LED command wins");
+    ASSERT_EQUAL(3, (int)controller.applied, "Three commands applied");
+    ASSERT_EQUAL(2, (int)controller.coalesced, "Two merged away");
+    ASSERT_EQUAL(1, changes, "One update for the batch");
+
+    output_post(&controller, CMD_BLINK);
+    output_post(&controller, CMD_BLINK);
+    output_post(&controller, CMD_BLINK);
+    output_service(&controller, 10000);
+    output_controller_state(&controller, &state);
+    ASSERT_EQUAL(3, state.cursor_x, "Cursor steps once per blink");
+    ASSERT_EQUAL('D', state.selected_char, "Character under the cursor selected");
+    ASSERT_TRUE(state.buzzer_active, "Burst sounds the buzzer");
+    ASSERT_EQUAL(4, (int)controller.coalesced, "Burst counts as one buzz");
+    ASSERT_EQUAL(2, changes, "One update for the burst");
+
+    output_controller_destroy(&controller);
+}
+
+/* The buzzer switches off BUZZER_DURATION_MS after its last trigger */
+void test_buzzer_timeout(void) {
+    TEST_START("Buzzer Timeout");
+
+    output_controller_t controller;
+    output_state_t state;
+    output_controller_init(&controller, NULL, NULL);
+
+    output_post(&controller, CMD_BLINK);
+    output_service(&controller, 1000);
+    output_service(&controller, 1000 + BUZZER_US - 1);
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(state.buzzer_active, "Still sounding before the deadline");
+
+    /* A new blink re-arms the deadline */
+    output_post(&controller, CMD_BLINK);
+    output_service(&controller, 1000 + BUZZER_US / 2);
+    output_service(&controller, 1000 + BUZZER_US);
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(state.buzzer_active, "Second blink extends the buzz");
+
+    ASSERT_TRUE(output_service(&controller, 1000 + BUZZER_US / 2 + BUZZER_US),
+                "Deadline reported as a change");
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(!state.buzzer_active, "Silent after BUZZER_DURATION_MS");
+
+    output_controller_destroy(&controller);
+}
+
+/* A full queue drops new commands instead of blocking the producer */
+void test_full_queue(void) {
+    TEST_START("Full Queue");
+
+    output_controller_t controller;
+    output_state_t state;
+    output_controller_init(&controller, NULL, NULL);
+
+    int accepted = 0;
+    for (int i = 0; i < OUTPUT_QUEUE_CAPACITY + 3; i++) {
+        accepted += output_post(&controller, (i % 2) ? CMD_RELAX : CMD_FOCUS) ? 1 : 0;
+    }
+    ASSERT_EQUAL(OUTPUT_QUEUE_CAPACITY, accepted, "Capacity commands accepted");
+    ASSERT_EQUAL(3, (int)output_dropped(&controller), "Overflow counted");
+
+    /* The queued commands end on RELAX (capacity is even) */
+    output_service(&controller, 0);
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(!state.led_state, "Kept commands applied in order");
+    ASSERT_TRUE(output_post(&controller, CMD_FOCUS), "Room again after a drain");
+
+    output_controller_destroy(&controller);
+}
+
+/* The consumer thread applies posts on its own and expires the buzzer */
+void test_consumer_thread(void) {
+    TEST_START("Consumer Thread");
+
+    output_controller_t controller;
+    output_state_t state;
+    output_controller_init(&controller, NULL, NULL);
+
+    if (!output_controller_start(&controller)) {
+        TEST_PASS("Test skipped - built without USE_PTHREADS");
+        output_controller_destroy(&controller);
+        return;
+    }
+
+    output_post(&controller, CMD_FOCUS);
+    output_post(&controller, CMD_BLINK);
+    uint64_t give_up = sched_now_us() + 1000000u;
+    do {
+        output_controller_state(&controller, &state);
+    } while (!state.buzzer_active && sched_now_us() < give_up);
+    ASSERT_TRUE(state.led_state && state.buzzer_active, "Thread applied the posts");
+
+    give_up = sched_now_us() + BUZZER_US + 1000000u;
+    do {
+        output_controller_state(&controller, &state);
+    } while (state.buzzer_active && sched_now_us() < give_up);
+    ASSERT_TRUE(!state.buzzer_active, "Thread silenced the buzzer on time");
+
+    output_post(&controller, CMD_RELAX);
+    output_controller_stop(&controller);
+    output_controller_state(&controller, &state);
+    ASSERT_TRUE(!state.led_state, "Pending command drained on stop");
+
+    output_controller_destroy(&controller);
+}
+
+int main() {
+    TEST_SUITE_START("Output Control Tests");
+
+    test_post_and_service();
+    test_coalescing();
+    test_buzzer_timeout();
+    test_full_queue();
+    test_consumer_thread();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/preprocessing.h"
+#include "../include/feature_extraction.h"
+#include "../include/fft.h"
+#include <math.h>
+#include <string.h>
+
+/* Reference O(length * window) moving average */
+static void reference_moving_average(const signal_t *input, signal_t *output,
+                                     size_t length, size_t window) {
+    if (window > length) window = length;
+    for (size_t i = 0; i < length; i++) {
+        signal_t sum = 0.0f;
+        size_t count = 0;
+        for (size_t j = 0; j < window && j <= i; j++) {
+            sum += input[i - j];
+            count++;
+        }
+        output[i] = sum / count;
+    }
+}
+
+static float max_abs_difference(const signal_t *a, const signal_t *b, size_t length) {
+    float max_diff = 0.0f;
+    for (size_t i = 0; i < length; i++) {
+        float diff = fabsf(a[i] - b[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    return max_diff;
+}
+
+/* Test running-sum moving average against the reference */
+void test_moving_average() {
+    TEST_START("Moving Average (Running Sum)");
+
+    signal_t input[WINDOW_SIZE];
+    signal_t expected[WINDOW_SIZE];
+    signal_t output[WINDOW_SIZE];
+
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        input[i] = 50.0f * sinf(2.0f * M_PI * 10.0f * i / 256.0f) + (i % 7) - 3.0f;
+    }
+
+    size_t windows[] = { 1, MA_FILTER_SIZE, 32, WINDOW_SIZE, WINDOW_SIZE + 10 };
+    float max_diff = 0.0f;
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        reference_moving_average(input, expected, WINDOW_SIZE, windows[w]);
+        moving_average_filter(input, output, WINDOW_SIZE, windows[w]);
+        float diff = max_abs_difference(expected, output, WINDOW_SIZE);
+        if (diff > max_diff) max_diff = diff;
+    }
+
+    ASSERT_TRUE(max_diff < 1e-3f, "Running sum matches reference (incl. warm-up)");
+
+    signal_t short_input[3] = { 3.0f, 6.0f, 9.0f };
+    signal_t short_output[3];
+    moving_average_filter(short_input, short_output, 3, 2);
+    ASSERT_FLOAT_EQUAL(3.0f, short_output[0], 0.0001f, "Warm-up window of one sample");
+    ASSERT_FLOAT_EQUAL(4.5f, short_output[1], 0.0001f, "Full window average");
+    ASSERT_FLOAT_EQUAL(7.5f, short_output[2], 0.0001f, "Full window average (last)");
+}
+
+/* Test in-place filtering gives the same output */
+void test_moving_average_in_place() {
+    TEST_START("Moving Average (In Place)");
+
+    signal_t input[WINDOW_SIZE];
+    signal_t separate[WINDOW_SIZE];
+
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        input[i] = (float)((i * 37) % 101) - 50.0f;
+    }
+
+    moving_average_filter(input, separate, WINDOW_SIZE, MA_FILTER_SIZE);
+    moving_average_filter(input, input, WINDOW_SIZE, MA_FILTER_SIZE);
+
+    ASSERT_TRUE(memcmp(input, separate, sizeof(input)) == 0,
+                "In-place output identical to out-of-place output");
+}
+
+/* Test full preprocessing keeps zero mean, unit variance */
+void test_preprocess_signal() {
+    TEST_START("Preprocessing Pipeline");
+
+    signal_t signal[WINDOW_SIZE];
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        signal[i] = 100.0f + 30.0f * sinf(2.0f * M_PI * 10.0f * i / 256.0f);
+    }
+
+    preprocess_signal(signal, WINDOW_SIZE);
+
+    float mean = 0.0f, variance = 0.0f;
+    for (int i = 0; i < WINDOW_SIZE; i++) mean += signal[i];
+    mean /= WINDOW_SIZE;
+    for (int i = 0; i < WINDOW_SIZE; i++) variance += (signal[i] - mean) * (signal[i] - mean);
+    variance /= WINDOW_SIZE;
+
+    ASSERT_FLOAT_EQUAL(0.0f, mean, 0.001f, "Preprocessed signal has zero mean");
+    ASSERT_FLOAT_EQUAL(1.0f, variance, 0.001f, "Preprocessed signal has unit variance");
+}
+
+/* Test fused kernel against the separate preprocessing stages */
+void test_preprocess_fused() {
+    TEST_START("Fused Preprocessing Kernel");
+
+    signal_t raw[WINDOW_SIZE];
+    signal_t staged[WINDOW_SIZE];
+    signal_t fused[WINDOW_SIZE];
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        float t = (float)i / SAMPLING_RATE;
+        raw[i] = 80.0f + 30.0f * sinf(2.0f * M_PI * 10.0f * t) + ((i % 40 == 0) ? 90.0f : 0.0f);
+    }
+
+    /* Reference: one stage at a time, then features */
+    signal_t baseline = calculate_baseline(raw, WINDOW_SIZE);
+    memcpy(staged, raw, sizeof(raw));
+    remove_baseline(staged, WINDOW_SIZE, baseline);
+    moving_average_filter(staged, staged, WINDOW_SIZE, MA_FILTER_SIZE);
+    normalize_signal(staged, WINDOW_SIZE);
+
+    features_t expected;
+    features_t actual;
+    extract_time_features(staged, WINDOW_SIZE, &expected);
+
+    memcpy(fused, raw, sizeof(raw));
+    preprocess_and_measure(fused, WINDOW_SIZE, &actual);
+
+    ASSERT_TRUE(max_abs_difference(staged, fused, WINDOW_SIZE) < 1e-3f,
+                "Fused output matches staged pipeline");
+    ASSERT_FLOAT_EQUAL(expected.variance, actual.variance, 0.001f, "Variance matches");
+    ASSERT_FLOAT_EQUAL(expected.peak_amplitude, actual.peak_amplitude, 0.001f, "Peak matches");
+    ASSERT_FLOAT_EQUAL(expected.skewness, actual.skewness, 0.01f, "Skewness matches");
+    ASSERT_TRUE(actual.skewness > 0.1f, "Positive spikes give positive skewness");
+}
+
+/* RMS of a filtered sinusoid after the start-up transient */
+static float filtered_rms(float freq, float low_freq, float high_freq) {
+    signal_t signal[4 * WINDOW_SIZE];
+    size_t length = 4 * WINDOW_SIZE;
+
+    for (size_t i = 0; i < length; i++) {
+        signal[i] = sinf(2.0f * M_PI * freq * i / SAMPLING_RATE);
+    }
+    bandpass_filter(signal, signal, length, low_freq, high_freq);
+
+    float power = 0.0f;
+    for (size_t i = length / 2; i < length; i++) {
+        power += signal[i] * signal[i];
+    }
+    return sqrtf(power / (length / 2));
+}
+
+/* Test band-pass filter honours its band edges */
+void test_bandpass_filter() {
+    TEST_START("IIR Band-Pass Filter");
+
+    /* Unit sinusoid has RMS 0.707 */
+    float in_band = filtered_rms(10.5f, ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
+    float below = filtered_rms(2.0f, ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
+    float above = filtered_rms(40.0f, ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ);
+    float beta = filtered_rms(21.5f, BETA_LOW_FREQ, BETA_HIGH_FREQ);
+
+    printf("  RMS in band: %.3f, 2 Hz: %.3f, 40 Hz: %.3f, beta: %.3f\n",
+           in_band, below, above, beta);
+
+    ASSERT_TRUE(in_band > 0.4f, "10.5 Hz passes alpha band-pass");
+    ASSERT_TRUE(below < 0.1f, "2 Hz rejected by alpha band-pass");
+    ASSERT_TRUE(above < 0.1f, "40 Hz rejected by alpha band-pass");
+    ASSERT_TRUE(beta > 0.5f, "21.5 Hz passes beta band-pass");
+}
+
+/* Test notch and per-band powers from the filter bank */
+void test_filter_bank() {
+    TEST_START("Filter Bank (Notch + Band Powers)");
+
+    filter_bank_t bank = *preprocessing_default_bank();
+    filter_bank_reset(&bank);
+
+    float mains_power = 0.0f;
+    for (size_t i = 0; i < 8 * WINDOW_SIZE; i++) {
+        float t = (float)i / SAMPLING_RATE;
+        signal_t x = sinf(2.0f * M_PI * NOTCH_FREQ * t) + 0.5f * sinf(2.0f * M_PI * 21.5f * t);
+        signal_t clean = filter_bank_process_sample(&bank, x, NULL);
+        if (i >= 4 * WINDOW_SIZE) {
+            signal_t residual = clean - 0.5f * sinf(2.0f * M_PI * 21.5f * t);
+            mains_power += residual * residual;
+        }
+    }
+    mains_power /= 4 * WINDOW_SIZE;
+
+    float band_powers[NUM_BANDS];
+    filter_bank_band_powers(&bank, band_powers);
+
+    ASSERT_TRUE(mains_power < 0.01f, "Notch removes mains interference");
+    ASSERT_TRUE(band_powers[BAND_BETA] > band_powers[BAND_ALPHA] &&
+                band_powers[BAND_BETA] > band_powers[BAND_THETA],
+                "Beta band power dominates for 21.5 Hz input");
+}
+
+/* Test filter-bank band ratios for pure tones against the FFT path */
+void test_filter_bank_tones() {
+    TEST_START("Filter Bank Selectivity vs FFT");
+
+    static signal_t window[4 * WINDOW_SIZE];
+    const size_t length = 4 * WINDOW_SIZE;
+    const float tones[] = { 6.0f, 10.0f, 20.0f, 40.0f };
+    const size_t expected_band[] = { BAND_THETA, BAND_ALPHA, BAND_BETA, BAND_GAMMA };
+    float worst_error = 0.0f;
+    int dominant = 0;
+
+    for (size_t t = 0; t < sizeof(tones) / sizeof(tones[0]); t++) {
+        filter_bank_t bank = *preprocessing_default_bank();
+        filter_bank_reset(&bank);
+        for (size_t i = 0; i < length; i++) {
+            window[i] = sinf(2.0f * M_PI * tones[t] * i / SAMPLING_RATE);
+            filter_bank_process_sample(&bank, window[i], NULL);
+        }
+
+        float iir[NUM_BANDS], fft[NUM_BANDS];
+        float iir_total = 0.0f, fft_total = 0.0f;
+        filter_bank_band_powers(&bank, iir);
+        calculate_band_powers_fft(&window[length - WINDOW_SIZE], WINDOW_SIZE, SAMPLING_RATE,
+                                  eeg_bands, NUM_BANDS, fft);
+        for (size_t b = 0; b < NUM_BANDS; b++) {
+            iir_total += iir[b];
+            fft_total += fft[b];
+        }
+
+        size_t b = expected_band[t];
+        float iir_ratio = iir[b] / iir_total;
+        float fft_ratio = fft[b] / fft_total;
+        printf("  %4.1f Hz: IIR %.3f, FFT %.3f\n", tones[t], iir_ratio, fft_ratio);
+        worst_error = fmaxf(worst_error, fabsf(iir_ratio - fft_ratio));
+        dominant += (iir_ratio > RELAX_THRESHOLD);
+    }
+
+    ASSERT_EQUAL(4, dominant, "Every tone clears the classifier threshold in its band");
+    ASSERT_TRUE(worst_error < 0.15f, "Band ratios within 0.15 of the FFT path");
+}
+
+int main() {
+    TEST_SUITE_START("Preprocessing Tests");
+
+    preprocessing_init();
+
+    test_moving_average();
+    test_moving_average_in_place();
+    test_preprocess_signal();
+    test_preprocess_fused();
+    test_bandpass_filter();
+    test_filter_bank();
+    test_filter_bank_tones();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+#include "test_framework.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_DUMP_PATH "test_profile_tmp.txt"
+
+/* Power-of-2 bins, min / max / totals */
+void test_histogram(void) {
+    TEST_START("Log2 Histogram");
+
+    prof_histogram_t hist;
+    memset(&hist, 0, sizeof(hist));
+
+    prof_histogram_add(&hist, 0, 0);
+    prof_histogram_add(&hist, 1, 1);
+    prof_histogram_add(&hist, 7, 3);
+    prof_histogram_add(&hist, 8, 4);
+    prof_histogram_add(&hist, 1000, 500);
+    prof_histogram_add(&hist, 1ull << 40, 0);
+
+    ASSERT_EQUAL(6, (int)hist.count, "Every duration counted");
+    ASSERT_EQUAL(1, (int)hist.bins[0], "Zero ticks in bin 0");
+    ASSERT_EQUAL(1, (int)hist.bins[1], "1 tick in bin 1");
+    ASSERT_EQUAL(1, (int)hist.bins[3], "7 ticks in bin 3 [4, 8)");
+    ASSERT_EQUAL(1, (int)hist.bins[4], "8 ticks in bin 4 [8, 16)");
+    ASSERT_EQUAL(1, (int)hist.bins[10], "1000 ticks in bin 10 [512, 1024)");
+    ASSERT_EQUAL(1, (int)hist.bins[PROF_HIST_BINS - 1], "Beyond 32 bits saturates");
+    ASSERT_EQUAL(0, (int)hist.min_ticks, "Minimum");
+    ASSERT_TRUE(hist.max_ticks == 0xFFFFFFFFu, "Maximum clamps to 32 bits");
+    ASSERT_TRUE(hist.total_ticks == 1016 + (1ull << 40), "Total keeps full precision");
+    ASSERT_EQUAL(508, (int)hist.total_instret, "Instructions summed");
+}
+
+/* Stage timing against the clock, and the latency / overrun records */
+void test_stage_recording(void) {
+    TEST_START("Stage and Latency Recording");
+
+    profiler_reset();
+    const profiler_t *prof = profiler_get();
+
+    prof_mark_t start = prof_read();
+    sched_sleep_until(sched_now_us() + 2000);
+    prof_record_stage(PROF_FFT, &start);
+
+    const prof_histogram_t *fft = &prof->stages[PROF_FFT];
+    ASSERT_EQUAL(1, (int)fft->count, "One FFT recorded");
+    ASSERT_EQUAL(0, (int)prof->stages[PROF_CLASSIFY].count, "Other stages untouched");
+    if (strcmp(prof_tick_unit(), "ns") == 0) {
+        ASSERT_TRUE(fft->min_ticks >= 2000000u, "2 ms sleep measured in ns");
+    }
+
+    prof_record_latency(prof_read().ticks);
+    prof_record_latency(0);
+    ASSERT_EQUAL(1, (int)prof->latency.count, "Unstamped buffers ignored");
+
+    prof_record_overruns(64, 2);
+    prof_record_overruns(32, 1);
+    ASSERT_EQUAL(96, (int)prof->dropped, "Dropped samples accumulate");
+    ASSERT_EQUAL(3, (int)prof->overruns, "Overruns accumulate");
+}
+
+/* Report lines parse back to the recorded numbers */
+void test_dump_format(void) {
+    TEST_START("Dump Format");
+
+    profiler_reset();
+    prof_mark_t start = prof_read();
+    prof_record_stage(PROF_CLASSIFY, &start);
+    prof_record_overruns(5, 1);
+
+    FILE *fp = fopen(TEST_DUMP_PATH, "w+");
+    ASSERT_TRUE(fp != NULL, "Dump file created");
+    if (fp == NULL) {
+        return;
+    }
+    profiler_dump(fp);
+    rewind(fp);
+
+    char line[256];
+    int hist_lines = 0, has_header = 0, has_end = 0;
+    unsigned long count = 0, dropped = 0, overruns = 0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char name[32];
+        unsigned long n;
+        if (strncmp(line, "@prof,1,", 8) == 0) {
+            has_header = 1;
+        } else if (sscanf(line, "@hist,%31[^,],%lu,", name, &n) == 2) {
+            hist_lines++;
+            if (strcmp(name, "classify") == 0) {
+                count = n;
+            }
+        } else if (sscanf(line, "@overrun,%lu,%lu", &dropped, &overruns) == 2) {
+            continue;
+        } else if (strcmp(line, "@end\n") == 0) {
+            has_end = 1;
+        }
+    }
+    fclose(fp);
+    remove(TEST_DUMP_PATH);
+
+    ASSERT_TRUE(has_header && has_end, "Header and end markers");
+    ASSERT_EQUAL(PROF_NUM_STAGES + 1, hist_lines, "One line per stage plus latency");
+    ASSERT_EQUAL(1, (int)count, "Classify count reported");
+    ASSERT_TRUE(dropped == 5 && overruns == 1, "Overrun line reported");
+}
+
+int main() {
+    TEST_SUITE_START("Profiler Tests");
+
+    printf("Tick unit: %s\n", prof_tick_unit());
+
+    test_histogram();
+    test_stage_recording();
+    test_dump_format();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/sample_ring.h"
+#include "../include/scheduler.h"
+#include <stdint.h>
+#include <string.h>
+
+#if USE_PTHREADS
+#include <pthread.h>
+#endif
+
+#define TEST_CAPACITY 16
+
+/* Test capacity rules and basic FIFO order */
+void test_ring_basics() {
+    TEST_START("Ring Basics");
+
+    signal_t storage[TEST_CAPACITY];
+    sample_ring_t ring;
+
+    ASSERT_TRUE(!sample_ring_init(&ring, storage, 12), "Non-power-of-2 capacity rejected");
+    ASSERT_TRUE(sample_ring_init(&ring, storage, TEST_CAPACITY), "Power-of-2 capacity accepted");
+    ASSERT_TRUE((uintptr_t)&ring.index.tail - (uintptr_t)&ring.index.head >= CACHE_LINE_SIZE,
+                "Head and tail on separate cache lines");
+    ASSERT_EQUAL(TEST_CAPACITY, (int)sample_ring_space(&ring), "Whole capacity usable");
+
+    for (int i = 0; i < 5; i++) {
+        sample_ring_push(&ring, (signal_t)i);
+    }
+    ASSERT_EQUAL(5, (int)sample_ring_available(&ring), "Pushed samples available");
+
+    signal_t out[TEST_CAPACITY];
+    size_t count = sample_ring_read(&ring, out, 3);
+    ASSERT_EQUAL(3, (int)count, "Partial read");
+    ASSERT_FLOAT_EQUAL(2.0f, out[2], 1e-6f, "Oldest samples first");
+    ASSERT_EQUAL(2, (int)sample_ring_available(&ring), "Remaining after read");
+}
+
+/* Test block writes across the wrap point and overrun accounting */
+void test_ring_wrap_and_overrun() {
+    TEST_START("Wraparound and Overruns");
+
+    signal_t storage[TEST_CAPACITY];
+    signal_t block[TEST_CAPACITY];
+    signal_t out[TEST_CAPACITY];
+    sample_ring_t ring;
+    sample_ring_init(&ring, storage, TEST_CAPACITY);
+
+    for (int i = 0; i < TEST_CAPACITY; i++) {
+        block[i] = (signal_t)(100 + i);
+    }
+
+    /* Move the indices near the end, then write across the wrap */
+    sample_ring_write(&ring, block, 12);
+    sample_ring_read(&ring, out, 12);
+    size_t stored = sample_ring_write(&ring, block, 10);
+    ASSERT_EQUAL(10, (int)stored, "Block write across wrap");
+
+    const signal_t *span;
+    size_t contiguous = sample_ring_peek(&ring, &span);
+    ASSERT_EQUAL(4, (int)contiguous, "Peek stops at the wrap");
+    ASSERT_FLOAT_EQUAL(100.0f, span[0], 1e-6f, "Peek sees oldest sample");
+    sample_ring_consume(&ring, contiguous);
+    contiguous = sample_ring_peek(&ring, &span);
+    ASSERT_EQUAL(6, (int)contiguous, "Second peek returns the wrapped part");
+    ASSERT_FLOAT_EQUAL(104.0f, span[0], 1e-6f, "Wrapped part continues the sequence");
+    sample_ring_consume(&ring, contiguous);
+
+    /* Fill completely, then overflow */
+    stored = sample_ring_write(&ring, block, TEST_CAPACITY);
+    ASSERT_EQUAL(TEST_CAPACITY, (int)stored, "Fill to capacity");
+    stored = sample_ring_write(&ring, block, 5);
+    ASSERT_EQUAL(0, (int)stored, "Full ring stores nothing");
+    ASSERT_TRUE(!sample_ring_push(&ring, 1.0f), "Push on full ring fails");
+    ASSERT_EQUAL(6, (int)sample_ring_dropped(&ring), "Dropped samples counted");
+    ASSERT_EQUAL(2, (int)sample_ring_overruns(&ring), "Overrun events counted");
+
+    sample_ring_read(&ring, out, TEST_CAPACITY);
+    ASSERT_TRUE(memcmp(out, block, sizeof(block)) == 0, "Stored data intact after overrun");
+}
+
+#if USE_PTHREADS
+#define STRESS_SAMPLES 200000
+
+static sample_ring_t stress_ring;
+static signal_t stress_storage[64];
+
+static void* stress_producer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < STRESS_SAMPLES; ) {
+        /* Retry instead of dropping so the consumer can check every sample */
+        signal_t block[7];
+        int count = (STRESS_SAMPLES - i < 7) ? STRESS_SAMPLES - i : 7;
+        for (int k = 0; k < count; k++) {
+            block[k] = (signal_t)(i + k);
+        }
+        size_t space = sample_ring_space(&stress_ring);
+        size_t n = ((size_t)count < space) ? (size_t)count : space;
+        i += (int)sample_ring_write(&stress_ring, block, n);
+    }
+    return NULL;
+}
+
+/* Test ordering with a real producer thread */
+void test_ring_threads() {
+    TEST_START("Producer Thread Stress");
+
+    pthread_t producer;
+    sample_ring_init(&stress_ring, stress_storage, 64);
+    pthread_create(&producer, NULL, stress_producer, NULL);
+
+    int expected = 0;
+    bool_t in_order = TRUE;
+    while (expected < STRESS_SAMPLES) {
+        signal_t out[13];
+        size_t n = sample_ring_read(&stress_ring, out, 13);
+        for (size_t k = 0; k < n; k++) {
+            if (out[k] != (signal_t)expected) {
+                in_order = FALSE;
+            }
+            expected++;
+        }
+    }
+    pthread_join(producer, NULL);
+
+    ASSERT_TRUE(in_order, "Every sample received once, in order");
+    ASSERT_EQUAL(0, (int)sample_ring_dropped(&stress_ring), "No drops when producer respects space");
+}
+#endif
+
+/* Test the timer and event waits */
+void test_scheduler() {
+    TEST_START("Scheduler");
+
+    sched_timer_t timer;
+    uint64_t start = sched_now_us();
+    sched_timer_start(&timer, 10000);
+    for (int i = 0; i < 3; i++) {
+        sched_timer_wait(&timer);
+    }
+    uint64_t elapsed = sched_now_us() - start;
+    ASSERT_TRUE(elapsed >= 30000, "Three 10 ms periods take at least 30 ms");
+    ASSERT_TRUE(elapsed < 500000, "Timer does not oversleep grossly");
+
+    sched_event_t event;
+    sched_event_init(&event);
+    ASSERT_TRUE(!sched_event_wait_until(&event, sched_now_us() + 5000), "Unsignalled wait times out");
+    sched_event_signal(&event);
+    ASSERT_TRUE(sched_event_wait_until(&event, sched_now_us() + 5000), "Signalled wait returns TRUE");
+    ASSERT_TRUE(!sched_event_wait_until(&event, sched_now_us()), "Wait clears the event");
+    sched_event_destroy(&event);
+}
+
+int main() {
+    TEST_SUITE_START("Sample Ring Tests");
+
+    test_ring_basics();
+    test_ring_wrap_and_overrun();
+#if USE_PTHREADS
+    test_ring_threads();
+#endif
+    test_scheduler();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+#include "test_framework.h"
+#include "session_file.h"
+#include "data_loader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_CSV_PATH "data/raw/sample_eeg_data.csv"
+#define TEST_SESSION_PATH "test_session_tmp.bcis"
+
+/* Convert the sample dataset and check it reads back sample-exact */
+void test_convert_roundtrip(void) {
+    TEST_START("CSV to Session Round Trip");
+
+    dataset_info_t info;
+    if (!get_dataset_info(TEST_CSV_PATH, &info)) {
+        printf("  WARNING: Could not open dataset (file may not exist yet)\n");
+        TEST_PASS("Test skipped - dataset file not found");
+        return;
+    }
+
+    eeg_frame_t expected;
+    command_t *expected_labels = (command_t*)malloc(info.num_samples * sizeof(command_t));
+    size_t num_loaded = 0;
+    eeg_frame_init(&expected, info.num_channels, info.num_samples);
+    load_multichannel_csv(TEST_CSV_PATH, &expected, expected_labels, &num_loaded);
+
+    bool_t converted = convert_csv_to_session(TEST_CSV_PATH, TEST_SESSION_PATH);
+    ASSERT_TRUE(converted, "Conversion succeeds");
+
+    session_reader_t reader;
+    bool_t opened = session_open(&reader, TEST_SESSION_PATH);
+    ASSERT_TRUE(opened, "Session file opens");
+    if (!opened) {
+        free(expected_labels);
+        eeg_frame_destroy(&expected);
+        return;
+    }
+
+    ASSERT_EQUAL((int)num_loaded, (int)reader.header.num_samples, "Sample count preserved");
+    ASSERT_EQUAL(1, (int)reader.header.num_channels, "Channel count preserved");
+    ASSERT_EQUAL(NUM_BANDS, (int)reader.header.num_bands, "Band table stored");
+    ASSERT_TRUE(strcmp(reader.header.labels[CMD_FOCUS], "FOCUS") == 0, "Label dictionary stored");
+
+    /* Zero-copy spans: aligned, bounded by their block */
+    const signal_t *span = NULL;
+    size_t count = session_channel_span(&reader, 0, 100, &span);
+    ASSERT_EQUAL(SESSION_BLOCK_SAMPLES - 100, (int)count, "Span ends at the block boundary");
+    ASSERT_TRUE(((uintptr_t)span % sizeof(float)) == 0, "Span is float-aligned in the mapping");
+
+    int mismatches = 0;
+    for (size_t i = 0; i < num_loaded; i += count) {
+        count = session_channel_span(&reader, 0, i, &span);
+        if (count == 0 || memcmp(span, eeg_frame_channel(&expected, 0) + i,
+                                 count * sizeof(signal_t)) != 0) {
+            mismatches++;
+            break;
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Every sample bit-identical to the CSV load");
+
+    int label_mismatches = 0;
+    for (size_t i = 0; i < num_loaded; i++) {
+        if (session_label(&reader, i) != expected_labels[i]) {
+            label_mismatches++;
+        }
+    }
+    ASSERT_EQUAL(0, label_mismatches, "Labels match the CSV commands");
+
+    /* Frame copy straddling blocks */
+    eeg_frame_t window;
+    command_t window_labels[WINDOW_SIZE];
+    eeg_frame_init(&window, 1, WINDOW_SIZE);
+    size_t copied = load_session_frame(&reader, 300, &window, window_labels);
+    ASSERT_EQUAL(WINDOW_SIZE, (int)copied, "Full window copied across a block boundary");
+    ASSERT_TRUE(memcmp(eeg_frame_channel(&window, 0), eeg_frame_channel(&expected, 0) + 300,
+                       WINDOW_SIZE * sizeof(signal_t)) == 0, "Window contents match");
+    copied = load_session_frame(&reader, num_loaded - 10, &window, NULL);
+    ASSERT_EQUAL(10, (int)copied, "Copy stops at the end of the recording");
+    eeg_frame_destroy(&window);
+
+    session_close(&reader);
+    free(expected_labels);
+    eeg_frame_destroy(&expected);
+}
+
+/* Seeking by time lands on the sample with that stamp */
+void test_seek_time(void) {
+    TEST_START("Seek by Time");
+
+    session_reader_t reader;
+    if (!session_open(&reader, TEST_SESSION_PATH)) {
+        TEST_PASS("Test skipped - no session file");
+        return;
+    }
+
+    float rate = reader.header.sample_rate;
+    ASSERT_EQUAL(0, (int)session_seek_time(&reader, 0.0f), "t=0 is the first sample");
+    ASSERT_EQUAL((int)(5 * rate), (int)session_seek_time(&reader, 5.0f), "t=5 s");
+    ASSERT_EQUAL((int)(2.5f * rate), (int)session_seek_time(&reader, 2.5f), "t=2.5 s");
+    ASSERT_EQUAL(0, (int)session_seek_time(&reader, -3.0f), "Before the start clamps");
+    ASSERT_EQUAL((int)reader.header.num_samples - 1, (int)session_seek_time(&reader, 1e6f),
+                 "Past the end clamps");
+
+    session_close(&reader);
+}
+
+/* Damaged files are rejected instead of being read out of bounds */
+void test_reject_corrupt(void) {
+    TEST_START("Corrupt Session Files");
+
+    FILE *fp = fopen(TEST_SESSION_PATH, "rb");
+    if (fp == NULL) {
+        TEST_PASS("Test skipped - no session file");
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    unsigned char *bytes = (unsigned char*)malloc((size_t)size);
+    size_t read = fread(bytes, 1, (size_t)size, fp);
+    fclose(fp);
+    ASSERT_TRUE(read == (size_t)size, "Session file read back");
+
+    session_reader_t reader;
+
+    /* Truncated: the index no longer fits */
+    fp = fopen(TEST_SESSION_PATH, "wb");
+    fwrite(bytes, 1, (size_t)size - 8, fp);
+    fclose(fp);
+    bool_t opened = session_open(&reader, TEST_SESSION_PATH);
+    ASSERT_TRUE(!opened, "Truncated file rejected");
+
+    /* Bad magic */
+    bytes[0] = 'X';
+    fp = fopen(TEST_SESSION_PATH, "wb");
+    fwrite(bytes, 1, (size_t)size, fp);
+    fclose(fp);
+    opened = session_open(&reader, TEST_SESSION_PATH);
+    ASSERT_TRUE(!opened, "Bad magic rejected");
+
+    free(bytes);
+    remove(TEST_SESSION_PATH);
+}
+
+int main() {
+    TEST_SUITE_START("Session File Tests");
+
+    data_loader_init(NULL);
+
+    test_convert_roundtrip();
+    test_seek_time();
+    test_reject_corrupt();
+
+    TEST_SUITE_END();
+
+    return 0;
+}
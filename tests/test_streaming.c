@@ -0,0 +1,211 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/streaming.h"
+#include "../include/feature_extraction.h"
+#include "../include/sliding_dft.h"
+#include "../include/fft.h"
+#include "../include/welch.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define NUM_STREAM_SAMPLES 1000
+
+/* The filter bank's skirts and running power average only track the FFT
+ * of one Hann window approximately */
+#if USE_IIR_BANDPOWER
+#define BAND_RATIO_TOLERANCE 0.12f
+#else
+#define BAND_RATIO_TOLERANCE 0.001f
+#endif
+
+/* Welch streaming averages segments, not one periodogram of the window */
+#define STREAM_USES_WELCH (!USE_IIR_BANDPOWER && !USE_SLIDING_DFT && USE_WELCH_PSD)
+
+static signal_t test_sample(size_t i) {
+    float t = i / (float)SAMPLING_RATE;
+    return 40.0f * sinf(2.0f * M_PI * 10.0f * t) + 15.0f * sinf(2.0f * M_PI * 21.0f * t) +
+           ((rand() % 100) / 10.0f);
+}
+
+/* Test hop scheduling: emissions start once the window fills */
+void test_emission_schedule() {
+    TEST_START("Emission Schedule");
+
+    stream_state_t stream;
+    streaming_init(&stream, 32);
+
+    size_t emitted = 0;
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        if (streaming_push_sample(&stream, test_sample(i), NULL)) {
+            emitted++;
+        }
+    }
+
+    size_t expected = (NUM_STREAM_SAMPLES - WINDOW_SIZE) / 32 + 1;
+    ASSERT_EQUAL((int)expected, (int)emitted, "One emission per hop after window fills");
+}
+
+/* Test running statistics against a full rescan of the window */
+void test_running_statistics() {
+    TEST_START("Running Statistics");
+
+    stream_state_t stream;
+    signal_t history[NUM_STREAM_SAMPLES];
+    streaming_init(&stream, 32);
+
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        history[i] = test_sample(i);
+        history[i] += (i == 900) ? 250.0f : 0.0f;  /* Spike inside the last window */
+        streaming_push_sample(&stream, history[i], NULL);
+    }
+
+    const signal_t *window = &history[NUM_STREAM_SAMPLES - WINDOW_SIZE];
+
+    ASSERT_FLOAT_EQUAL(calculate_mean(window, WINDOW_SIZE), streaming_mean(&stream), 0.01f,
+                       "Running mean matches rescan");
+    ASSERT_FLOAT_EQUAL(calculate_variance(window, WINDOW_SIZE), streaming_variance(&stream), 1.0f,
+                       "Running variance matches rescan");
+    ASSERT_FLOAT_EQUAL(detect_peak_amplitude(window, WINDOW_SIZE), streaming_peak(&stream), 0.001f,
+                       "Running peak matches rescan");
+}
+
+/* Test the running extremes on monotonic runs longer than a window */
+void test_monotonic_extremes() {
+    TEST_START("Running Extremes on Ramps and Steps");
+
+    stream_state_t stream;
+    signal_t history[NUM_STREAM_SAMPLES];
+
+    /* Rising through zero: the window's largest magnitude is its minimum */
+    streaming_init(&stream, 32);
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        history[i] = (signal_t)i - 1000.0f;
+        streaming_push_sample(&stream, history[i], NULL);
+    }
+    const signal_t *window = &history[NUM_STREAM_SAMPLES - WINDOW_SIZE];
+    ASSERT_FLOAT_EQUAL(detect_peak_amplitude(window, WINDOW_SIZE), streaming_peak(&stream), 0.001f,
+                       "Rising ramp: peak matches rescan");
+    ASSERT_TRUE(stream.min_tracker.length <= WINDOW_SIZE, "Rising ramp: min deque bounded");
+
+    /* Falling: the largest magnitude is the window's maximum */
+    streaming_init(&stream, 32);
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        history[i] = 1000.0f - (signal_t)i;
+        streaming_push_sample(&stream, history[i], NULL);
+    }
+    ASSERT_FLOAT_EQUAL(detect_peak_amplitude(window, WINDOW_SIZE), streaming_peak(&stream), 0.001f,
+                       "Falling ramp: peak matches rescan");
+    ASSERT_TRUE(stream.max_tracker.length <= WINDOW_SIZE, "Falling ramp: max deque bounded");
+
+    /* A step down: the old level leaves the window WINDOW_SIZE samples later */
+    streaming_init(&stream, 32);
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        streaming_push_sample(&stream, (i < 300) ? 500.0f : 20.0f, NULL);
+        if (i == 300 + WINDOW_SIZE - 2) {
+            ASSERT_FLOAT_EQUAL(500.0f, streaming_peak(&stream), 0.001f,
+                               "Step: old level held while still in the window");
+        }
+    }
+    ASSERT_FLOAT_EQUAL(20.0f, streaming_peak(&stream), 0.001f, "Step: old level expired");
+}
+
+/* Test band powers match batch feature extraction on the same window */
+void test_stream_features() {
+    TEST_START("Streaming Features vs Batch");
+
+    stream_state_t stream;
+    signal_t history[NUM_STREAM_SAMPLES];
+    features_t stream_features;
+    features_t batch_features;
+    streaming_init(&stream, 8);
+
+    size_t last_emit = 0;
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        history[i] = test_sample(i);
+        if (streaming_push_sample(&stream, history[i], &stream_features)) {
+            last_emit = i + 1;
+        }
+    }
+
+    extract_features(&history[last_emit - WINDOW_SIZE], WINDOW_SIZE, &batch_features);
+#if STREAM_USES_WELCH
+    /* The batch Welch estimate over the window ending at the last segment */
+    static welch_state_t welch;
+    float welch_powers[NUM_BANDS];
+    size_t segment_end = WELCH_SEGMENT_SIZE +
+                         (last_emit - WELCH_SEGMENT_SIZE) / WELCH_SEGMENT_HOP * WELCH_SEGMENT_HOP;
+    welch_init(&welch, SAMPLING_RATE);
+    calculate_band_powers_welch(&welch, &history[segment_end - WINDOW_SIZE], WINDOW_SIZE,
+                                eeg_bands, NUM_BANDS, welch_powers);
+    batch_features.theta_power = welch_powers[BAND_THETA];
+    batch_features.alpha_power = welch_powers[BAND_ALPHA];
+    batch_features.beta_power = welch_powers[BAND_BETA];
+    batch_features.gamma_power = welch_powers[BAND_GAMMA];
+    normalize_band_powers(&batch_features);
+#endif
+
+    ASSERT_FLOAT_EQUAL(batch_features.alpha_power, stream_features.alpha_power,
+                       BAND_RATIO_TOLERANCE, "Alpha ratio matches batch extraction");
+    ASSERT_FLOAT_EQUAL(batch_features.beta_power, stream_features.beta_power,
+                       BAND_RATIO_TOLERANCE, "Beta ratio matches batch extraction");
+    ASSERT_TRUE(stream_features.alpha_power > RELAX_THRESHOLD,
+                "Alpha ratio reaches the RELAX threshold");
+    ASSERT_TRUE(stream_features.alpha_power > stream_features.beta_power,
+                "Alpha dominates for 10 Hz + weaker 21 Hz signal");
+}
+
+/* Test sliding DFT band powers against the FFT backend */
+void test_sliding_dft() {
+    TEST_START("Sliding DFT vs FFT Band Powers");
+
+    sdft_state_t sdft;
+    signal_t history[NUM_STREAM_SAMPLES];
+    sdft_init(&sdft, eeg_bands, NUM_BANDS);
+
+    for (size_t i = 0; i < NUM_STREAM_SAMPLES; i++) {
+        history[i] = test_sample(i);
+        signal_t leaving = (i >= WINDOW_SIZE) ? history[i - WINDOW_SIZE] : 0.0f;
+        sdft_update(&sdft, history[i], leaving);
+    }
+
+    const signal_t *window = &history[NUM_STREAM_SAMPLES - WINDOW_SIZE];
+    float sdft_powers[NUM_BANDS];
+    float fft_powers[NUM_BANDS];
+    sdft_band_powers(&sdft, sdft_powers);
+    calculate_band_powers_fft(window, WINDOW_SIZE, SAMPLING_RATE, eeg_bands, NUM_BANDS, fft_powers);
+
+    /* Periodic (sliding) vs symmetric (FFT) Hann windows differ slightly */
+    float max_rel_error = 0.0f;
+    for (size_t b = BAND_ALPHA; b <= BAND_BETA; b++) {
+        float rel_error = fabsf(sdft_powers[b] - fft_powers[b]) / fft_powers[b];
+        if (rel_error > max_rel_error) {
+            max_rel_error = rel_error;
+        }
+    }
+    printf("  Max relative error (alpha/beta): %.4f\n", max_rel_error);
+    ASSERT_TRUE(max_rel_error < 0.05f, "Sliding DFT matches FFT band powers within 5%");
+
+    /* Resync from the window must agree with the recursive update */
+    float resync_powers[NUM_BANDS];
+    sdft_resync(&sdft, window);
+    sdft_band_powers(&sdft, resync_powers);
+    ASSERT_FLOAT_EQUAL(sdft_powers[BAND_ALPHA], resync_powers[BAND_ALPHA],
+                       0.001f * sdft_powers[BAND_ALPHA], "Resync matches recursive bins");
+}
+
+int main() {
+    TEST_SUITE_START("Streaming Pipeline Tests");
+
+    feature_extraction_init();
+
+    test_emission_schedule();
+    test_running_statistics();
+    test_monotonic_extremes();
+    test_stream_features();
+    test_sliding_dft();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+#include "test_framework.h"
+#include "telemetry.h"
+#include "utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#if TELEMETRY_HAS_UDP
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#define TEST_CAPTURE_PATH "test_telemetry_tmp.bct"
+
+static signal_t window[WINDOW_SIZE];
+static features_t features = { 0.1f, 0.2f, 0.6f, 0.1f, 12.0f, 4.0f, 0.0f };
+static output_state_t outputs = { TRUE, TRUE, 3, 0, 'D' };
+static predictions_t predictions = { PRED_NORMAL, PRED_BORDERLINE, PRED_IMPAIRED };
+
+static telemetry_record_t make_record(size_t num_samples, uint32_t first_sample) {
+    telemetry_record_t record = { window, num_samples, first_sample, &features, CMD_FOCUS,
+                                  &outputs, &predictions };
+    return record;
+}
+
+/* Header fields, decimation and the CRC seal */
+void test_encode(void) {
+    TEST_START("Frame Encoding");
+
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        window[i] = (signal_t)i;
+    }
+
+    telemetry_frame_t frame;
+    telemetry_record_t record = make_record(WINDOW_SIZE, 512);
+    telemetry_encode(&frame, 7, &record);
+
+    ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, (int)sizeof(frame), "Frame has no padding");
+    ASSERT_TRUE(frame.magic == TELEMETRY_MAGIC, "Magic");
+    ASSERT_EQUAL(7, (int)frame.sequence, "Sequence number");
+    ASSERT_EQUAL(512, (int)frame.first_sample, "First sample index");
+    ASSERT_EQUAL(SAMPLING_RATE, (int)frame.sample_rate, "Sample rate");
+    ASSERT_EQUAL(WINDOW_SIZE / TELEMETRY_FRAME_SAMPLES, (int)frame.sample_stride,
+                 "Full window decimated to fit");
+    ASSERT_EQUAL(TELEMETRY_FRAME_SAMPLES, (int)frame.num_samples, "Frame filled");
+    ASSERT_FLOAT_EQUAL(8.0f, frame.samples[1], 1e-6f, "Every stride-th sample kept");
+    ASSERT_EQUAL(CMD_FOCUS, (int)frame.command, "Command");
+    ASSERT_EQUAL(TELEMETRY_LED | TELEMETRY_BUZZER, (int)frame.outputs, "LED and buzzer bits");
+    ASSERT_EQUAL('D', (int)frame.selected_char, "Selected character");
+    ASSERT_EQUAL(PRED_IMPAIRED, (int)frame.predictions[2], "Attention prediction");
+    ASSERT_FLOAT_EQUAL(0.6f, frame.band_power[BAND_BETA], 1e-6f, "Beta power");
+    ASSERT_TRUE(telemetry_frame_check(&frame), "Sealed frame validates");
+
+    /* zlib's check value: the Python reader verifies frames with zlib.crc32 */
+    ASSERT_TRUE(crc32_update(0, "123456789", 9) == 0xCBF43926u, "CRC-32 check value");
+
+    frame.samples[5] += 1.0f;
+    ASSERT_TRUE(!telemetry_frame_check(&frame), "Damaged payload rejected");
+
+    /* A hop fits without decimation; missing context is zeroed */
+    telemetry_record_t hop = { window, STREAM_HOP_SIZE, 0, NULL, CMD_NONE, NULL, NULL };
+    telemetry_encode(&frame, 0, &hop);
+    ASSERT_EQUAL(1, (int)frame.sample_stride, "Hop sent sample by sample");
+    ASSERT_EQUAL(STREAM_HOP_SIZE, (int)frame.num_samples, "Hop length");
+    ASSERT_EQUAL(0, (int)frame.outputs, "No output state: all off");
+    ASSERT_FLOAT_EQUAL(0.0f, frame.band_power[BAND_ALPHA], 1e-6f, "No features: zero powers");
+
+    /* Odd lengths round the sample count up */
+    telemetry_record_t odd = make_record(100, 0);
+    telemetry_encode(&frame, 0, &odd);
+    ASSERT_EQUAL(4, (int)frame.sample_stride, "100 samples: stride 4");
+    ASSERT_EQUAL(25, (int)frame.num_samples, "100 samples: 25 kept");
+}
+
+/* A capture file reads back as back-to-back frames with running sequence numbers */
+void test_file_sink(void) {
+    TEST_START("File Sink");
+
+    telemetry_endpoint_t endpoint;
+    telemetry_sink_t sink;
+    telemetry_t telemetry;
+    bool_t opened = telemetry_endpoint_open(&endpoint, &sink, TEST_CAPTURE_PATH);
+    ASSERT_TRUE(opened, "Capture file opens");
+    if (!opened) {
+        return;
+    }
+
+    telemetry_init(&telemetry, &sink);
+    for (uint32_t i = 0; i < 3; i++) {
+        telemetry_record_t record = make_record(WINDOW_SIZE, i * WINDOW_SIZE);
+        telemetry_send(&telemetry, &record);
+    }
+    telemetry_endpoint_close(&endpoint);
+    ASSERT_EQUAL(3, (int)telemetry.sequence, "Three frames sent");
+    ASSERT_EQUAL(0, (int)telemetry.failed, "None dropped");
+
+    telemetry_frame_t frames[4];
+    FILE *fp = fopen(TEST_CAPTURE_PATH, "rb");
+    size_t read = (fp != NULL) ? fread(frames, sizeof(frames[0]), 4, fp) : 0;
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    remove(TEST_CAPTURE_PATH);
+
+    ASSERT_EQUAL(3, (int)read, "Capture holds exactly three frames");
+    int valid = 0;
+    int in_order = 0;
+    for (size_t i = 0; i < read; i++) {
+        valid += telemetry_frame_check(&frames[i]) ? 1 : 0;
+        in_order += (frames[i].sequence == i && frames[i].first_sample == i * WINDOW_SIZE);
+    }
+    ASSERT_EQUAL(3, valid, "Every frame validates");
+    ASSERT_EQUAL(3, in_order, "Sequence numbers and sample indices run on");
+}
+
+/* A sink that takes part of a frame counts it as failed */
+static size_t short_write(void *context, const void *data, size_t length) {
+    (void)context;
+    (void)data;
+    return length / 2;
+}
+
+void test_failed_frames(void) {
+    TEST_START("Dropped Frames");
+
+    telemetry_sink_t sink = { "short", short_write, NULL };
+    telemetry_t telemetry;
+    telemetry_init(&telemetry, &sink);
+
+    telemetry_record_t record = make_record(WINDOW_SIZE, 0);
+    bool_t sent = telemetry_send(&telemetry, &record);
+    ASSERT_TRUE(!sent, "Short write reported");
+    ASSERT_EQUAL(1, (int)telemetry.failed, "Failure counted");
+    ASSERT_EQUAL(1, (int)telemetry.sequence, "Sequence still advances (receiver sees the gap)");
+
+    telemetry_endpoint_t endpoint;
+    ASSERT_TRUE(!telemetry_endpoint_open(&endpoint, &sink, "udp:localhost"),
+                "UDP destination without a port rejected");
+}
+
+#if TELEMETRY_HAS_UDP
+/* Loopback: one frame per datagram */
+void test_udp_sink(void) {
+    TEST_START("UDP Sink");
+
+    int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    if (receiver < 0 || bind(receiver, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        getsockname(receiver, (struct sockaddr*)&address, &length) != 0) {
+        TEST_PASS("Test skipped - no loopback socket");
+        if (receiver >= 0) {
+            close(receiver);
+        }
+        return;
+    }
+    struct timeval timeout = { 2, 0 };
+    setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    char spec[64];
+    snprintf(spec, sizeof(spec), "udp:127.0.0.1:%u", (unsigned int)ntohs(address.sin_port));
+    telemetry_endpoint_t endpoint;
+    telemetry_sink_t sink;
+    telemetry_t telemetry;
+    bool_t opened = telemetry_endpoint_open(&endpoint, &sink, spec);
+    ASSERT_TRUE(opened, "UDP destination opens");
+    if (opened) {
+        telemetry_init(&telemetry, &sink);
+        telemetry_record_t record = make_record(WINDOW_SIZE, 0);
+        telemetry_send(&telemetry, &record);
+        telemetry_send(&telemetry, &record);
+        telemetry_endpoint_close(&endpoint);
+
+        telemetry_frame_t frame;
+        ssize_t first = recv(receiver, &frame, sizeof(frame), 0);
+        ASSERT_EQUAL((int)sizeof(frame), (int)first, "Datagram is one frame");
+        ASSERT_TRUE(first == (ssize_t)sizeof(frame) && telemetry_frame_check(&frame),
+                    "Received frame validates");
+        ssize_t second = recv(receiver, &frame, sizeof(frame), 0);
+        ASSERT_TRUE(second == (ssize_t)sizeof(frame) && frame.sequence == 1,
+                    "Second datagram carries sequence 1");
+    }
+    close(receiver);
+}
+#endif
+
+int main() {
+    TEST_SUITE_START("Telemetry Tests");
+
+    test_encode();
+    test_file_sink();
+    test_failed_frames();
+#if TELEMETRY_HAS_UDP
+    test_udp_sink();
+#endif
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/welch.h"
+#include "../include/fft.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define NUM_TEST_SAMPLES 1000
+#define NUM_TRIALS 40
+
+static welch_state_t welch;
+
+static const frequency_band_t test_bands[NUM_BANDS] = {
+    { THETA_LOW_FREQ, THETA_HIGH_FREQ },
+    { ALPHA_LOW_FREQ, ALPHA_HIGH_FREQ },
+    { BETA_LOW_FREQ, BETA_HIGH_FREQ },
+    { GAMMA_LOW_FREQ, GAMMA_HIGH_FREQ }
+};
+
+static signal_t noise_sample(void) {
+    return (rand() % 2001 - 1000) / 100.0f;
+}
+
+/* Alpha share of the 4-30 Hz power */
+static float alpha_share(const float *powers) {
+    float total = powers[0] + powers[1] + powers[2];
+    return (total > 0.0f) ? powers[1] / total : 0.0f;
+}
+
+/* Test segment scheduling: first segment once history fills, then one per hop */
+void test_segment_schedule() {
+    TEST_START("Segment Schedule");
+
+    signal_t zeros[WINDOW_SIZE] = { 0 };
+    welch_reset(&welch);
+
+    size_t segments = welch_push_samples(&welch, zeros, WELCH_SEGMENT_SIZE - 1);
+    ASSERT_EQUAL(0, (int)segments, "No segment before history fills");
+    ASSERT_EQUAL(0, (int)welch_spectrum(&welch)->num_bins, "Spectrum empty until then");
+
+    segments += welch_push_samples(&welch, &zeros[WELCH_SEGMENT_SIZE - 1],
+                                   WINDOW_SIZE - (WELCH_SEGMENT_SIZE - 1));
+    ASSERT_EQUAL(WELCH_NUM_SEGMENTS, (int)segments, "One window holds WELCH_NUM_SEGMENTS segments");
+    ASSERT_EQUAL(WELCH_NUM_BINS, (int)welch_spectrum(&welch)->num_bins, "Spectrum published");
+}
+
+/* Test scaling: the averaged density integrates to the signal power */
+void test_power_calibration() {
+    TEST_START("Power Calibration");
+
+    signal_t signal[WINDOW_SIZE];
+    float amplitude = 20.0f;
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        signal[i] = amplitude * sinf(2.0f * M_PI * 10.0f * i / SAMPLING_RATE);
+    }
+
+    frequency_band_t bands[2] = { { 8.0f, 13.0f }, { 0.0f, SAMPLING_RATE / 2.0f } };
+    float powers[2];
+    size_t segments = calculate_band_powers_welch(&welch, signal, WINDOW_SIZE, bands, 2, powers);
+
+    float expected = amplitude * amplitude / 2.0f;
+    ASSERT_EQUAL(WELCH_NUM_SEGMENTS, (int)segments, "Whole window averaged");
+    ASSERT_FLOAT_EQUAL(expected, powers[1], expected * 0.02f, "Total power is A^2/2");
+    ASSERT_FLOAT_EQUAL(expected, powers[0], expected * 0.05f, "10 Hz tone lands in alpha");
+}
+
+/* Test the streaming estimate against a batch estimate of the same samples */
+void test_stream_matches_batch() {
+    TEST_START("Streaming Average vs Batch");
+
+    signal_t history[NUM_TEST_SAMPLES];
+    size_t last_segment = 0;
+    srand(7);
+    welch_reset(&welch);
+    for (size_t i = 0; i < NUM_TEST_SAMPLES; i++) {
+        history[i] = 30.0f * sinf(2.0f * M_PI * 6.0f * i / SAMPLING_RATE) + noise_sample();
+        if (welch_push_sample(&welch, history[i])) {
+            last_segment = i + 1;
+        }
+    }
+
+    float streamed[NUM_BANDS];
+    float batch[NUM_BANDS];
+    welch_band_powers(&welch, test_bands, NUM_BANDS, streamed);
+
+    /* The average covers the last WELCH_NUM_SEGMENTS segments, i.e. one window */
+    static welch_state_t reference;
+    welch_init(&reference, SAMPLING_RATE);
+    calculate_band_powers_welch(&reference, &history[last_segment - WINDOW_SIZE], WINDOW_SIZE,
+                                test_bands, NUM_BANDS, batch);
+
+    float max_diff = 0.0f;
+    for (size_t b = 0; b < NUM_BANDS; b++) {
+        float diff = fabsf(streamed[b] - batch[b]);
+        max_diff = (diff > max_diff) ? diff : max_diff;
+    }
+    ASSERT_FLOAT_EQUAL(0.0f, max_diff, 1e-6f, "Ring-buffered segments match the batch window");
+}
+
+/* Test variance reduction: Welch band shares scatter less than a single
+ * periodogram at the same frequency resolution */
+void test_variance_reduction() {
+    TEST_START("Band Ratio Stability");
+
+    frequency_band_t bands[3] = { { 4.0f, 8.0f }, { 8.0f, 13.0f }, { 13.0f, 30.0f } };
+    signal_t signal[WINDOW_SIZE];
+    float welch_sum = 0.0f, welch_sq = 0.0f;
+    float single_sum = 0.0f, single_sq = 0.0f;
+
+    srand(11);
+    for (size_t trial = 0; trial < NUM_TRIALS; trial++) {
+        for (size_t i = 0; i < WINDOW_SIZE; i++) {
+            signal[i] = noise_sample();
+        }
+
+        float powers[3];
+        calculate_band_powers_welch(&welch, signal, WINDOW_SIZE, bands, 3, powers);
+        float share = alpha_share(powers);
+        welch_sum += share;
+        welch_sq += share * share;
+
+        /* One periodogram over the newest segment */
+        calculate_band_powers_fft(&signal[WINDOW_SIZE - WELCH_SEGMENT_SIZE], WELCH_SEGMENT_SIZE,
+                                  SAMPLING_RATE, bands, 3, powers);
+        share = alpha_share(powers);
+        single_sum += share;
+        single_sq += share * share;
+    }
+
+    float welch_var = welch_sq / NUM_TRIALS - (welch_sum / NUM_TRIALS) * (welch_sum / NUM_TRIALS);
+    float single_var = single_sq / NUM_TRIALS - (single_sum / NUM_TRIALS) * (single_sum / NUM_TRIALS);
+    printf("  Alpha share variance: Welch %.5f, single periodogram %.5f\n", welch_var, single_var);
+    ASSERT_TRUE(welch_var < single_var, "Averaging segments steadies band ratios");
+}
+
+int main() {
+    TEST_SUITE_START("Welch PSD Tests");
+
+    welch_init(&welch, SAMPLING_RATE);
+
+    test_segment_schedule();
+    test_power_calibration();
+    test_stream_matches_batch();
+    test_variance_reduction();
+
+    fft_cleanup();
+
+    TEST_SUITE_END();
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "test_framework.h"
+#include "../include/types.h"
+#include "../include/config.h"
+#include "../include/worker_pool.h"
+#include "../include/multichannel.h"
+#include "../include/utils.h"
+#include <math.h>
+#include <string.h>
+
+#define TEST_CHANNELS 12
+#define NUM_SESSIONS 4
+
+static const char *const session_paths[NUM_SESSIONS] = {
+    "data/raw/sample_eeg_data.csv",
+    "data/raw/visual_impairment_data.csv",
+    "data/raw/motor_impairment_data.csv",
+    "data/raw/attention_deficit_data.csv",
+};
+
+/* Channel c: 5 + 3c Hz tone, a different phase and offset per channel */
+static void fill_frame(eeg_frame_t *frame) {
+    for (size_t c = 0; c < frame->num_channels; c++) {
+        signal_t *row = eeg_frame_channel(frame, c);
+        for (size_t i = 0; i < frame->length; i++) {
+            row[i] = 30.0f * sinf(2.0f * M_PI * (5.0f + 3.0f * c) * i / SAMPLING_RATE + c) +
+                     5.0f * c;
+        }
+    }
+}
+
+/* Test parallel channels against serial process_frame */
+void test_parallel_channels() {
+    TEST_START("Parallel Channels Match Serial Pipeline");
+
+    worker_pool_t pool;
+    ASSERT_TRUE(worker_pool_init(&pool, 4, WINDOW_SIZE), "Pool starts");
+    ASSERT_TRUE(pool.num_workers >= 1 && pool.num_workers <= MAX_WORKERS, "Worker count in range");
+
+    eeg_frame_t serial_frame, parallel_frame;
+    eeg_frame_init(&serial_frame, TEST_CHANNELS, WINDOW_SIZE);
+    eeg_frame_init(&parallel_frame, TEST_CHANNELS, WINDOW_SIZE);
+    fill_frame(&serial_frame);
+    fill_frame(&parallel_frame);
+
+    features_t serial[TEST_CHANNELS];
+    features_t parallel[TEST_CHANNELS];
+    process_frame(NULL, &serial_frame, serial);
+    worker_pool_process_frame(&pool, &parallel_frame, parallel);
+
+    ASSERT_TRUE(memcmp(serial, parallel, sizeof(serial)) == 0,
+                "Per-channel features are bit-identical");
+
+    /* A second batch on the same pool reuses the idle workers */
+    fill_frame(&parallel_frame);
+    memset(parallel, 0, sizeof(parallel));
+    worker_pool_process_frame(&pool, &parallel_frame, parallel);
+    ASSERT_TRUE(memcmp(serial, parallel, sizeof(serial)) == 0, "Repeated batch is identical");
+
+    eeg_frame_destroy(&serial_frame);
+    eeg_frame_destroy(&parallel_frame);
+    worker_pool_destroy(&pool);
+}
+
+/* Test session scoring: same results for any worker count */
+void test_parallel_sessions() {
+    TEST_START("Parallel Session Scoring Is Deterministic");
+
+    session_result_t single[NUM_SESSIONS];
+    session_result_t multi[NUM_SESSIONS];
+    worker_pool_t pool;
+
+    worker_pool_init(&pool, 1, WINDOW_SIZE);
+    size_t loaded = worker_pool_process_sessions(&pool, session_paths, NUM_SESSIONS, single);
+    worker_pool_destroy(&pool);
+    ASSERT_EQUAL(NUM_SESSIONS, (int)loaded, "All sessions load with one worker");
+
+    worker_pool_init(&pool, MAX_WORKERS, WINDOW_SIZE);
+    loaded = worker_pool_process_sessions(&pool, session_paths, NUM_SESSIONS, multi);
+    worker_pool_destroy(&pool);
+    ASSERT_EQUAL(NUM_SESSIONS, (int)loaded, "All sessions load with a full pool");
+
+    ASSERT_TRUE(memcmp(single, multi, sizeof(single)) == 0,
+                "Merged results independent of worker count");
+
+    ASSERT_EQUAL(2560 / WINDOW_SIZE, (int)single[0].num_windows, "Windows per 10 s session");
+    size_t classified = 0;
+    for (size_t k = 0; k <= CMD_BLINK; k++) {
+        classified += single[0].command_counts[k];
+    }
+    ASSERT_EQUAL((int)single[0].num_windows, (int)classified, "Every window classified");
+    ASSERT_EQUAL((int)single[0].num_windows, (int)single[0].impairments.num_windows,
+                 "Every window graded for impairments");
+
+    const char *missing[] = { "data/raw/does_not_exist.csv" };
+    worker_pool_init(&pool, 2, WINDOW_SIZE);
+    loaded = worker_pool_process_sessions(&pool, missing, 1, single);
+    worker_pool_destroy(&pool);
+    ASSERT_TRUE(loaded == 0 && !single[0].loaded, "Missing session reported, not fatal");
+}
+
+int main() {
+    TEST_SUITE_START("Worker Pool Tests");
+
+    printf("Threads: %s\n", USE_PTHREADS ? "pthreads" : "serial fallback");
+
+    test_parallel_channels();
+    test_parallel_sessions();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}